@@ -299,6 +299,7 @@ void Anthropometrics::addMetric(
     Eigen::Vector3s axis)
 {
   mMetrics.emplace_back(name, bodyPose, bodyA, offsetA, bodyB, offsetB, axis);
+  updateMetricIndices();
 }
 
 //==============================================================================
@@ -320,6 +321,7 @@ void Anthropometrics::setDistribution(
     std::shared_ptr<math::MultivariateGaussian> dist)
 {
   mDist = dist;
+  updateMetricIndices();
 }
 
 //==============================================================================
@@ -494,12 +496,64 @@ std::map<std::string, s_t> Anthropometrics::measure(
   return result;
 }
 
+//==============================================================================
+/// This is the same as mDist->convertFromMap(measure(skel)), but it writes
+/// each measurement straight into its slot in the distribution's variable
+/// order.
+Eigen::VectorXs Anthropometrics::measureVector(
+    std::shared_ptr<dynamics::Skeleton> skel)
+{
+  const Eigen::VectorXs& mu = mDist->getMu();
+  Eigen::VectorXs result = Eigen::VectorXs::Zero(mu.size());
+  // Several metrics can share a name, and like measure() the last one we can
+  // actually measure wins, while the mean is only a fallback
+  std::vector<bool> measured(mu.size(), false);
+  Eigen::VectorXs originalPos = skel->getPositions();
+  for (int i = 0; i < mMetrics.size(); i++)
+  {
+    int index = mMetricIndices[i];
+    if (index == -1)
+    {
+      continue;
+    }
+    AnthroMetric& metric = mMetrics[i];
+    setSkelToMetricPose(skel, metric);
+    auto markersPair = getMarkers(skel, metric);
+
+    if (markersPair.first.first == nullptr
+        || markersPair.second.first == nullptr)
+    {
+      if (!measured[index])
+      {
+        result(index) = mu(index);
+        measured[index] = true;
+      }
+    }
+    else
+    {
+      if (metric.axis == Eigen::Vector3s::Zero())
+      {
+        result(index) = skel->getDistanceInWorldSpace(
+            markersPair.first, markersPair.second);
+      }
+      else
+      {
+        result(index) = skel->getDistanceAlongAxis(
+            markersPair.first, markersPair.second, metric.axis);
+      }
+      measured[index] = true;
+    }
+  }
+  skel->setPositions(originalPos);
+  return result;
+}
+
 //==============================================================================
 s_t Anthropometrics::getPDF(std::shared_ptr<dynamics::Skeleton> skel)
 {
   if (!mDist)
     return 0.0;
-  return mDist->computePDF(mDist->convertFromMap(measure(skel)));
+  return mDist->computePDF(measureVector(skel));
 }
 
 //==============================================================================
@@ -508,7 +562,7 @@ s_t Anthropometrics::getLogPDF(
 {
   if (!mDist)
     return 0.0;
-  return mDist->computeLogPDF(mDist->convertFromMap(measure(skel)), normalized);
+  return mDist->computeLogPDF(measureVector(skel), normalized);
 }
 
 //==============================================================================
@@ -519,12 +573,16 @@ Eigen::VectorXs Anthropometrics::getGradientOfLogPDFWrtBodyScales(
   if (!mDist)
     return grad;
 
-  std::map<std::string, s_t> gradMap = mDist->convertToMap(
-      mDist->computeLogPDFGrad(mDist->convertFromMap(measure(skel))));
+  Eigen::VectorXs logPDFGrad = mDist->computeLogPDFGrad(measureVector(skel));
 
   Eigen::VectorXs originalPos = skel->getPositions();
-  for (AnthroMetric& metric : mMetrics)
+  for (int i = 0; i < mMetrics.size(); i++)
   {
+    if (mMetricIndices[i] == -1)
+    {
+      continue;
+    }
+    AnthroMetric& metric = mMetrics[i];
     setSkelToMetricPose(skel, metric);
     auto markersPair = getMarkers(skel, metric);
 
@@ -533,13 +591,13 @@ Eigen::VectorXs Anthropometrics::getGradientOfLogPDFWrtBodyScales(
     {
       if (metric.axis == Eigen::Vector3s::Zero())
       {
-        grad += gradMap[metric.name]
+        grad += logPDFGrad(mMetricIndices[i])
                 * skel->getGradientOfDistanceWrtBodyScales(
                     markersPair.first, markersPair.second);
       }
       else
       {
-        grad += gradMap[metric.name]
+        grad += logPDFGrad(mMetricIndices[i])
                 * skel->getGradientOfDistanceAlongAxisWrtBodyScales(
                     markersPair.first, markersPair.second, metric.axis);
       }
@@ -587,12 +645,16 @@ Eigen::VectorXs Anthropometrics::getGradientOfLogPDFWrtGroupScales(
   if (!mDist)
     return grad;
 
-  std::map<std::string, s_t> gradMap = mDist->convertToMap(
-      mDist->computeLogPDFGrad(mDist->convertFromMap(measure(skel))));
+  Eigen::VectorXs logPDFGrad = mDist->computeLogPDFGrad(measureVector(skel));
 
   Eigen::VectorXs originalPos = skel->getPositions();
-  for (AnthroMetric& metric : mMetrics)
+  for (int i = 0; i < mMetrics.size(); i++)
   {
+    if (mMetricIndices[i] == -1)
+    {
+      continue;
+    }
+    AnthroMetric& metric = mMetrics[i];
     setSkelToMetricPose(skel, metric);
 
     auto markersPair = getMarkers(skel, metric);
@@ -601,13 +663,13 @@ Eigen::VectorXs Anthropometrics::getGradientOfLogPDFWrtGroupScales(
     {
       if (metric.axis == Eigen::Vector3s::Zero())
       {
-        grad += gradMap[metric.name]
+        grad += logPDFGrad(mMetricIndices[i])
                 * skel->getGradientOfDistanceWrtGroupScales(
                     markersPair.first, markersPair.second);
       }
       else
       {
-        grad += gradMap[metric.name]
+        grad += logPDFGrad(mMetricIndices[i])
                 * skel->getGradientOfDistanceAlongAxisWrtGroupScales(
                     markersPair.first, markersPair.second, metric.axis);
       }
@@ -647,5 +709,23 @@ Eigen::VectorXs Anthropometrics::finiteDifferenceGradientOfLogPDFWrtGroupScales(
   return result;
 }
 
+//==============================================================================
+/// This recomputes mMetricIndices, and needs to be called whenever the
+/// metrics or the distribution change
+void Anthropometrics::updateMetricIndices()
+{
+  mMetricIndices.clear();
+  std::vector<std::string> vars;
+  if (mDist)
+  {
+    vars = mDist->getVariableNames();
+  }
+  for (AnthroMetric& metric : mMetrics)
+  {
+    auto it = std::find(vars.begin(), vars.end(), metric.name);
+    mMetricIndices.push_back(it == vars.end() ? -1 : it - vars.begin());
+  }
+}
+
 } // namespace biomechanics
 } // namespace dart
\ No newline at end of file
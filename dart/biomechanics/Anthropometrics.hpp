@@ -84,6 +84,11 @@ public:
 
   std::map<std::string, s_t> measure(std::shared_ptr<dynamics::Skeleton> skel);
 
+  /// This is the same as mDist->convertFromMap(measure(skel)), but it writes
+  /// each measurement straight into its slot in the distribution's variable
+  /// order, without building any string-keyed maps.
+  Eigen::VectorXs measureVector(std::shared_ptr<dynamics::Skeleton> skel);
+
   s_t getPDF(std::shared_ptr<dynamics::Skeleton> skel);
 
   s_t getLogPDF(
@@ -105,8 +110,15 @@ public:
       std::shared_ptr<dynamics::Skeleton> skel);
 
 protected:
+  /// This recomputes mMetricIndices, and needs to be called whenever the
+  /// metrics or the distribution change
+  void updateMetricIndices();
+
   std::vector<AnthroMetric> mMetrics;
   std::shared_ptr<math::MultivariateGaussian> mDist;
+  /// For each entry in mMetrics, this is the index of its variable in mDist,
+  /// or -1 if mDist doesn't have it
+  std::vector<int> mMetricIndices;
 };
 
 } // namespace biomechanics
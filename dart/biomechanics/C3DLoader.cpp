@@ -64,14 +64,16 @@ s_t C3D::getWeightedDistFromCoPToNearestMarker()
 
   for (ForcePlate& plate : forcePlates)
   {
-    for (int i = 0; i < markerTimesteps.size(); i++)
+    for (int i = 0; i < markerObserved.cols(); i++)
     {
       Eigen::Vector3s cop = plate.centersOfPressure[i];
 
       s_t minDist = std::numeric_limits<double>::infinity();
-      for (auto& pair : markerTimesteps[i])
+      for (int j = 0; j < markerObserved.rows(); j++)
       {
-        s_t dist = (pair.second - cop).norm();
+        if (!markerObserved(j, i))
+          continue;
+        s_t dist = (markerPositions.block<3, 1>(j * 3, i) - cop).norm();
         if (dist < minDist)
         {
           minDist = dist;
@@ -99,50 +101,63 @@ s_t C3D::getWeightedDistFromCoPToNearestMarker()
 }
 
 //==============================================================================
-C3D C3DLoader::loadC3D(const std::string& uri)
+/// This rebuilds the map-based `markerTimesteps` view from the dense
+/// `markerPositions` and `markerObserved`.
+void C3D::rebuildMarkerTimestepsFromDense()
 {
-  C3D bestResult = loadC3DWithGRFConvention(uri, 0);
-  s_t bestResultRMS = bestResult.getWeightedDistFromCoPToNearestMarker();
-
-  // If there are no GRF's, no need to try multiple conventions
-  if (bestResultRMS == 0)
+  markerTimesteps.clear();
+  markerTimesteps.resize(markerObserved.cols());
+  for (int t = 0; t < markerObserved.cols(); t++)
   {
-    return bestResult;
+    std::map<std::string, Eigen::Vector3s>& map = markerTimesteps[t];
+    for (int i = 0; i < markerObserved.rows(); i++)
+    {
+      if (markerObserved(i, t))
+      {
+        // Markers are sorted by name in the map, so hint the insertion at the
+        // end whenever `markers` is already sorted. If a name shows up more
+        // than once, the last observed copy wins, like it does when loading.
+        auto it = map.emplace_hint(map.end(), markers[i], Eigen::Vector3s());
+        it->second = markerPositions.block<3, 1>(i * 3, t);
+      }
+    }
   }
+}
 
-  for (int i = 1; i < biomechanics::FORCE_PLATFORM_NUM_CONVENTIONS; i++)
+//==============================================================================
+/// This rebuilds the dense `markerPositions`, `markerObserved` and
+/// `markerIndices` from `markerTimesteps`. Call this after editing
+/// `markerTimesteps` directly.
+void C3D::rebuildDenseFromMarkerTimesteps()
+{
+  markerIndices.clear();
+  for (int i = 0; i < markers.size(); i++)
+  {
+    markerIndices[markers[i]] = i;
+  }
+  markerPositions
+      = Eigen::MatrixXs::Zero(markers.size() * 3, markerTimesteps.size());
+  markerObserved
+      = Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic>::Constant(
+          markers.size(), markerTimesteps.size(), false);
+  for (int t = 0; t < markerTimesteps.size(); t++)
   {
-    C3D competingConvention = loadC3DWithGRFConvention(uri, i);
-    s_t competingRMS
-        = competingConvention.getWeightedDistFromCoPToNearestMarker();
-    std::cout << "Tried force plate convention " << i << ". Best RMS "
-              << bestResultRMS << " vs this RMS " << competingRMS << std::endl;
-    if (competingRMS < bestResultRMS)
+    for (auto& pair : markerTimesteps[t])
     {
-      bestResult = competingConvention;
-      bestResultRMS = competingRMS;
+      auto index = markerIndices.find(pair.first);
+      if (index == markerIndices.end())
+        continue;
+      markerPositions.block<3, 1>(index->second * 3, t) = pair.second;
+      markerObserved(index->second, t) = true;
     }
   }
-  return bestResult;
 }
 
 //==============================================================================
-C3D C3DLoader::loadC3DWithGRFConvention(const std::string& uri, int convention)
+/// This reads the units the mocap points are declared in, and returns the
+/// factor to scale them into meters
+static double getMocapDataScaleFactor(const ezc3d::c3d& data)
 {
-  C3D result;
-  const std::string path = getAbsolutePath(uri);
-
-  std::string fullPath = getAbsolutePath(uri);
-
-  ezc3d::c3d data(fullPath);
-
-  double frameRate = data.header().frameRate();
-  std::cout << "Framerate: " << frameRate << std::endl;
-  result.framesPerSecond = frameRate;
-  int numFrames = data.header().nbFrames();
-  int analogFramesPerFrame = data.header().nbAnalogByFrame();
-
-  // Read the units that the mocap points are declared in
   double mocapDataScaleFactor = 1.0;
   const ezc3d::ParametersNS::Parameters& params = data.parameters();
   if (params.isGroup("POINT"))
@@ -181,8 +196,14 @@ C3D C3DLoader::loadC3DWithGRFConvention(const std::string& uri, int convention)
       }
     }
   }
+  return mocapDataScaleFactor;
+}
 
-  // Copy down the names of the points
+//==============================================================================
+/// This copies down the names of the points, cleaned up for use as keys
+static std::vector<std::string> getMarkerNames(const ezc3d::c3d& data)
+{
+  std::vector<std::string> markers;
   for (const std::string& name : data.pointNames())
   {
     std::string fixed = name;
@@ -197,7 +218,208 @@ C3D C3DLoader::loadC3DWithGRFConvention(const std::string& uri, int convention)
     {
       fixed = fixed.substr(fixed.find_first_of(":") + 1);
     }
-    result.markers.push_back(fixed);
+    markers.push_back(fixed);
+  }
+  return markers;
+}
+
+//==============================================================================
+/// This reads `numFrames` frames of marker data starting at file frame
+/// `firstFrame` into the dense layout used by C3D::markerPositions, writing
+/// into columns starting at `firstColumn`
+static void readMarkerFrames(
+    const ezc3d::c3d& data,
+    int firstFrame,
+    int numFrames,
+    double scaleFactor,
+    Eigen::MatrixXs& positions,
+    Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic>& observed,
+    int firstColumn)
+{
+  int numMarkers = observed.rows();
+  for (int t = 0; t < numFrames; t++)
+  {
+    const ezc3d::DataNS::Points3dNS::Points& points
+        = data.data().frame(firstFrame + t).points();
+    for (int i = 0; i < numMarkers; i++)
+    {
+      const ezc3d::DataNS::Points3dNS::Point& point = points.point(i);
+      Eigen::Vector3s pt = Eigen::Vector3s(
+          point.x() * scaleFactor,
+          point.y() * scaleFactor,
+          point.z() * scaleFactor);
+      // Don't store points with all zeros, since those are "unobserved"
+      bool isObserved = !(pt == Eigen::Vector3s::Zero() || pt.hasNaN());
+      observed(i, firstColumn + t) = isObserved;
+      if (isObserved)
+      {
+        positions.block<3, 1>(i * 3, firstColumn + t) = pt;
+      }
+      else
+      {
+        positions.block<3, 1>(i * 3, firstColumn + t).setZero();
+      }
+    }
+  }
+}
+
+//==============================================================================
+static C3D loadC3DFromData(const ezc3d::c3d& data, int convention);
+static void buildMarkerViews(C3D& result);
+
+//==============================================================================
+C3D C3DLoader::loadC3D(const std::string& uri)
+{
+  // Parse the file once, and then try each GRF convention against the same
+  // parsed data
+  ezc3d::c3d data(getAbsolutePath(uri));
+
+  C3D bestResult = loadC3DFromData(data, 0);
+  s_t bestResultRMS = bestResult.getWeightedDistFromCoPToNearestMarker();
+
+  // If there are no GRF's, no need to try multiple conventions
+  if (bestResultRMS != 0)
+  {
+    for (int i = 1; i < biomechanics::FORCE_PLATFORM_NUM_CONVENTIONS; i++)
+    {
+      C3D competingConvention = loadC3DFromData(data, i);
+      s_t competingRMS
+          = competingConvention.getWeightedDistFromCoPToNearestMarker();
+      std::cout << "Tried force plate convention " << i << ". Best RMS "
+                << bestResultRMS << " vs this RMS " << competingRMS
+                << std::endl;
+      if (competingRMS < bestResultRMS)
+      {
+        bestResult = std::move(competingConvention);
+        bestResultRMS = competingRMS;
+      }
+    }
+  }
+
+  buildMarkerViews(bestResult);
+  return bestResult;
+}
+
+//==============================================================================
+C3D C3DLoader::loadC3DWithGRFConvention(const std::string& uri, int convention)
+{
+  ezc3d::c3d data(getAbsolutePath(uri));
+  C3D result = loadC3DFromData(data, convention);
+  buildMarkerViews(result);
+  return result;
+}
+
+//==============================================================================
+/// This reads just the marker data out of a C3D file, `chunkFrames` frames
+/// at a time, and hands each chunk to `onChunk` in the same dense layout as
+/// C3D::markerPositions and C3D::markerObserved, scaled to meters. The data
+/// is not rotated and no map-based view is built, so beyond the parsed file
+/// itself we only hold one chunk at a time. This returns the marker names.
+std::vector<std::string> C3DLoader::loadC3DMarkerChunks(
+    const std::string& uri,
+    int chunkFrames,
+    std::function<void(
+        int startFrame,
+        const Eigen::MatrixXs& markerPositions,
+        const Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic>&
+            markerObserved)> onChunk)
+{
+  ezc3d::c3d data(getAbsolutePath(uri));
+  double mocapDataScaleFactor = getMocapDataScaleFactor(data);
+  std::vector<std::string> markers = getMarkerNames(data);
+
+  // This matches the frames we skip in loadC3D()
+  int startFrame = 2;
+  int numFrames = std::max(0, (int)data.header().nbFrames() - startFrame);
+  chunkFrames = std::max(1, chunkFrames);
+
+  Eigen::MatrixXs positions(markers.size() * 3, chunkFrames);
+  Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic> observed(
+      markers.size(), chunkFrames);
+  for (int t = 0; t < numFrames; t += chunkFrames)
+  {
+    int len = std::min(chunkFrames, numFrames - t);
+    if (len != positions.cols())
+    {
+      positions.resize(markers.size() * 3, len);
+      observed.resize(markers.size(), len);
+    }
+    readMarkerFrames(
+        data,
+        t + startFrame,
+        len,
+        mocapDataScaleFactor,
+        positions,
+        observed,
+        0);
+    onChunk(t, positions, observed);
+  }
+  return markers;
+}
+
+//==============================================================================
+/// This builds the map-based view and the shuffled matrices from the dense
+/// marker data
+static void buildMarkerViews(C3D& result)
+{
+  result.rebuildMarkerTimestepsFromDense();
+
+  // These are useful for faster access to the pre-random-order marker data in
+  // certain situations, for example in neural models
+  int numFrames = result.markerObserved.cols();
+  result.shuffledMarkersMatrix
+      = Eigen::MatrixXs::Zero(result.markers.size() * 3, numFrames);
+  result.shuffledMarkersMatrixMask
+      = Eigen::MatrixXs::Zero(result.markers.size() * 3, numFrames);
+
+  std::vector<int> markerOrder;
+  for (int i = 0; i < result.markers.size(); i++)
+  {
+    markerOrder.push_back(i);
+  }
+  auto rng = std::default_random_engine();
+
+  for (int t = 0; t < numFrames; t++)
+  {
+    int counter = 0;
+
+    std::shuffle(std::begin(markerOrder), std::end(markerOrder), rng);
+
+    for (int i : markerOrder)
+    {
+      if (result.markerObserved(i, t))
+      {
+        result.shuffledMarkersMatrix.block<3, 1>(counter * 3, t)
+            = result.markerPositions.block<3, 1>(i * 3, t);
+        result.shuffledMarkersMatrixMask.block<3, 1>(counter * 3, t)
+            .setConstant(1.0);
+        counter++;
+      }
+    }
+  }
+}
+
+//==============================================================================
+/// This loads everything except the map-based marker view and the shuffled
+/// matrices out of already parsed C3D data, using the given GRF convention
+static C3D loadC3DFromData(const ezc3d::c3d& data, int convention)
+{
+  C3D result;
+
+  double frameRate = data.header().frameRate();
+  std::cout << "Framerate: " << frameRate << std::endl;
+  result.framesPerSecond = frameRate;
+  int numFrames = data.header().nbFrames();
+  int analogFramesPerFrame = data.header().nbAnalogByFrame();
+
+  // Read the units that the mocap points are declared in
+  double mocapDataScaleFactor = getMocapDataScaleFactor(data);
+
+  // Copy down the names of the points
+  result.markers = getMarkerNames(data);
+  for (int i = 0; i < result.markers.size(); i++)
+  {
+    result.markerIndices[result.markers[i]] = i;
   }
 
   // Load in the force platforms
@@ -317,32 +539,33 @@ C3D C3DLoader::loadC3DWithGRFConvention(const std::string& uri, int convention)
   }
 
   int startFrame = 2;
-  for (int t = 0; t < numFrames - startFrame; t++)
+  int numLoadedFrames = std::max(0, numFrames - startFrame);
+  result.markerPositions
+      = Eigen::MatrixXs::Zero(result.markers.size() * 3, numLoadedFrames);
+  result.markerObserved
+      = Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic>::Constant(
+          result.markers.size(), numLoadedFrames, false);
+  readMarkerFrames(
+      data,
+      startFrame,
+      numLoadedFrames,
+      mocapDataScaleFactor,
+      result.markerPositions,
+      result.markerObserved,
+      0);
+
+  for (int j = 0; j < forcePlatforms.size(); j++)
+  {
+    result.forcePlates[j].timestamps.reserve(numLoadedFrames);
+    result.forcePlates[j].forces.reserve(numLoadedFrames);
+    result.forcePlates[j].moments.reserve(numLoadedFrames);
+    result.forcePlates[j].centersOfPressure.reserve(numLoadedFrames);
+  }
+  result.timestamps.reserve(numLoadedFrames);
+  for (int t = 0; t < numLoadedFrames; t++)
   {
     result.timestamps.push_back(t / frameRate);
 
-    result.markerTimesteps.emplace_back();
-    std::map<std::string, Eigen::Vector3s>& map = result.markerTimesteps.at(t);
-    for (int i = 0; i < result.markers.size(); i++)
-    {
-      const std::string& name = result.markers[i];
-      Eigen::Vector3s pt = Eigen::Vector3s(
-          data.data().frame(t + startFrame).points().point(i).x()
-              * mocapDataScaleFactor,
-          data.data().frame(t + startFrame).points().point(i).y()
-              * mocapDataScaleFactor,
-          data.data().frame(t + startFrame).points().point(i).z()
-              * mocapDataScaleFactor);
-      if (pt == Eigen::Vector3s::Zero() || pt.hasNaN())
-      {
-        // Don't store points with all zeros, since those are "unobserved"
-      }
-      else
-      {
-        map[name] = pt;
-      }
-    }
-
     for (int j = 0; j < forcePlatforms.size(); j++)
     {
       int frame = analogFramesPerFrame * (t + startFrame);
@@ -374,13 +597,17 @@ C3D C3DLoader::loadC3DWithGRFConvention(const std::string& uri, int convention)
     s_t groundLevel = result.forcePlates[0].corners[0].dot(up);
     // Flip the direction of "up" if the markers are showing up as below the
     // ground
-    if (result.markerTimesteps.size() > 0)
+    if (numLoadedFrames > 0)
     {
       s_t sumDist = 0.0;
-      for (auto& pair : result.markerTimesteps[(int)std::round(
-               result.markerTimesteps.size() / 2)])
+      int middle = (int)std::round(numLoadedFrames / 2);
+      for (int i = 0; i < result.markers.size(); i++)
       {
-        sumDist += pair.second.dot(up) - groundLevel;
+        if (result.markerObserved(i, middle))
+        {
+          sumDist += result.markerPositions.block<3, 1>(i * 3, middle).dot(up)
+                     - groundLevel;
+        }
       }
       if (sumDist < 0)
       {
@@ -478,42 +705,11 @@ C3D C3DLoader::loadC3DWithGRFConvention(const std::string& uri, int convention)
         assert(!result.forcePlates[i].moments[t].hasNaN());
       }
     }
-    for (int t = 0; t < result.markerTimesteps.size(); t++)
-    {
-      for (auto& pair : result.markerTimesteps[t])
-      {
-        pair.second = R * pair.second;
-      }
-    }
-  }
-
-  // These are useful for faster access to the pre-random-order marker data in
-  // certain situations, for example in neural models
-  result.shuffledMarkersMatrix = Eigen::MatrixXs::Zero(
-      result.markers.size() * 3, result.markerTimesteps.size());
-  result.shuffledMarkersMatrixMask = Eigen::MatrixXs::Zero(
-      result.markers.size() * 3, result.markerTimesteps.size());
-
-  std::vector<std::string> markerNames = result.markers;
-  auto rng = std::default_random_engine();
-
-  for (int t = 0; t < result.markerTimesteps.size(); t++)
-  {
-    int counter = 0;
-
-    std::shuffle(std::begin(markerNames), std::end(markerNames), rng);
-
-    for (std::string name : markerNames)
-    {
-      if (result.markerTimesteps[t].count(name) > 0)
-      {
-        result.shuffledMarkersMatrix.block(counter * 3, t, 3, 1)
-            = result.markerTimesteps[t][name];
-        result.shuffledMarkersMatrixMask.block<3, 1>(counter * 3, t)
-            .setConstant(1.0);
-        counter++;
-      }
-    }
+    // The dense marker array is just a long list of 3-vectors, so we can
+    // rotate them all at once. Unobserved markers are zero, and stay zero.
+    Eigen::Map<Eigen::MatrixXs> markerPoints(
+        result.markerPositions.data(), 3, result.markerPositions.size() / 3);
+    markerPoints = R * markerPoints;
   }
 
   return result;
@@ -567,6 +763,22 @@ void C3DLoader::fixupMarkerFlips(C3D* c3d)
 
         c3d->markerTimesteps[i][marker] = c3d->markerTimesteps[i][otherMarker];
         c3d->markerTimesteps[i][otherMarker] = tmp;
+
+        // Keep the dense copy in sync, if we have one
+        if (c3d->markerObserved.cols() == c3d->markerTimesteps.size()
+            && c3d->markerIndices.count(marker)
+            && c3d->markerIndices.count(otherMarker))
+        {
+          int a = c3d->markerIndices.at(marker);
+          int b = c3d->markerIndices.at(otherMarker);
+          Eigen::Vector3s tmpDense = c3d->markerPositions.block<3, 1>(a * 3, i);
+          c3d->markerPositions.block<3, 1>(a * 3, i)
+              = c3d->markerPositions.block<3, 1>(b * 3, i);
+          c3d->markerPositions.block<3, 1>(b * 3, i) = tmpDense;
+          bool tmpObserved = c3d->markerObserved(a, i);
+          c3d->markerObserved(a, i) = c3d->markerObserved(b, i);
+          c3d->markerObserved(b, i) = tmpObserved;
+        }
         closestMarkerFromLastTimestep[marker] = marker;
         closestMarkerFromLastTimestep[otherMarker] = otherMarker;
       }
@@ -1,8 +1,9 @@
 #ifndef DART_BIOMECH_C3D_HPP_
 #define DART_BIOMECH_C3D_HPP_
 
+#include <functional>
 #include <memory>
-// #include <unordered_map>
+#include <unordered_map>
 #include <map>
 #include <vector>
 
@@ -23,6 +24,14 @@ struct C3D
   std::vector<double> timestamps;
   std::vector<std::string> markers;
   std::vector<std::map<std::string, Eigen::Vector3s>> markerTimesteps;
+  // This is the same marker data as markerTimesteps, laid out densely. Column
+  // t holds every marker on frame t, with marker i in rows 3i to 3i+2 (in the
+  // order of `markers`). Unobserved markers are left at zero.
+  Eigen::MatrixXs markerPositions;
+  // This is (markers.size() x frames), true where a marker was observed
+  Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic> markerObserved;
+  // This maps a marker name to its index in `markers`
+  std::unordered_map<std::string, int> markerIndices;
   std::vector<ForcePlate> forcePlates;
   // These are useful for faster access to the marker data in certain situations
   Eigen::MatrixXs shuffledMarkersMatrix;
@@ -34,6 +43,15 @@ struct C3D
   /// that timestep. This is used as part of the heuristic to guess which
   /// convention a C3D file is using for storing its GRF data.
   s_t getWeightedDistFromCoPToNearestMarker();
+
+  /// This rebuilds the map-based `markerTimesteps` view from the dense
+  /// `markerPositions` and `markerObserved`.
+  void rebuildMarkerTimestepsFromDense();
+
+  /// This rebuilds the dense `markerPositions`, `markerObserved` and
+  /// `markerIndices` from `markerTimesteps`. Call this after editing
+  /// `markerTimesteps` directly.
+  void rebuildDenseFromMarkerTimesteps();
 };
 
 class C3DLoader
@@ -43,6 +61,20 @@ public:
 
   static C3D loadC3DWithGRFConvention(const std::string& uri, int convention);
 
+  /// This reads just the marker data out of a C3D file, `chunkFrames` frames
+  /// at a time, and hands each chunk to `onChunk` in the same dense layout as
+  /// C3D::markerPositions and C3D::markerObserved, scaled to meters. The data
+  /// is not rotated and no map-based view is built, so beyond the parsed file
+  /// itself we only hold one chunk at a time. This returns the marker names.
+  static std::vector<std::string> loadC3DMarkerChunks(
+      const std::string& uri,
+      int chunkFrames,
+      std::function<void(
+          int startFrame,
+          const Eigen::MatrixXs& markerPositions,
+          const Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic>&
+              markerObserved)> onChunk);
+
   /// This will check if markers
   /// obviously "flip" during the trajectory, and unflip them.
   static void fixupMarkerFlips(C3D* c3d);
@@ -7968,7 +7968,9 @@ DynamicsFitProblemConfig::DynamicsFitProblemConfig(
     mMaxNumTrials(-1),
     mOnlyOneTrial(-1),
     mMaxNumBlocksPerTrial(-1),
-    mNumThreads(16)
+    mNumThreads(16),
+    mCoarseToFineDecimation(1),
+    mCoarseToFineRefineIterationLimit(50)
 // mResidualWeight(0.1),
 // mLinearNewtonWeight(0.1),
 // mMarkerWeight(1.0),
@@ -8344,6 +8346,22 @@ DynamicsFitProblemConfig& DynamicsFitProblemConfig::setNumThreads(int value)
   return *(this);
 }
 
+//==============================================================================
+DynamicsFitProblemConfig& DynamicsFitProblemConfig::setCoarseToFineDecimation(
+    int value)
+{
+  mCoarseToFineDecimation = value;
+  return *(this);
+}
+
+//==============================================================================
+DynamicsFitProblemConfig&
+DynamicsFitProblemConfig::setCoarseToFineRefineIterationLimit(int value)
+{
+  mCoarseToFineRefineIterationLimit = value;
+  return *(this);
+}
+
 //------------------------- Ipopt::TNLP --------------------------------------
 
 //==============================================================================
@@ -14279,6 +14297,23 @@ void DynamicsFitter::estimateLinkMassesFromAcceleration(
 void DynamicsFitter::runIPOPTOptimization(
     std::shared_ptr<DynamicsInitialization> init,
     DynamicsFitProblemConfig config)
+{
+  if (config.mCoarseToFineDecimation > 1)
+  {
+    runCoarseToFineIPOPTOptimization(init, config);
+    return;
+  }
+  runIPOPTOptimizationAtFullRate(init, config, mIterationLimit);
+}
+
+//==============================================================================
+// This is the body of runIPOPTOptimization(), ignoring
+// config.mCoarseToFineDecimation, and stopping after `iterationLimit`
+// iterations.
+void DynamicsFitter::runIPOPTOptimizationAtFullRate(
+    std::shared_ptr<DynamicsInitialization> init,
+    DynamicsFitProblemConfig config,
+    int iterationLimit)
 {
   // Before using Eigen in a multi-threaded environment, we need to explicitly
   // call this (at least prior to Eigen 3.3)
@@ -14304,7 +14339,7 @@ void DynamicsFitter::runIPOPTOptimization(
       "scaling_method", "none"); // none, gradient-based
   */
 
-  app->Options()->SetIntegerValue("max_iter", mIterationLimit);
+  app->Options()->SetIntegerValue("max_iter", iterationLimit);
 
   // Warm start
   // app->Options()->SetBoolValue("warm_start_init_point", true);
@@ -14455,6 +14490,152 @@ void DynamicsFitter::runIPOPTOptimization(
   }
 }
 
+//==============================================================================
+// This keeps every `decimation`'th column of `mat`
+static Eigen::MatrixXs decimateColumns(
+    const Eigen::MatrixXs& mat, int decimation)
+{
+  int cols = (mat.cols() + decimation - 1) / decimation;
+  Eigen::MatrixXs result = Eigen::MatrixXs::Zero(mat.rows(), cols);
+  for (int i = 0; i < cols; i++)
+  {
+    result.col(i) = mat.col(i * decimation);
+  }
+  return result;
+}
+
+//==============================================================================
+// This makes a copy of `init` that keeps only every `decimation`'th frame of
+// each trial, with the timestep lengthened to match. Only the per-frame values
+// that DynamicsFitProblem reads are decimated. A frame is marked as missing
+// GRF if any of the frames the central differences around it span are.
+static std::shared_ptr<DynamicsInitialization> decimateInitialization(
+    std::shared_ptr<DynamicsInitialization> init, int decimation)
+{
+  std::shared_ptr<DynamicsInitialization> coarse
+      = std::make_shared<DynamicsInitialization>(*init);
+  for (int trial = 0; trial < init->poseTrials.size(); trial++)
+  {
+    int numTimesteps = init->poseTrials[trial].cols();
+    coarse->trialTimesteps[trial] = init->trialTimesteps[trial] * decimation;
+    coarse->poseTrials[trial]
+        = decimateColumns(init->poseTrials[trial], decimation);
+    coarse->grfTrials[trial]
+        = decimateColumns(init->grfTrials[trial], decimation);
+    if (trial < init->regularizePosesTo.size())
+    {
+      coarse->regularizePosesTo[trial]
+          = decimateColumns(init->regularizePosesTo[trial], decimation);
+    }
+    if (trial < init->jointCenters.size())
+    {
+      coarse->jointCenters[trial]
+          = decimateColumns(init->jointCenters[trial], decimation);
+    }
+    if (trial < init->jointAxis.size())
+    {
+      coarse->jointAxis[trial]
+          = decimateColumns(init->jointAxis[trial], decimation);
+    }
+
+    coarse->markerObservationTrials[trial].clear();
+    coarse->probablyMissingGRF[trial].clear();
+    if (trial < coarse->missingGRFReason.size())
+    {
+      coarse->missingGRFReason[trial].clear();
+    }
+    for (int t = 0; t < numTimesteps; t += decimation)
+    {
+      coarse->markerObservationTrials[trial].push_back(
+          init->markerObservationTrials[trial][t]);
+      bool missingGRF = false;
+      for (int j = std::max(0, t - decimation + 1);
+           j < std::min(numTimesteps, t + decimation);
+           j++)
+      {
+        missingGRF = missingGRF || init->probablyMissingGRF[trial][j];
+      }
+      coarse->probablyMissingGRF[trial].push_back(missingGRF);
+      if (trial < coarse->missingGRFReason.size())
+      {
+        coarse->missingGRFReason[trial].push_back(
+            init->missingGRFReason[trial][t]);
+      }
+    }
+
+    // Finite differencing needs at least a few frames to work with
+    if (coarse->poseTrials[trial].cols() < 3)
+    {
+      coarse->includeTrialsInDynamicsFit[trial] = false;
+    }
+  }
+  return coarse;
+}
+
+//==============================================================================
+// 3. This is what runIPOPTOptimization() does when
+// config.mCoarseToFineDecimation > 1. It solves the same problem on a copy
+// of `init` with only every N'th frame of each trial kept (so a timestep N
+// times as long), then copies the solved masses, inertias, scales and marker
+// offsets back to `init`, adds the linearly interpolated change in poses to
+// every frame, and finishes with a shorter solve at the full rate.
+void DynamicsFitter::runCoarseToFineIPOPTOptimization(
+    std::shared_ptr<DynamicsInitialization> init,
+    DynamicsFitProblemConfig config)
+{
+  int decimation = config.mCoarseToFineDecimation;
+
+  // 1. Solve the decimated problem
+  std::shared_ptr<DynamicsInitialization> coarse
+      = decimateInitialization(init, decimation);
+  std::vector<Eigen::MatrixXs> coarseOriginalPoses = coarse->poseTrials;
+  if (!mSilenceOutput)
+  {
+    std::cout << "Running the dynamics fit with every " << decimation
+              << " frames, before refining at the full rate" << std::endl;
+  }
+  runIPOPTOptimizationAtFullRate(coarse, config, mIterationLimit);
+
+  // 2. Copy the results back to the full rate. The poses get the change from
+  // the coarse solve interpolated across each frame, rather than the coarse
+  // poses themselves, so we keep any detail the decimation skipped over.
+  init->groupMasses = coarse->groupMasses;
+  init->bodyMasses = coarse->bodyMasses;
+  init->bodyCom = coarse->bodyCom;
+  init->groupInertias = coarse->groupInertias;
+  init->bodyInertia = coarse->bodyInertia;
+  init->groupScales = coarse->groupScales;
+  init->markerOffsets = coarse->markerOffsets;
+  init->updatedMarkerMap = coarse->updatedMarkerMap;
+  for (int trial = 0; trial < init->poseTrials.size(); trial++)
+  {
+    if (!coarse->includeTrialsInDynamicsFit[trial])
+    {
+      continue;
+    }
+    Eigen::MatrixXs delta
+        = coarse->poseTrials[trial] - coarseOriginalPoses[trial];
+    for (int t = 0; t < init->poseTrials[trial].cols(); t++)
+    {
+      int i = t / decimation;
+      s_t alpha = (s_t)(t % decimation) / decimation;
+      if (i + 1 < delta.cols())
+      {
+        init->poseTrials[trial].col(t)
+            += (1.0 - alpha) * delta.col(i) + alpha * delta.col(i + 1);
+      }
+      else
+      {
+        init->poseTrials[trial].col(t) += delta.col(delta.cols() - 1);
+      }
+    }
+  }
+
+  // 3. Refine at the full rate, with fewer iterations
+  runIPOPTOptimizationAtFullRate(
+      init, config, config.mCoarseToFineRefineIterationLimit);
+}
+
 //==============================================================================
 // 4. This runs the same optimization problem as
 // runExplicitVelAccOptimization(), but holds velocity and acc as implicit
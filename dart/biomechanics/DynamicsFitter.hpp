@@ -933,6 +933,9 @@ public:
 
   DynamicsFitProblemConfig& setNumThreads(int value);
 
+  DynamicsFitProblemConfig& setCoarseToFineDecimation(int value);
+  DynamicsFitProblemConfig& setCoarseToFineRefineIterationLimit(int value);
+
 public:
   friend class DynamicsFitProblem;
   friend class DynamicsFitter;
@@ -985,6 +988,13 @@ public:
   int mMaxNumBlocksPerTrial;
 
   int mNumThreads;
+
+  // If mCoarseToFineDecimation is > 1, DynamicsFitter::runIPOPTOptimization()
+  // first solves on every N'th frame of each trial, then interpolates the
+  // change in poses back up to warm start a solve at the full rate, limited to
+  // mCoarseToFineRefineIterationLimit iterations.
+  int mCoarseToFineDecimation;
+  int mCoarseToFineRefineIterationLimit;
 };
 
 /**
@@ -1554,6 +1564,24 @@ public:
       std::shared_ptr<DynamicsInitialization> init,
       DynamicsFitProblemConfig config);
 
+  // 3. This is what runIPOPTOptimization() does when
+  // config.mCoarseToFineDecimation > 1. It solves the same problem on a copy
+  // of `init` with only every N'th frame of each trial kept (so a timestep N
+  // times as long), then copies the solved masses, inertias, scales and marker
+  // offsets back to `init`, adds the linearly interpolated change in poses to
+  // every frame, and finishes with a shorter solve at the full rate.
+  void runCoarseToFineIPOPTOptimization(
+      std::shared_ptr<DynamicsInitialization> init,
+      DynamicsFitProblemConfig config);
+
+  // This is the body of runIPOPTOptimization(), ignoring
+  // config.mCoarseToFineDecimation, and stopping after `iterationLimit`
+  // iterations.
+  void runIPOPTOptimizationAtFullRate(
+      std::shared_ptr<DynamicsInitialization> init,
+      DynamicsFitProblemConfig config,
+      int iterationLimit);
+
   // 4. This runs the same optimization problem as
   // runExplicitVelAccOptimization(), but holds velocity and acc as implicit
   // functions of the position values, and removes any constraints. That means
@@ -2343,6 +2343,8 @@ s_t IKInitializer::estimatePosesWithIK(bool logOutput)
   {
     threadSkels.push_back(mSkel->cloneSkeleton());
   }
+  // These are built lazily, the first time we need to solve a new clip
+  std::vector<std::shared_ptr<dynamics::Skeleton>> threadBallSkels;
 
   int t = 0;
   while (t < mMarkerObservations.size())
@@ -2398,80 +2400,121 @@ s_t IKInitializer::estimatePosesWithIK(bool logOutput)
         jointClusterTarget.segment<3>(i * 3) = jointPoses[i];
       }
 
-      // 1.3. Solve the actual IK
-      math::solveIK(
-          mSkel->convertPositionsToBallSpace(lastPose),
-          mSkel->getPositionUpperLimits(),
-          mSkel->getPositionLowerLimits(),
-          markerTarget.size() + jointClusterTarget.size(),
-          [&](const Eigen::VectorXs& pos, bool clamp) {
-            // 1.3.1. Set poses on the ball joint skeleton, by default not
-            // clamping to limits
-            skelBallJoints->setPositions(pos);
-            if (clamp)
-            {
-              // If we're clamping to limits, do it in the original skeleton
-              // joint space, not in ball space
-              mSkel->setPositions(mSkel->convertPositionsFromBallSpace(pos));
-              mSkel->clampPositionsToLimits();
-              skelBallJoints->setPositions(
-                  mSkel->convertPositionsToBallSpace(mSkel->getPositions()));
-            }
-            return skelBallJoints->getPositions();
-          },
-          [&](Eigen::Ref<Eigen::VectorXs> diff,
-              Eigen::Ref<Eigen::MatrixXs> jac) {
-            // 1.3.2. Evaluate the error and the Jacobian relating dError / dPos
-
-            // 1.3.2.1. First we need to compute the marker error, and marker
-            // Jacobian
-            Eigen::VectorXs markerPositions
-                = skelBallJoints->getMarkerWorldPositions(markers);
-            diff.segment(0, markerPositions.size())
-                = markerPositions - markerTarget;
-            jac.block(0, 0, markerPositions.size(), jac.cols())
-                = skelBallJoints
-                      ->getMarkerWorldPositionsJacobianWrtJointPositions(
-                          markers);
-            for (int i = 0; i < anatomicalMarkers.size(); i++)
+      // 1.3. Build one copy of the IK problem per thread skeleton, so that
+      // the random restarts can run in parallel. Copy 0 runs on mSkel and
+      // skelBallJoints, and is left at the solution.
+      auto makeIKProblemCopy = [&](std::shared_ptr<dynamics::Skeleton> skel,
+                                   std::shared_ptr<dynamics::Skeleton>
+                                       ballSkel) {
+        std::vector<std::pair<dynamics::BodyNode*, Eigen::Vector3s>>
+            copyMarkers;
+        for (auto& marker : markers)
+        {
+          copyMarkers.emplace_back(
+              ballSkel->getBodyNode(marker.first->getName()), marker.second);
+        }
+        std::vector<dynamics::Joint*> copyJoints;
+        for (dynamics::Joint* joint : joints)
+        {
+          copyJoints.push_back(ballSkel->getJoint(joint->getName()));
+        }
+
+        math::IKProblemCopy copy;
+        copy.setPosAndClamp = [skel, ballSkel](
+                                  const Eigen::VectorXs& pos, bool clamp) {
+          // 1.3.1. Set poses on the ball joint skeleton, by default not
+          // clamping to limits
+          ballSkel->setPositions(pos);
+          if (clamp)
+          {
+            // If we're clamping to limits, do it in the original skeleton
+            // joint space, not in ball space
+            skel->setPositions(skel->convertPositionsFromBallSpace(pos));
+            skel->clampPositionsToLimits();
+            ballSkel->setPositions(
+                skel->convertPositionsToBallSpace(skel->getPositions()));
+          }
+          return ballSkel->getPositions();
+        };
+        copy.eval = [&, ballSkel, copyMarkers, copyJoints](
+                        Eigen::Ref<Eigen::VectorXs> diff,
+                        Eigen::Ref<Eigen::MatrixXs> jac) {
+          // 1.3.2. Evaluate the error and the Jacobian relating dError / dPos
+
+          // 1.3.2.1. First we need to compute the marker error, and marker
+          // Jacobian
+          Eigen::VectorXs markerPositions
+              = ballSkel->getMarkerWorldPositions(copyMarkers);
+          diff.segment(0, markerPositions.size())
+              = markerPositions - markerTarget;
+          jac.block(0, 0, markerPositions.size(), jac.cols())
+              = ballSkel->getMarkerWorldPositionsJacobianWrtJointPositions(
+                  copyMarkers);
+          for (int i = 0; i < anatomicalMarkers.size(); i++)
+          {
+            if (!anatomicalMarkers[i])
             {
-              if (!anatomicalMarkers[i])
-              {
-                diff.segment(i * 3, 3) *= 0.1;
-                jac.block(i * 3, 0, 3, jac.cols()) *= 0.1;
-              }
+              diff.segment(i * 3, 3) *= 0.1;
+              jac.block(i * 3, 0, 3, jac.cols()) *= 0.1;
             }
+          }
 
-            // 1.3.2.2. Next we need to compute the joint cluster error, and
-            // joint cluster Jacobian
-            Eigen::VectorXs jointPositions
-                = skelBallJoints->getJointWorldPositions(joints);
-            Eigen::MatrixXs jointJacobian
-                = skelBallJoints
-                      ->getJointWorldPositionsJacobianWrtJointPositions(joints);
-            jac.block(
-                   markerPositions.size(),
-                   0,
-                   jointClusters.size() * 3,
-                   jac.cols())
-                .setZero();
-            for (int i = 0; i < jointClusters.size(); i++)
+          // 1.3.2.2. Next we need to compute the joint cluster error, and
+          // joint cluster Jacobian
+          Eigen::VectorXs jointPositions
+              = ballSkel->getJointWorldPositions(copyJoints);
+          Eigen::MatrixXs jointJacobian
+              = ballSkel->getJointWorldPositionsJacobianWrtJointPositions(
+                  copyJoints);
+          jac.block(
+                 markerPositions.size(),
+                 0,
+                 jointClusters.size() * 3,
+                 jac.cols())
+              .setZero();
+          for (int i = 0; i < jointClusters.size(); i++)
+          {
+            int clusterRow = markerPositions.size() + i * 3;
+            Eigen::Vector3s clusterCenter = Eigen::Vector3s::Zero();
+            for (int j : jointClusters[i])
             {
-              int clusterRow = markerPositions.size() + i * 3;
-              Eigen::Vector3s clusterCenter = Eigen::Vector3s::Zero();
-              for (int j : jointClusters[i])
-              {
-                clusterCenter += jointPositions.segment<3>(j * 3)
-                                 / jointClusters[i].size();
-                jac.block(clusterRow, 0, 3, jac.cols())
-                    += jointJacobian.block(j * 3, 0, 3, jac.cols())
-                       / jointClusters[i].size();
-              }
-              Eigen::Vector3s clusterTarget
-                  = jointClusterTarget.segment<3>(i * 3);
-              diff.segment<3>(clusterRow) = clusterCenter - clusterTarget;
+              clusterCenter += jointPositions.segment<3>(j * 3)
+                               / jointClusters[i].size();
+              jac.block(clusterRow, 0, 3, jac.cols())
+                  += jointJacobian.block(j * 3, 0, 3, jac.cols())
+                     / jointClusters[i].size();
             }
-          },
+            Eigen::Vector3s clusterTarget
+                = jointClusterTarget.segment<3>(i * 3);
+            diff.segment<3>(clusterRow) = clusterCenter - clusterTarget;
+          }
+        };
+        return copy;
+      };
+
+      if (threadBallSkels.size() == 0)
+      {
+        for (int i = 1; i < maxNumThreads; i++)
+        {
+          threadBallSkels.push_back(
+              threadSkels[i]->convertSkeletonToBallJoints());
+        }
+      }
+      std::vector<math::IKProblemCopy> copies;
+      copies.push_back(makeIKProblemCopy(mSkel, skelBallJoints));
+      for (int i = 1; i < maxNumThreads; i++)
+      {
+        copies.push_back(
+            makeIKProblemCopy(threadSkels[i], threadBallSkels[i - 1]));
+      }
+
+      // 1.4. Solve the actual IK
+      math::solveIKParallel(
+          mSkel->convertPositionsToBallSpace(lastPose),
+          mSkel->getPositionUpperLimits(),
+          mSkel->getPositionLowerLimits(),
+          markerTarget.size() + jointClusterTarget.size(),
+          copies,
           [&](Eigen::Ref<Eigen::VectorXs> pos) {
             pos = skelBallJoints->getRandomPose();
           },
@@ -2479,6 +2522,11 @@ s_t IKInitializer::estimatePosesWithIK(bool logOutput)
               .setLogOutput(logOutput)
               .setMaxRestarts(100)
               .setConvergenceThreshold(1e-10));
+
+      // 1.5. Start the ordinary joint solves for this clip from the ball joint
+      // solution
+      lastPose = mSkel->convertPositionsFromBallSpace(
+          skelBallJoints->getPositions());
     }
 
     std::vector<std::future<std::pair<Eigen::VectorXs, s_t>>> futures;
@@ -370,7 +370,8 @@ Eigen::VectorXs MarkerFitterState::flattenGradient()
         += fitter->getMarkerLossGradientWrtJoints(
             skeleton, markers, markerErrorGrad);
     grad.segment(offset, skeleton->getNumDofs())
-        += skeleton->getJointWorldPositionsJacobianWrtJointPositions(joints)
+        += skeleton
+               ->getJointWorldPositionsSparseJacobianWrtJointPositions(joints)
                .transpose()
            * combinedJointGrad;
 
@@ -414,6 +415,8 @@ InitialMarkerFitParams::InitialMarkerFitParams()
     dontMoveMarkers(false),
     maxTrialsToUseForMultiTrialScaling(5),
     maxTimestepsToUseForMultiTrialScaling(800),
+    coarseToFineDecimation(1),
+    coarseToFineRefineIKTries(2),
     initPoses(Eigen::MatrixXs::Zero(0, 0)),
     groupScales(Eigen::VectorXs::Zero(0)),
     jointCenters(Eigen::MatrixXs::Zero(0, 0)),
@@ -443,7 +446,9 @@ InitialMarkerFitParams::InitialMarkerFitParams(
     maxTrialsToUseForMultiTrialScaling(
         other.maxTrialsToUseForMultiTrialScaling),
     maxTimestepsToUseForMultiTrialScaling(
-        other.maxTimestepsToUseForMultiTrialScaling)
+        other.maxTimestepsToUseForMultiTrialScaling),
+    coarseToFineDecimation(other.coarseToFineDecimation),
+    coarseToFineRefineIKTries(other.coarseToFineRefineIKTries)
 {
 }
 
@@ -561,6 +566,22 @@ InitialMarkerFitParams::setMaxTimestepsToUseForMultiTrialScaling(
   return *this;
 }
 
+//==============================================================================
+InitialMarkerFitParams& InitialMarkerFitParams::setCoarseToFineDecimation(
+    int decimation)
+{
+  this->coarseToFineDecimation = decimation;
+  return *this;
+}
+
+//==============================================================================
+InitialMarkerFitParams& InitialMarkerFitParams::setCoarseToFineRefineIKTries(
+    int retries)
+{
+  this->coarseToFineRefineIKTries = retries;
+  return *this;
+}
+
 //==============================================================================
 MarkerFitter::MarkerFitter(
     std::shared_ptr<dynamics::Skeleton> skeleton,
@@ -929,7 +950,7 @@ MarkerFitter::MarkerFitter(
       // 7.4.1. Body scales
       Eigen::VectorXs bodyScalesGradVector
           = this->mSkeleton
-                ->getMarkerWorldPositionsJacobianWrtBodyScales(
+                ->getMarkerWorldPositionsSparseJacobianWrtBodyScales(
                     staticTrialMarkers)
                 .transpose()
             * staticMarkerErrorGrad;
@@ -940,7 +961,7 @@ MarkerFitter::MarkerFitter(
       // 7.4.2. Marker offsets
       Eigen::VectorXs markerOffsetsGradVector
           = this->mSkeleton
-                ->getMarkerWorldPositionsJacobianWrtMarkerOffsets(
+                ->getMarkerWorldPositionsSparseJacobianWrtMarkerOffsets(
                     staticTrialMarkers)
                 .transpose()
             * staticMarkerErrorGrad;
@@ -952,7 +973,7 @@ MarkerFitter::MarkerFitter(
       // 7.4.3. Root translation
       Eigen::VectorXs jointGradVector
           = this->mSkeleton
-                ->getMarkerWorldPositionsJacobianWrtJointPositions(
+                ->getMarkerWorldPositionsSparseJacobianWrtJointPositions(
                     staticTrialMarkers)
                 .transpose()
             * staticMarkerErrorGrad;
@@ -1584,6 +1605,119 @@ std::vector<MarkerInitialization> MarkerFitter::runMultiTrialKinematicsPipeline(
   }
 }
 
+//==============================================================================
+/// This picks the timesteps to keep when decimating a trajectory by
+/// `decimation`. We keep every `decimation`'th frame counting from the start
+/// of each clip, and always keep the first and last frame of each clip, so
+/// that interpolating back up never crosses a clip boundary.
+std::vector<int> MarkerFitter::getDecimatedTimesteps(
+    const std::vector<bool>& newClip, int decimation)
+{
+  std::vector<int> timesteps;
+  int clipStart = 0;
+  for (int t = 0; t < newClip.size(); t++)
+  {
+    if (t == 0 || newClip[t])
+    {
+      clipStart = t;
+    }
+    bool lastInClip = t == newClip.size() - 1 || newClip[t + 1];
+    if ((t - clipStart) % decimation == 0 || lastInClip)
+    {
+      timesteps.push_back(t);
+    }
+  }
+  return timesteps;
+}
+
+//==============================================================================
+/// This takes a matrix with one column for each timestep in `timesteps` (as
+/// returned by getDecimatedTimesteps()), and linearly interpolates it back up
+/// to `numTimesteps` columns. Rows where `wrapRows` is true hold angles, which
+/// get interpolated the short way around the circle, so a joint that wraps
+/// from pi to -pi between two kept frames doesn't spin all the way back.
+Eigen::MatrixXs MarkerFitter::interpolateDecimatedColumns(
+    const Eigen::MatrixXs& decimated,
+    const std::vector<int>& timesteps,
+    int numTimesteps,
+    const std::vector<bool>& wrapRows)
+{
+  Eigen::MatrixXs result
+      = Eigen::MatrixXs::Zero(decimated.rows(), numTimesteps);
+  if (decimated.cols() == 0)
+  {
+    return result;
+  }
+  for (int i = 0; i < timesteps.size(); i++)
+  {
+    result.col(timesteps[i]) = decimated.col(i);
+    if (i + 1 < timesteps.size())
+    {
+      Eigen::VectorXs end = decimated.col(i + 1);
+      for (int row = 0; row < wrapRows.size(); row++)
+      {
+        if (wrapRows[row])
+        {
+          s_t delta = end(row) - decimated(row, i);
+          delta -= 2 * M_PI * std::round(delta / (2 * M_PI));
+          end(row) = decimated(row, i) + delta;
+        }
+      }
+      int gap = timesteps[i + 1] - timesteps[i];
+      for (int t = 1; t < gap; t++)
+      {
+        s_t alpha = (s_t)t / gap;
+        result.col(timesteps[i] + t)
+            = (1.0 - alpha) * decimated.col(i) + alpha * end;
+      }
+    }
+  }
+  return result;
+}
+
+//==============================================================================
+/// This is interpolateDecimatedColumns() for a MarkerInitialization::jointAxis
+/// matrix, which has 6 rows for each joint: the center of the axis, and then
+/// its direction. The directions in between the kept frames are renormalized,
+/// and an axis that flipped sign between two kept frames is interpolated
+/// without passing through zero.
+Eigen::MatrixXs MarkerFitter::interpolateDecimatedJointAxis(
+    const Eigen::MatrixXs& decimated,
+    const std::vector<int>& timesteps,
+    int numTimesteps)
+{
+  Eigen::MatrixXs result
+      = interpolateDecimatedColumns(decimated, timesteps, numTimesteps);
+  if (decimated.cols() == 0)
+  {
+    return result;
+  }
+  for (int i = 0; i + 1 < timesteps.size(); i++)
+  {
+    int gap = timesteps[i + 1] - timesteps[i];
+    for (int j = 0; j < decimated.rows() / 6; j++)
+    {
+      Eigen::Vector3s start = decimated.block<3, 1>(j * 6 + 3, i);
+      Eigen::Vector3s end = decimated.block<3, 1>(j * 6 + 3, i + 1);
+      if (start.dot(end) < 0)
+      {
+        end = -end;
+      }
+      for (int t = 1; t < gap; t++)
+      {
+        s_t alpha = (s_t)t / gap;
+        Eigen::Vector3s dir = (1.0 - alpha) * start + alpha * end;
+        if (dir.norm() > 0)
+        {
+          dir.normalize();
+        }
+        result.block<3, 1>(j * 6 + 3, timesteps[i] + t) = dir;
+      }
+    }
+  }
+  return result;
+}
+
 //==============================================================================
 /// Run the whole pipeline of optimization problems to fit the data as closely
 /// as we can
@@ -1595,6 +1729,24 @@ MarkerInitialization MarkerFitter::runKinematicsPipeline(
     int numSamples,
     bool skipFinalIK)
 {
+  // 0. If we're asked to, run the whole pipeline on a decimated copy of the
+  // trial, and then just refine the IK at the full rate
+  if (params.coarseToFineDecimation > 1)
+  {
+    std::vector<int> timesteps = MarkerFitter::getDecimatedTimesteps(
+        newClip, params.coarseToFineDecimation);
+    if (timesteps.size() < markerObservations.size())
+    {
+      return runCoarseToFineKinematicsPipeline(
+          markerObservations,
+          newClip,
+          timesteps,
+          params,
+          numSamples,
+          skipFinalIK);
+    }
+  }
+
   // 1. Find the initial scaling + IK
   MarkerInitialization init = getInitialization(
       markerObservations, newClip, InitialMarkerFitParams(params));
@@ -1658,6 +1810,96 @@ MarkerInitialization MarkerFitter::runKinematicsPipeline(
   }
 }
 
+//==============================================================================
+/// This is the coarse-to-fine version of runKinematicsPipeline(). It runs the
+/// full pipeline on just the frames in `timesteps`, then interpolates the
+/// poses, joint centers and joint axis back up to the full rate, and uses
+/// those to warm start one round of IK over every frame with the scales and
+/// marker offsets held fixed.
+MarkerInitialization MarkerFitter::runCoarseToFineKinematicsPipeline(
+    const std::vector<std::map<std::string, Eigen::Vector3s>>&
+        markerObservations,
+    const std::vector<bool>& newClip,
+    const std::vector<int>& timesteps,
+    InitialMarkerFitParams params,
+    int numSamples,
+    bool skipFinalIK)
+{
+  // 1. Solve the decimated problem
+  std::vector<std::map<std::string, Eigen::Vector3s>> coarseObservations;
+  std::vector<bool> coarseNewClip;
+  for (int t : timesteps)
+  {
+    coarseObservations.push_back(markerObservations[t]);
+    coarseNewClip.push_back(newClip[t]);
+  }
+  MarkerInitialization coarse = runKinematicsPipeline(
+      coarseObservations,
+      coarseNewClip,
+      InitialMarkerFitParams(params).setCoarseToFineDecimation(1),
+      numSamples,
+      skipFinalIK);
+
+  // 2. Interpolate back up to the full rate. Rotational DOFs with at least a
+  // full turn of range can wrap around between the kept frames.
+  int numTimesteps = markerObservations.size();
+  std::vector<bool> wrapDofs(mSkeleton->getNumDofs(), false);
+  for (int i = 0; i < mSkeleton->getNumDofs(); i++)
+  {
+    dynamics::DegreeOfFreedom* dof = mSkeleton->getDof(i);
+    bool rotational = dof->getJoint()
+                          ->getRelativeJacobian()
+                          .col(dof->getIndexInJoint())
+                          .head<3>()
+                          .norm()
+                      > 1e-8;
+    wrapDofs[i] = rotational
+                  && dof->getPositionUpperLimit() - dof->getPositionLowerLimit()
+                         >= 2 * M_PI;
+  }
+  Eigen::MatrixXs poses = interpolateDecimatedColumns(
+      coarse.poses, timesteps, numTimesteps, wrapDofs);
+  Eigen::MatrixXs jointCenters = interpolateDecimatedColumns(
+      coarse.jointCenters, timesteps, numTimesteps);
+  Eigen::MatrixXs jointAxis = interpolateDecimatedJointAxis(
+      coarse.jointAxis, timesteps, numTimesteps);
+
+  // 3. Refine the IK at full rate, keeping the body scales and marker offsets
+  // from the coarse solve
+  mSkeleton->setGroupScales(coarse.groupScales);
+  MarkerInitialization fine = getInitialization(
+      markerObservations,
+      newClip,
+      InitialMarkerFitParams(params)
+          .setCoarseToFineDecimation(1)
+          .setJointCentersAndWeights(
+              coarse.joints,
+              jointCenters,
+              coarse.jointsAdjacentMarkers,
+              coarse.jointWeights)
+          .setJointAxisAndWeights(jointAxis, coarse.axisWeights)
+          .setInitPoses(poses)
+          .setDontRescaleBodies(true)
+          .setDontMoveMarkers(true)
+          .setGroupScales(coarse.groupScales)
+          .setMarkerOffsets(coarse.markerOffsets)
+          .setNumIKTries(params.coarseToFineRefineIKTries));
+
+  fine.groupScales = coarse.groupScales;
+  fine.markerOffsets = coarse.markerOffsets;
+  fine.updatedMarkerMap = coarse.updatedMarkerMap;
+  fine.joints = coarse.joints;
+  fine.jointsAdjacentMarkers = coarse.jointsAdjacentMarkers;
+  fine.jointMarkerVariability = coarse.jointMarkerVariability;
+  fine.jointLoss = coarse.jointLoss;
+  fine.jointWeights = coarse.jointWeights;
+  fine.jointCenters = jointCenters;
+  fine.axisWeights = coarse.axisWeights;
+  fine.axisLoss = coarse.axisLoss;
+  fine.jointAxis = jointAxis;
+  return fine;
+}
+
 //==============================================================================
 /// This just finds the joint centers and axis over time.
 MarkerInitialization MarkerFitter::runJointsPipeline(
@@ -2814,6 +3056,13 @@ void MarkerFitter::autorotateC3D(C3D* c3d)
       pair.second = smallestMagR * pair.second;
     }
   }
+  // Keep the dense copy of the markers in sync, if we have one
+  if (c3d->markerPositions.size() > 0)
+  {
+    Eigen::Map<Eigen::MatrixXs> markerPoints(
+        c3d->markerPositions.data(), 3, c3d->markerPositions.size() / 3);
+    markerPoints = smallestMagR * markerPoints;
+  }
 }
 
 //==============================================================================
@@ -7772,7 +8021,8 @@ Eigen::VectorXs MarkerFitter::getMarkerLossGradientWrtJoints(
     const std::vector<std::pair<dynamics::BodyNode*, Eigen::Vector3s>>& markers,
     Eigen::VectorXs lossGradWrtMarkerError)
 {
-  return skeleton->getMarkerWorldPositionsJacobianWrtJointPositions(markers)
+  return skeleton->getMarkerWorldPositionsSparseJacobianWrtJointPositions(
+             markers)
              .transpose()
          * lossGradWrtMarkerError;
 }
@@ -7822,7 +8072,7 @@ Eigen::VectorXs MarkerFitter::getMarkerLossGradientWrtGroupScales(
     const std::vector<std::pair<dynamics::BodyNode*, Eigen::Vector3s>>& markers,
     Eigen::VectorXs lossGradWrtMarkerError)
 {
-  return skeleton->getMarkerWorldPositionsJacobianWrtGroupScales(markers)
+  return skeleton->getMarkerWorldPositionsSparseJacobianWrtGroupScales(markers)
              .transpose()
          * lossGradWrtMarkerError;
 }
@@ -7872,7 +8122,8 @@ Eigen::VectorXs MarkerFitter::getMarkerLossGradientWrtMarkerOffsets(
     const std::vector<std::pair<dynamics::BodyNode*, Eigen::Vector3s>>& markers,
     Eigen::VectorXs lossGradWrtMarkerError)
 {
-  return skeleton->getMarkerWorldPositionsJacobianWrtMarkerOffsets(markers)
+  return skeleton->getMarkerWorldPositionsSparseJacobianWrtMarkerOffsets(
+             markers)
              .transpose()
          * lossGradWrtMarkerError;
 }
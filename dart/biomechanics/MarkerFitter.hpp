@@ -540,6 +540,14 @@ struct InitialMarkerFitParams
   int maxTrialsToUseForMultiTrialScaling;
   int maxTimestepsToUseForMultiTrialScaling;
 
+  // If this is > 1, runKinematicsPipeline() first solves on a copy of the
+  // trial keeping only every N'th frame, and then interpolates that back up
+  // to warm start a single round of IK at the full rate, with
+  // coarseToFineRefineIKTries block retries. The default of 1 runs every
+  // stage at full rate.
+  int coarseToFineDecimation;
+  int coarseToFineRefineIKTries;
+
   InitialMarkerFitParams();
   InitialMarkerFitParams(const InitialMarkerFitParams& other);
   InitialMarkerFitParams& setMarkerWeights(
@@ -566,6 +574,8 @@ struct InitialMarkerFitParams
   InitialMarkerFitParams& setMaxTrialsToUseForMultiTrialScaling(int numTrials);
   InitialMarkerFitParams& setMaxTimestepsToUseForMultiTrialScaling(
       int numTimesteps);
+  InitialMarkerFitParams& setCoarseToFineDecimation(int decimation);
+  InitialMarkerFitParams& setCoarseToFineRefineIKTries(int retries);
 };
 
 struct ScaleAndFitResult
@@ -638,6 +648,47 @@ public:
       int numSamples = 20,
       bool skipFinalIK = false);
 
+  /// This is what runKinematicsPipeline() does when
+  /// params.coarseToFineDecimation > 1. It runs the whole pipeline on just the
+  /// frames in `timesteps`, interpolates the result back up to the full rate,
+  /// and uses that to warm start a round of IK over every frame, with the body
+  /// scales and marker offsets from the decimated solve held fixed. This skips
+  /// the least-squares initializer, the joint center fits and the bilevel
+  /// optimization at full rate, which dominate the cost on long trials.
+  MarkerInitialization runCoarseToFineKinematicsPipeline(
+      const std::vector<std::map<std::string, Eigen::Vector3s>>&
+          markerObservations,
+      const std::vector<bool>& newClip,
+      const std::vector<int>& timesteps,
+      InitialMarkerFitParams params = InitialMarkerFitParams(),
+      int numSamples = 20,
+      bool skipFinalIK = false);
+
+  /// This picks the timesteps to keep when decimating a trajectory by
+  /// `decimation`. We keep every `decimation`'th frame counting from the start
+  /// of each clip, and always keep the first and last frame of each clip, so
+  /// that interpolating back up never crosses a clip boundary.
+  static std::vector<int> getDecimatedTimesteps(
+      const std::vector<bool>& newClip, int decimation);
+
+  /// This takes a matrix with one column for each timestep in `timesteps` (as
+  /// returned by getDecimatedTimesteps()), and linearly interpolates it back
+  /// up to `numTimesteps` columns. Rows where `wrapRows` is true hold angles,
+  /// which get interpolated the short way around the circle.
+  static Eigen::MatrixXs interpolateDecimatedColumns(
+      const Eigen::MatrixXs& decimated,
+      const std::vector<int>& timesteps,
+      int numTimesteps,
+      const std::vector<bool>& wrapRows = std::vector<bool>());
+
+  /// This is interpolateDecimatedColumns() for a
+  /// MarkerInitialization::jointAxis matrix (6 rows per joint: the center of
+  /// the axis, then its direction), which keeps the directions unit length.
+  static Eigen::MatrixXs interpolateDecimatedJointAxis(
+      const Eigen::MatrixXs& decimated,
+      const std::vector<int>& timesteps,
+      int numTimesteps);
+
   /// This just finds the joint centers and axis over time.
   MarkerInitialization runJointsPipeline(
       const std::vector<std::map<std::string, Eigen::Vector3s>>&
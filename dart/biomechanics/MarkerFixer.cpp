@@ -8,6 +8,7 @@
 #include "dart/math/AssignmentMatcher.hpp"
 #include "dart/math/Geometry.hpp"
 #include "dart/math/MathTypes.hpp"
+#include "dart/math/SpatialHash.hpp"
 #include "dart/server/GUIRecording.hpp"
 #include "dart/utils/AccelerationSmoother.hpp"
 
@@ -86,18 +87,26 @@ s_t LabeledMarkerTrace::pointToAppendDistance(
   {
     return 0.0;
   }
+  return (point - projectedPointAt(time, extrapolate)).norm();
+}
+
+//==============================================================================
+/// This returns where we would expect a point appended at `time` to be,
+/// which is the last point (or an extrapolation at this timestep of the last
+/// point, of order up to 2). The trace must not be empty.
+Eigen::Vector3s LabeledMarkerTrace::projectedPointAt(int time, bool extrapolate)
+{
   Eigen::Vector3s& lastPoint = mPoints.at(mPoints.size() - 1);
   if (extrapolate && mPoints.size() > 1)
   {
     int lastTime = mTimes.at(mTimes.size() - 1);
     Eigen::Vector3s v = (lastPoint - mPoints.at(mPoints.size() - 2))
                         / (lastTime - mTimes.at(mTimes.size() - 2));
-    Eigen::Vector3s projected = lastPoint + (v * (time - lastTime));
-    return (point - projected).norm();
+    return lastPoint + (v * (time - lastTime));
   }
   else
   {
-    return (point - lastPoint).norm();
+    return lastPoint;
   }
 }
 
@@ -413,6 +422,8 @@ std::vector<LabeledMarkerTrace> LabeledMarkerTrace::createRawTraces(
 {
   std::vector<LabeledMarkerTrace> traces;
   std::vector<int> activeTraces;
+  math::SpatialHash activeTraceHash(mergeDistance);
+  std::vector<int> nearbyTraces;
   for (int t = 0; t < markerObservations.size(); t++)
   {
     // 1. Only count as "active" the traces that had a point on the last frame
@@ -442,33 +453,41 @@ std::vector<LabeledMarkerTrace> LabeledMarkerTrace::createRawTraces(
       markerNames.push_back(pair.first);
     }
 
-    // 2. Compute affinity scores between active traces and points
-    Eigen::MatrixXs weights
-        = Eigen::MatrixXs(markerObservations[t].size(), activeTraces.size());
+    // 2. Compute affinity scores between active traces and points. Switching
+    // labels only ever adds to the distance, so any pair that can score above
+    // -infinity has a trace expecting its next point within `mergeDistance`,
+    // and we use a spatial hash of those expected points to find them.
+    activeTraceHash.clear();
+    for (int j = 0; j < activeTraces.size(); j++)
+    {
+      activeTraceHash.insert(
+          j, traces[activeTraces[j]].projectedPointAt(t, true));
+    }
+    std::vector<Eigen::Triplet<s_t>> candidates;
     for (int i = 0; i < markerNames.size(); i++)
     {
-      for (int j = 0; j < activeTraces.size(); j++)
+      const Eigen::Vector3s& point = markerObservations[t].at(markerNames[i]);
+      nearbyTraces.clear();
+      activeTraceHash.getCandidates(point, nearbyTraces);
+      for (int j : nearbyTraces)
       {
-        s_t dist = traces[activeTraces[j]].pointToAppendDistance(
-            t, markerObservations[t].at(markerNames[i]), true);
+        s_t dist
+            = traces[activeTraces[j]].pointToAppendDistance(t, point, true);
         if (traces[activeTraces[j]].getLastLabel() != markerNames[i])
         {
           dist += 0.04;
         }
-        if (dist > mergeDistance)
-        {
-          weights(i, j) = -1 * std::numeric_limits<double>::infinity();
-        }
-        else
+        if (dist <= mergeDistance)
         {
-          weights(i, j) = 1.0 / dist;
+          candidates.emplace_back(i, j, 1.0 / dist);
         }
       }
     }
 
     // 3. Assign points to active traces, or create new traces for unassigned
     // points
-    Eigen::VectorXi map = math::AssignmentMatcher::assignRowsToColumns(weights);
+    Eigen::VectorXi map = math::AssignmentMatcher::assignRowsToColumnsSparse(
+        markerNames.size(), activeTraces.size(), candidates);
     for (int i = 0; i < map.size(); i++)
     {
       if (map(i) == -1)
@@ -10,6 +10,7 @@
 #include "dart/math/AssignmentMatcher.hpp"
 #include "dart/math/Geometry.hpp"
 #include "dart/math/MathTypes.hpp"
+#include "dart/math/SpatialHash.hpp"
 
 namespace dart {
 namespace biomechanics {
@@ -75,18 +76,26 @@ s_t MarkerTrace::pointToAppendDistance(
   {
     return 0.0;
   }
+  return (point - projectedPointAt(time, extrapolate)).norm();
+}
+
+//==============================================================================
+/// This returns where we would expect a point appended at `time` to be,
+/// which is the last point (or an extrapolation at this timestep of the last
+/// point, of order up to 2). The trace must not be empty.
+Eigen::Vector3s MarkerTrace::projectedPointAt(int time, bool extrapolate)
+{
   Eigen::Vector3s& lastPoint = mPoints.at(mPoints.size() - 1);
   if (extrapolate && mPoints.size() > 1)
   {
     int lastTime = mTimes.at(mTimes.size() - 1);
     Eigen::Vector3s v = (lastPoint - mPoints.at(mPoints.size() - 2))
                         / (lastTime - mTimes.at(mTimes.size() - 2));
-    Eigen::Vector3s projected = lastPoint + (v * (time - lastTime));
-    return (point - projected).norm();
+    return lastPoint + (v * (time - lastTime));
   }
   else
   {
-    return (point - lastPoint).norm();
+    return lastPoint;
   }
 }
 
@@ -101,6 +110,8 @@ std::vector<MarkerTrace> MarkerTrace::createRawTraces(
 {
   std::vector<MarkerTrace> traces;
   std::vector<int> activeTraces;
+  math::SpatialHash activeTraceHash(mergeDistance);
+  std::vector<int> nearbyTraces;
   for (int t = 0; t < pointClouds.size(); t++)
   {
     // 1. Only count as "active" the traces that are within `mergeFrames` of now
@@ -124,29 +135,36 @@ std::vector<MarkerTrace> MarkerTrace::createRawTraces(
       continue;
     }
 
-    // 2. Compute affinity scores between active traces and points
-    Eigen::MatrixXs weights
-        = Eigen::MatrixXs(pointClouds[t].size(), activeTraces.size());
+    // 2. Compute affinity scores between active traces and points. Only
+    // traces that expect their next point within `mergeDistance` can score
+    // above -infinity, so we use a spatial hash of those expected points to
+    // skip all the pairs that are obviously too far apart.
+    activeTraceHash.clear();
+    for (int j = 0; j < activeTraces.size(); j++)
+    {
+      activeTraceHash.insert(
+          j, traces[activeTraces[j]].projectedPointAt(t, true));
+    }
+    std::vector<Eigen::Triplet<s_t>> candidates;
     for (int i = 0; i < pointClouds[t].size(); i++)
     {
-      for (int j = 0; j < activeTraces.size(); j++)
+      nearbyTraces.clear();
+      activeTraceHash.getCandidates(pointClouds[t][i], nearbyTraces);
+      for (int j : nearbyTraces)
       {
         s_t dist = traces[activeTraces[j]].pointToAppendDistance(
             t, pointClouds[t][i], true);
-        if (dist > mergeDistance)
-        {
-          weights(i, j) = -1 * std::numeric_limits<double>::infinity();
-        }
-        else
+        if (dist <= mergeDistance)
         {
-          weights(i, j) = 1.0 / dist;
+          candidates.emplace_back(i, j, 1.0 / dist);
         }
       }
     }
 
     // 3. Assign points to active traces, or create new traces for unassigned
     // points
-    Eigen::VectorXi map = math::AssignmentMatcher::assignRowsToColumns(weights);
+    Eigen::VectorXi map = math::AssignmentMatcher::assignRowsToColumnsSparse(
+        pointClouds[t].size(), activeTraces.size(), candidates);
     for (int i = 0; i < map.size(); i++)
     {
       if (map(i) == -1)
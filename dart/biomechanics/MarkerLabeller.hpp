@@ -59,6 +59,11 @@ public:
   /// timestep of the last point, of order up to 2)
   s_t pointToAppendDistance(int time, Eigen::Vector3s point, bool extrapolate);
 
+  /// This returns where we would expect a point appended at `time` to be,
+  /// which is the last point (or an extrapolation at this timestep of the last
+  /// point, of order up to 2). The trace must not be empty.
+  Eigen::Vector3s projectedPointAt(int time, bool extrapolate);
+
   /// This merges point clouds over time, to create a set of raw MarkerTraces
   /// over time. These traces can then be intelligently merged using any desired
   /// algorithm.
@@ -2,13 +2,19 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <limits>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -2983,6 +2989,187 @@ void OpenSimParser::filterJustMarkers(
   newFile.SaveFile(outputPath.c_str());
 }
 
+//==============================================================================
+/// This finds the [start, end) byte range of every line in `content`, not
+/// including the '\n' (or "\r\n", if the file was saved on a Windows machine).
+/// If `includeUnterminated` is false, a final line with no '\n' is dropped.
+static std::vector<std::pair<std::size_t, std::size_t>> findLineBoundaries(
+    const std::string& content, bool includeUnterminated)
+{
+  std::vector<std::pair<std::size_t, std::size_t>> lines;
+  lines.reserve(
+      std::count(content.begin(), content.end(), '\n')
+      + (includeUnterminated ? 1 : 0));
+
+  std::size_t start = 0;
+  while (start <= content.size())
+  {
+    const char* newline = static_cast<const char*>(std::memchr(
+        content.data() + start, '\n', content.size() - start));
+    if (newline == nullptr && !includeUnterminated)
+    {
+      break;
+    }
+    std::size_t end = newline == nullptr
+                          ? content.size()
+                          : static_cast<std::size_t>(newline - content.data());
+    std::size_t trimmedEnd = end;
+    if (trimmedEnd > start && content[trimmedEnd - 1] == '\r')
+    {
+      trimmedEnd--;
+    }
+    lines.emplace_back(start, trimmedEnd);
+    if (newline == nullptr)
+    {
+      break;
+    }
+    start = end + 1;
+  }
+  return lines;
+}
+
+//==============================================================================
+/// This parses the number in [start, end), with the same result as `strtod()`
+/// on the token. Plain decimals that fit in a double's mantissa, which is
+/// almost every value in a mocap file, are converted with a single exact
+/// multiply or divide by a power of ten. Anything else (long mantissas, large
+/// exponents, "nan", "inf", garbage) falls back to `strtod()`.
+double OpenSimParser::parseDecimal(const char* start, const char* end)
+{
+  static const double exactPowersOfTen[]
+      = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+         1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+         1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+  const char* p = start;
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+'))
+  {
+    negative = (*p == '-');
+    p++;
+  }
+
+  std::uint64_t mantissa = 0;
+  int significantDigits = 0;
+  int exponent = 0;
+  bool anyDigits = false;
+  while (p < end && *p >= '0' && *p <= '9')
+  {
+    if (mantissa != 0 || *p != '0')
+      significantDigits++;
+    mantissa = mantissa * 10 + (*p - '0');
+    anyDigits = true;
+    p++;
+  }
+  if (p < end && *p == '.')
+  {
+    p++;
+    while (p < end && *p >= '0' && *p <= '9')
+    {
+      if (mantissa != 0 || *p != '0')
+        significantDigits++;
+      mantissa = mantissa * 10 + (*p - '0');
+      exponent--;
+      anyDigits = true;
+      p++;
+    }
+  }
+  if (anyDigits && p < end && (*p == 'e' || *p == 'E'))
+  {
+    p++;
+    bool negativeExponent = false;
+    if (p < end && (*p == '-' || *p == '+'))
+    {
+      negativeExponent = (*p == '-');
+      p++;
+    }
+    int explicitExponent = 0;
+    bool anyExponentDigits = false;
+    while (p < end && *p >= '0' && *p <= '9')
+    {
+      if (explicitExponent < 10000)
+        explicitExponent = explicitExponent * 10 + (*p - '0');
+      anyExponentDigits = true;
+      p++;
+    }
+    if (!anyExponentDigits)
+      anyDigits = false;
+    exponent += negativeExponent ? -explicitExponent : explicitExponent;
+  }
+
+  if (!anyDigits || p != end || significantDigits > 19
+      || mantissa > (static_cast<std::uint64_t>(1) << 53) || exponent < -22
+      || exponent > 22)
+  {
+    // The token is always followed by whitespace, a line break or the end of
+    // the string, so strtod() doesn't read past the token.
+    return std::strtod(start, nullptr);
+  }
+
+  double value = static_cast<double>(mantissa);
+  if (exponent < 0)
+    value /= exactPowersOfTen[-exponent];
+  else
+    value *= exactPowersOfTen[exponent];
+  return negative ? -value : value;
+}
+
+//==============================================================================
+/// This splits the line [start, end) on spaces and tabs, and parses up to
+/// `maxTokens` of the tokens into `out`. Returns the number of tokens parsed.
+static int parseNumericRow(
+    const char* start, const char* end, double* out, int maxTokens)
+{
+  int numTokens = 0;
+  const char* p = start;
+  while (numTokens < maxTokens)
+  {
+    while (p < end && (*p == ' ' || *p == '\t'))
+      p++;
+    if (p == end)
+      break;
+    const char* tokenEnd = p;
+    while (tokenEnd < end && *tokenEnd != ' ' && *tokenEnd != '\t')
+      tokenEnd++;
+    out[numTokens] = OpenSimParser::parseDecimal(p, tokenEnd);
+    numTokens++;
+    p = tokenEnd;
+  }
+  return numTokens;
+}
+
+//==============================================================================
+/// This calls `fn(startRow, endRow)` on contiguous blocks of [0, numRows),
+/// spread over the hardware threads if there are enough rows to be worth it.
+static void parallelForRows(
+    int numRows, const std::function<void(int, int)>& fn)
+{
+  const int minRowsPerThread = 1024;
+  int numThreads = std::max(1, (int)std::thread::hardware_concurrency());
+  numThreads = std::min(numThreads, numRows / minRowsPerThread);
+  if (numThreads <= 1)
+  {
+    fn(0, numRows);
+    return;
+  }
+
+  const int rowsPerThread = (numRows + numThreads - 1) / numThreads;
+  std::vector<std::future<void>> futures;
+  for (int start = rowsPerThread; start < numRows; start += rowsPerThread)
+  {
+    futures.push_back(std::async(
+        std::launch::async,
+        fn,
+        start,
+        std::min(numRows, start + rowsPerThread)));
+  }
+  fn(0, rowsPerThread);
+  for (std::future<void>& future : futures)
+  {
+    future.get();
+  }
+}
+
 //==============================================================================
 /// This grabs the marker trajectories from a TRC file
 OpenSimTRC OpenSimParser::loadTRC(
@@ -2993,20 +3180,20 @@ OpenSimTRC OpenSimParser::loadTRC(
 
   OpenSimTRC result;
   const std::string content = retriever->readAll(uri);
+  const std::vector<std::pair<std::size_t, std::size_t>> lines
+      = findLineBoundaries(content, false);
   double unitsMultiplier = 1.0;
 
   std::vector<std::string> markerNames;
-  Eigen::Vector3s markerSwapSpace = Eigen::Vector3s::Zero();
 
-  int lineNumber = 0;
-  auto start = 0U;
-  auto end = content.find("\n");
-  while (end != std::string::npos)
+  // Only lines 2 (the units) and 3 (the marker names) of the header carry
+  // anything we need.
+  for (int lineNumber = 2; lineNumber <= 3 && lineNumber < (int)lines.size();
+       lineNumber++)
   {
-    std::string line = content.substr(start, end - start);
-
-    std::map<std::string, Eigen::Vector3s> markerPositions;
-    double timestamp = 0.0;
+    std::string line = content.substr(
+        lines[lineNumber].first,
+        lines[lineNumber].second - lines[lineNumber].first);
 
     int tokenNumber = 0;
     std::string whitespace = " \t";
@@ -3042,30 +3229,6 @@ OpenSimTRC OpenSimParser::loadTRC(
       {
         markerNames.push_back(token);
       }
-      else if (lineNumber > 5)
-      {
-        if (tokenNumber == 1)
-        {
-          timestamp = atof(token.c_str());
-        }
-        else if (tokenNumber > 1)
-        {
-          int offset
-              = tokenNumber - 2; // first two cols are "frame #" and "time"
-          int markerNumber = (int)floor((double)offset / 3);
-          int axisNumber = offset - (markerNumber * 3);
-          markerSwapSpace(axisNumber) = atof(token.c_str()) * unitsMultiplier;
-          if (axisNumber == 2)
-          {
-            if (!markerSwapSpace.hasNaN()
-                && (markerSwapSpace != Eigen::Vector3s::Zero()))
-            {
-              markerPositions[markerNames[markerNumber]]
-                  = Eigen::Vector3s(markerSwapSpace);
-            }
-          }
-        }
-      }
 
       /////////////////////////////////////////////////////////
 
@@ -3076,17 +3239,46 @@ OpenSimTRC OpenSimParser::loadTRC(
       }
       tokenStart = line.find_first_not_of(whitespace, tokenEnd + 1);
     }
+  }
 
-    if (lineNumber > 5)
-    {
-      result.markerTimesteps.push_back(markerPositions);
-      result.timestamps.push_back(timestamp);
+  // Every line after the header is a row of "frame #", "time", and then XYZ
+  // for each marker. Rows are independent, so we parse them in parallel
+  // straight into a preallocated matrix with one column per row.
+  const int firstDataLine = 6;
+  const int numRows = std::max(0, (int)lines.size() - firstDataLine);
+  const int numCols = 2 + 3 * (int)markerNames.size();
+  Eigen::MatrixXd values(numCols, numRows);
+  result.timestamps.resize(numRows, 0.0);
+  result.markerTimesteps.resize(numRows);
+  parallelForRows(numRows, [&](int startRow, int endRow) {
+    for (int row = startRow; row < endRow; row++)
+    {
+      const std::pair<std::size_t, std::size_t>& line
+          = lines[firstDataLine + row];
+      const int numTokens = parseNumericRow(
+          content.data() + line.first,
+          content.data() + line.second,
+          values.col(row).data(),
+          numCols);
+      if (numTokens > 1)
+      {
+        result.timestamps[row] = values(1, row);
+      }
+      std::map<std::string, Eigen::Vector3s>& markerPositions
+          = result.markerTimesteps[row];
+      for (int i = 0; 2 + 3 * i + 2 < numTokens; i++)
+      {
+        Eigen::Vector3s markerPosition
+            = values.block<3, 1>(2 + 3 * i, row).cast<s_t>()
+              * unitsMultiplier;
+        if (!markerPosition.hasNaN()
+            && (markerPosition != Eigen::Vector3s::Zero()))
+        {
+          markerPositions[markerNames[i]] = markerPosition;
+        }
+      }
     }
-
-    start = end + 1; // "\n".length()
-    end = content.find("\n", start);
-    lineNumber++;
-  }
+  });
 
   // Translate into a "lines" format, where each marker gets a full trajectory
   for (int i = 0; i < result.markerTimesteps.size(); i++)
@@ -3191,30 +3383,23 @@ OpenSimMot OpenSimParser::loadMot(
   const common::ResourceRetrieverPtr retriever
       = ensureRetriever(nullOrRetriever);
 
-  OpenSimTRC result;
   const std::string content = retriever->readAll(uri);
+  const std::vector<std::pair<std::size_t, std::size_t>> lines
+      = findLineBoundaries(content, false);
   std::vector<int> columnToDof;
   std::vector<bool> rotationalDof;
 
-  std::vector<Eigen::VectorXs> poses;
-  std::vector<double> timestamps;
-
   bool inHeader = true;
   bool inDegrees = false;
 
-  int downsampleClock = 0;
-  int lineNumber = 0;
-  auto start = 0U;
-  auto end = content.find("\n");
-  while (end != std::string::npos)
+  // Read the header and the row of column names, then hand the numeric rows
+  // off to the parallel parser below
+  int firstDataLine = lines.size();
+  for (int lineIndex = 0; lineIndex < (int)lines.size(); lineIndex++)
   {
-    std::string line = content.substr(start, end - start);
-
-    // Trim '\r', in case this file was saved on a Windows machine
-    if (line.size() > 0 && line[line.size() - 1] == '\r')
-    {
-      line = line.substr(0, line.size() - 1);
-    }
+    std::string line = content.substr(
+        lines[lineIndex].first,
+        lines[lineIndex].second - lines[lineIndex].first);
 
     if (inHeader)
     {
@@ -3241,74 +3426,43 @@ OpenSimMot OpenSimParser::loadMot(
       int tokenNumber = 0;
       std::string whitespace = " \t";
       auto tokenStart = line.find_first_not_of(whitespace);
-      Eigen::VectorXs pose = Eigen::VectorXs::Zero(skel->getNumDofs());
-      double timestamp = 0.0;
       while (tokenStart != std::string::npos)
       {
         auto tokenEnd = line.find_first_of(whitespace, tokenStart + 1);
         std::string token = line.substr(tokenStart, tokenEnd - tokenStart);
 
-        /////////////////////////////////////////////////////////
-        // Process the token, given tokenNumber and lineNumber
-
-        if (lineNumber == 0)
+        if (tokenNumber > 0)
         {
-          if (tokenNumber > 0)
+          // This means we're on the row defining the names of the joints
+          // we're recording positions of
+          dynamics::DegreeOfFreedom* dof = skel->getDof(token);
+          bool isRotationalJoint = true;
+          if (dof != nullptr)
           {
-            // This means we're on the row defining the names of the joints
-            // we're recording positions of
-            dynamics::DegreeOfFreedom* dof = skel->getDof(token);
-            bool isRotationalJoint = true;
-            if (dof != nullptr)
+            columnToDof.push_back(dof->getIndexInSkeleton());
+            dynamics::Joint* joint = dof->getJoint();
+            if (joint->getType()
+                    == dynamics::TranslationalJoint2D::getStaticType()
+                || joint->getType()
+                       == dynamics::TranslationalJoint::getStaticType()
+                || joint->getType()
+                       == dynamics::PrismaticJoint::getStaticType())
             {
-              columnToDof.push_back(dof->getIndexInSkeleton());
-              dynamics::Joint* joint = dof->getJoint();
-              if (joint->getType()
-                      == dynamics::TranslationalJoint2D::getStaticType()
-                  || joint->getType()
-                         == dynamics::TranslationalJoint::getStaticType()
-                  || joint->getType()
-                         == dynamics::PrismaticJoint::getStaticType())
-              {
-                isRotationalJoint = false;
-              }
-              if (joint->getType() == dynamics::EulerFreeJoint::getStaticType()
-                  && dof->getIndexInJoint() >= 3)
-              {
-                isRotationalJoint = false;
-              }
+              isRotationalJoint = false;
             }
-            else
+            if (joint->getType() == dynamics::EulerFreeJoint::getStaticType()
+                && dof->getIndexInJoint() >= 3)
             {
-              columnToDof.push_back(-1);
+              isRotationalJoint = false;
             }
-            rotationalDof.push_back(isRotationalJoint);
-          }
-        }
-        else
-        {
-          double value = atof(token.c_str());
-          if (tokenNumber == 0)
-          {
-            timestamp = value;
           }
           else
           {
-            int dofIndex = columnToDof[tokenNumber - 1];
-            if (dofIndex != -1)
-            {
-              bool isRotationalJoint = rotationalDof[tokenNumber - 1];
-              if (inDegrees && isRotationalJoint)
-              {
-                value *= M_PI / 180.0;
-              }
-              pose(dofIndex) = value;
-            }
+            columnToDof.push_back(-1);
           }
+          rotationalDof.push_back(isRotationalJoint);
         }
 
-        /////////////////////////////////////////////////////////
-
         tokenNumber++;
         if (tokenEnd == std::string::npos)
         {
@@ -3316,31 +3470,58 @@ OpenSimMot OpenSimParser::loadMot(
         }
         tokenStart = line.find_first_not_of(whitespace, tokenEnd + 1);
       }
+      firstDataLine = lineIndex + 1;
+      break;
+    }
+  }
 
-      if (lineNumber > 0)
+  // We only keep every `downsampleByFactor` rows (starting with the first), so
+  // only those rows get parsed at all. Each kept row is parsed in parallel
+  // straight into its column of the preallocated matrices.
+  const int numRows = std::max(0, (int)lines.size() - firstDataLine);
+  const int stride = std::max(1, downsampleByFactor);
+  const int numKept = (numRows + stride - 1) / stride;
+  const int numCols = 1 + (int)columnToDof.size();
+  Eigen::MatrixXd values(numCols, numKept);
+  std::vector<double> timestamps(numKept, 0.0);
+  Eigen::MatrixXs posesMatrix
+      = Eigen::MatrixXs::Zero(skel->getNumDofs(), numKept);
+  parallelForRows(numKept, [&](int startRow, int endRow) {
+    for (int i = startRow; i < endRow; i++)
+    {
+      const std::pair<std::size_t, std::size_t>& line
+          = lines[firstDataLine + i * stride];
+      const int numTokens = parseNumericRow(
+          content.data() + line.first,
+          content.data() + line.second,
+          values.col(i).data(),
+          numCols);
+      if (numTokens > 0)
+      {
+        timestamps[i] = values(0, i);
+      }
+      for (int col = 1; col < numTokens; col++)
       {
-        downsampleClock--;
-        if (downsampleClock <= 0)
+        int dofIndex = columnToDof[col - 1];
+        if (dofIndex != -1)
         {
-          downsampleClock = downsampleByFactor;
-          poses.push_back(pose);
-          timestamps.push_back(timestamp);
+          double value = values(col, i);
+          if (inDegrees && rotationalDof[col - 1])
+          {
+            value *= M_PI / 180.0;
+          }
+          posesMatrix(dofIndex, i) = value;
         }
       }
-      lineNumber++;
     }
+  });
 
-    start = end + 1; // "\n".length()
-    end = content.find("\n", start);
-  }
-  Eigen::MatrixXs posesMatrix
-      = Eigen::MatrixXs::Zero(skel->getNumDofs(), poses.size());
-  for (int i = 0; i < poses.size(); i++)
+  if (skel->getJoint(0)->getType() == dynamics::EulerFreeJoint::getStaticType())
   {
-    if (skel->getJoint(0)->getType()
-        == dynamics::EulerFreeJoint::getStaticType())
+    for (int i = 0; i < posesMatrix.cols(); i++)
     {
-      Eigen::VectorXs ballPoses = skel->convertPositionsToBallSpace(poses[i]);
+      Eigen::VectorXs ballPoses
+          = skel->convertPositionsToBallSpace(posesMatrix.col(i));
 
       // Rotate the orientation
       Eigen::Vector3s so3 = ballPoses.segment<3>(0);
@@ -3352,10 +3533,6 @@ OpenSimMot OpenSimParser::loadMot(
 
       posesMatrix.col(i) = skel->convertPositionsFromBallSpace(ballPoses);
     }
-    else
-    {
-      posesMatrix.col(i) = poses[i];
-    }
   }
   OpenSimMot mot;
   mot.poses = posesMatrix;
@@ -3800,18 +3977,16 @@ std::vector<ForcePlate> OpenSimParser::loadGRF(
   std::vector<std::vector<Eigen::Vector3s>> copRows;
   std::vector<std::vector<Eigen::Vector6s>> wrenchRows;
 
-  int lineNumber = 0;
-  auto start = 0U;
-  auto end = content.find("\n");
-  while (true)
+  // Read the header and the row of column names, then hand the numeric rows
+  // off to the parallel parser below
+  const std::vector<std::pair<std::size_t, std::size_t>> lines
+      = findLineBoundaries(content, true);
+  int firstDataLine = lines.size();
+  for (int lineIndex = 0; lineIndex < (int)lines.size(); lineIndex++)
   {
-    std::string line = content.substr(start, end - start);
-
-    // Trim '\r', in case this file was saved on a Windows machine
-    if (line.size() > 0 && line[line.size() - 1] == '\r')
-    {
-      line = line.substr(0, line.size() - 1);
-    }
+    std::string line = content.substr(
+        lines[lineIndex].first,
+        lines[lineIndex].second - lines[lineIndex].first);
 
     if (inHeader)
     {
@@ -3837,234 +4012,227 @@ std::vector<ForcePlate> OpenSimParser::loadGRF(
     // file.
     else if (!line.empty())
     {
-      int tokenNumber = 0;
       std::string whitespace = " \t";
       auto tokenStart = line.find_first_not_of(whitespace);
-
-      double timestamp = 0.0;
-      std::vector<Eigen::Vector3s> cops;
-      std::vector<Eigen::Vector6s> wrenches;
-
-      for (int i = 0; i < numPlates; i++)
+      while (tokenStart != std::string::npos)
       {
-        wrenches.push_back(Eigen::Vector6s::Zero());
-        cops.push_back(Eigen::Vector3s::Zero());
+        auto tokenEnd = line.find_first_of(whitespace, tokenStart + 1);
+        colNames.push_back(line.substr(tokenStart, tokenEnd - tokenStart));
+        if (tokenEnd == std::string::npos)
+        {
+          break;
+        }
+        tokenStart = line.find_first_not_of(whitespace, tokenEnd + 1);
+      }
+      // Ignore whitespace in a .MOT file between "endheader" and the names of
+      // the columns
+      if (colNames.empty())
+      {
+        continue;
       }
 
-      while (tokenStart != std::string::npos)
+      // Find the unique prefix/suffixes
+      std::map<std::string, int> prefixSuffixNumbers;
+
+      for (int i = 0; i < colNames.size(); i++)
       {
-        auto tokenEnd = line.find_first_of(whitespace, tokenStart + 1);
-        std::string token = line.substr(tokenStart, tokenEnd - tokenStart);
+        const std::string& token = colNames[i];
 
-        /////////////////////////////////////////////////////////
-        // Process the token, given tokenNumber and lineNumber
+        // Compute the names of the columns
+        int plate = -1;
+        int cop = -1;
+        int wrench = -1;
 
-        if (lineNumber == 0)
+        std::string empty = "";
+        std::string underscore = "_";
+        std::string prefixSuffix = token;
+
+        if (token.find("px") != std::string::npos)
         {
-          colNames.push_back(token);
+          prefixSuffix.replace(token.find("px"), 2, empty);
+          cop = 0;
         }
-        else
+        if (token.find("py") != std::string::npos)
         {
-          double value = atof(token.c_str());
-          if (tokenNumber == 0)
-          {
-            timestamp = value;
-          }
-          else
-          {
-            int plateIndex = colToPlate[tokenNumber];
-            int copIndex = colToCOP[tokenNumber];
-            int wrenchIndex = colToWrench[tokenNumber];
-            if (plateIndex != -1)
-            {
-              if (wrenchIndex != -1)
-              {
-                wrenches[plateIndex](wrenchIndex) = value;
-              }
-              if (copIndex != -1)
-              {
-                cops[plateIndex](copIndex) = value;
-              }
-            }
-          }
+          prefixSuffix.replace(token.find("py"), 2, empty);
+          cop = 1;
         }
-
-        /////////////////////////////////////////////////////////
-
-        tokenNumber++;
-        if (tokenEnd == std::string::npos)
+        if (token.find("pz") != std::string::npos)
         {
-          break;
+          prefixSuffix.replace(token.find("pz"), 2, empty);
+          cop = 2;
+        }
+        if (token.find("mx") != std::string::npos)
+        {
+          prefixSuffix.replace(token.find("mx"), 2, empty);
+          wrench = 0;
+        }
+        if (token.find("my") != std::string::npos)
+        {
+          prefixSuffix.replace(token.find("my"), 2, empty);
+          wrench = 1;
+        }
+        if (token.find("mz") != std::string::npos)
+        {
+          prefixSuffix.replace(token.find("mz"), 2, empty);
+          wrench = 2;
+        }
+        if (token.find("torque_x") != std::string::npos)
+        {
+          prefixSuffix.replace(
+              token.find("torque_x"), std::string("torque_x").size(), empty);
+          wrench = 0;
+        }
+        if (token.find("torque_y") != std::string::npos)
+        {
+          prefixSuffix.replace(
+              token.find("torque_y"), std::string("torque_y").size(), empty);
+          wrench = 1;
+        }
+        if (token.find("torque_z") != std::string::npos)
+        {
+          prefixSuffix.replace(
+              token.find("torque_z"), std::string("torque_z").size(), empty);
+          wrench = 2;
+        }
+        if (token.find("torque_r_x") != std::string::npos
+            || token.find("torque_l_x") != std::string::npos)
+        {
+          prefixSuffix.replace(
+              token.find("_x"), std::string("_x").size(), underscore);
+          wrench = 0;
+        }
+        if (token.find("torque_r_y") != std::string::npos
+            || token.find("torque_l_y") != std::string::npos)
+        {
+          prefixSuffix.replace(
+              token.find("_y"), std::string("_y").size(), underscore);
+          wrench = 1;
+        }
+        if (token.find("torque_r_z") != std::string::npos
+            || token.find("torque_l_z") != std::string::npos)
+        {
+          prefixSuffix.replace(
+              token.find("_z"), std::string("_z").size(), underscore);
+          wrench = 2;
+        }
+        if (token.find("vx") != std::string::npos)
+        {
+          prefixSuffix.replace(token.find("vx"), 2, empty);
+          wrench = 3;
+        }
+        if (token.find("vy") != std::string::npos)
+        {
+          prefixSuffix.replace(token.find("vy"), 2, empty);
+          wrench = 4;
+        }
+        if (token.find("vz") != std::string::npos)
+        {
+          prefixSuffix.replace(token.find("vz"), 2, empty);
+          wrench = 5;
         }
-        tokenStart = line.find_first_not_of(whitespace, tokenEnd + 1);
-      }
-
-      if (lineNumber == 0)
-      {
-        // Find the unique prefix/suffixes
-        std::map<std::string, int> prefixSuffixNumbers;
 
-        for (int i = 0; i < colNames.size(); i++)
+        if (prefixSuffix.find("force") != std::string::npos)
         {
-          const std::string& token = colNames[i];
+          prefixSuffix.replace(prefixSuffix.find("force"), 5, empty);
+        }
+        if (prefixSuffix.find("moment") != std::string::npos)
+        {
+          prefixSuffix.replace(prefixSuffix.find("moment"), 6, empty);
+        }
+        if (prefixSuffix.find("torque") != std::string::npos)
+        {
+          prefixSuffix.replace(prefixSuffix.find("torque"), 6, empty);
+        }
 
-          // Compute the names of the columns
-          int plate = -1;
-          int cop = -1;
-          int wrench = -1;
+        while (prefixSuffix.find("__") != std::string::npos)
+        {
+          prefixSuffix.replace(prefixSuffix.find("__"), 2, std::string("_"));
+        }
 
-          std::string empty = "";
-          std::string underscore = "_";
-          std::string prefixSuffix = token;
+        if (token == "time")
+        {
+          // Default to plate 0
+          plate = 0;
+        }
+        else if (prefixSuffixNumbers.count(prefixSuffix) > 0)
+        {
+          plate = prefixSuffixNumbers.at(prefixSuffix);
+        }
+        else
+        {
+          std::cout << "Reading new GRF column prefixSuffix: " << prefixSuffix
+                    << std::endl;
+          plate = prefixSuffixNumbers.size();
+          prefixSuffixNumbers[prefixSuffix] = plate;
+        }
 
-          if (token.find("px") != std::string::npos)
-          {
-            prefixSuffix.replace(token.find("px"), 2, empty);
-            cop = 0;
-          }
-          if (token.find("py") != std::string::npos)
-          {
-            prefixSuffix.replace(token.find("py"), 2, empty);
-            cop = 1;
-          }
-          if (token.find("pz") != std::string::npos)
-          {
-            prefixSuffix.replace(token.find("pz"), 2, empty);
-            cop = 2;
-          }
-          if (token.find("mx") != std::string::npos)
-          {
-            prefixSuffix.replace(token.find("mx"), 2, empty);
-            wrench = 0;
-          }
-          if (token.find("my") != std::string::npos)
-          {
-            prefixSuffix.replace(token.find("my"), 2, empty);
-            wrench = 1;
-          }
-          if (token.find("mz") != std::string::npos)
-          {
-            prefixSuffix.replace(token.find("mz"), 2, empty);
-            wrench = 2;
-          }
-          if (token.find("torque_x") != std::string::npos)
-          {
-            prefixSuffix.replace(
-                token.find("torque_x"), std::string("torque_x").size(), empty);
-            wrench = 0;
-          }
-          if (token.find("torque_y") != std::string::npos)
-          {
-            prefixSuffix.replace(
-                token.find("torque_y"), std::string("torque_y").size(), empty);
-            wrench = 1;
-          }
-          if (token.find("torque_z") != std::string::npos)
-          {
-            prefixSuffix.replace(
-                token.find("torque_z"), std::string("torque_z").size(), empty);
-            wrench = 2;
-          }
-          if (token.find("torque_r_x") != std::string::npos
-              || token.find("torque_l_x") != std::string::npos)
-          {
-            prefixSuffix.replace(
-                token.find("_x"), std::string("_x").size(), underscore);
-            wrench = 0;
-          }
-          if (token.find("torque_r_y") != std::string::npos
-              || token.find("torque_l_y") != std::string::npos)
-          {
-            prefixSuffix.replace(
-                token.find("_y"), std::string("_y").size(), underscore);
-            wrench = 1;
-          }
-          if (token.find("torque_r_z") != std::string::npos
-              || token.find("torque_l_z") != std::string::npos)
-          {
-            prefixSuffix.replace(
-                token.find("_z"), std::string("_z").size(), underscore);
-            wrench = 2;
-          }
-          if (token.find("vx") != std::string::npos)
-          {
-            prefixSuffix.replace(token.find("vx"), 2, empty);
-            wrench = 3;
-          }
-          if (token.find("vy") != std::string::npos)
-          {
-            prefixSuffix.replace(token.find("vy"), 2, empty);
-            wrench = 4;
-          }
-          if (token.find("vz") != std::string::npos)
-          {
-            prefixSuffix.replace(token.find("vz"), 2, empty);
-            wrench = 5;
-          }
+        colToPlate.push_back(plate);
+        colToCOP.push_back(cop);
+        colToWrench.push_back(wrench);
+      }
 
-          if (prefixSuffix.find("force") != std::string::npos)
-          {
-            prefixSuffix.replace(prefixSuffix.find("force"), 5, empty);
-          }
-          if (prefixSuffix.find("moment") != std::string::npos)
-          {
-            prefixSuffix.replace(prefixSuffix.find("moment"), 6, empty);
-          }
-          if (prefixSuffix.find("torque") != std::string::npos)
-          {
-            prefixSuffix.replace(prefixSuffix.find("torque"), 6, empty);
-          }
+      numPlates = prefixSuffixNumbers.size();
+      firstDataLine = lineIndex + 1;
+      break;
+    }
+  }
 
-          while (prefixSuffix.find("__") != std::string::npos)
-          {
-            prefixSuffix.replace(prefixSuffix.find("__"), 2, std::string("_"));
-          }
+  // Skip empty data lines, like the extra lines at the end of the file
+  std::vector<int> dataLines;
+  for (int lineIndex = firstDataLine; lineIndex < (int)lines.size();
+       lineIndex++)
+  {
+    if (lines[lineIndex].second > lines[lineIndex].first)
+    {
+      dataLines.push_back(lineIndex);
+    }
+  }
 
-          if (token == "time")
-          {
-            // Default to plate 0
-            plate = 0;
-          }
-          else if (prefixSuffixNumbers.count(prefixSuffix) > 0)
+  // Every data row is independent, so parse them in parallel straight into a
+  // preallocated matrix with one column per row
+  const int numRows = dataLines.size();
+  const int numCols = colNames.size();
+  Eigen::MatrixXd values(numCols, numRows);
+  timestamps.resize(numRows, 0.0);
+  copRows.resize(
+      numRows,
+      std::vector<Eigen::Vector3s>(numPlates, Eigen::Vector3s::Zero()));
+  wrenchRows.resize(
+      numRows,
+      std::vector<Eigen::Vector6s>(numPlates, Eigen::Vector6s::Zero()));
+  parallelForRows(numRows, [&](int startRow, int endRow) {
+    for (int row = startRow; row < endRow; row++)
+    {
+      const std::pair<std::size_t, std::size_t>& line = lines[dataLines[row]];
+      const int numTokens = parseNumericRow(
+          content.data() + line.first,
+          content.data() + line.second,
+          values.col(row).data(),
+          numCols);
+      if (numTokens > 0)
+      {
+        timestamps[row] = values(0, row);
+      }
+      for (int col = 1; col < numTokens; col++)
+      {
+        int plateIndex = colToPlate[col];
+        int copIndex = colToCOP[col];
+        int wrenchIndex = colToWrench[col];
+        if (plateIndex != -1)
+        {
+          if (wrenchIndex != -1)
           {
-            plate = prefixSuffixNumbers.at(prefixSuffix);
+            wrenchRows[row][plateIndex](wrenchIndex) = values(col, row);
           }
-          else
+          if (copIndex != -1)
           {
-            std::cout << "Reading new GRF column prefixSuffix: " << prefixSuffix
-                      << std::endl;
-            plate = prefixSuffixNumbers.size();
-            prefixSuffixNumbers[prefixSuffix] = plate;
+            copRows[row][plateIndex](copIndex) = values(col, row);
           }
-
-          colToPlate.push_back(plate);
-          colToCOP.push_back(cop);
-          colToWrench.push_back(wrench);
         }
-
-        numPlates = prefixSuffixNumbers.size();
-      }
-      else
-      {
-        copRows.push_back(cops);
-        wrenchRows.push_back(wrenches);
-        timestamps.push_back(timestamp);
-      }
-      // Ignore whitespace in a .MOT file between "endheader" and the names of
-      // the columns
-      if (lineNumber > 0 || colNames.size() > 0)
-      {
-        lineNumber++;
       }
     }
-
-    if (end == std::string::npos)
-    {
-      break;
-    }
-    start = end + 1; // "\n".length()
-    end = content.find("\n", start);
-  }
+  });
 
   assert(timestamps.size() == copRows.size());
   assert(timestamps.size() == wrenchRows.size());
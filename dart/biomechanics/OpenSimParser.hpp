@@ -251,6 +251,13 @@ public:
       const std::string& outputPath,
       const common::ResourceRetrieverPtr& retriever = nullptr);
 
+  /// This parses the number in [start, end), with the same result as
+  /// `strtod()` on the token, but without a library call for the plain
+  /// decimals that make up almost every value in a mocap file. The character
+  /// at `end` must not continue the number (whitespace, a line break or a
+  /// '\0' are all fine), since the slow path hands `start` to `strtod()`.
+  static double parseDecimal(const char* start, const char* end);
+
   /// This grabs the marker trajectories from a TRC file
   static OpenSimTRC loadTRC(
       const common::Uri& uri,
@@ -0,0 +1,1011 @@
+#include "dart/biomechanics/SkeletonSnapshot.hpp"
+
+#include <fstream>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "dart/biomechanics/macros.hpp"
+#include "dart/common/Console.hpp"
+#include "dart/common/LocalResourceRetriever.hpp"
+#include "dart/common/Uri.hpp"
+#include "dart/dynamics/BallJoint.hpp"
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/BoxShape.hpp"
+#include "dart/dynamics/CapsuleShape.hpp"
+#include "dart/dynamics/ConstantCurveIncompressibleJoint.hpp"
+#include "dart/dynamics/CustomJoint.hpp"
+#include "dart/dynamics/CylinderShape.hpp"
+#include "dart/dynamics/DegreeOfFreedom.hpp"
+#include "dart/dynamics/EllipsoidJoint.hpp"
+#include "dart/dynamics/EllipsoidShape.hpp"
+#include "dart/dynamics/EulerFreeJoint.hpp"
+#include "dart/dynamics/EulerJoint.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
+#include "dart/dynamics/Inertia.hpp"
+#include "dart/dynamics/Joint.hpp"
+#include "dart/dynamics/MeshShape.hpp"
+#include "dart/dynamics/PrismaticJoint.hpp"
+#include "dart/dynamics/RevoluteJoint.hpp"
+#include "dart/dynamics/ScapulathoracicJoint.hpp"
+#include "dart/dynamics/ScrewJoint.hpp"
+#include "dart/dynamics/ShapeFrame.hpp"
+#include "dart/dynamics/ShapeNode.hpp"
+#include "dart/dynamics/SphereShape.hpp"
+#include "dart/dynamics/TranslationalJoint.hpp"
+#include "dart/dynamics/UniversalJoint.hpp"
+#include "dart/dynamics/WeldJoint.hpp"
+#include "dart/math/ConstantFunction.hpp"
+#include "dart/math/CustomFunction.hpp"
+#include "dart/math/LinearFunction.hpp"
+#include "dart/math/MathTypes.hpp"
+#include "dart/math/PiecewiseLinearFunction.hpp"
+#include "dart/math/PolynomialFunction.hpp"
+#include "dart/math/SimmSpline.hpp"
+#include "dart/proto/SkeletonSnapshot.pb.h"
+#include "dart/utils/CompositeResourceRetriever.hpp"
+#include "dart/utils/DartResourceRetriever.hpp"
+
+namespace dart {
+namespace biomechanics {
+
+// Bump this whenever the meaning of existing fields changes, so that stale
+// snapshots get rejected rather than silently misread
+static const int SKELETON_SNAPSHOT_VERSION = 1;
+
+//==============================================================================
+static void writeVector(
+    google::protobuf::RepeatedField<double>* field, const Eigen::VectorXs& vec)
+{
+  field->Reserve(vec.size());
+  for (int i = 0; i < vec.size(); i++)
+  {
+    field->Add((double)vec(i));
+  }
+}
+
+//==============================================================================
+static Eigen::VectorXs readVector(
+    const google::protobuf::RepeatedField<double>& field)
+{
+  Eigen::VectorXs vec = Eigen::VectorXs::Zero(field.size());
+  for (int i = 0; i < field.size(); i++)
+  {
+    vec(i) = field.Get(i);
+  }
+  return vec;
+}
+
+//==============================================================================
+static void writeTransform(
+    google::protobuf::RepeatedField<double>* field, const Eigen::Isometry3s& T)
+{
+  Eigen::Matrix4s mat = T.matrix();
+  writeVector(field, Eigen::Map<const Eigen::VectorXs>(mat.data(), 16));
+}
+
+//==============================================================================
+static Eigen::Isometry3s readTransform(
+    const google::protobuf::RepeatedField<double>& field)
+{
+  Eigen::Isometry3s T = Eigen::Isometry3s::Identity();
+  if (field.size() == 16)
+  {
+    Eigen::VectorXs flat = readVector(field);
+    T.matrix() = Eigen::Map<const Eigen::Matrix4s>(flat.data());
+  }
+  return T;
+}
+
+//==============================================================================
+static void writeCustomFunction(
+    proto::SkeletonSnapshotCustomFunction* proto,
+    const std::shared_ptr<math::CustomFunction>& fn,
+    int drivenByDof)
+{
+  proto->set_driven_by_dof(drivenByDof);
+  if (auto* constant = dynamic_cast<math::ConstantFunction*>(fn.get()))
+  {
+    proto->set_type(proto::constantFunction);
+    proto->add_coefficients((double)constant->mValue);
+  }
+  else if (auto* linear = dynamic_cast<math::LinearFunction*>(fn.get()))
+  {
+    proto->set_type(proto::linearFunction);
+    proto->add_coefficients((double)linear->mSlope);
+    proto->add_coefficients((double)linear->mYIntercept);
+  }
+  else if (
+      auto* polynomial = dynamic_cast<math::PolynomialFunction*>(fn.get()))
+  {
+    proto->set_type(proto::polynomialFunction);
+    for (s_t coeff : polynomial->mCoeffs)
+    {
+      proto->add_coefficients((double)coeff);
+    }
+  }
+  else if (auto* spline = dynamic_cast<math::SimmSpline*>(fn.get()))
+  {
+    proto->set_type(proto::simmSpline);
+    for (s_t x : spline->getX())
+      proto->add_x((double)x);
+    for (s_t y : spline->getY())
+      proto->add_y((double)y);
+  }
+  else if (
+      auto* pl = dynamic_cast<math::PiecewiseLinearFunction*>(fn.get()))
+  {
+    proto->set_type(proto::piecewiseLinearFunction);
+    for (s_t x : pl->getX())
+      proto->add_x((double)x);
+    for (s_t y : pl->getY())
+      proto->add_y((double)y);
+  }
+  else
+  {
+    NIMBLE_THROW(
+        "SkeletonSnapshot doesn't support this CustomJoint function type.");
+  }
+}
+
+//==============================================================================
+static std::shared_ptr<math::CustomFunction> readCustomFunction(
+    const proto::SkeletonSnapshotCustomFunction& proto)
+{
+  std::vector<s_t> coeffs(
+      proto.coefficients().begin(), proto.coefficients().end());
+  std::vector<s_t> x(proto.x().begin(), proto.x().end());
+  std::vector<s_t> y(proto.y().begin(), proto.y().end());
+  switch (proto.type())
+  {
+    case proto::constantFunction:
+      return std::make_shared<math::ConstantFunction>(coeffs.at(0));
+    case proto::linearFunction:
+      return std::make_shared<math::LinearFunction>(coeffs.at(0), coeffs.at(1));
+    case proto::polynomialFunction:
+      return std::make_shared<math::PolynomialFunction>(coeffs);
+    case proto::simmSpline:
+      return std::make_shared<math::SimmSpline>(x, y);
+    case proto::piecewiseLinearFunction:
+      return std::make_shared<math::PiecewiseLinearFunction>(x, y);
+    default:
+      return nullptr;
+  }
+}
+
+//==============================================================================
+template <std::size_t Dimension>
+static bool writeCustomJoint(
+    proto::SkeletonSnapshotJoint* proto, dynamics::Joint* joint)
+{
+  if (joint->getType() != dynamics::CustomJoint<Dimension>::getStaticType())
+    return false;
+  auto* custom = static_cast<dynamics::CustomJoint<Dimension>*>(joint);
+  proto->set_axis_order((int)custom->getAxisOrder());
+  writeVector(proto->mutable_flip_axis_map(), custom->getFlipAxisMap());
+  for (int i = 0; i < 6; i++)
+  {
+    writeCustomFunction(
+        proto->add_custom_function(),
+        custom->getCustomFunction(i),
+        custom->getCustomFunctionDrivenByDof(i));
+  }
+  return true;
+}
+
+//==============================================================================
+static void writeJoint(
+    proto::SkeletonSnapshotJoint* proto, dynamics::Joint* joint)
+{
+  proto->set_name(joint->getName());
+  proto->set_type(joint->getType());
+
+  // We store the unscaled translations, so that re-applying the body scales
+  // on load reproduces the current transforms exactly
+  const dynamics::Joint::Properties& props = joint->getJointProperties();
+  Eigen::Isometry3s fromParent = props.mT_ParentBodyToJoint;
+  fromParent.translation() = props.mOriginalParentTranslation;
+  Eigen::Isometry3s fromChild = props.mT_ChildBodyToJoint;
+  fromChild.translation() = props.mOriginalChildTranslation;
+  writeTransform(proto->mutable_transform_from_parent(), fromParent);
+  writeTransform(proto->mutable_transform_from_child(), fromChild);
+  proto->set_actuator_type((int)joint->getActuatorType());
+  proto->set_position_limit_enforced(joint->isPositionLimitEnforced());
+
+  for (int i = 0; i < joint->getNumDofs(); i++)
+  {
+    const dynamics::DegreeOfFreedom* dof = joint->getDof(i);
+    proto::SkeletonSnapshotDof* dofProto = proto->add_dof();
+    dofProto->set_name(dof->getName());
+    dofProto->set_position((double)dof->getPosition());
+    dofProto->set_velocity((double)dof->getVelocity());
+    dofProto->set_initial_position((double)dof->getInitialPosition());
+    dofProto->set_initial_velocity((double)dof->getInitialVelocity());
+    dofProto->set_position_lower_limit((double)dof->getPositionLowerLimit());
+    dofProto->set_position_upper_limit((double)dof->getPositionUpperLimit());
+    dofProto->set_velocity_lower_limit((double)dof->getVelocityLowerLimit());
+    dofProto->set_velocity_upper_limit((double)dof->getVelocityUpperLimit());
+    dofProto->set_acceleration_lower_limit(
+        (double)dof->getAccelerationLowerLimit());
+    dofProto->set_acceleration_upper_limit(
+        (double)dof->getAccelerationUpperLimit());
+    dofProto->set_control_force_lower_limit(
+        (double)dof->getControlForceLowerLimit());
+    dofProto->set_control_force_upper_limit(
+        (double)dof->getControlForceUpperLimit());
+    dofProto->set_spring_stiffness((double)dof->getSpringStiffness());
+    dofProto->set_rest_position((double)dof->getRestPosition());
+    dofProto->set_damping_coefficient((double)dof->getDampingCoefficient());
+    dofProto->set_coulomb_friction((double)dof->getCoulombFriction());
+  }
+
+  const std::string& type = joint->getType();
+  if (type == dynamics::WeldJoint::getStaticType()
+      || type == dynamics::FreeJoint::getStaticType()
+      || type == dynamics::BallJoint::getStaticType()
+      || type == dynamics::TranslationalJoint::getStaticType())
+  {
+    // These have no parameters beyond their DOFs
+  }
+  else if (type == dynamics::EulerJoint::getStaticType())
+  {
+    auto* euler = static_cast<dynamics::EulerJoint*>(joint);
+    proto->set_axis_order((int)euler->getAxisOrder());
+    writeVector(proto->mutable_flip_axis_map(), euler->getFlipAxisMap());
+  }
+  else if (type == dynamics::EulerFreeJoint::getStaticType())
+  {
+    auto* eulerFree = static_cast<dynamics::EulerFreeJoint*>(joint);
+    proto->set_axis_order((int)eulerFree->getAxisOrder());
+    writeVector(proto->mutable_flip_axis_map(), eulerFree->getFlipAxisMap());
+  }
+  else if (type == dynamics::EllipsoidJoint::getStaticType())
+  {
+    auto* ellipsoid = static_cast<dynamics::EllipsoidJoint*>(joint);
+    proto->set_axis_order((int)ellipsoid->getAxisOrder());
+    writeVector(proto->mutable_flip_axis_map(), ellipsoid->getFlipAxisMap());
+    writeVector(
+        proto->mutable_ellipsoid_radii(), ellipsoid->getEllipsoidRadii());
+  }
+  else if (type == dynamics::ScapulathoracicJoint::getStaticType())
+  {
+    auto* scapula = static_cast<dynamics::ScapulathoracicJoint*>(joint);
+    proto->set_axis_order((int)scapula->getAxisOrder());
+    writeVector(proto->mutable_flip_axis_map(), scapula->getFlipAxisMap());
+    writeVector(proto->mutable_ellipsoid_radii(), scapula->getEllipsoidRadii());
+    writeVector(
+        proto->mutable_winging_axis_offset(), scapula->getWingingAxisOffset());
+    proto->set_winging_axis_direction(
+        (double)scapula->getWingingAxisDirection());
+  }
+  else if (type == dynamics::ConstantCurveIncompressibleJoint::getStaticType())
+  {
+    auto* curve
+        = static_cast<dynamics::ConstantCurveIncompressibleJoint*>(joint);
+    writeVector(proto->mutable_flip_axis_map(), curve->getFlipAxisMap());
+    writeVector(proto->mutable_neutral_pos(), curve->getNeutralPos());
+    proto->set_length((double)curve->getLength());
+  }
+  else if (type == dynamics::RevoluteJoint::getStaticType())
+  {
+    writeVector(
+        proto->mutable_axis(),
+        static_cast<dynamics::RevoluteJoint*>(joint)->getAxis());
+  }
+  else if (type == dynamics::PrismaticJoint::getStaticType())
+  {
+    writeVector(
+        proto->mutable_axis(),
+        static_cast<dynamics::PrismaticJoint*>(joint)->getAxis());
+  }
+  else if (type == dynamics::ScrewJoint::getStaticType())
+  {
+    auto* screw = static_cast<dynamics::ScrewJoint*>(joint);
+    writeVector(proto->mutable_axis(), screw->getAxis());
+    proto->set_pitch((double)screw->getPitch());
+  }
+  else if (type == dynamics::UniversalJoint::getStaticType())
+  {
+    auto* universal = static_cast<dynamics::UniversalJoint*>(joint);
+    writeVector(proto->mutable_axis(), universal->getAxis1());
+    writeVector(proto->mutable_axis2(), universal->getAxis2());
+  }
+  else if (
+      !writeCustomJoint<1>(proto, joint) && !writeCustomJoint<2>(proto, joint)
+      && !writeCustomJoint<3>(proto, joint)
+      && !writeCustomJoint<4>(proto, joint)
+      && !writeCustomJoint<5>(proto, joint)
+      && !writeCustomJoint<6>(proto, joint))
+  {
+    NIMBLE_THROW(
+        "SkeletonSnapshot doesn't support joint type \"" + type
+        + "\", on joint \"" + joint->getName() + "\".");
+  }
+}
+
+//==============================================================================
+template <typename JointType>
+static std::pair<JointType*, dynamics::BodyNode*> createJointAndBody(
+    dynamics::SkeletonPtr skel,
+    dynamics::BodyNode* parentBody,
+    const dynamics::BodyNode::Properties& bodyProps)
+{
+  typename JointType::Properties props;
+  if (parentBody == nullptr)
+  {
+    return skel->createJointAndBodyNodePair<JointType>(
+        nullptr, props, bodyProps);
+  }
+  return parentBody->createChildJointAndBodyNodePair<JointType>(
+      props, bodyProps);
+}
+
+//==============================================================================
+template <std::size_t Dimension>
+static bool readCustomJoint(
+    std::pair<dynamics::Joint*, dynamics::BodyNode*>& pair,
+    dynamics::SkeletonPtr skel,
+    dynamics::BodyNode* parentBody,
+    const dynamics::BodyNode::Properties& bodyProps,
+    const proto::SkeletonSnapshotJoint& proto)
+{
+  if (proto.type() != dynamics::CustomJoint<Dimension>::getStaticType())
+    return false;
+  auto created = createJointAndBody<dynamics::CustomJoint<Dimension>>(
+      skel, parentBody, bodyProps);
+  created.first->setAxisOrder(
+      (dynamics::EulerJoint::AxisOrder)proto.axis_order());
+  created.first->setFlipAxisMap(readVector(proto.flip_axis_map()));
+  for (int i = 0; i < proto.custom_function_size(); i++)
+  {
+    created.first->setCustomFunction(
+        i,
+        readCustomFunction(proto.custom_function(i)),
+        proto.custom_function(i).driven_by_dof());
+  }
+  pair = created;
+  return true;
+}
+
+//==============================================================================
+/// This creates the joint and body, and sets the joint's type-specific
+/// parameters. Returns a pair of nullptrs if the joint type isn't supported.
+static std::pair<dynamics::Joint*, dynamics::BodyNode*> readJointAndBody(
+    dynamics::SkeletonPtr skel,
+    dynamics::BodyNode* parentBody,
+    const dynamics::BodyNode::Properties& bodyProps,
+    const proto::SkeletonSnapshotJoint& proto)
+{
+  std::pair<dynamics::Joint*, dynamics::BodyNode*> pair(nullptr, nullptr);
+  const std::string& type = proto.type();
+  if (type == dynamics::WeldJoint::getStaticType())
+  {
+    pair = createJointAndBody<dynamics::WeldJoint>(skel, parentBody, bodyProps);
+  }
+  else if (type == dynamics::FreeJoint::getStaticType())
+  {
+    pair = createJointAndBody<dynamics::FreeJoint>(skel, parentBody, bodyProps);
+  }
+  else if (type == dynamics::BallJoint::getStaticType())
+  {
+    pair = createJointAndBody<dynamics::BallJoint>(skel, parentBody, bodyProps);
+  }
+  else if (type == dynamics::TranslationalJoint::getStaticType())
+  {
+    pair = createJointAndBody<dynamics::TranslationalJoint>(
+        skel, parentBody, bodyProps);
+  }
+  else if (type == dynamics::EulerJoint::getStaticType())
+  {
+    auto created = createJointAndBody<dynamics::EulerJoint>(
+        skel, parentBody, bodyProps);
+    created.first->setAxisOrder(
+        (dynamics::EulerJoint::AxisOrder)proto.axis_order());
+    created.first->setFlipAxisMap(readVector(proto.flip_axis_map()));
+    pair = created;
+  }
+  else if (type == dynamics::EulerFreeJoint::getStaticType())
+  {
+    auto created = createJointAndBody<dynamics::EulerFreeJoint>(
+        skel, parentBody, bodyProps);
+    created.first->setAxisOrder(
+        (dynamics::EulerJoint::AxisOrder)proto.axis_order());
+    created.first->setFlipAxisMap(readVector(proto.flip_axis_map()));
+    pair = created;
+  }
+  else if (type == dynamics::EllipsoidJoint::getStaticType())
+  {
+    auto created = createJointAndBody<dynamics::EllipsoidJoint>(
+        skel, parentBody, bodyProps);
+    created.first->setAxisOrder(
+        (dynamics::EulerJoint::AxisOrder)proto.axis_order());
+    created.first->setFlipAxisMap(readVector(proto.flip_axis_map()));
+    created.first->setEllipsoidRadii(readVector(proto.ellipsoid_radii()));
+    pair = created;
+  }
+  else if (type == dynamics::ScapulathoracicJoint::getStaticType())
+  {
+    auto created = createJointAndBody<dynamics::ScapulathoracicJoint>(
+        skel, parentBody, bodyProps);
+    created.first->setAxisOrder(
+        (dynamics::EulerJoint::AxisOrder)proto.axis_order());
+    created.first->setFlipAxisMap(readVector(proto.flip_axis_map()));
+    created.first->setEllipsoidRadii(readVector(proto.ellipsoid_radii()));
+    created.first->setWingingAxisOffset(
+        readVector(proto.winging_axis_offset()));
+    created.first->setWingingAxisDirection(proto.winging_axis_direction());
+    pair = created;
+  }
+  else if (type == dynamics::ConstantCurveIncompressibleJoint::getStaticType())
+  {
+    auto created
+        = createJointAndBody<dynamics::ConstantCurveIncompressibleJoint>(
+            skel, parentBody, bodyProps);
+    created.first->setFlipAxisMap(readVector(proto.flip_axis_map()));
+    created.first->setNeutralPos(readVector(proto.neutral_pos()));
+    created.first->setLength(proto.length());
+    pair = created;
+  }
+  else if (type == dynamics::RevoluteJoint::getStaticType())
+  {
+    auto created = createJointAndBody<dynamics::RevoluteJoint>(
+        skel, parentBody, bodyProps);
+    created.first->setAxis(readVector(proto.axis()));
+    pair = created;
+  }
+  else if (type == dynamics::PrismaticJoint::getStaticType())
+  {
+    auto created = createJointAndBody<dynamics::PrismaticJoint>(
+        skel, parentBody, bodyProps);
+    created.first->setAxis(readVector(proto.axis()));
+    pair = created;
+  }
+  else if (type == dynamics::ScrewJoint::getStaticType())
+  {
+    auto created = createJointAndBody<dynamics::ScrewJoint>(
+        skel, parentBody, bodyProps);
+    created.first->setAxis(readVector(proto.axis()));
+    created.first->setPitch(proto.pitch());
+    pair = created;
+  }
+  else if (type == dynamics::UniversalJoint::getStaticType())
+  {
+    auto created = createJointAndBody<dynamics::UniversalJoint>(
+        skel, parentBody, bodyProps);
+    created.first->setAxis1(readVector(proto.axis()));
+    created.first->setAxis2(readVector(proto.axis2()));
+    pair = created;
+  }
+  else
+  {
+    readCustomJoint<1>(pair, skel, parentBody, bodyProps, proto)
+        || readCustomJoint<2>(pair, skel, parentBody, bodyProps, proto)
+        || readCustomJoint<3>(pair, skel, parentBody, bodyProps, proto)
+        || readCustomJoint<4>(pair, skel, parentBody, bodyProps, proto)
+        || readCustomJoint<5>(pair, skel, parentBody, bodyProps, proto)
+        || readCustomJoint<6>(pair, skel, parentBody, bodyProps, proto);
+  }
+  if (pair.first == nullptr)
+    return pair;
+
+  dynamics::Joint* joint = pair.first;
+  joint->setName(proto.name());
+  joint->setTransformFromParentBodyNode(
+      readTransform(proto.transform_from_parent()));
+  joint->setTransformFromChildBodyNode(
+      readTransform(proto.transform_from_child()));
+  joint->setActuatorType((dynamics::Joint::ActuatorType)proto.actuator_type());
+  joint->setPositionLimitEnforced(proto.position_limit_enforced());
+
+  // Setting the axis order above renames the DOFs, so we do this after
+  for (int i = 0; i < proto.dof_size() && i < joint->getNumDofs(); i++)
+  {
+    const proto::SkeletonSnapshotDof& dofProto = proto.dof(i);
+    dynamics::DegreeOfFreedom* dof = joint->getDof(i);
+    dof->setName(dofProto.name());
+    dof->setPositionLimits(
+        dofProto.position_lower_limit(), dofProto.position_upper_limit());
+    dof->setVelocityLimits(
+        dofProto.velocity_lower_limit(), dofProto.velocity_upper_limit());
+    dof->setAccelerationLimits(
+        dofProto.acceleration_lower_limit(),
+        dofProto.acceleration_upper_limit());
+    dof->setControlForceLimits(
+        dofProto.control_force_lower_limit(),
+        dofProto.control_force_upper_limit());
+    dof->setPosition(dofProto.position());
+    dof->setVelocity(dofProto.velocity());
+    dof->setInitialPosition(dofProto.initial_position());
+    dof->setInitialVelocity(dofProto.initial_velocity());
+    dof->setSpringStiffness(dofProto.spring_stiffness());
+    dof->setRestPosition(dofProto.rest_position());
+    dof->setDampingCoefficient(dofProto.damping_coefficient());
+    dof->setCoulombFriction(dofProto.coulomb_friction());
+  }
+  return pair;
+}
+
+//==============================================================================
+static void writeShape(
+    proto::SkeletonSnapshotShape* proto, const dynamics::ShapeNode* shapeNode)
+{
+  writeTransform(
+      proto->mutable_relative_transform(), shapeNode->getRelativeTransform());
+
+  const dynamics::Shape* shape = shapeNode->getShape().get();
+  const std::string& type = shape->getType();
+  if (type == dynamics::MeshShape::getStaticType())
+  {
+    auto* mesh = static_cast<const dynamics::MeshShape*>(shape);
+    proto->set_type(proto::meshShape);
+    proto->set_mesh_uri(mesh->getMeshUri());
+    writeVector(proto->mutable_size(), mesh->getScale());
+  }
+  else if (type == dynamics::BoxShape::getStaticType())
+  {
+    proto->set_type(proto::boxShape);
+    writeVector(
+        proto->mutable_size(),
+        static_cast<const dynamics::BoxShape*>(shape)->getSize());
+  }
+  else if (type == dynamics::SphereShape::getStaticType())
+  {
+    proto->set_type(proto::sphereShape);
+    proto->set_radius(
+        (double)static_cast<const dynamics::SphereShape*>(shape)->getRadius());
+  }
+  else if (type == dynamics::CapsuleShape::getStaticType())
+  {
+    auto* capsule = static_cast<const dynamics::CapsuleShape*>(shape);
+    proto->set_type(proto::capsuleShape);
+    proto->set_radius((double)capsule->getRadius());
+    proto->set_height((double)capsule->getHeight());
+  }
+  else if (type == dynamics::CylinderShape::getStaticType())
+  {
+    auto* cylinder = static_cast<const dynamics::CylinderShape*>(shape);
+    proto->set_type(proto::cylinderShape);
+    proto->set_radius((double)cylinder->getRadius());
+    proto->set_height((double)cylinder->getHeight());
+  }
+  else if (type == dynamics::EllipsoidShape::getStaticType())
+  {
+    proto->set_type(proto::ellipsoidShape);
+    writeVector(
+        proto->mutable_size(),
+        static_cast<const dynamics::EllipsoidShape*>(shape)->getDiameters());
+  }
+  else
+  {
+    NIMBLE_THROW(
+        "SkeletonSnapshot doesn't support shape type \"" + type
+        + "\", on shape node \"" + shapeNode->getName() + "\".");
+  }
+
+  const dynamics::VisualAspect* visual = shapeNode->getVisualAspect();
+  proto->set_has_visual(visual != nullptr);
+  if (visual != nullptr)
+  {
+    writeVector(proto->mutable_color(), visual->getRGBA());
+    proto->set_hidden(visual->isHidden());
+  }
+  proto->set_has_collision(shapeNode->getCollisionAspect() != nullptr);
+  const dynamics::DynamicsAspect* dynamicsAspect
+      = shapeNode->getDynamicsAspect();
+  proto->set_has_dynamics(dynamicsAspect != nullptr);
+  if (dynamicsAspect != nullptr)
+  {
+    proto->set_friction_coeff((double)dynamicsAspect->getFrictionCoeff());
+    proto->set_restitution_coeff((double)dynamicsAspect->getRestitutionCoeff());
+  }
+}
+
+//==============================================================================
+static void readShape(
+    dynamics::BodyNode* body,
+    const proto::SkeletonSnapshotShape& proto,
+    const common::ResourceRetrieverPtr& geometryRetriever)
+{
+  dynamics::ShapePtr shape = nullptr;
+  switch (proto.type())
+  {
+    case proto::meshShape: {
+      std::shared_ptr<dynamics::SharedMeshWrapper> meshPtr
+          = dynamics::MeshShape::loadMesh(proto.mesh_uri(), geometryRetriever);
+      // The parsers skip meshes that fail to load, so we do too
+      if (meshPtr)
+      {
+        shape = std::make_shared<dynamics::MeshShape>(
+            readVector(proto.size()),
+            meshPtr,
+            common::Uri(proto.mesh_uri()),
+            geometryRetriever);
+      }
+      break;
+    }
+    case proto::boxShape:
+      shape = std::make_shared<dynamics::BoxShape>(readVector(proto.size()));
+      break;
+    case proto::sphereShape:
+      shape = std::make_shared<dynamics::SphereShape>(proto.radius());
+      break;
+    case proto::capsuleShape:
+      shape = std::make_shared<dynamics::CapsuleShape>(
+          proto.radius(), proto.height());
+      break;
+    case proto::cylinderShape:
+      shape = std::make_shared<dynamics::CylinderShape>(
+          proto.radius(), proto.height());
+      break;
+    case proto::ellipsoidShape:
+      shape = std::make_shared<dynamics::EllipsoidShape>(
+          readVector(proto.size()));
+      break;
+    default:
+      break;
+  }
+  if (shape == nullptr)
+    return;
+
+  dynamics::ShapeNode* shapeNode = body->createShapeNode(shape);
+  shapeNode->setRelativeTransform(readTransform(proto.relative_transform()));
+  if (proto.has_visual())
+  {
+    dynamics::VisualAspect* visual = shapeNode->createVisualAspect();
+    visual->setRGBA(readVector(proto.color()));
+    visual->setHidden(proto.hidden());
+  }
+  if (proto.has_collision())
+  {
+    shapeNode->createCollisionAspect();
+  }
+  if (proto.has_dynamics())
+  {
+    dynamics::DynamicsAspect* dynamicsAspect
+        = shapeNode->createDynamicsAspect();
+    dynamicsAspect->setFrictionCoeff(proto.friction_coeff());
+    dynamicsAspect->setRestitutionCoeff(proto.restitution_coeff());
+  }
+}
+
+//==============================================================================
+static void writeSkeletonProto(
+    proto::SkeletonSnapshot* proto, std::shared_ptr<dynamics::Skeleton> skel)
+{
+  proto->set_version(SKELETON_SNAPSHOT_VERSION);
+  proto->set_name(skel->getName());
+  proto->set_self_collision_check(skel->isEnabledSelfCollisionCheck());
+  proto->set_adjacent_body_check(skel->isEnabledAdjacentBodyCheck());
+
+  for (int i = 0; i < skel->getNumBodyNodes(); i++)
+  {
+    dynamics::BodyNode* body = skel->getBodyNode(i);
+    proto::SkeletonSnapshotBody* bodyProto = proto->add_body();
+    bodyProto->set_name(body->getName());
+    dynamics::BodyNode* parent = body->getParentBodyNode();
+    bodyProto->set_parent_index(
+        parent == nullptr ? -1 : (int)parent->getIndexInSkeleton());
+    writeJoint(bodyProto->mutable_parent_joint(), body->getParentJoint());
+
+    const dynamics::Inertia& inertia = body->getInertia();
+    bodyProto->set_mass((double)inertia.getMass());
+    writeVector(bodyProto->mutable_local_com(), inertia.getLocalCOM());
+    writeVector(
+        bodyProto->mutable_moment_of_inertia(), inertia.getMomentVector());
+    bodyProto->set_mass_lower_bound((double)inertia.getMassLowerBound());
+    bodyProto->set_mass_upper_bound((double)inertia.getMassUpperBound());
+    writeVector(
+        bodyProto->mutable_local_com_lower_bound(),
+        inertia.getLocalCOMLowerBound());
+    writeVector(
+        bodyProto->mutable_local_com_upper_bound(),
+        inertia.getLocalCOMUpperBound());
+    writeVector(
+        bodyProto->mutable_moment_of_inertia_lower_bound(),
+        inertia.getMomentLowerBound());
+    writeVector(
+        bodyProto->mutable_moment_of_inertia_upper_bound(),
+        inertia.getMomentUpperBound());
+
+    writeVector(bodyProto->mutable_scale(), body->getScale());
+    writeVector(
+        bodyProto->mutable_scale_lower_bound(), body->getScaleLowerBound());
+    writeVector(
+        bodyProto->mutable_scale_upper_bound(), body->getScaleUpperBound());
+    bodyProto->set_gravity_mode(body->getGravityMode());
+    bodyProto->set_collidable(body->isCollidable());
+    bodyProto->set_friction_coeff((double)body->getFrictionCoeff());
+    bodyProto->set_restitution_coeff((double)body->getRestitutionCoeff());
+
+    for (const dynamics::ShapeNode* shapeNode :
+         const_cast<const dynamics::BodyNode*>(body)->getShapeNodes())
+    {
+      writeShape(bodyProto->add_shape(), shapeNode);
+    }
+  }
+
+  for (const dynamics::BodyScaleGroup& group : skel->getBodyScaleGroups())
+  {
+    proto::SkeletonSnapshotScaleGroup* groupProto = proto->add_scale_group();
+    groupProto->set_uniform_scaling(group.uniformScaling);
+    for (int i = 0; i < group.nodes.size(); i++)
+    {
+      groupProto->add_body_index(group.nodes[i]->getIndexInSkeleton());
+      writeVector(groupProto->mutable_flip_axis(), group.flipAxis[i]);
+    }
+  }
+}
+
+//==============================================================================
+static std::shared_ptr<dynamics::Skeleton> readSkeletonProto(
+    const proto::SkeletonSnapshot& proto,
+    const common::ResourceRetrieverPtr& geometryRetriever)
+{
+  dynamics::SkeletonPtr skel = dynamics::Skeleton::create(proto.name());
+
+  // 1. Build the tree with every body at unit scale
+  for (int i = 0; i < proto.body_size(); i++)
+  {
+    const proto::SkeletonSnapshotBody& bodyProto = proto.body(i);
+    dynamics::BodyNode::Properties bodyProps;
+    bodyProps.mName = bodyProto.name();
+    bodyProps.mInertia = dynamics::Inertia(
+        bodyProto.mass(),
+        readVector(bodyProto.local_com()),
+        Eigen::Matrix3s::Identity());
+    bodyProps.mInertia.setMomentVector(
+        readVector(bodyProto.moment_of_inertia()));
+    bodyProps.mInertia.setMassLowerBound(bodyProto.mass_lower_bound());
+    bodyProps.mInertia.setMassUpperBound(bodyProto.mass_upper_bound());
+    bodyProps.mInertia.setLocalCOMLowerBound(
+        readVector(bodyProto.local_com_lower_bound()));
+    bodyProps.mInertia.setLocalCOMUpperBound(
+        readVector(bodyProto.local_com_upper_bound()));
+    bodyProps.mInertia.setMomentLowerBound(
+        readVector(bodyProto.moment_of_inertia_lower_bound()));
+    bodyProps.mInertia.setMomentUpperBound(
+        readVector(bodyProto.moment_of_inertia_upper_bound()));
+    bodyProps.mGravityMode = bodyProto.gravity_mode();
+    bodyProps.mIsCollidable = bodyProto.collidable();
+    bodyProps.mFrictionCoeff = bodyProto.friction_coeff();
+    bodyProps.mRestitutionCoeff = bodyProto.restitution_coeff();
+
+    dynamics::BodyNode* parentBody = nullptr;
+    if (bodyProto.parent_index() >= 0)
+    {
+      if (bodyProto.parent_index() >= i)
+      {
+        dterr << "SkeletonSnapshot body \"" << bodyProto.name()
+              << "\" comes before its parent.\n";
+        return nullptr;
+      }
+      parentBody = skel->getBodyNode(bodyProto.parent_index());
+    }
+    std::pair<dynamics::Joint*, dynamics::BodyNode*> pair = readJointAndBody(
+        skel, parentBody, bodyProps, bodyProto.parent_joint());
+    if (pair.first == nullptr)
+    {
+      dterr << "SkeletonSnapshot doesn't support joint type \""
+            << bodyProto.parent_joint().type() << "\".\n";
+      return nullptr;
+    }
+  }
+
+  // 2. Apply the scales, which rescales the joint offsets exactly the way they
+  // were scaled when the snapshot was written
+  for (int i = 0; i < proto.body_size(); i++)
+  {
+    const proto::SkeletonSnapshotBody& bodyProto = proto.body(i);
+    dynamics::BodyNode* body = skel->getBodyNode(i);
+    Eigen::Vector3s scale = readVector(bodyProto.scale());
+    // The scale may be outside the bounds, if they were changed after it was
+    // set, so we set it with the bounds out of the way
+    body->setScaleLowerBound(scale);
+    body->setScaleUpperBound(scale);
+    body->setScale(scale);
+    body->setScaleLowerBound(readVector(bodyProto.scale_lower_bound()));
+    body->setScaleUpperBound(readVector(bodyProto.scale_upper_bound()));
+  }
+
+  // 3. Attach the shapes, which were stored at their current scale
+  for (int i = 0; i < proto.body_size(); i++)
+  {
+    const proto::SkeletonSnapshotBody& bodyProto = proto.body(i);
+    for (int j = 0; j < bodyProto.shape_size(); j++)
+    {
+      readShape(skel->getBodyNode(i), bodyProto.shape(j), geometryRetriever);
+    }
+  }
+
+  if (proto.scale_group_size() > 0)
+  {
+    std::vector<dynamics::BodyScaleGroup> groups;
+    for (const proto::SkeletonSnapshotScaleGroup& groupProto :
+         proto.scale_group())
+    {
+      groups.emplace_back();
+      dynamics::BodyScaleGroup& group = groups.back();
+      group.uniformScaling = groupProto.uniform_scaling();
+      Eigen::VectorXs flips = readVector(groupProto.flip_axis());
+      for (int i = 0; i < groupProto.body_index_size(); i++)
+      {
+        group.nodes.push_back(skel->getBodyNode(groupProto.body_index(i)));
+        group.flipAxis.push_back(flips.segment<3>(i * 3));
+      }
+    }
+    skel->setBodyScaleGroups(groups);
+  }
+
+  skel->setSelfCollisionCheck(proto.self_collision_check());
+  skel->setAdjacentBodyCheck(proto.adjacent_body_check());
+  return skel;
+}
+
+//==============================================================================
+static void writeSnapshotFile(
+    const std::string& path, const google::protobuf::Message& message)
+{
+  std::string serialized;
+  message.SerializeToString(&serialized);
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file.is_open())
+  {
+    NIMBLE_THROW("SkeletonSnapshot unable to open \"" + path + "\" to write.");
+  }
+  file.write(serialized.data(), serialized.size());
+}
+
+//==============================================================================
+static bool readSnapshotFile(
+    const std::string& path, google::protobuf::Message& message)
+{
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file.is_open())
+  {
+    dterr << "SkeletonSnapshot unable to open \"" << path << "\" to read.\n";
+    return false;
+  }
+  std::vector<char> buffer(file.tellg());
+  file.seekg(0);
+  file.read(buffer.data(), buffer.size());
+  if (!file || !message.ParseFromArray(buffer.data(), buffer.size()))
+  {
+    dterr << "SkeletonSnapshot got an error parsing \"" << path << "\".\n";
+    return false;
+  }
+  return true;
+}
+
+//==============================================================================
+static common::ResourceRetrieverPtr ensureGeometryRetriever(
+    const common::ResourceRetrieverPtr& retriever)
+{
+  if (retriever)
+    return retriever;
+  auto newRetriever = std::make_shared<utils::CompositeResourceRetriever>();
+  newRetriever->addSchemaRetriever(
+      "file", std::make_shared<common::LocalResourceRetriever>());
+  newRetriever->addSchemaRetriever(
+      "dart", utils::DartResourceRetriever::create());
+  return newRetriever;
+}
+
+//==============================================================================
+/// This writes a skeleton out to `path` in the snapshot format.
+void SkeletonSnapshot::writeSkeleton(
+    const std::string& path, std::shared_ptr<dynamics::Skeleton> skel)
+{
+  proto::SkeletonSnapshot proto;
+  writeSkeletonProto(&proto, skel);
+  writeSnapshotFile(path, proto);
+}
+
+//==============================================================================
+/// This reads a skeleton written by writeSkeleton().
+std::shared_ptr<dynamics::Skeleton> SkeletonSnapshot::readSkeleton(
+    const std::string& path,
+    const common::ResourceRetrieverPtr& geometryRetriever)
+{
+  proto::SkeletonSnapshot proto;
+  if (!readSnapshotFile(path, proto))
+    return nullptr;
+  if (proto.version() != SKELETON_SNAPSHOT_VERSION)
+  {
+    dterr << "SkeletonSnapshot \"" << path << "\" has version "
+          << proto.version() << ", but we can only read version "
+          << SKELETON_SNAPSHOT_VERSION << ".\n";
+    return nullptr;
+  }
+  return readSkeletonProto(proto, ensureGeometryRetriever(geometryRetriever));
+}
+
+//==============================================================================
+/// This writes a parsed OpenSim file out to `path` in the snapshot format.
+void SkeletonSnapshot::writeOpenSimFile(
+    const std::string& path, const OpenSimFile& file)
+{
+  proto::OpenSimFileSnapshot proto;
+  writeSkeletonProto(proto.mutable_skeleton(), file.skeleton);
+  for (auto& pair : file.markersMap)
+  {
+    proto::SkeletonSnapshotMarker* marker = proto.add_marker();
+    marker->set_name(pair.first);
+    marker->set_body_index(pair.second.first->getIndexInSkeleton());
+    writeVector(marker->mutable_offset(), pair.second.second);
+  }
+  for (const std::string& name : file.anatomicalMarkers)
+    proto.add_anatomical_marker(name);
+  for (const std::string& name : file.trackingMarkers)
+    proto.add_tracking_marker(name);
+  for (auto& pair : file.imuMap)
+  {
+    proto::SkeletonSnapshotIMU* imu = proto.add_imu();
+    imu->set_name(pair.first);
+    imu->set_body_name(pair.second.first);
+    writeTransform(imu->mutable_transform(), pair.second.second);
+  }
+  for (const std::string& warning : file.warnings)
+    proto.add_warning(warning);
+  for (const std::string& body : file.ignoredBodies)
+    proto.add_ignored_body(body);
+  for (auto& pair : file.jointsDrivenBy)
+  {
+    proto.add_joint_driven_by(pair.first);
+    proto.add_joint_driven_by(pair.second);
+  }
+  writeSnapshotFile(path, proto);
+}
+
+//==============================================================================
+/// This reads a file written by writeOpenSimFile().
+OpenSimFile SkeletonSnapshot::readOpenSimFile(
+    const std::string& path,
+    const common::ResourceRetrieverPtr& geometryRetriever)
+{
+  OpenSimFile file;
+  file.skeleton = nullptr;
+
+  proto::OpenSimFileSnapshot proto;
+  if (!readSnapshotFile(path, proto))
+    return file;
+  if (proto.skeleton().version() != SKELETON_SNAPSHOT_VERSION)
+  {
+    dterr << "SkeletonSnapshot \"" << path << "\" has version "
+          << proto.skeleton().version() << ", but we can only read version "
+          << SKELETON_SNAPSHOT_VERSION << ".\n";
+    return file;
+  }
+  dynamics::SkeletonPtr skel = readSkeletonProto(
+      proto.skeleton(), ensureGeometryRetriever(geometryRetriever));
+  if (skel == nullptr)
+    return file;
+
+  for (const proto::SkeletonSnapshotMarker& marker : proto.marker())
+  {
+    file.markersMap[marker.name()] = std::make_pair(
+        skel->getBodyNode(marker.body_index()),
+        (Eigen::Vector3s)readVector(marker.offset()));
+  }
+  file.anatomicalMarkers.assign(
+      proto.anatomical_marker().begin(), proto.anatomical_marker().end());
+  file.trackingMarkers.assign(
+      proto.tracking_marker().begin(), proto.tracking_marker().end());
+  for (const proto::SkeletonSnapshotIMU& imu : proto.imu())
+  {
+    file.imuMap[imu.name()]
+        = std::make_pair(imu.body_name(), readTransform(imu.transform()));
+  }
+  file.warnings.assign(proto.warning().begin(), proto.warning().end());
+  file.ignoredBodies.assign(
+      proto.ignored_body().begin(), proto.ignored_body().end());
+  for (int i = 0; i + 1 < proto.joint_driven_by_size(); i += 2)
+  {
+    file.jointsDrivenBy.emplace_back(
+        proto.joint_driven_by(i), proto.joint_driven_by(i + 1));
+  }
+  file.skeleton = skel;
+  return file;
+}
+
+} // namespace biomechanics
+} // namespace dart
@@ -0,0 +1,60 @@
+#ifndef BIOMECH_SKELETON_SNAPSHOT
+#define BIOMECH_SKELETON_SNAPSHOT
+
+#include <memory>
+#include <string>
+
+#include "dart/biomechanics/OpenSimParser.hpp"
+#include "dart/common/ResourceRetriever.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+
+namespace dart {
+namespace biomechanics {
+
+/**
+ * This is a precompiled binary format for skeletons, so that pipelines which
+ * load the same model over and over don't pay to parse the XML, set up the
+ * CustomJoint splines, and walk the marker set every time. A snapshot is a
+ * single protobuf message, read with one large read and parsed from one
+ * buffer.
+ *
+ * A snapshot records the topology, every joint's type and parameters
+ * (including CustomJoint functions), DOF limits and state, inertias and their
+ * bounds, body scales and scale bounds, scale groups, and shapes. Meshes are
+ * stored by URI and reloaded through dynamics::MeshShape::loadMesh(), which
+ * shares identical meshes across loads. The OpenSimFile variants also record
+ * the marker set, IMUs, and the parser's warnings.
+ *
+ * Only the joint, shape and CustomFunction types that our parsers produce are
+ * supported. Writing a skeleton that uses anything else throws.
+ */
+class SkeletonSnapshot
+{
+public:
+  /// This writes a skeleton out to `path` in the snapshot format.
+  static void writeSkeleton(
+      const std::string& path, std::shared_ptr<dynamics::Skeleton> skel);
+
+  /// This reads a skeleton written by writeSkeleton(). Meshes are loaded with
+  /// `geometryRetriever`, or with a retriever for "file://" and "dart://" URIs
+  /// if that's null. On failure, this prints an error and returns nullptr.
+  static std::shared_ptr<dynamics::Skeleton> readSkeleton(
+      const std::string& path,
+      const common::ResourceRetrieverPtr& geometryRetriever = nullptr);
+
+  /// This writes a parsed OpenSim file out to `path` in the snapshot format,
+  /// so that readOpenSimFile() can stand in for OpenSimParser::parseOsim().
+  static void writeOpenSimFile(const std::string& path, const OpenSimFile& file);
+
+  /// This reads a file written by writeOpenSimFile(). On failure, this prints
+  /// an error and returns a file with a null skeleton, like
+  /// OpenSimParser::parseOsim().
+  static OpenSimFile readOpenSimFile(
+      const std::string& path,
+      const common::ResourceRetrieverPtr& geometryRetriever = nullptr);
+};
+
+} // namespace biomechanics
+} // namespace dart
+
+#endif
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/common/Sha256.hpp"
+
+#include <array>
+#include <cstdint>
+
+namespace dart {
+namespace common {
+
+namespace {
+
+constexpr std::array<uint32_t, 64> kRoundConstants = {
+    {0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+     0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+     0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+     0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+     0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+     0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+     0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+     0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+     0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+     0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+     0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2}};
+
+//==============================================================================
+inline uint32_t rotateRight(uint32_t x, int bits)
+{
+  return (x >> bits) | (x << (32 - bits));
+}
+
+//==============================================================================
+/// This mixes one 64 byte block into `state`
+void compressBlock(std::array<uint32_t, 8>& state, const unsigned char* block)
+{
+  std::array<uint32_t, 64> w;
+  for (int i = 0; i < 16; i++)
+  {
+    w[i] = (static_cast<uint32_t>(block[4 * i]) << 24)
+           | (static_cast<uint32_t>(block[4 * i + 1]) << 16)
+           | (static_cast<uint32_t>(block[4 * i + 2]) << 8)
+           | static_cast<uint32_t>(block[4 * i + 3]);
+  }
+  for (int i = 16; i < 64; i++)
+  {
+    const uint32_t s0 = rotateRight(w[i - 15], 7) ^ rotateRight(w[i - 15], 18)
+                        ^ (w[i - 15] >> 3);
+    const uint32_t s1 = rotateRight(w[i - 2], 17) ^ rotateRight(w[i - 2], 19)
+                        ^ (w[i - 2] >> 10);
+    w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+  }
+
+  uint32_t a = state[0];
+  uint32_t b = state[1];
+  uint32_t c = state[2];
+  uint32_t d = state[3];
+  uint32_t e = state[4];
+  uint32_t f = state[5];
+  uint32_t g = state[6];
+  uint32_t h = state[7];
+  for (int i = 0; i < 64; i++)
+  {
+    const uint32_t s1
+        = rotateRight(e, 6) ^ rotateRight(e, 11) ^ rotateRight(e, 25);
+    const uint32_t ch = (e & f) ^ (~e & g);
+    const uint32_t temp1 = h + s1 + ch + kRoundConstants[i] + w[i];
+    const uint32_t s0
+        = rotateRight(a, 2) ^ rotateRight(a, 13) ^ rotateRight(a, 22);
+    const uint32_t maj = (a & b) ^ (a & c) ^ (b & c);
+    const uint32_t temp2 = s0 + maj;
+
+    h = g;
+    g = f;
+    f = e;
+    e = d + temp1;
+    d = c;
+    c = b;
+    b = a;
+    a = temp1 + temp2;
+  }
+
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+  state[5] += f;
+  state[6] += g;
+  state[7] += h;
+}
+
+} // namespace
+
+//==============================================================================
+std::string computeSha256(const std::string& data)
+{
+  std::array<uint32_t, 8> state = {{0x6a09e667,
+                                    0xbb67ae85,
+                                    0x3c6ef372,
+                                    0xa54ff53a,
+                                    0x510e527f,
+                                    0x9b05688c,
+                                    0x1f83d9ab,
+                                    0x5be0cd19}};
+
+  const unsigned char* bytes
+      = reinterpret_cast<const unsigned char*>(data.data());
+  const std::size_t fullBlocks = data.size() / 64;
+  for (std::size_t i = 0; i < fullBlocks; i++)
+  {
+    compressBlock(state, bytes + 64 * i);
+  }
+
+  // Pad the tail with a single 1 bit, then zeros, then the message length in
+  // bits as a big-endian 64 bit integer. That can spill into a second block.
+  std::array<unsigned char, 128> tail{};
+  const std::size_t remainder = data.size() - 64 * fullBlocks;
+  for (std::size_t i = 0; i < remainder; i++)
+  {
+    tail[i] = bytes[64 * fullBlocks + i];
+  }
+  tail[remainder] = 0x80;
+  const std::size_t tailSize = remainder + 9 <= 64 ? 64 : 128;
+  const uint64_t bitLength = static_cast<uint64_t>(data.size()) * 8;
+  for (int i = 0; i < 8; i++)
+  {
+    tail[tailSize - 1 - i] = static_cast<unsigned char>(bitLength >> (8 * i));
+  }
+  for (std::size_t i = 0; i < tailSize; i += 64)
+  {
+    compressBlock(state, tail.data() + i);
+  }
+
+  static const char* hexDigits = "0123456789abcdef";
+  std::string digest;
+  digest.reserve(64);
+  for (uint32_t word : state)
+  {
+    for (int shift = 28; shift >= 0; shift -= 4)
+    {
+      digest.push_back(hexDigits[(word >> shift) & 0xf]);
+    }
+  }
+  return digest;
+}
+
+} // namespace common
+} // namespace dart
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "dart/common/WorkerPool.hpp"
+
+#include <cassert>
+
+namespace dart {
+namespace common {
+
+//==============================================================================
+WorkerPool::WorkerPool(int numWorkers)
+  : mTask(nullptr),
+    mNumTasks(0),
+    mGeneration(0),
+    mNumRemaining(0),
+    mException(nullptr),
+    mShutdown(false)
+{
+  mThreads.reserve(numWorkers);
+  for (int i = 0; i < numWorkers; i++)
+  {
+    mThreads.emplace_back(&WorkerPool::workerLoop, this, i);
+  }
+}
+
+//==============================================================================
+WorkerPool::~WorkerPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mShutdown = true;
+  }
+  mWorkReady.notify_all();
+  for (std::thread& thread : mThreads)
+  {
+    thread.join();
+  }
+}
+
+//==============================================================================
+int WorkerPool::getNumWorkers() const
+{
+  return mThreads.size();
+}
+
+//==============================================================================
+void WorkerPool::run(int numTasks, const std::function<void(int)>& task)
+{
+  assert(numTasks <= getNumWorkers());
+  if (numTasks <= 0)
+    return;
+
+  std::unique_lock<std::mutex> lock(mMutex);
+  mTask = &task;
+  mNumTasks = numTasks;
+  mNumRemaining = numTasks;
+  mException = nullptr;
+  mGeneration++;
+  mWorkReady.notify_all();
+  mWorkDone.wait(lock, [this] { return mNumRemaining == 0; });
+  mTask = nullptr;
+
+  if (mException)
+  {
+    std::exception_ptr exception = mException;
+    mException = nullptr;
+    std::rethrow_exception(exception);
+  }
+}
+
+//==============================================================================
+void WorkerPool::workerLoop(int index)
+{
+  long lastGeneration = 0;
+  std::unique_lock<std::mutex> lock(mMutex);
+  while (true)
+  {
+    mWorkReady.wait(lock, [&] {
+      return mShutdown || mGeneration != lastGeneration;
+    });
+    if (mShutdown)
+      return;
+    lastGeneration = mGeneration;
+    if (index >= mNumTasks)
+      continue;
+
+    const std::function<void(int)>* task = mTask;
+    lock.unlock();
+    std::exception_ptr exception = nullptr;
+    try
+    {
+      (*task)(index);
+    }
+    catch (...)
+    {
+      exception = std::current_exception();
+    }
+    lock.lock();
+
+    if (exception && !mException)
+      mException = exception;
+    mNumRemaining--;
+    if (mNumRemaining == 0)
+      mWorkDone.notify_one();
+  }
+}
+
+} // namespace common
+} // namespace dart
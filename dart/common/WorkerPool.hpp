@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DART_COMMON_WORKERPOOL_HPP_
+#define DART_COMMON_WORKERPOOL_HPP_
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dart {
+namespace common {
+
+/// A fixed set of threads that live as long as the pool, for callers that fan
+/// the same kind of work out over and over (for example, once per optimizer
+/// callback). This avoids paying to create and join a thread per task on every
+/// call, the way std::async does.
+///
+/// Each call to run() hands task i to worker i, so a worker always runs the
+/// same task index. That lets callers bind per-worker state (like a cloned
+/// World) to each index, and keep it warm in that thread's cache.
+class WorkerPool
+{
+public:
+  /// Starts `numWorkers` threads, which sleep until run() is called
+  explicit WorkerPool(int numWorkers);
+
+  /// Stops and joins every worker
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  /// Returns the number of worker threads
+  int getNumWorkers() const;
+
+  /// This runs task(i) on worker i, for every i in [0, numTasks), and blocks
+  /// until they've all finished. `numTasks` must be no more than
+  /// getNumWorkers(). If any task throws, the first exception is rethrown
+  /// here once every task has finished. Only one thread may call run() at a
+  /// time.
+  void run(int numTasks, const std::function<void(int)>& task);
+
+protected:
+  /// This is the loop each worker thread runs until the pool is destroyed
+  void workerLoop(int index);
+
+  std::vector<std::thread> mThreads;
+  std::mutex mMutex;
+  std::condition_variable mWorkReady;
+  std::condition_variable mWorkDone;
+
+  /// This is the task from the current call to run()
+  const std::function<void(int)>* mTask;
+  int mNumTasks;
+  /// This counts calls to run(), so workers can tell new work from old
+  long mGeneration;
+  int mNumRemaining;
+  std::exception_ptr mException;
+  bool mShutdown;
+};
+
+} // namespace common
+} // namespace dart
+
+#endif // DART_COMMON_WORKERPOOL_HPP_
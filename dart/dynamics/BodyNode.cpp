@@ -1686,6 +1686,7 @@ BodyNode* BodyNode::clone(
   clonedBn->mScale = mScale;
   clonedBn->mScaleLowerBound = mScaleLowerBound;
   clonedBn->mScaleUpperBound = mScaleUpperBound;
+  clonedBn->mBeta = mBeta;
   clonedBn->setInertia(getInertia().clone());
 
   clonedBn->matchAspects(this);
@@ -0,0 +1,427 @@
+#include "dart/dynamics/KinematicsPlan.hpp"
+
+#include <cassert>
+#include <map>
+
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/DegreeOfFreedom.hpp"
+#include "dart/dynamics/Joint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+
+namespace dart {
+namespace dynamics {
+
+//==============================================================================
+KinematicsPlan::KinematicsPlan(
+    std::shared_ptr<Skeleton> skel,
+    const std::vector<std::pair<BodyNode*, Eigen::Vector3s>>& markers,
+    const std::vector<Joint*>& joints)
+  : KinematicsPlan(skel.get(), markers, joints)
+{
+  mSkelOwner = skel;
+}
+
+//==============================================================================
+KinematicsPlan::KinematicsPlan(
+    Skeleton* skel,
+    const std::vector<std::pair<BodyNode*, Eigen::Vector3s>>& markers,
+    const std::vector<Joint*>& joints)
+  : mSkel(skel), mJoints(joints)
+{
+  std::vector<BodyNode*> pointBodies;
+  for (auto& marker : markers)
+  {
+    pointBodies.push_back(marker.first);
+    mMarkerOffsets.push_back(marker.second);
+  }
+  for (Joint* joint : joints)
+  {
+    pointBodies.push_back(joint->getChildBodyNode());
+  }
+
+  // Number the bodies, and the DOFs that move them, in skeleton order
+  std::map<int, int> bodyToPlanIndex;
+  std::map<int, int> dofToPlanIndex;
+  for (BodyNode* body : pointBodies)
+  {
+    bodyToPlanIndex[body->getIndexInSkeleton()] = 0;
+    for (BodyNode* cursor = body; cursor != nullptr;
+         cursor = cursor->getParentBodyNode())
+    {
+      Joint* parentJoint = cursor->getParentJoint();
+      for (int i = 0; i < parentJoint->getNumDofs(); i++)
+      {
+        dofToPlanIndex[parentJoint->getIndexInSkeleton(i)] = 0;
+      }
+    }
+  }
+  for (auto& pair : bodyToPlanIndex)
+  {
+    pair.second = mBodies.size();
+    mBodies.push_back(mSkel->getBodyNode(pair.first));
+  }
+  for (auto& pair : dofToPlanIndex)
+  {
+    pair.second = mDofs.size();
+    mDofs.push_back(pair.first);
+  }
+  mWorldTransforms.resize(mBodies.size());
+  mWorldPoints = Eigen::Matrix<s_t, 3, Eigen::Dynamic>::Zero(
+      3, pointBodies.size());
+  mScrews = Eigen::Matrix<s_t, 6, Eigen::Dynamic>::Zero(6, mDofs.size());
+
+  // Record which DOFs move each point, and lay out the sparsity pattern
+  std::vector<Eigen::Triplet<s_t>> triplets;
+  for (int i = 0; i < pointBodies.size(); i++)
+  {
+    mPointBodies.push_back(
+        bodyToPlanIndex[pointBodies[i]->getIndexInSkeleton()]);
+    mPointDofs.emplace_back();
+    for (BodyNode* cursor = pointBodies[i]; cursor != nullptr;
+         cursor = cursor->getParentBodyNode())
+    {
+      Joint* parentJoint = cursor->getParentJoint();
+      for (int j = 0; j < parentJoint->getNumDofs(); j++)
+      {
+        int dof = parentJoint->getIndexInSkeleton(j);
+        mPointDofs[i].push_back(dofToPlanIndex[dof]);
+        for (int row = 0; row < 3; row++)
+        {
+          triplets.emplace_back(i * 3 + row, dof, 0.0);
+        }
+      }
+    }
+  }
+  mJacobianPattern = Eigen::SparseMatrix<s_t, Eigen::RowMajor>(
+      pointBodies.size() * 3, mSkel->getNumDofs());
+  mJacobianPattern.setFromTriplets(triplets.begin(), triplets.end());
+  mJacobianPattern.makeCompressed();
+
+  // All 3 rows of a point have the same columns, so a DOF sits at the same
+  // position within each of them
+  for (int i = 0; i < pointBodies.size(); i++)
+  {
+    mPointValueIndices.emplace_back();
+    const int rowStart = mJacobianPattern.outerIndexPtr()[i * 3];
+    for (int planDof : mPointDofs[i])
+    {
+      int index = rowStart;
+      while (mJacobianPattern.innerIndexPtr()[index] != mDofs[planDof])
+      {
+        index++;
+      }
+      assert(index < mJacobianPattern.outerIndexPtr()[i * 3 + 1]);
+      mPointValueIndices[i].push_back(index - rowStart);
+    }
+  }
+
+  // Lay out the body scale Jacobian of the markers the same way
+  std::map<BodyNode*, int> scaleBodyToPlanIndex;
+  triplets.clear();
+  for (int i = 0; i < markers.size(); i++)
+  {
+    mMarkerScaleBodies.emplace_back();
+    for (BodyNode* cursor = markers[i].first; cursor != nullptr;
+         cursor = cursor->getParentBodyNode())
+    {
+      if (scaleBodyToPlanIndex.count(cursor) == 0)
+      {
+        scaleBodyToPlanIndex[cursor] = mScaleBodies.size();
+        mScaleBodies.push_back(cursor);
+      }
+      mMarkerScaleBodies[i].push_back(scaleBodyToPlanIndex[cursor]);
+      for (int row = 0; row < 3; row++)
+      {
+        for (int axis = 0; axis < 3; axis++)
+        {
+          triplets.emplace_back(
+              i * 3 + row, cursor->getIndexInSkeleton() * 3 + axis, 0.0);
+        }
+      }
+    }
+  }
+  mScaleJacobianPattern = Eigen::SparseMatrix<s_t, Eigen::RowMajor>(
+      markers.size() * 3, mSkel->getNumBodyNodes() * 3);
+  mScaleJacobianPattern.setFromTriplets(triplets.begin(), triplets.end());
+  mScaleJacobianPattern.makeCompressed();
+  for (int i = 0; i < markers.size(); i++)
+  {
+    mMarkerScaleValueIndices.emplace_back();
+    const int rowStart = mScaleJacobianPattern.outerIndexPtr()[i * 3];
+    for (int scaleBody : mMarkerScaleBodies[i])
+    {
+      int col = mScaleBodies[scaleBody]->getIndexInSkeleton() * 3;
+      int index = rowStart;
+      while (mScaleJacobianPattern.innerIndexPtr()[index] != col)
+      {
+        index++;
+      }
+      assert(index + 2 < mScaleJacobianPattern.outerIndexPtr()[i * 3 + 1]);
+      mMarkerScaleValueIndices[i].push_back(index - rowStart);
+    }
+  }
+
+  triplets.clear();
+  for (int i = 0; i < markers.size(); i++)
+  {
+    for (int row = 0; row < 3; row++)
+    {
+      for (int col = 0; col < 3; col++)
+      {
+        triplets.emplace_back(i * 3 + row, i * 3 + col, 0.0);
+      }
+    }
+  }
+  mOffsetJacobianPattern = Eigen::SparseMatrix<s_t, Eigen::RowMajor>(
+      markers.size() * 3, markers.size() * 3);
+  mOffsetJacobianPattern.setFromTriplets(triplets.begin(), triplets.end());
+  mOffsetJacobianPattern.makeCompressed();
+}
+
+//==============================================================================
+/// This returns the number of points (markers + joints) in the plan
+int KinematicsPlan::getNumPoints() const
+{
+  return mPointBodies.size();
+}
+
+//==============================================================================
+/// This returns true if the plan was built for markers on exactly the bodies
+/// in `markers` and exactly `joints`, in the same order.
+bool KinematicsPlan::isPlanFor(
+    const std::vector<std::pair<BodyNode*, Eigen::Vector3s>>& markers,
+    const std::vector<Joint*>& joints) const
+{
+  if (markers.size() != mMarkerOffsets.size() || joints != mJoints)
+  {
+    return false;
+  }
+  for (int i = 0; i < markers.size(); i++)
+  {
+    if (mBodies[mPointBodies[i]] != markers[i].first)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//==============================================================================
+/// This replaces the (unscaled) marker offsets with the ones in `markers`.
+void KinematicsPlan::setMarkerOffsets(
+    const std::vector<std::pair<BodyNode*, Eigen::Vector3s>>& markers)
+{
+  assert(markers.size() == mMarkerOffsets.size());
+  for (int i = 0; i < markers.size(); i++)
+  {
+    assert(mBodies[mPointBodies[i]] == markers[i].first);
+    mMarkerOffsets[i] = markers[i].second;
+  }
+}
+
+//==============================================================================
+/// This returns the concatenated world positions of every point, at the
+/// skeleton's current positions and scales.
+Eigen::VectorXs KinematicsPlan::getWorldPositions()
+{
+  updateWorldPoints();
+  return Eigen::Map<const Eigen::VectorXs>(
+      mWorldPoints.data(), mWorldPoints.size());
+}
+
+//==============================================================================
+/// This returns the Jacobian of getWorldPositions() with respect to joint
+/// positions, at the skeleton's current positions and scales.
+Eigen::SparseMatrix<s_t, Eigen::RowMajor>
+KinematicsPlan::getWorldPositionsJacobianWrtJointPositions()
+{
+  updateWorldPoints();
+  updateScrews();
+  return assembleJacobian();
+}
+
+//==============================================================================
+/// This returns the Jacobian of the world positions of just the markers with
+/// respect to body scales.
+Eigen::SparseMatrix<s_t, Eigen::RowMajor>
+KinematicsPlan::getMarkerWorldPositionsJacobianWrtBodyScales()
+{
+  updateWorldPoints();
+
+  // Scaling a body moves its own origin along its parent joint's offset, and
+  // moves its children along their parent joints' offsets. Both are shared by
+  // every marker below the body.
+  std::vector<Eigen::Matrix3s> childScaleOffsets(mScaleBodies.size());
+  std::vector<Eigen::Matrix3s> parentScaleOffsets(mScaleBodies.size());
+  for (int i = 0; i < mScaleBodies.size(); i++)
+  {
+    const Joint* parentJoint = mScaleBodies[i]->getParentJoint();
+    for (int axis = 0; axis < 3; axis++)
+    {
+      childScaleOffsets[i].col(axis)
+          = parentJoint->getWorldTranslationOfChildBodyWrtChildScale(axis);
+      parentScaleOffsets[i].col(axis)
+          = parentJoint->getWorldTranslationOfChildBodyWrtParentScale(axis);
+    }
+  }
+
+  Eigen::SparseMatrix<s_t, Eigen::RowMajor> jac = mScaleJacobianPattern;
+  s_t* values = jac.valuePtr();
+  const int* rowStarts = jac.outerIndexPtr();
+  for (int i = 0; i < mMarkerScaleBodies.size(); i++)
+  {
+    const std::vector<int>& chain = mMarkerScaleBodies[i];
+    const Eigen::Matrix3s& R = mWorldTransforms[mPointBodies[i]].linear();
+    for (int k = 0; k < chain.size(); k++)
+    {
+      // The marker's own body also stretches the marker offset. Each body
+      // above it moves it by the offset of the child joint that leads down
+      // towards the marker.
+      Eigen::Matrix3s offsets = childScaleOffsets[chain[k]];
+      if (k == 0)
+        offsets += R * mMarkerOffsets[i].asDiagonal();
+      else
+        offsets += parentScaleOffsets[chain[k - 1]];
+      for (int row = 0; row < 3; row++)
+      {
+        Eigen::Map<Eigen::Matrix<s_t, 1, 3>>(
+            values + rowStarts[i * 3 + row] + mMarkerScaleValueIndices[i][k])
+            = offsets.row(row);
+      }
+    }
+  }
+  return jac;
+}
+
+//==============================================================================
+/// This returns the Jacobian of the world positions of just the markers with
+/// respect to their offsets, which is block diagonal.
+Eigen::SparseMatrix<s_t, Eigen::RowMajor>
+KinematicsPlan::getMarkerWorldPositionsJacobianWrtMarkerOffsets()
+{
+  Eigen::SparseMatrix<s_t, Eigen::RowMajor> jac = mOffsetJacobianPattern;
+  s_t* values = jac.valuePtr();
+  for (int i = 0; i < mMarkerOffsets.size(); i++)
+  {
+    BodyNode* body = mBodies[mPointBodies[i]];
+    Eigen::Matrix3s block
+        = body->getWorldTransform().linear() * body->getScale().asDiagonal();
+    // Each row of the block diagonal has exactly 3 entries
+    for (int row = 0; row < 3; row++)
+    {
+      Eigen::Map<Eigen::Matrix<s_t, 1, 3>>(values + (i * 3 + row) * 3)
+          = block.row(row);
+    }
+  }
+  return jac;
+}
+
+//==============================================================================
+/// Each column of `poses` is a full set of joint positions. This returns a
+/// matrix with the world positions of every point as the corresponding
+/// column.
+Eigen::MatrixXs KinematicsPlan::getWorldPositionsForPoses(
+    const Eigen::MatrixXs& poses)
+{
+  assert(poses.rows() == mSkel->getNumDofs());
+  Eigen::VectorXs originalPositions = mSkel->getPositions();
+  Eigen::MatrixXs result
+      = Eigen::MatrixXs::Zero(mWorldPoints.size(), poses.cols());
+  for (int t = 0; t < poses.cols(); t++)
+  {
+    mSkel->setPositions(poses.col(t));
+    updateWorldPoints();
+    result.col(t) = Eigen::Map<const Eigen::VectorXs>(
+        mWorldPoints.data(), mWorldPoints.size());
+  }
+  mSkel->setPositions(originalPositions);
+  return result;
+}
+
+//==============================================================================
+/// Each column of `poses` is a full set of joint positions. This returns the
+/// Jacobian of the world positions with respect to joint positions at each
+/// pose.
+std::vector<Eigen::SparseMatrix<s_t, Eigen::RowMajor>>
+KinematicsPlan::getWorldPositionsJacobiansWrtJointPositionsForPoses(
+    const Eigen::MatrixXs& poses)
+{
+  assert(poses.rows() == mSkel->getNumDofs());
+  Eigen::VectorXs originalPositions = mSkel->getPositions();
+  std::vector<Eigen::SparseMatrix<s_t, Eigen::RowMajor>> result;
+  result.reserve(poses.cols());
+  for (int t = 0; t < poses.cols(); t++)
+  {
+    mSkel->setPositions(poses.col(t));
+    updateWorldPoints();
+    updateScrews();
+    result.push_back(assembleJacobian());
+  }
+  mSkel->setPositions(originalPositions);
+  return result;
+}
+
+//==============================================================================
+/// This reads the world transform of every body we care about into
+/// mWorldTransforms, and the world point of every marker and joint into
+/// mWorldPoints
+void KinematicsPlan::updateWorldPoints()
+{
+  for (int i = 0; i < mBodies.size(); i++)
+  {
+    mWorldTransforms[i] = mBodies[i]->getWorldTransform();
+  }
+  for (int i = 0; i < mMarkerOffsets.size(); i++)
+  {
+    BodyNode* body = mBodies[mPointBodies[i]];
+    mWorldPoints.col(i) = mWorldTransforms[mPointBodies[i]]
+                          * body->getScale().cwiseProduct(mMarkerOffsets[i]);
+  }
+  for (int i = 0; i < mJoints.size(); i++)
+  {
+    int point = mMarkerOffsets.size() + i;
+    mWorldPoints.col(point)
+        = mWorldTransforms[mPointBodies[point]]
+          * mJoints[i]->getTransformFromChildBodyNode().translation();
+  }
+}
+
+//==============================================================================
+/// This reads the world screw axis of every DOF we care about into mScrews.
+void KinematicsPlan::updateScrews()
+{
+  for (int i = 0; i < mDofs.size(); i++)
+  {
+    const DegreeOfFreedom* dof = mSkel->getDof(mDofs[i]);
+    mScrews.col(i) = dof->getJoint()->getWorldAxisScrewForPosition(
+        dof->getIndexInJoint());
+  }
+}
+
+//==============================================================================
+/// This fills in a copy of mJacobianPattern from mScrews and mWorldPoints
+Eigen::SparseMatrix<s_t, Eigen::RowMajor> KinematicsPlan::assembleJacobian()
+    const
+{
+  Eigen::SparseMatrix<s_t, Eigen::RowMajor> jac = mJacobianPattern;
+  s_t* values = jac.valuePtr();
+  const int* rowStarts = jac.outerIndexPtr();
+  for (int i = 0; i < mPointDofs.size(); i++)
+  {
+    const Eigen::Vector3s& point = mWorldPoints.col(i);
+    for (int j = 0; j < mPointDofs[i].size(); j++)
+    {
+      const auto& screw = mScrews.col(mPointDofs[i][j]);
+      Eigen::Vector3s velocity = screw.tail<3>() + screw.head<3>().cross(point);
+      for (int row = 0; row < 3; row++)
+      {
+        values[rowStarts[i * 3 + row] + mPointValueIndices[i][j]]
+            = velocity(row);
+      }
+    }
+  }
+  return jac;
+}
+
+} // namespace dynamics
+} // namespace dart
@@ -0,0 +1,164 @@
+#ifndef DART_DYNAMICS_KINEMATICS_PLAN_HPP_
+#define DART_DYNAMICS_KINEMATICS_PLAN_HPP_
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+
+#include "dart/math/MathTypes.hpp"
+
+namespace dart {
+namespace dynamics {
+
+class BodyNode;
+class Joint;
+class Skeleton;
+
+/// This is a precomputed plan for repeatedly evaluating the world positions of
+/// a fixed set of markers and joint centers, and their Jacobians with respect
+/// to joint positions.
+///
+/// Skeleton::getMarkerWorldPositionsJacobianWrtJointPositions() and
+/// Skeleton::getJointWorldPositionsJacobianWrtJointPositions() search the
+/// whole skeleton for the ancestors of every point, and allocate a dense 6xN
+/// Jacobian per point, on every call. This does that work once, up front,
+/// and then on each evaluation reads each body transform and each DOF screw
+/// axis exactly once into a flat cache, and writes straight into a sparse
+/// Jacobian with a fixed sparsity pattern.
+///
+/// The points are ordered with all the markers first, followed by all the
+/// joints, 3 rows per point. Marker offsets and joint centers are scaled by
+/// the current body scales at evaluation time, so the plan stays valid as
+/// scales change. It does NOT stay valid if the skeleton's structure changes.
+///
+/// The Jacobians are row-major (CSR), since the fitters mostly multiply their
+/// transposes by a vector.
+class KinematicsPlan
+{
+public:
+  KinematicsPlan(
+      std::shared_ptr<Skeleton> skel,
+      const std::vector<std::pair<BodyNode*, Eigen::Vector3s>>& markers,
+      const std::vector<Joint*>& joints = std::vector<Joint*>());
+
+  /// This is the same as the constructor above, but doesn't keep `skel`
+  /// alive. Skeleton uses this to cache plans for its own sparse Jacobians.
+  KinematicsPlan(
+      Skeleton* skel,
+      const std::vector<std::pair<BodyNode*, Eigen::Vector3s>>& markers,
+      const std::vector<Joint*>& joints = std::vector<Joint*>());
+
+  /// This returns the number of points (markers + joints) in the plan
+  int getNumPoints() const;
+
+  /// This returns true if the plan was built for markers on exactly the bodies
+  /// in `markers` and exactly `joints`, in the same order. The marker offsets
+  /// don't have to match, see setMarkerOffsets().
+  bool isPlanFor(
+      const std::vector<std::pair<BodyNode*, Eigen::Vector3s>>& markers,
+      const std::vector<Joint*>& joints = std::vector<Joint*>()) const;
+
+  /// This replaces the (unscaled) marker offsets with the ones in `markers`,
+  /// which must be on the same bodies as the markers the plan was built for.
+  /// This doesn't change the sparsity patterns.
+  void setMarkerOffsets(
+      const std::vector<std::pair<BodyNode*, Eigen::Vector3s>>& markers);
+
+  /// This returns the concatenated world positions of every point, at the
+  /// skeleton's current positions and scales. This matches
+  /// Skeleton::getMarkerWorldPositions() followed by
+  /// Skeleton::getJointWorldPositions().
+  Eigen::VectorXs getWorldPositions();
+
+  /// This returns the Jacobian of getWorldPositions() with respect to joint
+  /// positions, at the skeleton's current positions and scales.
+  Eigen::SparseMatrix<s_t, Eigen::RowMajor>
+  getWorldPositionsJacobianWrtJointPositions();
+
+  /// This returns the Jacobian of the world positions of just the markers
+  /// with respect to body scales, matching
+  /// Skeleton::getMarkerWorldPositionsJacobianWrtBodyScales().
+  Eigen::SparseMatrix<s_t, Eigen::RowMajor>
+  getMarkerWorldPositionsJacobianWrtBodyScales();
+
+  /// This returns the Jacobian of the world positions of just the markers
+  /// with respect to their offsets, which is block diagonal, matching
+  /// Skeleton::getMarkerWorldPositionsJacobianWrtMarkerOffsets().
+  Eigen::SparseMatrix<s_t, Eigen::RowMajor>
+  getMarkerWorldPositionsJacobianWrtMarkerOffsets();
+
+  /// Each column of `poses` is a full set of joint positions. This returns a
+  /// matrix with the world positions of every point as the corresponding
+  /// column. The skeleton's positions are restored afterwards.
+  Eigen::MatrixXs getWorldPositionsForPoses(const Eigen::MatrixXs& poses);
+
+  /// Each column of `poses` is a full set of joint positions. This returns the
+  /// Jacobian of the world positions with respect to joint positions at each
+  /// pose. The skeleton's positions are restored afterwards.
+  std::vector<Eigen::SparseMatrix<s_t, Eigen::RowMajor>>
+  getWorldPositionsJacobiansWrtJointPositionsForPoses(
+      const Eigen::MatrixXs& poses);
+
+protected:
+  /// This reads the world transform of every body we care about into
+  /// mWorldTransforms, and the world point of every marker and joint into
+  /// mWorldPoints
+  void updateWorldPoints();
+
+  /// This reads the world screw axis of every DOF we care about into mScrews.
+  /// This must be called after updateWorldPoints().
+  void updateScrews();
+
+  /// This fills in a copy of mJacobianPattern from mScrews and mWorldPoints
+  Eigen::SparseMatrix<s_t, Eigen::RowMajor> assembleJacobian() const;
+
+  Skeleton* mSkel;
+  /// This is only set if the plan keeps the skeleton alive
+  std::shared_ptr<Skeleton> mSkelOwner;
+
+  /// These are the bodies that have at least one point attached, in skeleton
+  /// order, and their cached world transforms
+  std::vector<BodyNode*> mBodies;
+  std::vector<Eigen::Isometry3s> mWorldTransforms;
+
+  /// For each point, this is the index into mBodies of the body it's attached
+  /// to
+  std::vector<int> mPointBodies;
+  std::vector<Eigen::Vector3s> mMarkerOffsets;
+  std::vector<Joint*> mJoints;
+  Eigen::Matrix<s_t, 3, Eigen::Dynamic> mWorldPoints;
+
+  /// These are the indices in the skeleton of the DOFs that move at least one
+  /// point, and their cached world screw axes (one per column)
+  std::vector<int> mDofs;
+  Eigen::Matrix<s_t, 6, Eigen::Dynamic> mScrews;
+
+  /// For each point, these are the indices into mDofs of every DOF that moves
+  /// it, and for each of those DOFs its position within each of the point's 3
+  /// rows of mJacobianPattern (which all have the same columns)
+  std::vector<std::vector<int>> mPointDofs;
+  std::vector<std::vector<int>> mPointValueIndices;
+  Eigen::SparseMatrix<s_t, Eigen::RowMajor> mJacobianPattern;
+
+  /// These are the bodies whose scale moves at least one marker: each marker's
+  /// own body and every body above it.
+  std::vector<BodyNode*> mScaleBodies;
+  /// For each marker, these are the indices into mScaleBodies of its own body
+  /// followed by each of its ancestors in order, and for each of those bodies
+  /// the position of its x-scale column within each of the marker's 3 rows of
+  /// mScaleJacobianPattern. The y and z columns follow it.
+  std::vector<std::vector<int>> mMarkerScaleBodies;
+  std::vector<std::vector<int>> mMarkerScaleValueIndices;
+  Eigen::SparseMatrix<s_t, Eigen::RowMajor> mScaleJacobianPattern;
+
+  /// This is the block diagonal pattern of the marker offsets Jacobian
+  Eigen::SparseMatrix<s_t, Eigen::RowMajor> mOffsetJacobianPattern;
+};
+
+} // namespace dynamics
+} // namespace dart
+
+#endif
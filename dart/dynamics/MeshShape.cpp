@@ -32,18 +32,31 @@
 
 #include "dart/dynamics/MeshShape.hpp"
 
+#include <atomic>
+#include <cstdio>
+#include <fstream>
 #include <limits>
+#include <list>
+#include <mutex>
+#include <set>
+#include <sstream>
 #include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <unistd.h>
 
 #include <assimp/DefaultLogger.hpp>
 #include <assimp/Importer.hpp>
 #include <assimp/LogStream.hpp>
 #include <assimp/Logger.hpp>
+#include <assimp/cexport.h>
 #include <assimp/cimport.h>
 #include <assimp/postprocess.h>
 
 #include "dart/common/Console.hpp"
 #include "dart/common/LocalResourceRetriever.hpp"
+#include "dart/common/Sha256.hpp"
 #include "dart/common/Uri.hpp"
 #include "dart/config.hpp"
 #include "dart/dynamics/AssimpInputResourceAdaptor.hpp"
@@ -444,7 +457,210 @@ void MeshShape::updateVolume() const
 }
 
 //==============================================================================
-std::shared_ptr<SharedMeshWrapper> MeshShape::loadMesh(
+/// This is one mesh in the in-memory cache
+struct MeshCacheEntry
+{
+  std::shared_ptr<SharedMeshWrapper> mesh;
+  /// The key of this mesh's file alone, into MeshCache::dependencies
+  std::string contentKey;
+  /// This entry's position in MeshCache::recentlyUsed
+  std::list<std::string>::iterator recentlyUsed;
+};
+
+//==============================================================================
+/// This is the process-wide cache behind MeshShape::loadMesh()
+struct MeshCache
+{
+  std::mutex mutex;
+  bool enabled = true;
+  std::string directory;
+  std::size_t capacity = 1024;
+  std::unordered_map<std::string, MeshCacheEntry> meshes;
+  /// The keys of `meshes`, most recently used first
+  std::list<std::string> recentlyUsed;
+  /// The other resources (like .mtl files and textures) that Assimp read the
+  /// last time it imported a mesh file, keyed on the digest of that file.
+  /// These are relative to the mesh file's folder wherever possible, so a
+  /// copy of the file in another folder resolves them against its own folder.
+  std::unordered_map<std::string, std::vector<std::string>> dependencies;
+};
+
+//==============================================================================
+static MeshCache& getMeshCache()
+{
+  static MeshCache cache;
+  return cache;
+}
+
+//==============================================================================
+/// This drops the least recently used meshes until `cache` is within its
+/// capacity. The caller must hold `cache.mutex`.
+static void evictMeshCacheOverCapacity(MeshCache& cache)
+{
+  while (cache.meshes.size() > cache.capacity)
+  {
+    auto it = cache.meshes.find(cache.recentlyUsed.back());
+    cache.dependencies.erase(it->second.contentKey);
+    cache.meshes.erase(it);
+    cache.recentlyUsed.pop_back();
+  }
+}
+
+//==============================================================================
+/// This returns the mesh under `key` and marks it most recently used, or
+/// nullptr if it isn't cached. The caller must hold `cache.mutex`.
+static std::shared_ptr<SharedMeshWrapper> findCachedMesh(
+    MeshCache& cache, const std::string& key)
+{
+  auto it = cache.meshes.find(key);
+  if (it == cache.meshes.end())
+  {
+    return nullptr;
+  }
+  cache.recentlyUsed.splice(
+      cache.recentlyUsed.begin(),
+      cache.recentlyUsed,
+      it->second.recentlyUsed);
+  return it->second.mesh;
+}
+
+//==============================================================================
+/// This returns everything in `uri` up to and including the last '/'
+static std::string getUriFolder(const std::string& uri)
+{
+  const std::size_t slashIndex = uri.find_last_of('/');
+  if (slashIndex == std::string::npos)
+    return "";
+  return uri.substr(0, slashIndex + 1);
+}
+
+//==============================================================================
+/// This returns a name next to `path` that no other thread or process will
+/// pick, so a cache file can be written in full and then renamed into place
+static std::string getUniqueTempPath(const std::string& path)
+{
+  static std::atomic<long> counter(0);
+  std::stringstream tempPath;
+  tempPath << path << ".tmp." << getpid() << "." << counter++;
+  return tempPath.str();
+}
+
+//==============================================================================
+/// This passes everything through to another ResourceRetriever, and records
+/// the URIs of every resource that Assimp asks for besides the mesh file
+/// itself, so loadMesh() can key the cache on them too
+class DependencyRecordingRetriever : public common::ResourceRetriever
+{
+public:
+  DependencyRecordingRetriever(
+      common::ResourceRetrieverPtr retriever, const std::string& meshUri)
+    : mRetriever(std::move(retriever)), mMeshUri(meshUri)
+  {
+  }
+
+  bool exists(const common::Uri& uri) override
+  {
+    record(uri);
+    return mRetriever->exists(uri);
+  }
+
+  common::ResourcePtr retrieve(const common::Uri& uri) override
+  {
+    record(uri);
+    return mRetriever->retrieve(uri);
+  }
+
+  std::string getFilePath(const common::Uri& uri) override
+  {
+    return mRetriever->getFilePath(uri);
+  }
+
+  /// This returns the recorded URIs, relative to the mesh file's folder
+  /// wherever possible. Missing resources are included, so that creating one
+  /// later changes the key as well.
+  std::vector<std::string> getDependencies() const
+  {
+    const std::string folder = getUriFolder(mMeshUri);
+    std::vector<std::string> dependencies;
+    for (const std::string& uri : mUris)
+    {
+      if (!folder.empty() && uri.compare(0, folder.size(), folder) == 0)
+        dependencies.push_back(uri.substr(folder.size()));
+      else
+        dependencies.push_back(uri);
+    }
+    return dependencies;
+  }
+
+protected:
+  void record(const common::Uri& uri)
+  {
+    const std::string uriString = uri.toString();
+    if (uriString != mMeshUri && uriString != common::Uri(mMeshUri).toString())
+      mUris.insert(uriString);
+  }
+
+  common::ResourceRetrieverPtr mRetriever;
+  std::string mMeshUri;
+  std::set<std::string> mUris;
+};
+
+//==============================================================================
+/// This is the cache key for a mesh file at `uri` whose own contents have the
+/// key `contentKey`, and which pulls in `dependencies` (as returned by
+/// DependencyRecordingRetriever::getDependencies()). The key covers the
+/// resolved URI and the SHA-256 of the current contents of each dependency.
+static std::string getMeshCacheKey(
+    const std::string& contentKey,
+    const std::string& uri,
+    const std::vector<std::string>& dependencies,
+    const common::ResourceRetrieverPtr& retriever)
+{
+  if (dependencies.empty())
+  {
+    return contentKey;
+  }
+
+  const std::string folder = getUriFolder(uri);
+  std::string manifest = contentKey;
+  for (const std::string& dependency : dependencies)
+  {
+    const bool isAbsolute = dependency.find("://") != std::string::npos
+                            || (!dependency.empty() && dependency[0] == '/');
+    const std::string resolved = isAbsolute ? dependency : folder + dependency;
+    common::ResourcePtr resource = retriever->retrieve(resolved);
+    manifest += "\n" + resolved + "\n"
+                + (resource ? common::computeSha256(resource->readAll())
+                            : std::string("missing"));
+  }
+  // Keep the extension, so Assimp can tell the format of files on disk
+  const std::size_t extensionIndex = contentKey.find('.');
+  return common::computeSha256(manifest)
+         + (extensionIndex == std::string::npos
+                ? ""
+                : contentKey.substr(extensionIndex));
+}
+
+//==============================================================================
+/// This returns the lower-cased file extension of `uri`, including the dot
+static std::string getMeshExtension(const std::string& uri)
+{
+  std::string extension;
+  const std::size_t extensionIndex = uri.find_last_of('.');
+  if (extensionIndex != std::string::npos)
+    extension = uri.substr(extensionIndex);
+
+  std::transform(
+      std::begin(extension),
+      std::end(extension),
+      std::begin(extension),
+      ::tolower);
+  return extension;
+}
+
+//==============================================================================
+/// This runs Assimp on the mesh at `_uri`, without touching the cache
+static std::shared_ptr<SharedMeshWrapper> importMesh(
     const std::string& _uri, const common::ResourceRetrieverPtr& retriever)
 {
   // Remove points and lines from the import.
@@ -503,16 +719,7 @@ std::shared_ptr<SharedMeshWrapper> MeshShape::loadMesh(
   // rotation. We are only catching files with the .dae file ending here. We
   // might miss files with an .xml file ending, which would need to be looked
   // into to figure out whether they are collada files.
-  std::string extension;
-  const std::size_t extensionIndex = _uri.find_last_of('.');
-  if (extensionIndex != std::string::npos)
-    extension = _uri.substr(extensionIndex);
-
-  std::transform(
-      std::begin(extension),
-      std::end(extension),
-      std::begin(extension),
-      ::tolower);
+  std::string extension = getMeshExtension(_uri);
 
   if (extension == ".dae" || extension == ".zae")
     scene->mRootNode->mTransformation = aiMatrix4x4();
@@ -528,6 +735,209 @@ std::shared_ptr<SharedMeshWrapper> MeshShape::loadMesh(
   return std::make_shared<SharedMeshWrapper>(scene);
 }
 
+//==============================================================================
+std::shared_ptr<SharedMeshWrapper> MeshShape::loadMesh(
+    const std::string& _uri, const common::ResourceRetrieverPtr& retriever)
+{
+  MeshCache& cache = getMeshCache();
+  std::string directory;
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (!cache.enabled)
+    {
+      return importMesh(_uri, retriever);
+    }
+    directory = cache.directory;
+  }
+
+  // Key the mesh on its contents, so the same file under different paths (or
+  // copied into different model folders) only gets imported once
+  common::ResourcePtr resource
+      = retriever ? retriever->retrieve(_uri) : nullptr;
+  if (!resource)
+  {
+    return importMesh(_uri, retriever);
+  }
+  const std::string contentKey
+      = common::computeSha256(resource->readAll()) + getMeshExtension(_uri);
+
+  // If we've imported this file before, we know what else it reads, which
+  // completes the key. Otherwise we only find out by importing it.
+  bool knowDependencies = false;
+  std::vector<std::string> dependencies;
+  {
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    auto it = cache.dependencies.find(contentKey);
+    if (it != cache.dependencies.end())
+    {
+      knowDependencies = true;
+      dependencies = it->second;
+    }
+  }
+  const std::string dependenciesPath
+      = directory.empty() ? "" : directory + "/" + contentKey + ".deps";
+  if (!knowDependencies && !dependenciesPath.empty())
+  {
+    std::ifstream dependenciesFile(dependenciesPath);
+    if (dependenciesFile.good())
+    {
+      knowDependencies = true;
+      std::string line;
+      while (std::getline(dependenciesFile, line))
+      {
+        if (!line.empty())
+          dependencies.push_back(line);
+      }
+    }
+  }
+
+  std::string key;
+  std::shared_ptr<SharedMeshWrapper> mesh = nullptr;
+  if (knowDependencies)
+  {
+    key = getMeshCacheKey(contentKey, _uri, dependencies, retriever);
+    {
+      std::lock_guard<std::mutex> lock(cache.mutex);
+      mesh = findCachedMesh(cache, key);
+      if (mesh)
+      {
+        return mesh;
+      }
+    }
+
+    // Import outside the lock, so different meshes can load in parallel
+    const std::string cachePath
+        = directory.empty() ? "" : directory + "/" + key + ".assbin";
+    if (!cachePath.empty() && std::ifstream(cachePath).good())
+    {
+      // The file on disk was already post-processed before we wrote it
+      const aiScene* scene = aiImportFile(cachePath.c_str(), 0);
+      if (scene)
+      {
+        mesh = std::make_shared<SharedMeshWrapper>(scene);
+      }
+    }
+  }
+  if (!mesh)
+  {
+    auto recorder
+        = std::make_shared<DependencyRecordingRetriever>(retriever, _uri);
+    mesh = importMesh(_uri, recorder);
+    if (!mesh)
+    {
+      return nullptr;
+    }
+    dependencies = recorder->getDependencies();
+    key = getMeshCacheKey(contentKey, _uri, dependencies, retriever);
+
+    if (!directory.empty())
+    {
+      // Write both files under temporary names and rename them into place,
+      // mesh first and dependency list last, so a reader (in this or another
+      // process) that finds the list also finds a complete mesh
+      const std::string cachePath = directory + "/" + key + ".assbin";
+      const std::string cacheTempPath = getUniqueTempPath(cachePath);
+      const std::string dependenciesTempPath
+          = getUniqueTempPath(dependenciesPath);
+      bool written = aiExportScene(
+                         mesh->mesh, "assbin", cacheTempPath.c_str(), 0)
+                     == aiReturn_SUCCESS;
+      if (written)
+      {
+        std::ofstream dependenciesFile(dependenciesTempPath);
+        for (const std::string& dependency : dependencies)
+        {
+          dependenciesFile << dependency << "\n";
+        }
+        dependenciesFile.close();
+        written = !dependenciesFile.fail();
+      }
+      if (written)
+      {
+        written = std::rename(cacheTempPath.c_str(), cachePath.c_str()) == 0
+                  && std::rename(
+                         dependenciesTempPath.c_str(),
+                         dependenciesPath.c_str())
+                         == 0;
+      }
+      if (!written)
+      {
+        dtwarn << "[MeshShape::loadMesh] Failed writing mesh '" << _uri
+               << "' to the mesh cache at '" << cachePath << "'.\n";
+        std::remove(cacheTempPath.c_str());
+        std::remove(dependenciesTempPath.c_str());
+      }
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  cache.dependencies[contentKey] = dependencies;
+  // If another thread beat us to it, use its copy so everyone shares one
+  std::shared_ptr<SharedMeshWrapper> existing = findCachedMesh(cache, key);
+  if (existing)
+  {
+    return existing;
+  }
+  cache.recentlyUsed.push_front(key);
+  MeshCacheEntry& entry = cache.meshes[key];
+  entry.mesh = mesh;
+  entry.contentKey = contentKey;
+  entry.recentlyUsed = cache.recentlyUsed.begin();
+  evictMeshCacheOverCapacity(cache);
+  return mesh;
+}
+
+//==============================================================================
+void MeshShape::setMeshCacheEnabled(bool enabled)
+{
+  MeshCache& cache = getMeshCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  cache.enabled = enabled;
+}
+
+//==============================================================================
+void MeshShape::setMeshCacheDirectory(const std::string& directory)
+{
+  MeshCache& cache = getMeshCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  cache.directory = directory;
+}
+
+//==============================================================================
+void MeshShape::clearMeshCache()
+{
+  MeshCache& cache = getMeshCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  cache.meshes.clear();
+  cache.recentlyUsed.clear();
+  cache.dependencies.clear();
+}
+
+//==============================================================================
+void MeshShape::setMeshCacheCapacity(std::size_t capacity)
+{
+  MeshCache& cache = getMeshCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  cache.capacity = capacity;
+  evictMeshCacheOverCapacity(cache);
+}
+
+//==============================================================================
+std::size_t MeshShape::getMeshCacheCapacity()
+{
+  MeshCache& cache = getMeshCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  return cache.capacity;
+}
+
+//==============================================================================
+std::size_t MeshShape::getMeshCacheSize()
+{
+  MeshCache& cache = getMeshCache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  return cache.meshes.size();
+}
+
 //==============================================================================
 std::shared_ptr<SharedMeshWrapper> MeshShape::loadMesh(
     const common::Uri& uri, const common::ResourceRetrieverPtr& retriever)
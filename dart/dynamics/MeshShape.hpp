@@ -179,6 +179,35 @@ public:
   static std::shared_ptr<SharedMeshWrapper> loadMesh(
       const common::Uri& uri, const common::ResourceRetrieverPtr& retriever);
 
+  /// loadMesh() keeps the meshes it loads in a process-wide cache, keyed by
+  /// the SHA-256 of the file's contents and of every other resource Assimp
+  /// read to import it (like .mtl files and textures, resolved against the
+  /// file's folder). It hands out the same SharedMeshWrapper to later loads of
+  /// identical files (from any path), without running Assimp again. The
+  /// meshes are shared, so they must not be modified. This is on by default.
+  static void setMeshCacheEnabled(bool enabled);
+
+  /// If this is set to a directory, loadMesh() also writes each mesh it has
+  /// to import into that directory in Assimp's binary format, after
+  /// triangulating and pre-transforming it, along with the list of resources
+  /// it depends on, and reads meshes back from there in later processes. Pass
+  /// an empty string (the default) to disable this.
+  static void setMeshCacheDirectory(const std::string& directory);
+
+  /// This sets how many meshes the in-memory cache holds (1024 by default).
+  /// Past that, the least recently loaded meshes are dropped from the cache.
+  static void setMeshCacheCapacity(std::size_t capacity);
+
+  /// Returns the most meshes the in-memory cache will hold
+  static std::size_t getMeshCacheCapacity();
+
+  /// This drops every mesh from the in-memory cache. Meshes still in use by a
+  /// MeshShape stay alive until the shape is destroyed.
+  static void clearMeshCache();
+
+  /// Returns the number of meshes in the in-memory cache
+  static std::size_t getMeshCacheSize();
+
   // Documentation inherited.
   Eigen::Matrix3s computeInertia(s_t mass) const override;
 
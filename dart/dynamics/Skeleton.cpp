@@ -52,6 +52,7 @@
 #include "dart/dynamics/Frame.hpp"
 #include "dart/dynamics/FreeJoint.hpp"
 #include "dart/dynamics/Joint.hpp"
+#include "dart/dynamics/KinematicsPlan.hpp"
 #include "dart/dynamics/Marker.hpp"
 #include "dart/dynamics/MeshShape.hpp"
 #include "dart/dynamics/PointMass.hpp"
@@ -475,6 +476,11 @@ SkeletonPtr Skeleton::cloneSkeleton(const std::string& cloneName) const
 {
   SkeletonPtr skelClone = Skeleton::create(cloneName);
 
+  // The clone registers its BodyNodes in the same order as ours, so every
+  // BodyNode, Joint and Node in the clone has the same index as its original,
+  // and we can look them up by index rather than by name. Joint clones share
+  // their immutable data (like CustomJoint functions) with the originals, and
+  // ShapeNode clones share their Shapes (including meshes).
   for (std::size_t i = 0; i < getNumBodyNodes(); ++i)
   {
     // Create a clone of the parent Joint
@@ -483,26 +489,20 @@ SkeletonPtr Skeleton::cloneSkeleton(const std::string& cloneName) const
     // Identify the original parent BodyNode
     const BodyNode* originalParent = getBodyNode(i)->getParentBodyNode();
 
-    // Grab the parent BodyNode clone (using its name, which is guaranteed to be
-    // unique), or use nullptr if this is a root BodyNode
+    // Grab the parent BodyNode clone, which must already have been created,
+    // or use nullptr if this is a root BodyNode
     BodyNode* parentClone
         = (originalParent == nullptr)
               ? nullptr
-              : skelClone->getBodyNode(originalParent->getName());
-
-    if ((nullptr != originalParent) && (nullptr == parentClone))
-    {
-      dterr << "[Skeleton::clone] Failed to find a clone of BodyNode named ["
-            << originalParent->getName() << "] which is needed as the parent "
-            << "of the BodyNode named [" << getBodyNode(i)->getName()
-            << "] and should already have been created. Please report this as "
-            << "a bug!\n";
-    }
+              : skelClone->getBodyNode(originalParent->getIndexInSkeleton());
 
     BodyNode* newBody = getBodyNode(i)->clone(parentClone, joint, false);
 
-    skelClone->registerBodyNode(newBody);
+    // Resizing the dynamics caches is O(dofs^2), so we do it once at the end
+    // instead of once per BodyNode
+    skelClone->registerBodyNode(newBody, false);
   }
+  skelClone->updateAllCacheDimensions();
 
   // Clone over the nodes in such a way that their indexing will match up with
   // the original
@@ -511,7 +511,8 @@ SkeletonPtr Skeleton::cloneSkeleton(const std::string& cloneName) const
     for (const auto& node : nodeType.second)
     {
       const BodyNode* originalBn = node->getBodyNodePtr();
-      BodyNode* newBn = skelClone->getBodyNode(originalBn->getName());
+      BodyNode* newBn
+          = skelClone->getBodyNode(originalBn->getIndexInSkeleton());
       node->cloneNode(newBn)->attach();
     }
   }
@@ -520,14 +521,16 @@ SkeletonPtr Skeleton::cloneSkeleton(const std::string& cloneName) const
   skelClone->setName(cloneName);
   skelClone->setState(getState());
 
-  // Fix mimic joint references
+  // Fix mimic joint references. A joint can mimic a joint in another
+  // Skeleton, in which case the clone keeps pointing at the original.
   for (std::size_t i = 0; i < getNumJoints(); ++i)
   {
     Joint* joint = skelClone->getJoint(i);
-    if (joint->getActuatorType() == Joint::MIMIC)
+    if (joint->getActuatorType() == Joint::MIMIC
+        && joint->getMimicJoint()->getSkeleton().get() == this)
     {
-      const Joint* mimicJoint
-          = skelClone->getJoint(joint->getMimicJoint()->getName());
+      const Joint* mimicJoint = skelClone->getJoint(
+          joint->getMimicJoint()->getJointIndexInSkeleton());
       if (mimicJoint)
       {
         joint->setMimicJoint(
@@ -553,9 +556,11 @@ SkeletonPtr Skeleton::cloneSkeleton(const std::string& cloneName) const
 
     cloneGroup.flipAxis = thisGroup.flipAxis;
     cloneGroup.uniformScaling = thisGroup.uniformScaling;
+    cloneGroup.nodes.reserve(thisGroup.nodes.size());
     for (auto& node : thisGroup.nodes)
     {
-      cloneGroup.nodes.push_back(skelClone->getBodyNode(node->getName()));
+      cloneGroup.nodes.push_back(
+          skelClone->getBodyNode(node->getIndexInSkeleton()));
     }
   }
   skelClone->updateGroupScaleIndices();
@@ -3831,6 +3836,15 @@ const std::vector<BodyScaleGroup>& Skeleton::getBodyScaleGroups() const
   return mBodyScaleGroups;
 }
 
+//==============================================================================
+/// This replaces the scale groups wholesale, for example when restoring a
+/// skeleton from a snapshot. Every body must appear in exactly one group.
+void Skeleton::setBodyScaleGroups(const std::vector<BodyScaleGroup>& groups)
+{
+  mBodyScaleGroups = groups;
+  updateGroupScaleIndices();
+}
+
 //==============================================================================
 const BodyScaleGroup& Skeleton::getBodyScaleGroup(int index) const
 {
@@ -5347,6 +5361,37 @@ Eigen::MatrixXs Skeleton::convertBodyScalesJacobianToGroupScales(
   return J;
 }
 
+//==============================================================================
+/// This is the sparse version of convertBodyScalesJacobianToGroupScales()
+Eigen::SparseMatrix<s_t, Eigen::RowMajor>
+Skeleton::convertBodyScalesSparseJacobianToGroupScales(
+    const Eigen::SparseMatrix<s_t, Eigen::RowMajor>& bodyScalesJac)
+{
+  // This maps body scale axis to the group scale that drives it
+  std::vector<Eigen::Triplet<s_t>> triplets;
+  int cursor = 0;
+  for (int i = 0; i < mBodyScaleGroups.size(); i++)
+  {
+    for (dynamics::BodyNode* node : mBodyScaleGroups[i].nodes)
+    {
+      for (int axis = 0; axis < 3; axis++)
+      {
+        triplets.emplace_back(
+            node->getIndexInSkeleton() * 3 + axis,
+            mBodyScaleGroups[i].uniformScaling ? cursor : cursor + axis,
+            1.0);
+      }
+    }
+    cursor += mBodyScaleGroups[i].uniformScaling ? 1 : 3;
+  }
+  assert(cursor == getGroupScaleDim());
+
+  Eigen::SparseMatrix<s_t, Eigen::RowMajor> bodyToGroup(
+      bodyScalesJac.cols(), cursor);
+  bodyToGroup.setFromTriplets(triplets.begin(), triplets.end());
+  return bodyScalesJac * bodyToGroup;
+}
+
 //==============================================================================
 /// This returns the Jacobian of the joint positions wrt the scales of the
 /// groups
@@ -5927,6 +5972,40 @@ Eigen::MatrixXs Skeleton::getJointWorldPositionsJacobianWrtJointPositions(
   return jac;
 }
 
+//==============================================================================
+/// This returns the plan cached in `cache` if it was built for exactly these
+/// markers and joints (updating the marker offsets), and otherwise replaces it
+/// with a new one. The caller must hold mSparseJacobianPlanMutex.
+static KinematicsPlan& getCachedKinematicsPlan(
+    std::shared_ptr<KinematicsPlan>& cache,
+    Skeleton* skel,
+    const std::vector<std::pair<dynamics::BodyNode*, Eigen::Vector3s>>& markers,
+    const std::vector<dynamics::Joint*>& joints)
+{
+  if (cache && cache->isPlanFor(markers, joints))
+  {
+    cache->setMarkerOffsets(markers);
+  }
+  else
+  {
+    cache = std::make_shared<KinematicsPlan>(skel, markers, joints);
+  }
+  return *cache;
+}
+
+//==============================================================================
+/// This is the sparse version of
+/// getJointWorldPositionsJacobianWrtJointPositions().
+Eigen::SparseMatrix<s_t, Eigen::RowMajor>
+Skeleton::getJointWorldPositionsSparseJacobianWrtJointPositions(
+    const std::vector<dynamics::Joint*>& joints) const
+{
+  std::lock_guard<std::mutex> lock(mSparseJacobianPlanMutex);
+  return getCachedKinematicsPlan(
+             mJointJacobianPlan, const_cast<Skeleton*>(this), {}, joints)
+      .getWorldPositionsJacobianWrtJointPositions();
+}
+
 //==============================================================================
 /// This returns the Jacobian relating changes in source skeleton joint
 /// positions to changes in source joint world positions.
@@ -6704,6 +6783,57 @@ Eigen::MatrixXs Skeleton::getMarkerWorldPositionsJacobianWrtMarkerOffsets(
   return jac;
 }
 
+//==============================================================================
+/// This is the sparse version of
+/// getMarkerWorldPositionsJacobianWrtJointPositions().
+Eigen::SparseMatrix<s_t, Eigen::RowMajor>
+Skeleton::getMarkerWorldPositionsSparseJacobianWrtJointPositions(
+    const std::vector<std::pair<dynamics::BodyNode*, Eigen::Vector3s>>& markers)
+    const
+{
+  std::lock_guard<std::mutex> lock(mSparseJacobianPlanMutex);
+  return getCachedKinematicsPlan(
+             mMarkerJacobianPlan, const_cast<Skeleton*>(this), markers, {})
+      .getWorldPositionsJacobianWrtJointPositions();
+}
+
+//==============================================================================
+/// This is the sparse version of
+/// getMarkerWorldPositionsJacobianWrtBodyScales().
+Eigen::SparseMatrix<s_t, Eigen::RowMajor>
+Skeleton::getMarkerWorldPositionsSparseJacobianWrtBodyScales(
+    const std::vector<std::pair<dynamics::BodyNode*, Eigen::Vector3s>>& markers)
+{
+  std::lock_guard<std::mutex> lock(mSparseJacobianPlanMutex);
+  return getCachedKinematicsPlan(mMarkerJacobianPlan, this, markers, {})
+      .getMarkerWorldPositionsJacobianWrtBodyScales();
+}
+
+//==============================================================================
+/// This is the sparse version of
+/// getMarkerWorldPositionsJacobianWrtGroupScales()
+Eigen::SparseMatrix<s_t, Eigen::RowMajor>
+Skeleton::getMarkerWorldPositionsSparseJacobianWrtGroupScales(
+    const std::vector<std::pair<dynamics::BodyNode*, Eigen::Vector3s>>& markers)
+{
+  return convertBodyScalesSparseJacobianToGroupScales(
+      getMarkerWorldPositionsSparseJacobianWrtBodyScales(markers));
+}
+
+//==============================================================================
+/// This is the sparse version of
+/// getMarkerWorldPositionsJacobianWrtMarkerOffsets(), which is block diagonal.
+Eigen::SparseMatrix<s_t, Eigen::RowMajor>
+Skeleton::getMarkerWorldPositionsSparseJacobianWrtMarkerOffsets(
+    const std::vector<std::pair<dynamics::BodyNode*, Eigen::Vector3s>>& markers)
+    const
+{
+  std::lock_guard<std::mutex> lock(mSparseJacobianPlanMutex);
+  return getCachedKinematicsPlan(
+             mMarkerJacobianPlan, const_cast<Skeleton*>(this), markers, {})
+      .getMarkerWorldPositionsJacobianWrtMarkerOffsets();
+}
+
 //==============================================================================
 /// This returns the Jacobian relating changes in marker offsets to changes in
 /// marker world positions.
@@ -11453,8 +11583,18 @@ void Skeleton::constructNewTree()
 }
 
 //==============================================================================
-void Skeleton::registerBodyNode(BodyNode* _newBodyNode)
+void Skeleton::resetSparseJacobianPlans()
+{
+  std::lock_guard<std::mutex> lock(mSparseJacobianPlanMutex);
+  mMarkerJacobianPlan.reset();
+  mJointJacobianPlan.reset();
+}
+
+//==============================================================================
+void Skeleton::registerBodyNode(BodyNode* _newBodyNode, bool _updateCaches)
 {
+  resetSparseJacobianPlans();
+
 #ifndef NDEBUG // Debug mode
   std::vector<BodyNode*>::iterator repeat = std::find(
       mSkelCache.mBodyNodes.begin(), mSkelCache.mBodyNodes.end(), _newBodyNode);
@@ -11506,8 +11646,11 @@ void Skeleton::registerBodyNode(BodyNode* _newBodyNode)
     for (auto& node : nodeType.second)
       registerNode(node);
 
-  updateTotalMass();
-  updateCacheDimensions(_newBodyNode->mTreeIndex);
+  if (_updateCaches)
+  {
+    updateTotalMass();
+    updateCacheDimensions(_newBodyNode->mTreeIndex);
+  }
 
 #ifndef NDEBUG // Debug mode
   for (std::size_t i = 0; i < mSkelCache.mBodyNodes.size(); ++i)
@@ -11556,6 +11699,8 @@ void Skeleton::registerBodyNode(BodyNode* _newBodyNode)
 //==============================================================================
 void Skeleton::registerJoint(Joint* _newJoint)
 {
+  resetSparseJacobianPlans();
+
   if (nullptr == _newJoint)
   {
     dterr << "[Skeleton::registerJoint] Error: Attempting to add a nullptr "
@@ -11727,6 +11872,8 @@ void Skeleton::unregisterBodyNode(BodyNode* _oldBodyNode)
 //==============================================================================
 void Skeleton::unregisterJoint(Joint* _oldJoint)
 {
+  resetSparseJacobianPlans();
+
   if (nullptr == _oldJoint)
   {
     dterr << "[Skeleton::unregisterJoint] Attempting to unregister nullptr "
@@ -12043,7 +12190,8 @@ std::vector<BodyNode*> Skeleton::extractBodyNodeTree(BodyNode* _bodyNode)
 void Skeleton::receiveBodyNodeTree(const std::vector<BodyNode*>& _tree)
 {
   for (BodyNode* bn : _tree)
-    registerBodyNode(bn);
+    registerBodyNode(bn, false);
+  updateAllCacheDimensions();
 }
 
 //==============================================================================
@@ -12078,6 +12226,18 @@ void Skeleton::updateCacheDimensions(std::size_t _treeIdx)
   dirtyArticulatedInertia(_treeIdx);
 }
 
+//==============================================================================
+void Skeleton::updateAllCacheDimensions()
+{
+  updateTotalMass();
+  for (std::size_t i = 0; i < mTreeCache.size(); ++i)
+  {
+    updateCacheDimensions(mTreeCache[i]);
+    dirtyArticulatedInertia(i);
+  }
+  updateCacheDimensions(mSkelCache);
+}
+
 //==============================================================================
 void Skeleton::updateArticulatedInertia(std::size_t _tree) const
 {
@@ -37,6 +37,8 @@
 #include <memory>
 #include <mutex>
 
+#include <Eigen/Sparse>
+
 #include "dart/common/NameManager.hpp"
 #include "dart/common/VersionCounter.hpp"
 #include "dart/dynamics/EndEffector.hpp"
@@ -60,6 +62,8 @@ class ConstrainedGroupGradientMatrices;
 
 namespace dynamics {
 
+class KinematicsPlan;
+
 typedef std::map<std::string, std::pair<dynamics::BodyNode*, Eigen::Vector3s>>
     MarkerMap;
 
@@ -985,6 +989,10 @@ public:
 
   const BodyScaleGroup& getBodyScaleGroup(int index) const;
 
+  /// This replaces the scale groups wholesale, for example when restoring a
+  /// skeleton from a snapshot. Every body must appear in exactly one group.
+  void setBodyScaleGroups(const std::vector<BodyScaleGroup>& groups);
+
   /// This creates scale groups for any body nodes that may've been added since
   /// we last interacted with the body scale group APIs
   void ensureBodyScaleGroups();
@@ -1226,6 +1234,11 @@ public:
   Eigen::MatrixXs convertBodyScalesJacobianToGroupScales(
       Eigen::MatrixXs bodyScalesJac);
 
+  /// This is the sparse version of convertBodyScalesJacobianToGroupScales()
+  Eigen::SparseMatrix<s_t, Eigen::RowMajor>
+  convertBodyScalesSparseJacobianToGroupScales(
+      const Eigen::SparseMatrix<s_t, Eigen::RowMajor>& bodyScalesJac);
+
   /// This returns the Jacobian of the joint positions wrt the scales of the
   /// groups
   Eigen::MatrixXs getJointWorldPositionsJacobianWrtGroupScales(
@@ -1341,6 +1354,13 @@ public:
   Eigen::MatrixXs getJointWorldPositionsJacobianWrtJointPositions(
       const std::vector<dynamics::Joint*>& joints) const;
 
+  /// This is the sparse version of
+  /// getJointWorldPositionsJacobianWrtJointPositions(). Each joint only has
+  /// entries for the DOFs between it and the root.
+  Eigen::SparseMatrix<s_t, Eigen::RowMajor>
+  getJointWorldPositionsSparseJacobianWrtJointPositions(
+      const std::vector<dynamics::Joint*>& joints) const;
+
   /// This returns the Jacobian relating changes in source skeleton joint
   /// positions to changes in source joint world positions.
   Eigen::MatrixXs finiteDifferenceJointWorldPositionsJacobianWrtJointPositions(
@@ -1507,6 +1527,37 @@ public:
       const std::vector<std::pair<dynamics::BodyNode*, Eigen::Vector3s>>&
           markers) const;
 
+  /// This is the sparse version of
+  /// getMarkerWorldPositionsJacobianWrtJointPositions(). Each marker only has
+  /// entries for the DOFs between its body and the root.
+  Eigen::SparseMatrix<s_t, Eigen::RowMajor>
+  getMarkerWorldPositionsSparseJacobianWrtJointPositions(
+      const std::vector<std::pair<dynamics::BodyNode*, Eigen::Vector3s>>&
+          markers) const;
+
+  /// This is the sparse version of
+  /// getMarkerWorldPositionsJacobianWrtBodyScales(). Each marker only has
+  /// entries for its own body and the bodies between it and the root.
+  Eigen::SparseMatrix<s_t, Eigen::RowMajor>
+  getMarkerWorldPositionsSparseJacobianWrtBodyScales(
+      const std::vector<std::pair<dynamics::BodyNode*, Eigen::Vector3s>>&
+          markers);
+
+  /// This is the sparse version of
+  /// getMarkerWorldPositionsJacobianWrtGroupScales()
+  Eigen::SparseMatrix<s_t, Eigen::RowMajor>
+  getMarkerWorldPositionsSparseJacobianWrtGroupScales(
+      const std::vector<std::pair<dynamics::BodyNode*, Eigen::Vector3s>>&
+          markers);
+
+  /// This is the sparse version of
+  /// getMarkerWorldPositionsJacobianWrtMarkerOffsets(), which is block
+  /// diagonal.
+  Eigen::SparseMatrix<s_t, Eigen::RowMajor>
+  getMarkerWorldPositionsSparseJacobianWrtMarkerOffsets(
+      const std::vector<std::pair<dynamics::BodyNode*, Eigen::Vector3s>>&
+          markers) const;
+
   /// This returns the Jacobian relating changes in marker offsets to changes in
   /// marker world positions.
   Eigen::MatrixXs finiteDifferenceMarkerWorldPositionsJacobianWrtMarkerOffsets(
@@ -2634,8 +2685,11 @@ protected:
   /// Construct a new tree in the Skeleton
   void constructNewTree();
 
-  /// Register a BodyNode with the Skeleton. Internal use only.
-  void registerBodyNode(BodyNode* _newBodyNode);
+  /// Register a BodyNode with the Skeleton. Internal use only. If
+  /// _updateCaches is false, this skips resizing the dynamics caches and
+  /// summing the total mass, so callers registering many BodyNodes at once
+  /// must call updateAllCacheDimensions() when they're done.
+  void registerBodyNode(BodyNode* _newBodyNode, bool _updateCaches = true);
 
   /// Register a Joint with the Skeleton. Internal use only.
   void registerJoint(Joint* _newJoint);
@@ -2655,6 +2709,10 @@ protected:
   /// Remove a Joint from the Skeleton. Internal use only.
   void unregisterJoint(Joint* _oldJoint);
 
+  /// Throw away the cached sparse Jacobian plans, because our structure
+  /// changed. Internal use only.
+  void resetSparseJacobianPlans();
+
   /// Remove a Node from the Skeleton. Internal use only.
   void unregisterNode(NodeMap& nodeMap, Node* _oldNode, std::size_t& _index);
 
@@ -2720,6 +2778,10 @@ protected:
   /// Update the dimensions for a tree's cache
   void updateCacheDimensions(std::size_t _treeIdx);
 
+  /// Update the total mass, and the dimensions of every tree's cache and the
+  /// Skeleton's cache
+  void updateAllCacheDimensions();
+
   /// Update the articulated inertia of a tree
   void updateArticulatedInertia(std::size_t _tree) const;
 
@@ -2959,6 +3021,14 @@ protected:
 
   mutable std::mutex mMutex;
 
+  /// These are the plans behind the sparse marker and joint world position
+  /// Jacobians, kept between calls so the sparsity patterns are only worked
+  /// out again when the set of markers or joints (or our structure) changes.
+  /// They're guarded by mSparseJacobianPlanMutex.
+  mutable std::shared_ptr<KinematicsPlan> mMarkerJacobianPlan;
+  mutable std::shared_ptr<KinematicsPlan> mJointJacobianPlan;
+  mutable std::mutex mSparseJacobianPlanMutex;
+
 public:
   //--------------------------------------------------------------------------
   // Union finding
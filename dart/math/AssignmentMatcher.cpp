@@ -1,5 +1,13 @@
 #include "dart/math/AssignmentMatcher.hpp"
 
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
 namespace dart {
 namespace math {
 
@@ -60,6 +68,287 @@ Eigen::VectorXi AssignmentMatcher::assignRowsToColumns(
   return mapping;
 }
 
+/// This is the same as assignRowsToColumns(), but only considers the
+/// (row, col, weight) `candidates` passed in. Every other pair is treated as
+/// if it had a weight of -infinity, and will never be assigned.
+Eigen::VectorXi AssignmentMatcher::assignRowsToColumnsSparse(
+    int numRows,
+    int numCols,
+    const std::vector<Eigen::Triplet<s_t>>& candidates)
+{
+  // The dense greedy algorithm repeatedly takes the highest remaining weight,
+  // breaking ties by the first (row, col) in row-major order. Visiting the
+  // edges once in that same order gives the same assignments.
+  std::vector<int> order;
+  order.reserve(candidates.size());
+  for (int i = 0; i < candidates.size(); i++)
+  {
+    if (candidates[i].value() > -1 * std::numeric_limits<double>::infinity())
+    {
+      order.push_back(i);
+    }
+  }
+  std::sort(order.begin(), order.end(), [&](int a, int b) {
+    const Eigen::Triplet<s_t>& edgeA = candidates[a];
+    const Eigen::Triplet<s_t>& edgeB = candidates[b];
+    if (edgeA.value() != edgeB.value())
+    {
+      return edgeA.value() > edgeB.value();
+    }
+    if (edgeA.row() != edgeB.row())
+    {
+      return edgeA.row() < edgeB.row();
+    }
+    return edgeA.col() < edgeB.col();
+  });
+
+  Eigen::VectorXi mapping = -1 * Eigen::VectorXi::Ones(numRows);
+  std::vector<bool> colAssigned(numCols, false);
+  int numAssigned = 0;
+  for (int i : order)
+  {
+    if (numAssigned == std::min(numRows, numCols))
+    {
+      break;
+    }
+    const Eigen::Triplet<s_t>& edge = candidates[i];
+    if (mapping(edge.row()) == -1 && !colAssigned[edge.col()])
+    {
+      mapping(edge.row()) = edge.col();
+      colAssigned[edge.col()] = true;
+      numAssigned++;
+    }
+  }
+
+  return mapping;
+}
+
+/// This finds the assignment of rows to columns with the highest total
+/// weight, only considering the (row, col, weight) `candidates` passed in.
+Eigen::VectorXi AssignmentMatcher::assignRowsToColumnsOptimal(
+    int numRows,
+    int numCols,
+    const std::vector<Eigen::Triplet<s_t>>& candidates)
+{
+  // We solve this as a min-cost problem, with cost = -weight, using successive
+  // shortest augmenting paths (as in Jonker-Volgenant). Every row also gets a
+  // private "dummy" column with a cost of 0, which stands for leaving that row
+  // unassigned, so columns [0, numCols) are real and column numCols + i is row
+  // i's dummy.
+  //
+  // We keep a potential for every row and column, such that the reduced cost
+  // (cost + rowPotential - colPotential) is >= 0 on every edge and exactly 0
+  // on every assigned edge. That lets each augmenting path search use
+  // Dijkstra. Every unassigned column also leads on to a shared sink with a
+  // potential of 0, so unassigned columns keep potentials >= 0 and assigned
+  // columns <= 0.
+  const int totalCols = numCols + numRows;
+
+  s_t maxAbsWeight = 0.0;
+  for (const Eigen::Triplet<s_t>& edge : candidates)
+  {
+    if (std::isfinite((double)edge.value()))
+    {
+      maxAbsWeight = std::max(maxAbsWeight, (s_t)std::abs(edge.value()));
+    }
+  }
+  // Stand in for +infinity weights with something larger than any possible
+  // total of finite weights
+  const s_t infiniteWeight = 2 * (numRows + 1) * (maxAbsWeight + 1);
+
+  // Negative weights (and -infinity) would only ever lower the total compared
+  // to leaving the row unassigned, so we drop them up front. What's left goes
+  // into compressed rows, with the dummy column first.
+  std::vector<int> rowStart(numRows + 1, 0);
+  for (const Eigen::Triplet<s_t>& edge : candidates)
+  {
+    if (edge.value() >= 0)
+    {
+      rowStart[edge.row() + 1]++;
+    }
+  }
+  for (int row = 0; row < numRows; row++)
+  {
+    rowStart[row + 1] += rowStart[row] + 1;
+  }
+  std::vector<int> edgeCol(rowStart[numRows]);
+  std::vector<s_t> edgeCost(rowStart[numRows]);
+  std::vector<int> nextEdge(rowStart.begin(), rowStart.end() - 1);
+  for (int row = 0; row < numRows; row++)
+  {
+    edgeCol[nextEdge[row]] = numCols + row;
+    edgeCost[nextEdge[row]] = 0.0;
+    nextEdge[row]++;
+  }
+  for (const Eigen::Triplet<s_t>& edge : candidates)
+  {
+    if (edge.value() >= 0)
+    {
+      int index = nextEdge[edge.row()]++;
+      edgeCol[index] = edge.col();
+      edgeCost[index] = std::isfinite((double)edge.value())
+                            ? -1 * edge.value()
+                            : -1 * infiniteWeight;
+    }
+  }
+
+  // To start, every row takes its favorite column if no other row already
+  // has, which is all the matching most sparse problems need. With all column
+  // potentials at 0, the row potentials are just the best weight for each row.
+  std::vector<s_t> colPotential(totalCols, 0.0);
+  std::vector<s_t> rowPotential(numRows);
+  std::vector<int> rowToCol(numRows, -1);
+  std::vector<int> colToRow(totalCols, -1);
+  for (int row = 0; row < numRows; row++)
+  {
+    int bestEdge = rowStart[row];
+    for (int e = rowStart[row] + 1; e < rowStart[row + 1]; e++)
+    {
+      if (edgeCost[e] < edgeCost[bestEdge])
+      {
+        bestEdge = e;
+      }
+    }
+    int col = edgeCol[bestEdge];
+    rowPotential[row] = -1 * edgeCost[bestEdge];
+    if (colToRow[col] == -1)
+    {
+      rowToCol[row] = col;
+      colToRow[col] = row;
+    }
+  }
+
+  // Scratch space for the searches, which we reset only where it was touched
+  std::vector<s_t> dist(totalCols, std::numeric_limits<double>::infinity());
+  std::vector<int> predRow(totalCols, -1);
+  std::vector<bool> finalized(totalCols, false);
+  std::vector<int> touchedCols;
+  std::vector<int> finalizedCols;
+  std::vector<std::pair<int, s_t>> finalizedRows;
+  std::priority_queue<
+      std::pair<s_t, int>,
+      std::vector<std::pair<s_t, int>>,
+      std::greater<std::pair<s_t, int>>>
+      queue;
+
+  for (int source = 0; source < numRows; source++)
+  {
+    if (rowToCol[source] != -1)
+    {
+      continue;
+    }
+    // Dijkstra over the reduced costs, from `source` to the sink. Entering an
+    // assigned column continues along its (zero reduced cost) assigned edge to
+    // its row, and entering an unassigned column offers a path to the sink.
+    int row = source;
+    s_t rowDist = 0.0;
+    int target = -1;
+    s_t targetDist = std::numeric_limits<double>::infinity();
+    while (row != -1)
+    {
+      finalizedRows.emplace_back(row, rowDist);
+      for (int e = rowStart[row]; e < rowStart[row + 1]; e++)
+      {
+        int col = edgeCol[e];
+        if (finalized[col])
+        {
+          continue;
+        }
+        s_t d = rowDist + edgeCost[e] + rowPotential[row] - colPotential[col];
+        if (d < dist[col])
+        {
+          if (dist[col] == std::numeric_limits<double>::infinity())
+          {
+            touchedCols.push_back(col);
+          }
+          dist[col] = d;
+          predRow[col] = row;
+          queue.emplace(d, col);
+        }
+      }
+
+      row = -1;
+      while (!queue.empty())
+      {
+        std::pair<s_t, int> top = queue.top();
+        if (finalized[top.second] || top.first != dist[top.second])
+        {
+          queue.pop();
+          continue;
+        }
+        if (top.first >= targetDist)
+        {
+          break;
+        }
+        queue.pop();
+        int col = top.second;
+        finalized[col] = true;
+        finalizedCols.push_back(col);
+        if (colToRow[col] == -1)
+        {
+          s_t sinkDist = top.first + colPotential[col];
+          if (sinkDist < targetDist)
+          {
+            target = col;
+            targetDist = sinkDist;
+          }
+          continue;
+        }
+        row = colToRow[col];
+        rowDist = top.first;
+        break;
+      }
+    }
+    // The source's dummy column always leads to the sink, so this can't happen
+    assert(target != -1);
+
+    // Update the potentials so that the path we found has zero reduced cost,
+    // while every other edge stays non-negative
+    for (int col : finalizedCols)
+    {
+      colPotential[col] += dist[col] - targetDist;
+    }
+    for (const std::pair<int, s_t>& finalizedRow : finalizedRows)
+    {
+      rowPotential[finalizedRow.first] += finalizedRow.second - targetDist;
+    }
+
+    // Flip the assignments along the path
+    int col = target;
+    while (col != -1)
+    {
+      int pathRow = predRow[col];
+      int previousCol = rowToCol[pathRow];
+      rowToCol[pathRow] = col;
+      colToRow[col] = pathRow;
+      col = pathRow == source ? -1 : previousCol;
+    }
+
+    for (int touched : touchedCols)
+    {
+      dist[touched] = std::numeric_limits<double>::infinity();
+      finalized[touched] = false;
+    }
+    touchedCols.clear();
+    finalizedCols.clear();
+    finalizedRows.clear();
+    queue = std::priority_queue<
+        std::pair<s_t, int>,
+        std::vector<std::pair<s_t, int>>,
+        std::greater<std::pair<s_t, int>>>();
+  }
+
+  Eigen::VectorXi mapping = -1 * Eigen::VectorXi::Ones(numRows);
+  for (int row = 0; row < numRows; row++)
+  {
+    if (rowToCol[row] < numCols)
+    {
+      mapping(row) = rowToCol[row];
+    }
+  }
+  return mapping;
+}
+
 std::map<std::string, std::string> AssignmentMatcher::assignKeysToKeys(
     std::vector<std::string> source,
     std::vector<std::string> target,
@@ -1,6 +1,10 @@
 #ifndef MATH_ASSIGNMENT_MATCHER_H_
 #define MATH_ASSIGNMENT_MATCHER_H_
 
+#include <vector>
+
+#include <Eigen/Sparse>
+
 #include "dart/math/CustomFunction.hpp"
 #include "dart/math/MathTypes.hpp"
 
@@ -14,6 +18,30 @@ public:
   /// unassigned rows get assigned to -1
   static Eigen::VectorXi assignRowsToColumns(const Eigen::MatrixXs& weights);
 
+  /// This is the same as assignRowsToColumns(), but only considers the
+  /// (row, col, weight) `candidates` passed in. Every other pair is treated as
+  /// if it had a weight of -infinity, and will never be assigned. When only a
+  /// few pairs per row are plausible this is much cheaper than filling in and
+  /// scanning a dense weight matrix.
+  static Eigen::VectorXi assignRowsToColumnsSparse(
+      int numRows,
+      int numCols,
+      const std::vector<Eigen::Triplet<s_t>>& candidates);
+
+  /// This finds the assignment of rows to columns with the highest total
+  /// weight, only considering the (row, col, weight) `candidates` passed in.
+  /// Unlike assignRowsToColumns(), which is greedy, this is optimal. A row is
+  /// left unassigned (-1) rather than take a candidate that would lower the
+  /// total weight, so negative weight candidates are never used.
+  ///
+  /// This solves by shortest augmenting paths over only the candidate pairs,
+  /// so when there are only a few plausible candidates for each row it scales
+  /// to thousands of rows, where the O(n^3) dense methods can't.
+  static Eigen::VectorXi assignRowsToColumnsOptimal(
+      int numRows,
+      int numCols,
+      const std::vector<Eigen::Triplet<s_t>>& candidates);
+
   static std::map<std::string, std::string> assignKeysToKeys(
       std::vector<std::string> source,
       std::vector<std::string> target,
@@ -0,0 +1,154 @@
+#include "dart/math/BandedCholesky.hpp"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "dart/math/MathTypes.hpp"
+
+namespace dart {
+namespace math {
+
+//==============================================================================
+/// `band` holds the lower band of A, with `bandwidth + 1` rows and one
+/// column for each row of A, so that band(k, j) = A(j + k, j). Entries past
+/// the bottom of A are ignored.
+BandedCholesky::BandedCholesky(const Eigen::MatrixXs& band)
+  : mBandwidth(std::max(0, (int)band.rows() - 1)),
+    mL(Eigen::MatrixXs::Zero(band.rows(), band.cols())),
+    mPositiveDefinite(true)
+{
+  const int n = band.cols();
+  for (int j = 0; j < n; j++)
+  {
+    for (int k = 0; k <= mBandwidth && j + k < n; k++)
+    {
+      const int i = j + k;
+      s_t sum = band(k, j);
+      for (int l = std::max(0, i - mBandwidth); l < j; l++)
+      {
+        sum -= mL(i - l, l) * mL(j - l, l);
+      }
+      if (k == 0)
+      {
+        if (sum <= 0)
+        {
+          mPositiveDefinite = false;
+          return;
+        }
+        mL(0, j) = sqrt(sum);
+      }
+      else
+      {
+        mL(k, j) = sum / mL(0, j);
+      }
+    }
+  }
+}
+
+//==============================================================================
+/// This returns the factor of (I + D^T * D), where D is the
+/// (timesteps - stencil.size() + 1) x timesteps finite difference operator
+/// that applies `stencil` at every timestep it fits in.
+std::shared_ptr<const BandedCholesky> BandedCholesky::factorSmoothingSystem(
+    const Eigen::VectorXs& stencil, int timesteps)
+{
+  static std::mutex cacheMutex;
+  static std::map<
+      std::pair<int, std::vector<s_t>>,
+      std::shared_ptr<const BandedCholesky>>
+      cache;
+
+  std::pair<int, std::vector<s_t>> key(
+      timesteps,
+      std::vector<s_t>(stencil.data(), stencil.data() + stencil.size()));
+  {
+    const std::lock_guard<std::mutex> lock(cacheMutex);
+    auto found = cache.find(key);
+    if (found != cache.end())
+    {
+      return found->second;
+    }
+  }
+
+  const int width = stencil.size();
+  Eigen::MatrixXs band = Eigen::MatrixXs::Zero(std::max(1, width), timesteps);
+  band.row(0).setOnes();
+  for (int row = 0; row + width <= timesteps; row++)
+  {
+    for (int p = 0; p < width; p++)
+    {
+      for (int q = p; q < width; q++)
+      {
+        band(q - p, row + p) += stencil(p) * stencil(q);
+      }
+    }
+  }
+  std::shared_ptr<const BandedCholesky> factor
+      = std::make_shared<BandedCholesky>(band);
+
+  const std::lock_guard<std::mutex> lock(cacheMutex);
+  // Callers almost always cycle through a handful of trial lengths, so rather
+  // than track recency we just start over if the cache ever gets large.
+  if (cache.size() >= 32)
+  {
+    cache.clear();
+  }
+  cache[key] = factor;
+  return factor;
+}
+
+//==============================================================================
+/// This solves A * x = b for every row b of `rhs`, in place.
+void BandedCholesky::solveRowsInPlace(Eigen::MatrixXs& rhs) const
+{
+  assert(rhs.cols() == mL.cols());
+  const int n = mL.cols();
+
+  // Forward substitution, L * y = b
+  for (int i = 0; i < n; i++)
+  {
+    for (int k = 1; k <= std::min(i, mBandwidth); k++)
+    {
+      rhs.col(i) -= mL(k, i - k) * rhs.col(i - k);
+    }
+    rhs.col(i) /= mL(0, i);
+  }
+
+  // Back substitution, L^T * x = y
+  for (int i = n - 1; i >= 0; i--)
+  {
+    for (int k = 1; k <= std::min(n - 1 - i, mBandwidth); k++)
+    {
+      rhs.col(i) -= mL(k, i) * rhs.col(i + k);
+    }
+    rhs.col(i) /= mL(0, i);
+  }
+}
+
+//==============================================================================
+/// This returns the size of A
+int BandedCholesky::size() const
+{
+  return mL.cols();
+}
+
+//==============================================================================
+/// This returns the number of non-zero sub-diagonals of A
+int BandedCholesky::getBandwidth() const
+{
+  return mBandwidth;
+}
+
+//==============================================================================
+/// This returns true if the factorization succeeded, which is false if A was
+/// not positive definite.
+bool BandedCholesky::isPositiveDefinite() const
+{
+  return mPositiveDefinite;
+}
+
+} // namespace math
+} // namespace dart
@@ -0,0 +1,59 @@
+#ifndef MATH_BANDEDCHOLESKY_H_
+#define MATH_BANDEDCHOLESKY_H_
+
+#include <memory>
+
+#include "dart/math/MathTypes.hpp"
+
+namespace dart {
+namespace math {
+
+/// This is a Cholesky factorization A = L * L^T of a symmetric positive
+/// definite matrix with only `bandwidth` non-zero sub-diagonals. Factoring
+/// costs O(n * bandwidth^2) and each solve O(n * bandwidth), instead of the
+/// O(n^3) and O(n^2) of a dense factorization.
+class BandedCholesky
+{
+public:
+  /// `band` holds the lower band of A, with `bandwidth + 1` rows and one
+  /// column for each row of A, so that band(k, j) = A(j + k, j). Entries past
+  /// the bottom of A are ignored.
+  BandedCholesky(const Eigen::MatrixXs& band);
+
+  /// This returns the factor of (I + D^T * D), where D is the
+  /// (timesteps - stencil.size() + 1) x timesteps finite difference operator
+  /// that applies `stencil` at every timestep it fits in. This is the normal
+  /// equations of the least squares smoothing problems in
+  /// utils::AccelerationSmoother and utils::VelocityMinimizingSmoother.
+  ///
+  /// Factors are cached by (stencil, timesteps), so repeatedly smoothing
+  /// trials of the same length only pays for the factorization once.
+  static std::shared_ptr<const BandedCholesky> factorSmoothingSystem(
+      const Eigen::VectorXs& stencil, int timesteps);
+
+  /// This solves A * x = b for every row b of `rhs`, in place. Each row is an
+  /// independent right hand side, so `rhs` must have one column for every
+  /// row of A.
+  void solveRowsInPlace(Eigen::MatrixXs& rhs) const;
+
+  /// This returns the size of A
+  int size() const;
+
+  /// This returns the number of non-zero sub-diagonals of A
+  int getBandwidth() const;
+
+  /// This returns true if the factorization succeeded, which is false if A was
+  /// not positive definite.
+  bool isPositiveDefinite() const;
+
+protected:
+  int mBandwidth;
+  /// The lower band of L, with mL(k, j) = L(j + k, j)
+  Eigen::MatrixXs mL;
+  bool mPositiveDefinite;
+};
+
+} // namespace math
+} // namespace dart
+
+#endif
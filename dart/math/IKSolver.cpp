@@ -4,6 +4,7 @@
 #include <array>
 #include <cassert>
 #include <cmath>
+#include <future>
 #include <iomanip>
 #include <iostream>
 #include <string>
@@ -204,67 +205,135 @@ s_t solveIK(
         getRandomRestart,
     IKConfig config)
 {
+  std::vector<IKProblemCopy> copies;
+  copies.push_back(IKProblemCopy{setPosAndClamp, eval});
+  return solveIKParallel(
+      initialPos,
+      upperBound,
+      lowerBound,
+      targetSize,
+      copies,
+      getRandomRestart,
+      config);
+}
+
+s_t solveIKParallel(
+    const Eigen::VectorXs& initialPos,
+    const Eigen::VectorXs& upperBound,
+    const Eigen::VectorXs& lowerBound,
+    int targetSize,
+    const std::vector<IKProblemCopy>& copies,
+    std::function<void(/*out*/ Eigen::Ref<Eigen::VectorXs> pos)>
+        getRandomRestart,
+    IKConfig config)
+{
+  assert(copies.size() > 0);
+  const IKProblemCopy& main = copies[0];
+
 #ifndef NDEBUG
   verifyJacobian(
       initialPos,
       upperBound,
       lowerBound,
       targetSize,
-      setPosAndClamp,
-      eval,
+      main.setPosAndClamp,
+      main.eval,
       config);
 #endif
 
   s_t bestError = std::numeric_limits<s_t>::infinity();
   Eigen::VectorXs bestResult = initialPos;
 
-  Eigen::VectorXs pos = setPosAndClamp(initialPos, config.startClamped);
+  Eigen::VectorXs pos = main.setPosAndClamp(initialPos, config.startClamped);
 
   // For each of the restarts, only do 20 steps, to gauge which one seems most
-  // promising
-  for (int k = 0; k < config.maxRestarts; k++)
+  // promising. We run the restarts in batches, one per copy of the problem.
+  int batchSize = copies.size();
+  bool terminated = false;
+  for (int batchStart = 0; batchStart < config.maxRestarts && !terminated;
+       batchStart += batchSize)
   {
-    if (k > 0)
+    int batchEnd = std::min(batchStart + batchSize, config.maxRestarts);
+
+    // Draw the random restarts up front, on this thread, so that we get the
+    // same sequence of restarts no matter how many copies we're running
+    std::vector<Eigen::VectorXs> startPoses;
+    for (int k = batchStart; k < batchEnd; k++)
     {
-      getRandomRestart(pos);
-      pos = setPosAndClamp(pos, true);
-      if (config.logOutput)
+      if (k > 0)
       {
-        std::cout << "## IK random restart " << k << " [best = " << bestError
-                  << "]" << std::endl;
+        getRandomRestart(pos);
       }
+      startPoses.push_back(pos);
     }
 
-    IKResult result = refineIK(
-        pos,
-        upperBound,
-        lowerBound,
-        targetSize,
-        setPosAndClamp,
-        eval,
-        IKConfig(config).setMaxStepCount(20));
+    auto runRestart = [&](int k) {
+      const IKProblemCopy& copy = copies[k - batchStart];
+      Eigen::VectorXs startPos = startPoses[k - batchStart];
+      if (k > 0)
+      {
+        startPos = copy.setPosAndClamp(startPos, true);
+      }
+      return refineIK(
+          startPos,
+          upperBound,
+          lowerBound,
+          targetSize,
+          copy.setPosAndClamp,
+          copy.eval,
+          IKConfig(config).setMaxStepCount(20));
+    };
+
+    std::vector<IKResult> results;
+    if (batchEnd - batchStart == 1)
+    {
+      results.push_back(runRestart(batchStart));
+    }
+    else
+    {
+      std::vector<std::future<IKResult>> futures;
+      for (int k = batchStart; k < batchEnd; k++)
+      {
+        futures.push_back(std::async(std::launch::async, runRestart, k));
+      }
+      for (auto& future : futures)
+      {
+        results.push_back(future.get());
+      }
+    }
 
-    if (result.loss < bestError && (result.clamped || !isfinite(bestError)))
+    for (int k = batchStart; k < batchEnd; k++)
     {
-      bestError = result.loss;
-      bestResult = result.pos;
-      if (result.loss <= config.lossLowerBound)
+      const IKResult& result = results[k - batchStart];
+      if (k > 0 && config.logOutput)
       {
-        if (config.logOutput)
+        std::cout << "## IK random restart " << k << " [best = " << bestError
+                  << "]" << std::endl;
+      }
+
+      if (result.loss < bestError && (result.clamped || !isfinite(bestError)))
+      {
+        bestError = result.loss;
+        bestResult = result.pos;
+        if (result.loss <= config.lossLowerBound)
         {
-          std::cout
-              << "Terminating random restarts early, because we found an loss "
-              << bestError << " <= " << config.lossLowerBound
-              << " that satisfies or exceeds the loss lower-bound we "
-                 "were expecting."
-              << std::endl;
+          if (config.logOutput)
+          {
+            std::cout << "Terminating random restarts early, because we found "
+                         "an loss "
+                      << bestError << " <= " << config.lossLowerBound
+                      << " that satisfies or exceeds the loss lower-bound we "
+                         "were expecting."
+                      << std::endl;
+          }
+          terminated = true;
+          break;
         }
-        break;
       }
     }
   }
 
-  setPosAndClamp(bestResult, true);
+  main.setPosAndClamp(bestResult, true);
 
   // For the best restart, run the remainder of the steps to further refine the
   // IK solution
@@ -273,8 +342,8 @@ s_t solveIK(
       upperBound,
       lowerBound,
       targetSize,
-      setPosAndClamp,
-      eval,
+      main.setPosAndClamp,
+      main.eval,
       config);
 
   if (config.logOutput)
@@ -451,7 +520,10 @@ IKResult refineIK(
       }
       else
       {
-        if (J.cols() < J.rows())
+        // (J^T J + dI)^-1 J^T == J^T (J J^T + dI)^-1, so we factor whichever
+        // of the two systems is smaller. Marker IK usually has many more rows
+        // (3 per marker) than columns (DOFs).
+        if (J.rows() < J.cols())
         {
           Eigen::MatrixXs toInvert
               = J * J.transpose()
@@ -2,6 +2,7 @@
 #define DART_MATH_IK_SOLVER_HPP_
 
 #include <functional>
+#include <vector>
 
 #include <Eigen/Dense>
 
@@ -48,6 +49,20 @@ struct IKResult
   bool clamped;
 };
 
+/// This holds the callbacks for one independent copy of an IK problem (for
+/// example, one built around its own cloned Skeleton), so that several copies
+/// can be stepped at the same time on different threads.
+struct IKProblemCopy
+{
+  std::function<Eigen::VectorXs(
+      /* in*/ const Eigen::VectorXs& pos, bool clamp)>
+      setPosAndClamp;
+  std::function<void(
+      /*out*/ Eigen::Ref<Eigen::VectorXs> diff,
+      /*out*/ Eigen::Ref<Eigen::MatrixXs> jac)>
+      eval;
+};
+
 void verifyJacobian(
     const Eigen::VectorXs& atPos,
     const Eigen::VectorXs& upperBound,
@@ -74,6 +89,23 @@ s_t solveIK(
         getRandomRestart,
     IKConfig config = IKConfig());
 
+/// This runs the same search as solveIK(), but the random restarts are run in
+/// batches of `copies.size()`, one restart per copy, each on its own thread.
+/// The restart poses are drawn on the calling thread in the same order as
+/// solveIK() draws them, and the batch results are scanned in restart order,
+/// so this finds the same solution as solveIK() and only wastes some work
+/// past an early termination. The final refinement runs on copies[0], which
+/// is left at the solution.
+s_t solveIKParallel(
+    const Eigen::VectorXs& initialPos,
+    const Eigen::VectorXs& upperBound,
+    const Eigen::VectorXs& lowerBound,
+    int targetSize,
+    const std::vector<IKProblemCopy>& copies,
+    std::function<void(/*out*/ Eigen::Ref<Eigen::VectorXs> pos)>
+        getRandomRestart,
+    IKConfig config = IKConfig());
+
 IKResult refineIK(
     const Eigen::VectorXs& initialPos,
     const Eigen::VectorXs& upperBound,
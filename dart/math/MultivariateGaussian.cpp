@@ -113,9 +113,12 @@ s_t MultivariateGaussian::computePDF(Eigen::VectorXs x)
 
 s_t MultivariateGaussian::computeLogPDF(Eigen::VectorXs x, bool normalized)
 {
+  // diff^T * cov^-1 * diff = |L^-1 * diff|^2, which only needs one triangular
+  // solve rather than two
   Eigen::VectorXs diff = x - mMu;
+  mCovInv.matrixL().solveInPlace(diff);
   return (normalized ? mLogNormalizationConstant : 0)
-         + (-0.5 * diff.transpose() * mCovInv.solve(diff));
+         + (-0.5 * diff.squaredNorm());
 }
 
 Eigen::VectorXs MultivariateGaussian::computeLogPDFGrad(Eigen::VectorXs x)
@@ -124,6 +127,23 @@ Eigen::VectorXs MultivariateGaussian::computeLogPDFGrad(Eigen::VectorXs x)
   return -mCovInv.solve(diff);
 }
 
+Eigen::VectorXs MultivariateGaussian::computeLogPDFBatch(
+    const Eigen::MatrixXs& xs, bool normalized)
+{
+  Eigen::MatrixXs diffs = xs.colwise() - mMu;
+  mCovInv.matrixL().solveInPlace(diffs);
+  return (-0.5 * diffs.colwise().squaredNorm().transpose()).array()
+         + (normalized ? mLogNormalizationConstant : 0);
+}
+
+Eigen::MatrixXs MultivariateGaussian::computeLogPDFGradBatch(
+    const Eigen::MatrixXs& xs)
+{
+  Eigen::MatrixXs diffs = xs.colwise() - mMu;
+  mCovInv.solveInPlace(diffs);
+  return -diffs;
+}
+
 Eigen::VectorXs MultivariateGaussian::finiteDifferenceLogPDFGrad(
     Eigen::VectorXs x)
 {
@@ -38,6 +38,16 @@ public:
 
   Eigen::VectorXs computeLogPDFGrad(Eigen::VectorXs x);
 
+  /// Each column of `xs` is a sample. This returns the log-PDF of every
+  /// sample, reusing the Cholesky factor of the covariance for the whole
+  /// batch.
+  Eigen::VectorXs computeLogPDFBatch(
+      const Eigen::MatrixXs& xs, bool normalized = true);
+
+  /// Each column of `xs` is a sample. This returns a matrix where each column
+  /// is the gradient of the log-PDF at that sample.
+  Eigen::MatrixXs computeLogPDFGradBatch(const Eigen::MatrixXs& xs);
+
   Eigen::VectorXs finiteDifferenceLogPDFGrad(Eigen::VectorXs x);
 
   std::vector<std::string> getVariableNames();
@@ -67,6 +77,8 @@ protected:
   std::vector<std::string> mVars;
   Eigen::VectorXs mMu;
   Eigen::MatrixXs mCov;
+  /// This is the Cholesky factorization of mCov, computed once on
+  /// construction
   Eigen::LLT<Eigen::MatrixXs> mCovInv;
   s_t mNormalizationConstant;
   s_t mLogNormalizationConstant;
@@ -0,0 +1,88 @@
+#include "dart/math/SpatialHash.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "dart/math/MathTypes.hpp"
+
+namespace dart {
+namespace math {
+
+//==============================================================================
+SpatialHash::SpatialHash(s_t cellSize) : mCellSize(cellSize)
+{
+}
+
+//==============================================================================
+/// This removes all the points, but keeps the cell size
+void SpatialHash::clear()
+{
+  mCells.clear();
+}
+
+//==============================================================================
+/// This adds a point to the hash, under an arbitrary caller-chosen `index`
+void SpatialHash::insert(int index, const Eigen::Vector3s& point)
+{
+  if (point.hasNaN())
+  {
+    return;
+  }
+  mCells[getKey(getCell(point))].push_back(index);
+}
+
+//==============================================================================
+/// This appends to `candidates` the index of every inserted point in the 27
+/// cells around `point`.
+void SpatialHash::getCandidates(
+    const Eigen::Vector3s& point, std::vector<int>& candidates) const
+{
+  if (point.hasNaN())
+  {
+    return;
+  }
+  Eigen::Vector3i center = getCell(point);
+  for (int x = -1; x <= 1; x++)
+  {
+    for (int y = -1; y <= 1; y++)
+    {
+      for (int z = -1; z <= 1; z++)
+      {
+        auto cell = mCells.find(getKey(center + Eigen::Vector3i(x, y, z)));
+        if (cell != mCells.end())
+        {
+          candidates.insert(
+              candidates.end(), cell->second.begin(), cell->second.end());
+        }
+      }
+    }
+  }
+}
+
+//==============================================================================
+/// This returns the integer coordinates of the cell containing `point`
+Eigen::Vector3i SpatialHash::getCell(const Eigen::Vector3s& point) const
+{
+  Eigen::Vector3i cell;
+  for (int i = 0; i < 3; i++)
+  {
+    // Clamp, so that absurdly distant points can't overflow the cast to int
+    double coord = std::floor((double)(point(i) / mCellSize));
+    cell(i) = (int)std::max(-1e9, std::min(1e9, coord));
+  }
+  return cell;
+}
+
+//==============================================================================
+/// This packs integer cell coordinates into a single hash key.
+std::int64_t SpatialHash::getKey(const Eigen::Vector3i& cell)
+{
+  // 21 bits per axis, which wraps around every ~2 million cells
+  const std::int64_t mask = (1 << 21) - 1;
+  return ((std::int64_t)(cell(0) & mask) << 42)
+         | ((std::int64_t)(cell(1) & mask) << 21)
+         | (std::int64_t)(cell(2) & mask);
+}
+
+} // namespace math
+} // namespace dart
@@ -0,0 +1,49 @@
+#ifndef MATH_SPATIALHASH_H_
+#define MATH_SPATIALHASH_H_
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "dart/math/MathTypes.hpp"
+
+namespace dart {
+namespace math {
+
+/// This buckets 3D points into a uniform grid of cubic cells, so that every
+/// point within `cellSize` of a query can be found by only looking at the 27
+/// cells around it, rather than comparing against every point.
+class SpatialHash
+{
+public:
+  SpatialHash(s_t cellSize);
+
+  /// This removes all the points, but keeps the cell size
+  void clear();
+
+  /// This adds a point to the hash, under an arbitrary caller-chosen `index`
+  void insert(int index, const Eigen::Vector3s& point);
+
+  /// This appends to `candidates` the index of every inserted point in the 27
+  /// cells around `point`. That includes every point within `cellSize` of
+  /// `point`, along with some further away, so callers still need to check
+  /// distances themselves.
+  void getCandidates(
+      const Eigen::Vector3s& point, std::vector<int>& candidates) const;
+
+protected:
+  /// This returns the integer coordinates of the cell containing `point`
+  Eigen::Vector3i getCell(const Eigen::Vector3s& point) const;
+
+  /// This packs integer cell coordinates into a single hash key. Cells far
+  /// enough apart can collide, which only adds extra candidates.
+  static std::int64_t getKey(const Eigen::Vector3i& cell);
+
+  s_t mCellSize;
+  std::unordered_map<std::int64_t, std::vector<int>> mCells;
+};
+
+} // namespace math
+} // namespace dart
+
+#endif
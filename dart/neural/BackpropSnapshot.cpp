@@ -3667,6 +3667,8 @@ Eigen::MatrixXs BackpropSnapshot::getJacobianOfClampingConstraints(
 
   std::vector<std::shared_ptr<DifferentiableContactConstraint>> constraints
       = getClampingConstraints();
+  DifferentiableContactConstraint::computeConstraintForcesJacobians(
+      world, constraints, world->getContactGradientThreads());
   int dofs = world->getNumDofs();
   Eigen::MatrixXs result = Eigen::MatrixXs::Zero(dofs, dofs);
   assert(constraints.size() == f0.size());
@@ -3695,6 +3697,8 @@ Eigen::MatrixXs BackpropSnapshot::getJacobianOfClampingConstraintsTranspose(
 
   std::vector<std::shared_ptr<DifferentiableContactConstraint>> constraints
       = getClampingConstraints();
+  DifferentiableContactConstraint::computeConstraintForcesJacobians(
+      world, constraints, world->getContactGradientThreads());
   int dofs = world->getNumDofs();
   assert(constraints.size() == mNumClamping);
   Eigen::MatrixXs result = Eigen::MatrixXs::Zero(mNumClamping, dofs);
@@ -3716,6 +3720,8 @@ Eigen::MatrixXs BackpropSnapshot::getJacobianOfUpperBoundConstraints(
 {
   std::vector<std::shared_ptr<DifferentiableContactConstraint>> constraints
       = getUpperBoundConstraints();
+  DifferentiableContactConstraint::computeConstraintForcesJacobians(
+      world, constraints, world->getContactGradientThreads());
   int dofs = world->getNumDofs();
   Eigen::MatrixXs result = Eigen::MatrixXs::Zero(dofs, dofs);
   assert(constraints.size() == E_f0.size());
@@ -3734,6 +3740,8 @@ Eigen::MatrixXs BackpropSnapshot::getJacobianOfUpperBoundConstraintsTranspose(
 {
   std::vector<std::shared_ptr<DifferentiableContactConstraint>> constraints
       = getUpperBoundConstraints();
+  DifferentiableContactConstraint::computeConstraintForcesJacobians(
+      world, constraints, world->getContactGradientThreads());
   int dofs = world->getNumDofs();
   assert(constraints.size() == mNumUpperBound);
   Eigen::MatrixXs result = Eigen::MatrixXs::Zero(mNumUpperBound, dofs);
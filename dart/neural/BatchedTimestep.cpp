@@ -0,0 +1,204 @@
+#include "dart/neural/BatchedTimestep.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <thread>
+
+#include "dart/neural/BackpropSnapshot.hpp"
+#include "dart/neural/NeuralUtils.hpp"
+#include "dart/simulation/World.hpp"
+
+namespace dart {
+namespace neural {
+
+//==============================================================================
+/// This calls `fn(worker, row)` for every row in [0, numRows), splitting the
+/// rows into one contiguous chunk per worker, and running the chunks in
+/// parallel.
+static void runOverBatch(
+    int numRows, int numWorkers, const std::function<void(int, int)>& fn)
+{
+  numWorkers = std::max(1, std::min(numWorkers, numRows));
+  int rowsPerWorker = (numRows + numWorkers - 1) / numWorkers;
+
+  std::vector<std::future<void>> futures;
+  for (int worker = 0; worker < numWorkers; worker++)
+  {
+    int start = worker * rowsPerWorker;
+    int end = std::min(numRows, start + rowsPerWorker);
+    futures.push_back(
+        std::async(std::launch::async, [&fn, worker, start, end]() {
+          for (int row = start; row < end; row++)
+          {
+            fn(worker, row);
+          }
+        }));
+  }
+  for (std::future<void>& future : futures)
+  {
+    future.get();
+  }
+}
+
+//==============================================================================
+BatchedTimestep::BatchedTimestep(
+    std::shared_ptr<simulation::World> world, int numThreads)
+  : mWorldsMutex(std::make_shared<std::mutex>()),
+    mLCPCache(world->getCachedLCPSolution()),
+    mInitialMasses(world->getMasses())
+{
+  if (numThreads <= 0)
+  {
+    numThreads = std::max(1, (int)std::thread::hardware_concurrency());
+  }
+  for (int i = 0; i < numThreads; i++)
+  {
+    mWorlds.push_back(world->clone());
+  }
+}
+
+//==============================================================================
+/// Each row of `states` and `actions` is one element of the batch.
+std::shared_ptr<BatchedBackpropSnapshot> BatchedTimestep::forwardPass(
+    const Eigen::MatrixXs& states,
+    const Eigen::MatrixXs& actions,
+    const Eigen::MatrixXs& masses)
+{
+  const std::shared_ptr<simulation::World>& world = mWorlds[0];
+  int batchSize = states.rows();
+  if (states.cols() != world->getStateSize() || actions.rows() != batchSize
+      || actions.cols() != world->getActionSize()
+      || (masses.rows() > 0
+          && (masses.rows() != batchSize
+              || masses.cols() != (int)world->getMassDims())))
+  {
+    std::cerr << "BatchedTimestep::forwardPass() got inputs of the wrong "
+                 "shape. Expected states "
+              << batchSize << "x" << world->getStateSize() << " (got "
+              << states.rows() << "x" << states.cols() << "), actions "
+              << batchSize << "x" << world->getActionSize() << " (got "
+              << actions.rows() << "x" << actions.cols() << "), and masses "
+              << batchSize << "x" << world->getMassDims() << " or empty (got "
+              << masses.rows() << "x" << masses.cols() << ")." << std::endl;
+    return nullptr;
+  }
+
+  // Each clone keeps whatever masses the last batch left on it, so if this
+  // batch doesn't pass masses we have to put the original ones back
+  Eigen::MatrixXs rowMasses = masses;
+  if (rowMasses.rows() == 0)
+  {
+    rowMasses = mInitialMasses.transpose().replicate(batchSize, 1);
+  }
+
+  std::vector<std::shared_ptr<BackpropSnapshot>> snapshots(batchSize);
+  Eigen::MatrixXs nextStates = Eigen::MatrixXs::Zero(batchSize, states.cols());
+  {
+    const std::lock_guard<std::mutex> lock(*mWorldsMutex);
+    // The clones all share one WithRespectToMass, which isn't safe to use
+    // from several threads at once
+    std::mutex massMutex;
+    runOverBatch(batchSize, mWorlds.size(), [&](int worker, int row) {
+      const std::shared_ptr<simulation::World>& rowWorld = mWorlds[worker];
+      if (rowMasses.cols() > 0)
+      {
+        const std::lock_guard<std::mutex> massLock(massMutex);
+        rowWorld->setMasses(rowMasses.row(row).transpose());
+      }
+      rowWorld->setState(states.row(row).transpose());
+      rowWorld->setAction(actions.row(row).transpose());
+      rowWorld->setCachedLCPSolution(mLCPCache);
+      snapshots[row] = neural::forwardPass(rowWorld);
+      nextStates.row(row) = rowWorld->getState().transpose();
+    });
+  }
+
+  return std::make_shared<BatchedBackpropSnapshot>(
+      mWorlds, mWorldsMutex, snapshots, nextStates, rowMasses);
+}
+
+//==============================================================================
+/// This returns the number of world clones that batches get split across
+int BatchedTimestep::getNumThreads() const
+{
+  return mWorlds.size();
+}
+
+//==============================================================================
+BatchedBackpropSnapshot::BatchedBackpropSnapshot(
+    std::vector<std::shared_ptr<simulation::World>> worlds,
+    std::shared_ptr<std::mutex> worldsMutex,
+    std::vector<std::shared_ptr<BackpropSnapshot>> snapshots,
+    Eigen::MatrixXs nextStates,
+    Eigen::MatrixXs masses)
+  : mWorlds(worlds),
+    mWorldsMutex(worldsMutex),
+    mSnapshots(snapshots),
+    mNextStates(nextStates),
+    mMasses(masses)
+{
+}
+
+//==============================================================================
+/// This returns the state after the timestep for each row of the batch
+const Eigen::MatrixXs& BatchedBackpropSnapshot::getNextStates() const
+{
+  return mNextStates;
+}
+
+//==============================================================================
+/// Each row of `nextStateLossGrads` is the gradient of the loss with respect
+/// to the same row of getNextStates().
+BatchedLossGradient BatchedBackpropSnapshot::backpropState(
+    const Eigen::MatrixXs& nextStateLossGrads)
+{
+  assert(nextStateLossGrads.rows() == mNextStates.rows());
+  assert(nextStateLossGrads.cols() == mNextStates.cols());
+
+  const std::shared_ptr<simulation::World>& world = mWorlds[0];
+  int batchSize = mSnapshots.size();
+  BatchedLossGradient grad;
+  grad.lossWrtState = Eigen::MatrixXs::Zero(batchSize, world->getStateSize());
+  grad.lossWrtAction = Eigen::MatrixXs::Zero(batchSize, world->getActionSize());
+  grad.lossWrtMass = Eigen::MatrixXs::Zero(batchSize, world->getMassDims());
+
+  const std::lock_guard<std::mutex> lock(*mWorldsMutex);
+  std::mutex massMutex;
+  runOverBatch(batchSize, mWorlds.size(), [&](int worker, int row) {
+    const std::shared_ptr<simulation::World>& rowWorld = mWorlds[worker];
+    // BackpropSnapshot restores the state it was taken in, but not the
+    // masses, so we have to put those back ourselves
+    if (mMasses.cols() > 0)
+    {
+      const std::lock_guard<std::mutex> massLock(massMutex);
+      rowWorld->setMasses(mMasses.row(row).transpose());
+    }
+    LossGradientHighLevelAPI rowGrad = mSnapshots[row]->backpropState(
+        rowWorld, nextStateLossGrads.row(row).transpose());
+    grad.lossWrtState.row(row) = rowGrad.lossWrtState.transpose();
+    grad.lossWrtAction.row(row) = rowGrad.lossWrtAction.transpose();
+    grad.lossWrtMass.row(row) = rowGrad.lossWrtMass.transpose();
+  });
+  return grad;
+}
+
+//==============================================================================
+/// This returns the number of rows in the batch
+int BatchedBackpropSnapshot::getBatchSize() const
+{
+  return mSnapshots.size();
+}
+
+//==============================================================================
+/// This returns the BackpropSnapshot for a single row of the batch
+std::shared_ptr<BackpropSnapshot> BatchedBackpropSnapshot::getSnapshot(
+    int row) const
+{
+  return mSnapshots[row];
+}
+
+} // namespace neural
+} // namespace dart
@@ -0,0 +1,114 @@
+#ifndef DART_NEURAL_BATCHED_TIMESTEP_HPP_
+#define DART_NEURAL_BATCHED_TIMESTEP_HPP_
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "dart/math/MathTypes.hpp"
+
+namespace dart {
+
+namespace simulation {
+class World;
+}
+
+namespace neural {
+
+class BackpropSnapshot;
+class BatchedBackpropSnapshot;
+
+/// This is the batched version of LossGradientHighLevelAPI, where each row is
+/// the gradient for one element of the batch.
+struct BatchedLossGradient
+{
+  Eigen::MatrixXs lossWrtState;
+  Eigen::MatrixXs lossWrtAction;
+  Eigen::MatrixXs lossWrtMass;
+};
+
+/// This takes a timestep for every row of a batch of (state, action, mass)
+/// inputs in one call, spreading the batch over a pool of clones of a world,
+/// with one clone per thread. It's the batched version of forwardPass() and
+/// BackpropSnapshot::backpropState(), so that training on a minibatch costs
+/// one call into C++ rather than one call per row.
+///
+/// The clones are made once, when this is constructed, so later changes to
+/// `world` (other than the state, action and masses, which come in with each
+/// batch) are not picked up.
+class BatchedTimestep
+{
+public:
+  /// If `numThreads` is <= 0, this uses one thread per core.
+  BatchedTimestep(
+      std::shared_ptr<simulation::World> world, int numThreads = -1);
+
+  /// Each row of `states` and `actions` is one element of the batch. If
+  /// `masses` has any rows, it must have one for each element of the batch,
+  /// and they're applied with World::setMasses() before stepping. Otherwise
+  /// every element uses the masses the world had at construction.
+  ///
+  /// This returns a snapshot holding the next state for each row, which can
+  /// backprop through the whole batch. On malformed inputs, this prints an
+  /// error and returns nullptr.
+  std::shared_ptr<BatchedBackpropSnapshot> forwardPass(
+      const Eigen::MatrixXs& states,
+      const Eigen::MatrixXs& actions,
+      const Eigen::MatrixXs& masses = Eigen::MatrixXs::Zero(0, 0));
+
+  /// This returns the number of world clones that batches get split across
+  int getNumThreads() const;
+
+protected:
+  std::vector<std::shared_ptr<simulation::World>> mWorlds;
+  /// Snapshots keep the worlds around for backprop, so we share the lock
+  /// with them to keep a forward and a backward pass from overlapping
+  std::shared_ptr<std::mutex> mWorldsMutex;
+  /// Every row starts from the same cached LCP solution, so that results
+  /// don't depend on which clone a row happened to land on
+  Eigen::VectorXs mLCPCache;
+  /// These are the masses the world had at construction, which we use for
+  /// batches that don't pass any
+  Eigen::VectorXs mInitialMasses;
+};
+
+/// This holds the results of BatchedTimestep::forwardPass(), and the
+/// information needed to backprop through them.
+class BatchedBackpropSnapshot
+{
+public:
+  BatchedBackpropSnapshot(
+      std::vector<std::shared_ptr<simulation::World>> worlds,
+      std::shared_ptr<std::mutex> worldsMutex,
+      std::vector<std::shared_ptr<BackpropSnapshot>> snapshots,
+      Eigen::MatrixXs nextStates,
+      Eigen::MatrixXs masses);
+
+  /// This returns the state after the timestep for each row of the batch
+  const Eigen::MatrixXs& getNextStates() const;
+
+  /// Each row of `nextStateLossGrads` is the gradient of the loss with
+  /// respect to the same row of getNextStates(). This returns the gradient of
+  /// the loss with respect to each row of the inputs to the forward pass.
+  BatchedLossGradient backpropState(const Eigen::MatrixXs& nextStateLossGrads);
+
+  /// This returns the number of rows in the batch
+  int getBatchSize() const;
+
+  /// This returns the BackpropSnapshot for a single row of the batch
+  std::shared_ptr<BackpropSnapshot> getSnapshot(int row) const;
+
+protected:
+  std::vector<std::shared_ptr<simulation::World>> mWorlds;
+  std::shared_ptr<std::mutex> mWorldsMutex;
+  std::vector<std::shared_ptr<BackpropSnapshot>> mSnapshots;
+  Eigen::MatrixXs mNextStates;
+  Eigen::MatrixXs mMasses;
+};
+
+} // namespace neural
+} // namespace dart
+
+#endif
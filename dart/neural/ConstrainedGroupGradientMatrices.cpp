@@ -1795,6 +1795,8 @@ ConstrainedGroupGradientMatrices::getJacobianOfClampingConstraints(
 
   std::vector<std::shared_ptr<DifferentiableContactConstraint>> constraints
       = getClampingConstraints();
+  DifferentiableContactConstraint::computeConstraintForcesJacobians(
+      world, constraints, world->getContactGradientThreads());
   Eigen::MatrixXs result = Eigen::MatrixXs::Zero(mNumDOFs, mNumDOFs);
   assert(constraints.size() == f0.size());
   for (int i = 0; i < constraints.size(); i++)
@@ -1816,6 +1818,8 @@ ConstrainedGroupGradientMatrices::getJacobianOfClampingConstraintsTranspose(
 
   std::vector<std::shared_ptr<DifferentiableContactConstraint>> constraints
       = getClampingConstraints();
+  DifferentiableContactConstraint::computeConstraintForcesJacobians(
+      world, constraints, world->getContactGradientThreads());
   Eigen::MatrixXs result = Eigen::MatrixXs::Zero(constraints.size(), mNumDOFs);
   for (int i = 0; i < constraints.size(); i++)
   {
@@ -1838,6 +1842,8 @@ ConstrainedGroupGradientMatrices::getJacobianOfUpperBoundConstraints(
 
   std::vector<std::shared_ptr<DifferentiableContactConstraint>> constraints
       = getUpperBoundConstraints();
+  DifferentiableContactConstraint::computeConstraintForcesJacobians(
+      world, constraints, world->getContactGradientThreads());
   Eigen::MatrixXs result = Eigen::MatrixXs::Zero(mNumDOFs, mNumDOFs);
   assert(constraints.size() == f0.size());
   for (int i = 0; i < constraints.size(); i++)
@@ -1856,6 +1862,8 @@ ConstrainedGroupGradientMatrices::getJacobianOfUpperBoundConstraintsTranspose(
 {
   std::vector<std::shared_ptr<dynamics::Skeleton>> skels = getSkeletons(world);
 
+  DifferentiableContactConstraint::computeConstraintForcesJacobians(
+      world, mUpperBoundConstraints, world->getContactGradientThreads());
   int dofs = world->getNumDofs();
   Eigen::MatrixXs result
       = Eigen::MatrixXs::Zero(mUpperBoundConstraints.size(), dofs);
@@ -1,5 +1,8 @@
 #include "dart/neural/DifferentiableContactConstraint.hpp"
 
+#include <algorithm>
+#include <future>
+
 #include "dart/collision/Contact.hpp"
 #include "dart/constraint/ConstraintBase.hpp"
 #include "dart/constraint/ContactConstraint.hpp"
@@ -1325,6 +1328,26 @@ DifferentiableContactConstraint::getScrewAxisForForceGradient_Optimized(
     dynamics::DegreeOfFreedom* screwDof,
     dynamics::DegreeOfFreedom* rotateDof,
     const Eigen::Vector6s& axisWorldTwist)
+{
+  return getScrewAxisForForceGradient_Optimized(
+      screwDof,
+      rotateDof,
+      axisWorldTwist,
+      getWorldScrewAxisForPosition(rotateDof));
+}
+
+//==============================================================================
+/// Returns the gradient of the screw axis with respect to the rotate dof
+///
+/// This also takes the world screw axis (for position) of the rotate dof, so
+/// that callers who have precomputed it with getWorldScrewAxes() don't pay
+/// to recompute it.
+Eigen::Vector6s
+DifferentiableContactConstraint::getScrewAxisForForceGradient_Optimized(
+    dynamics::DegreeOfFreedom* screwDof,
+    dynamics::DegreeOfFreedom* rotateDof,
+    const Eigen::Vector6s& axisWorldTwist,
+    const Eigen::Vector6s& rotateWorldTwist)
 {
   // Special case: all angular DOFs within FreeJoints effect each other in
   // special ways
@@ -1361,7 +1384,6 @@ DifferentiableContactConstraint::getScrewAxisForForceGradient_Optimized(
   assert(rotateDof->isParentOf(screwDof));
 #endif
 
-  Eigen::Vector6s rotateWorldTwist = getWorldScrewAxisForPosition(rotateDof);
   return math::ad(rotateWorldTwist, axisWorldTwist);
 }
 
@@ -1505,10 +1527,32 @@ s_t DifferentiableContactConstraint::getConstraintForceDerivative(
 const Eigen::MatrixXs&
 DifferentiableContactConstraint::getConstraintForcesJacobian(
     std::shared_ptr<simulation::World> world)
+{
+  if (mWorldConstraintJacCacheDirty)
+  {
+    math::Jacobian positionAxes;
+    math::Jacobian forceAxes;
+    getWorldScrewAxes(world, positionAxes, forceAxes);
+    getConstraintForcesJacobian(world, positionAxes, forceAxes);
+  }
+  return mWorldConstraintJacCache;
+}
+
+//==============================================================================
+/// This is the same as getConstraintForcesJacobian(world), except that it
+/// reads the world screw axes of every DOF from `positionAxes` and
+/// `forceAxes`, which must come from getWorldScrewAxes(). Those don't depend
+/// on the contact, so they can be shared by every contact in the world.
+const Eigen::MatrixXs&
+DifferentiableContactConstraint::getConstraintForcesJacobian(
+    std::shared_ptr<simulation::World> world,
+    const math::Jacobian& positionAxes,
+    const math::Jacobian& forceAxes)
 {
   if (mWorldConstraintJacCacheDirty)
   {
     int dim = world->getNumDofs();
+    assert(positionAxes.cols() == dim && forceAxes.cols() == dim);
     math::Jacobian forceJac = getContactForceJacobian(world);
     Eigen::Vector6s force = getWorldForce();
     std::vector<dynamics::DegreeOfFreedom*> dofs = world->getDofs();
@@ -1559,8 +1603,7 @@ DifferentiableContactConstraint::getConstraintForcesJacobian(
       if (multiple == 0.0)
         continue;
 
-      Eigen::Vector6s axis = getWorldScrewAxisForForce(dofs[row]);
-      // Eigen::Vector6s axisWorldTwist = getWorldScrewAxisForForce(dofs[row]);
+      Eigen::Vector6s axis = forceAxes.col(row);
 
       // Each element [i] of this vector is the forceJac col(i) dotted with
       // axis.
@@ -1592,7 +1635,7 @@ DifferentiableContactConstraint::getConstraintForcesJacobian(
                     + world->getSkeletonDofOffset(jointCursor->getSkeleton());
           Eigen::Vector6s screwAxisGradient
               = getScrewAxisForForceGradient_Optimized(
-                  dofs[row], dofs[wrt], axis); // axisWorldTwist
+                  dofs[row], dofs[wrt], axis, positionAxes.col(wrt));
           mWorldConstraintJacCache(row, wrt)
               += multiple * screwAxisGradient.dot(force);
         }
@@ -1648,6 +1691,70 @@ DifferentiableContactConstraint::getConstraintForcesJacobian(
   return mWorldConstraintJacCache;
 }
 
+//==============================================================================
+/// This fills in the getConstraintForcesJacobian(world) cache for every
+/// constraint in `constraints` that doesn't have one yet. The world screw
+/// axes are computed once and shared across constraints, and the
+/// constraints are split across `numThreads` threads.
+void DifferentiableContactConstraint::computeConstraintForcesJacobians(
+    std::shared_ptr<simulation::World> world,
+    const std::vector<std::shared_ptr<DifferentiableContactConstraint>>&
+        constraints,
+    int numThreads)
+{
+  std::vector<std::shared_ptr<DifferentiableContactConstraint>> dirty;
+  for (auto constraint : constraints)
+  {
+    if (constraint->mWorldConstraintJacCacheDirty)
+    {
+      dirty.push_back(constraint);
+    }
+  }
+  if (dirty.size() == 0)
+    return;
+
+  // Computing the screw axes brings every joint's lazily cached transforms and
+  // Jacobians up to date, and the DOF parent maps are also cached lazily. We
+  // do both on this thread, so the workers below only ever read shared state.
+  math::Jacobian positionAxes;
+  math::Jacobian forceAxes;
+  getWorldScrewAxes(world, positionAxes, forceAxes);
+  for (int i = 0; i < world->getNumSkeletons(); i++)
+  {
+    world->getSkeleton(i)->getDofParentMap();
+  }
+
+  int numDirty = dirty.size();
+  int numChunks = std::min(numThreads, numDirty);
+  if (numChunks <= 1)
+  {
+    for (auto constraint : dirty)
+    {
+      constraint->getConstraintForcesJacobian(world, positionAxes, forceAxes);
+    }
+    return;
+  }
+
+  // Each constraint only writes its own cache, so the chunks don't share
+  // anything they write to
+  int chunkSize = (numDirty + numChunks - 1) / numChunks;
+  std::vector<std::future<void>> futures;
+  for (int start = 0; start < numDirty; start += chunkSize)
+  {
+    int end = std::min(start + chunkSize, numDirty);
+    futures.push_back(std::async(std::launch::async, [&, start, end]() {
+      for (int i = start; i < end; i++)
+      {
+        dirty[i]->getConstraintForcesJacobian(world, positionAxes, forceAxes);
+      }
+    }));
+  }
+  for (auto& future : futures)
+  {
+    future.get();
+  }
+}
+
 //==============================================================================
 /// This computes and returns the analytical Jacobian relating how changes in
 /// the positions of wrt's DOFs changes the constraint forces on skel.
@@ -3017,6 +3124,27 @@ Eigen::Vector6s DifferentiableContactConstraint::getWorldScrewAxisForForce(
   return dof->getJoint()->getWorldAxisScrewForVelocity(jointIndex);
 }
 
+//==============================================================================
+/// This computes the world screw axes of every DOF in the world, one column
+/// per DOF, both for position (getWorldScrewAxisForPosition()) and for force
+/// (getWorldScrewAxisForForce()).
+void DifferentiableContactConstraint::getWorldScrewAxes(
+    std::shared_ptr<simulation::World> world,
+    /* OUT */ math::Jacobian& positionAxes,
+    /* OUT */ math::Jacobian& forceAxes)
+{
+  int dim = world->getNumDofs();
+  positionAxes.resize(6, dim);
+  forceAxes.resize(6, dim);
+  int i = 0;
+  for (auto dof : world->getDofs())
+  {
+    positionAxes.col(i) = getWorldScrewAxisForPosition(dof);
+    forceAxes.col(i) = getWorldScrewAxisForForce(dof);
+    i++;
+  }
+}
+
 //==============================================================================
 std::shared_ptr<DifferentiableContactConstraint>
 DifferentiableContactConstraint::getPeerConstraint(
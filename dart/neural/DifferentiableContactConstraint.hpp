@@ -156,6 +156,17 @@ public:
       dynamics::DegreeOfFreedom* rotateDof,
       const Eigen::Vector6s& axisWorldTwist);
 
+  /// Returns the gradient of the screw axis with respect to the rotate dof
+  ///
+  /// This also takes the world screw axis (for position) of the rotate dof, so
+  /// that callers who have precomputed it with getWorldScrewAxes() don't pay
+  /// to recompute it.
+  static Eigen::Vector6s getScrewAxisForForceGradient_Optimized(
+      dynamics::DegreeOfFreedom* screwDof,
+      dynamics::DegreeOfFreedom* rotateDof,
+      const Eigen::Vector6s& axisWorldTwist,
+      const Eigen::Vector6s& rotateWorldTwist);
+
   /// This is the analytical Jacobian for the contact position
   math::LinearJacobian getContactPositionJacobian(
       std::shared_ptr<simulation::World> world);
@@ -199,6 +210,25 @@ public:
   const Eigen::MatrixXs& getConstraintForcesJacobian(
       std::shared_ptr<simulation::World> world);
 
+  /// This is the same as getConstraintForcesJacobian(world), except that it
+  /// reads the world screw axes of every DOF from `positionAxes` and
+  /// `forceAxes`, which must come from getWorldScrewAxes(). Those don't depend
+  /// on the contact, so they can be shared by every contact in the world.
+  const Eigen::MatrixXs& getConstraintForcesJacobian(
+      std::shared_ptr<simulation::World> world,
+      const math::Jacobian& positionAxes,
+      const math::Jacobian& forceAxes);
+
+  /// This fills in the getConstraintForcesJacobian(world) cache for every
+  /// constraint in `constraints` that doesn't have one yet. The world screw
+  /// axes are computed once and shared across constraints, and the
+  /// constraints are split across `numThreads` threads.
+  static void computeConstraintForcesJacobians(
+      std::shared_ptr<simulation::World> world,
+      const std::vector<std::shared_ptr<DifferentiableContactConstraint>>&
+          constraints,
+      int numThreads);
+
   /// This computes and returns the analytical Jacobian relating how changes in
   /// the positions of wrt's DOFs changes the constraint forces on skel.
   Eigen::MatrixXs getConstraintForcesJacobian(
@@ -362,6 +392,14 @@ public:
   static Eigen::Vector6s getWorldScrewAxisForForce(
       dynamics::DegreeOfFreedom* dof);
 
+  /// This computes the world screw axes of every DOF in the world, one column
+  /// per DOF, both for position (getWorldScrewAxisForPosition()) and for force
+  /// (getWorldScrewAxisForForce()).
+  static void getWorldScrewAxes(
+      std::shared_ptr<simulation::World> world,
+      /* OUT */ math::Jacobian& positionAxes,
+      /* OUT */ math::Jacobian& forceAxes);
+
   /// This returns the constraint that's at our same location in the snapshot.
   /// This assumes that `mOffsetIntoWorld` and `mIsUpperBoundConstraint` are
   /// set.
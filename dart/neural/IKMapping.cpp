@@ -15,7 +15,9 @@ namespace neural {
 
 //==============================================================================
 IKMapping::IKMapping(std::shared_ptr<simulation::World> world)
-  : mIKIterationLimit(100)
+  : mIKIterationLimit(100),
+    mWarmStart(false),
+    mNumPosJacobianEvaluations(0)
 {
   mMassDim = world->getMassDims();
 }
@@ -39,6 +41,54 @@ int IKMapping::getIKIterationLimit()
   return mIKIterationLimit;
 }
 
+//==============================================================================
+void IKMapping::setWarmStart(bool warmStart)
+{
+  mWarmStart = warmStart;
+  mLastSolution.resize(0);
+  mCachedJac.resize(0, 0);
+}
+
+//==============================================================================
+bool IKMapping::getWarmStart()
+{
+  return mWarmStart;
+}
+
+//==============================================================================
+Eigen::MatrixXs IKMapping::solveTrajectory(
+    std::shared_ptr<simulation::World> world,
+    const Eigen::MatrixXs& mappedPositions)
+{
+  bool originalWarmStart = mWarmStart;
+  mWarmStart = true;
+
+  Eigen::MatrixXs result
+      = Eigen::MatrixXs::Zero(world->getNumDofs(), mappedPositions.cols());
+  Eigen::VectorXs initialPos = Eigen::VectorXs::Zero(world->getNumDofs());
+  for (int t = 0; t < mappedPositions.cols(); t++)
+  {
+    solvePositionsFrom(world, mappedPositions.col(t), initialPos);
+    initialPos = world->getPositions();
+    result.col(t) = initialPos;
+  }
+
+  mWarmStart = originalWarmStart;
+  return result;
+}
+
+//==============================================================================
+int IKMapping::getNumPosJacobianEvaluations()
+{
+  return mNumPosJacobianEvaluations;
+}
+
+//==============================================================================
+void IKMapping::resetNumPosJacobianEvaluations()
+{
+  mNumPosJacobianEvaluations = 0;
+}
+
 //==============================================================================
 void IKMapping::addSpatialBodyNode(dynamics::BodyNode* node)
 {
@@ -87,12 +137,29 @@ void IKMapping::setPositions(
     std::shared_ptr<simulation::World> world,
     const Eigen::Ref<Eigen::VectorXs>& positions)
 {
-  // Reset to 0, so that solutions are always deterministic even if IK is
-  // under/over specified
-  world->setPositions(Eigen::VectorXs::Zero(world->getNumDofs()));
+  if (mWarmStart && mLastSolution.size() == world->getNumDofs())
+  {
+    solvePositionsFrom(world, positions, mLastSolution);
+  }
+  else
+  {
+    // Reset to 0, so that solutions are always deterministic even if IK is
+    // under/over specified
+    solvePositionsFrom(
+        world, positions, Eigen::VectorXs::Zero(world->getNumDofs()));
+  }
+}
+
+//==============================================================================
+void IKMapping::solvePositionsFrom(
+    std::shared_ptr<simulation::World> world,
+    const Eigen::VectorXs& positions,
+    const Eigen::VectorXs& initialPos)
+{
+  world->setPositions(initialPos);
 
   math::solveIK(
-      Eigen::VectorXs::Zero(world->getNumDofs()),
+      initialPos,
       world->getPositionUpperLimits(),
       world->getPositionLowerLimits(),
       positions.size(),
@@ -107,8 +174,17 @@ void IKMapping::setPositions(
       },
       [this, world, positions](
           Eigen::Ref<Eigen::VectorXs> diff, Eigen::Ref<Eigen::MatrixXs> J) {
-        diff = getPositions(world) - positions;
-        J = getPosJacobian(world);
+        Eigen::VectorXs mapped = getPositions(world);
+        diff = mapped - positions;
+        if (mWarmStart)
+        {
+          J = getUpdatedPosJacobian(world, mapped);
+        }
+        else
+        {
+          J = getPosJacobian(world);
+          mNumPosJacobianEvaluations++;
+        }
       },
       [](Eigen::Ref<Eigen::VectorXs> pos) {
         // Don't random restart here
@@ -116,6 +192,11 @@ void IKMapping::setPositions(
         assert(false);
       },
       math::IKConfig().setMaxStepCount(500).setMaxRestarts(1));
+
+  if (mWarmStart)
+  {
+    mLastSolution = world->getPositions();
+  }
 }
 
 //==============================================================================
@@ -424,6 +505,39 @@ Eigen::MatrixXs IKMapping::getPosJacobianInverse(
   return J.completeOrthogonalDecomposition().pseudoInverse();
 }
 
+//==============================================================================
+const Eigen::MatrixXs& IKMapping::getUpdatedPosJacobian(
+    std::shared_ptr<simulation::World> world, const Eigen::VectorXs& mapped)
+{
+  Eigen::VectorXs pos = world->getPositions();
+  if (mCachedJac.rows() == mapped.size() && mCachedJac.cols() == pos.size())
+  {
+    Eigen::VectorXs dx = pos - mCachedJacPos;
+    Eigen::VectorXs df = mapped - mCachedJacMapped;
+    s_t dxSquaredNorm = dx.squaredNorm();
+    if (dxSquaredNorm == 0)
+    {
+      return mCachedJac;
+    }
+    // The update is only trustworthy if the old Jacobian already explained
+    // most of the step. Otherwise (large steps, or the log map wrapping
+    // around) we recompute from scratch.
+    Eigen::VectorXs residual = df - mCachedJac * dx;
+    if (residual.norm() <= 0.1 * df.norm())
+    {
+      mCachedJac += residual * dx.transpose() / dxSquaredNorm;
+      mCachedJacPos = pos;
+      mCachedJacMapped = mapped;
+      return mCachedJac;
+    }
+  }
+  mCachedJac = getPosJacobian(world);
+  mNumPosJacobianEvaluations++;
+  mCachedJacPos = pos;
+  mCachedJacMapped = mapped;
+  return mCachedJac;
+}
+
 /// Computes a Jacobian that transforms changes in joint vel to changes in
 /// IK body vels (expressed in log space).
 Eigen::MatrixXs IKMapping::getVelJacobian(
@@ -48,6 +48,31 @@ public:
   void setIKIterationLimit(int limit);
   int getIKIterationLimit();
 
+  /// When this is on, each IK solve in setPositions() starts from the
+  /// previous solution instead of from zero, and the solver's Jacobian is
+  /// kept up to date with cheap rank-one (Broyden) updates as long as they
+  /// keep predicting the mapped positions well, falling back to a full
+  /// recompute when they don't. This is much faster when consecutive calls
+  /// have nearby targets, like the timesteps of a trajectory, but it means
+  /// the result of an under-determined solve depends on the previous call.
+  /// Defaults to off.
+  void setWarmStart(bool warmStart);
+  bool getWarmStart();
+
+  /// Each column of `mappedPositions` is a target for setPositions(). This
+  /// solves them in order, warm starting each from the solution to the one
+  /// before, and returns the real positions with one column per target. The
+  /// world is left at the solution for the last column.
+  Eigen::MatrixXs solveTrajectory(
+      std::shared_ptr<simulation::World> world,
+      const Eigen::MatrixXs& mappedPositions);
+
+  /// This is the number of times the IK solves in setPositions() have
+  /// computed the pos Jacobian from scratch, rather than reusing or updating
+  /// a cached one, since the last call to resetNumPosJacobianEvaluations().
+  int getNumPosJacobianEvaluations();
+  void resetNumPosJacobianEvaluations();
+
   /// This adds the spatial (6D) coordinates of a body node to the list,
   /// increasing Dim size by 6
   void addSpatialBodyNode(dynamics::BodyNode* node);
@@ -156,6 +181,20 @@ protected:
   Eigen::MatrixXs getPosJacobianInverse(
       std::shared_ptr<simulation::World> world);
 
+  /// This runs the IK solve behind setPositions(), starting from
+  /// `initialPos`
+  void solvePositionsFrom(
+      std::shared_ptr<simulation::World> world,
+      const Eigen::VectorXs& positions,
+      const Eigen::VectorXs& initialPos);
+
+  /// This returns the pos Jacobian at the world's current positions, given
+  /// that `mapped` is getPositions(world). It tries a Broyden update of the
+  /// last Jacobian first, and only recomputes from scratch when the update
+  /// would predict the change in `mapped` poorly.
+  const Eigen::MatrixXs& getUpdatedPosJacobian(
+      std::shared_ptr<simulation::World> world, const Eigen::VectorXs& mapped);
+
   /// Computes a Jacobian that transforms changes in joint vel to changes in
   /// IK body vels (expressed in log space).
   Eigen::MatrixXs getVelJacobian(std::shared_ptr<simulation::World> world);
@@ -176,6 +215,15 @@ protected:
 
   int mMassDim;
   int mIKIterationLimit;
+
+  bool mWarmStart;
+  Eigen::VectorXs mLastSolution;
+  /// This is the Jacobian we're keeping up to date with Broyden updates, and
+  /// the real and mapped positions it was last updated at
+  Eigen::MatrixXs mCachedJac;
+  Eigen::VectorXs mCachedJacPos;
+  Eigen::VectorXs mCachedJacMapped;
+  int mNumPosJacobianEvaluations;
 };
 
 } // namespace neural
@@ -1,5 +1,7 @@
 #include "dart/realtime/MPCLocal.hpp"
 
+#include <algorithm>
+
 #include <google/protobuf/arena_impl.h>
 #include <grpcpp/ext/proto_server_reflection_plugin.h>
 #include <grpcpp/grpcpp.h>
@@ -11,6 +13,7 @@
 #include "dart/realtime/RealTimeControlBuffer.hpp"
 #include "dart/simulation/World.hpp"
 #include "dart/trajectory/IPOptOptimizer.hpp"
+#include "dart/trajectory/LineSearchOptimizer.hpp"
 #include "dart/trajectory/LossFn.hpp"
 #include "dart/trajectory/MultiShot.hpp"
 #include "dart/trajectory/Solution.hpp"
@@ -37,6 +40,7 @@ MPCLocal::MPCLocal(
         world->getMasses()),
     mEnableLinesearch(true),
     mEnableOptimizationGuards(false),
+    mEnableWarmStart(true),
     mRecordIterations(false),
     mPlanningHorizonMillis(planningHorizonMillis),
     mMillisPerStep(1000 * world->getTimeStep()),
@@ -58,6 +62,7 @@ MPCLocal::MPCLocal(const MPCLocal& mpc)
     mObservationLog(mpc.mObservationLog),
     mEnableLinesearch(mpc.mEnableLinesearch),
     mEnableOptimizationGuards(mpc.mEnableOptimizationGuards),
+    mEnableWarmStart(mpc.mEnableWarmStart),
     mRecordIterations(mpc.mRecordIterations),
     mPlanningHorizonMillis(mpc.mPlanningHorizonMillis),
     mMillisPerStep(mpc.mMillisPerStep),
@@ -143,6 +148,17 @@ void MPCLocal::setEnableOptimizationGuards(bool enabled)
   mEnableOptimizationGuards = enabled;
 }
 
+/// This enables warm-starting replans from the previous plan. Defaults to
+/// true. When the problem is advanced in time, IPOPT is warm-started from the
+/// time-shifted dual variables of the last solve as well as the primal ones.
+/// When the problem has to be rebuilt (for example because SSID changed the
+/// mass), the new problem is seeded with the time-shifted forces of the last
+/// plan, instead of starting from zero forces.
+void MPCLocal::setEnableWarmStart(bool enabled)
+{
+  mEnableWarmStart = enabled;
+}
+
 /// Defaults to false. This records every iteration of IPOPT in the log, so we
 /// can debug it. This should only be used on MPCLocal that's running for a
 /// short time. Otherwise the log will grow without bound.
@@ -228,6 +244,31 @@ void MPCLocal::optimizePlan(long startTime)
       std::shared_ptr<MultiShot> multishot = std::make_shared<MultiShot>(
           worldClone, *mLoss.get(), mSteps, mShotLength, false);
       multishot->setParallelOperationsEnabled(true);
+
+      if (mEnableWarmStart && mProblem && mSolution)
+      {
+        // Seed the new problem with the old plan, shifted forward to the new
+        // start time, so we don't throw away all our previous work just
+        // because the world parameters changed a little.
+        PerformanceLog* warmStart = log->startRun("Warm Start");
+        int steps = static_cast<int>(floor(
+            static_cast<s_t>(startTime - mLastOptimizedTime) / mMillisPerStep));
+        Eigen::MatrixXs oldForces
+            = mProblem->getRolloutCache(worldClone)->getControlForcesConst();
+        Eigen::MatrixXs newForces
+            = Eigen::MatrixXs::Zero(oldForces.rows(), mSteps);
+        int overlap = std::min(mSteps, (int)oldForces.cols() - steps);
+        if (steps >= 0 && overlap > 0)
+        {
+          newForces.block(0, 0, newForces.rows(), overlap)
+              = oldForces.block(0, steps, oldForces.rows(), overlap);
+        }
+        // This rolls out the new forces from the estimated start state, so
+        // the knot points are consistent with the seeded forces
+        multishot->updateWithForces(worldClone, newForces);
+        warmStart->end();
+      }
+
       mProblem = multishot;
       mVarchange = false;
     }
@@ -274,13 +315,43 @@ void MPCLocal::optimizePlan(long startTime)
     mBuffer.estimateWorldStateAt(
         worldClone, &mObservationLog, roundedStartTime);
 
-    mProblem->advanceSteps(
+    Eigen::VectorXi mapping = mProblem->advanceSteps(
         worldClone,
         worldClone->getPositions(),
         worldClone->getVelocities(),
         steps);
 
-    mSolution->reoptimize();
+    // This is the share of the new planning time that we allow ourselves to
+    // spend replanning
+    s_t factorOfSafety = 0.5;
+
+    if (std::dynamic_pointer_cast<IPOptOptimizer>(mOptimizer))
+    {
+      // Reusing the IPOPT application keeps its internal state across
+      // replans, and the mapping lets us warm-start the dual variables too
+      mSolution->reoptimize(
+          mEnableWarmStart ? mapping : Eigen::VectorXi::Zero(0));
+    }
+    else
+    {
+      std::shared_ptr<LineSearchOptimizer> lineSearchOptimizer
+          = std::dynamic_pointer_cast<LineSearchOptimizer>(mOptimizer);
+      if (lineSearchOptimizer)
+      {
+        // Adam and L-BFGS can stop early, so hold them to our allowed time
+        lineSearchOptimizer->setTimeBudgetMillis(
+            std::max(1, (int)floor(roundedDiff * factorOfSafety)));
+      }
+      // Other optimizers start from the current (already time-shifted) state
+      // of the problem, so this is still a warm start
+      mSolution = mOptimizer->optimize(mProblem.get(), mSolution);
+    }
+
+    if (!mSilent)
+    {
+      std::cout << " -> Replan took " << mSolution->getIterationCount()
+                << " iterations" << std::endl;
+    }
 
     // std::cout << "MPCLocal::optimizePlan() mBuffer.setControlForcePlan()" <<
     // std::endl;
@@ -304,7 +375,6 @@ void MPCLocal::optimizePlan(long startTime)
 
     if (!mSilent)
     {
-      s_t factorOfSafety = 0.5;
       std::cout << " -> We were allowed "
                 << (int)floor(roundedDiff * factorOfSafety)
                 << "ms to solve this problem (" << roundedDiff
@@ -412,6 +482,59 @@ void MPCLocal::serve(int port)
   server->Wait();
 }
 
+/// This serves the same API as serve(), but to an MPCRemote on the same host
+/// through a SharedMemoryChannel. This spins on the channel, so observations
+/// reach the planner as soon as they're sent, and blocks until the channel
+/// is closed.
+void MPCLocal::serveSharedMemory(std::shared_ptr<SharedMemoryChannel> channel)
+{
+  std::vector<char> planBuffer;
+  registerReplanningListener(
+      [channel, planBuffer](
+          long startTime,
+          const trajectory::TrajectoryRollout* rollout,
+          long duration) mutable {
+        packPlanUpdate(startTime, rollout, duration, planBuffer);
+        channel->sendToClient(
+            MPC_PLAN_UPDATE, planBuffer.data(), planBuffer.size());
+      });
+
+  int type;
+  std::vector<char> data;
+  std::vector<Eigen::VectorXs> vectors;
+  while (!channel->isClosed())
+  {
+    if (!channel->receiveOnPlanner(type, data))
+    {
+      std::this_thread::yield();
+      continue;
+    }
+    switch (type)
+    {
+      case MPC_START:
+        start();
+        break;
+      case MPC_STOP:
+        stop();
+        break;
+      case MPC_RECORD_GROUND_TRUTH_STATE: {
+        long time = unpackTimedVectors(data, vectors);
+        recordGroundTruthState(time, vectors[0], vectors[1], vectors[2]);
+        break;
+      }
+      case MPC_OBSERVE_FORCE: {
+        long time = unpackTimedVectors(data, vectors);
+        mBuffer.manuallyRecordObservedForce(time, vectors[0]);
+        break;
+      }
+      default:
+        std::cout << "MPCLocal::serveSharedMemory() got an unknown message "
+                  << "type " << type << std::endl;
+    }
+  }
+  stop();
+}
+
 ///////////////////////////////////////////////////////////////////////
 /// Implements the gRPC API
 ///////////////////////////////////////////////////////////////////////
@@ -9,6 +9,7 @@
 #include "dart/proto/MPC.grpc.pb.h"
 #include "dart/realtime/MPC.hpp"
 #include "dart/realtime/RealTimeControlBuffer.hpp"
+#include "dart/realtime/SharedMemoryChannel.hpp"
 
 using namespace grpc;
 
@@ -48,7 +49,9 @@ public:
   void setLoss(std::shared_ptr<trajectory::LossFn> loss);
 
   /// This sets the optimizer that MPCLocal will use. This will override the
-  /// default optimizer. This should be called before start().
+  /// default optimizer. This should be called before start(). For tight
+  /// real-time loops, an AdamOptimizer or LBFGSOptimizer avoids IPOPT's setup
+  /// cost, and MPCLocal sets its time budget before each replan.
   void setOptimizer(std::shared_ptr<trajectory::Optimizer> optimizer);
 
   /// This returns the current optimizer that MPCLocal is using
@@ -83,6 +86,14 @@ public:
   /// the stability of solutions, but can lead to getting stuck in local minima.
   void setEnableOptimizationGuards(bool enabled);
 
+  /// This enables warm-starting replans from the previous plan. Defaults to
+  /// true. When the problem is advanced in time, IPOPT is warm-started from
+  /// the time-shifted dual variables of the last solve as well as the primal
+  /// ones. When the problem has to be rebuilt (for example because SSID
+  /// changed the mass), the new problem is seeded with the time-shifted forces
+  /// of the last plan, instead of starting from zero forces.
+  void setEnableWarmStart(bool enabled);
+
   /// Defaults to false. This records every iteration of IPOPT in the log, so we
   /// can debug it. This should only be used on MPCLocal that's running for a
   /// short time. Otherwise the log will grow without bound.
@@ -137,6 +148,12 @@ public:
   /// indefinitely, until the program is killed with Ctrl+C
   void serve(int port);
 
+  /// This serves the same API as serve(), but to an MPCRemote on the same host
+  /// through a SharedMemoryChannel. This spins on the channel, so observations
+  /// reach the planner as soon as they're sent, and blocks until the channel
+  /// is closed.
+  void serveSharedMemory(std::shared_ptr<SharedMemoryChannel> channel);
+
   bool variableChange();
 
   void setMasschange(s_t mass);
@@ -157,6 +174,7 @@ protected:
   // Meta config
   bool mEnableLinesearch;
   bool mEnableOptimizationGuards;
+  bool mEnableWarmStart;
   bool mRecordIterations;
 
   int mPlanningHorizonMillis;
@@ -1,7 +1,10 @@
 #include "dart/realtime/MPCRemote.hpp"
 
+#include <cstdio>
+
 #include <grpcpp/grpcpp.h>
 #include <sys/types.h>
+#include <sys/wait.h>
 #include <unistd.h>
 
 #include "dart/proto/SerializeEigen.hpp"
@@ -14,28 +17,17 @@ namespace realtime {
 
 // RealTimeControlBuffer(int forceDim, int steps, int millisPerStep);
 
-/// This connects to an MPC remote server
-MPCRemote::MPCRemote(
-    const std::string& host, int port, int dofs, int steps, int millisPerStep)
-  : mRunning(false),
-    mChannel(grpc::CreateChannel(
-        host + ":" + std::to_string(port), grpc::InsecureChannelCredentials())),
-    mStub(proto::MPCService::NewStub(mChannel)),
-    mBuffer(dofs, steps, millisPerStep)
-{
-}
-
-/// This forks the process, starts a server on another process, and connects
-/// to it
-MPCRemote::MPCRemote(MPCLocal& local, int /* ignored */)
-  : mRunning(false),
-    mChannel(nullptr),
-    mStub(nullptr),
-    mBuffer(RealTimeControlBuffer(
-        local.mWorld->getNumDofs(), local.mSteps, local.mMillisPerStep))
+/// This forks the process, and runs `serve` in the child, which exits when
+/// `serve` returns or the parent dies. This returns the child's process id in
+/// the parent.
+///
+/// The child leaves with _exit() rather than exit(), so it doesn't run the
+/// parent's atexit handlers or flush output the parent had buffered before the
+/// fork (like a test runner's log) a second time.
+static int forkServer(const std::function<void()>& serve)
 {
-  int port = (rand() % 2000) + 2000;
-
+  std::cout.flush();
+  fflush(nullptr);
   int original_id = getpid();
   int child_id = fork();
   // We're in the child process, boot a server to listen
@@ -52,17 +44,91 @@ MPCRemote::MPCRemote(MPCLocal& local, int /* ignored */)
         // This means the parent is dead
         if (parent_id != original_id)
         {
-          exit(0);
+          std::cout.flush();
+          _exit(0);
         }
       }
     });
     // Start a server on this thread
-    local.serve(port);
+    serve();
     // When we're done serving, kill this process
-    exit(0);
+    std::cout.flush();
+    _exit(0);
   }
+  return child_id;
+}
+
+/// This connects to an MPC remote server
+MPCRemote::MPCRemote(
+    const std::string& host, int port, int dofs, int steps, int millisPerStep)
+  : mRunning(false),
+    mChannel(grpc::CreateChannel(
+        host + ":" + std::to_string(port), grpc::InsecureChannelCredentials())),
+    mStub(proto::MPCService::NewStub(mChannel)),
+    mBuffer(dofs, steps, millisPerStep),
+    mSharedMemory(nullptr),
+    mOwnsServer(false),
+    mServerProcessId(-1)
+{
+}
+
+/// This connects to an MPCLocal that's serving on `channel`, through
+/// MPCLocal::serveSharedMemory(), either in this process or a forked one
+MPCRemote::MPCRemote(
+    std::shared_ptr<SharedMemoryChannel> channel,
+    int dofs,
+    int steps,
+    int millisPerStep)
+  : mRunning(false),
+    mChannel(nullptr),
+    mStub(nullptr),
+    mBuffer(dofs, steps, millisPerStep),
+    mSharedMemory(channel),
+    mOwnsServer(false),
+    mServerProcessId(-1)
+{
+}
+
+/// This forks the process, starts a server on another process, and connects
+/// to it
+MPCRemote::MPCRemote(MPCLocal& local, int /* ignored */)
+  : MPCRemote(local, MPCTransport::GRPC)
+{
+}
+
+/// This forks the process, starts a server on another process, and connects
+/// to it over `transport`
+MPCRemote::MPCRemote(MPCLocal& local, MPCTransport transport)
+  : mRunning(false),
+    mChannel(nullptr),
+    mStub(nullptr),
+    mBuffer(RealTimeControlBuffer(
+        local.mWorld->getNumDofs(), local.mSteps, local.mMillisPerStep)),
+    mSharedMemory(nullptr),
+    mOwnsServer(false),
+    mServerProcessId(-1)
+{
+  if (transport == MPCTransport::SHARED_MEMORY)
+  {
+    // The channel has to exist before we fork, so both processes map it
+    mSharedMemory = std::make_shared<SharedMemoryChannel>();
+    std::shared_ptr<SharedMemoryChannel> channel = mSharedMemory;
+    int child_id
+        = forkServer([&local, channel]() { local.serveSharedMemory(channel); });
+    if (child_id > 0)
+    {
+      std::cout << "(MPC fork process id = " << child_id << ")" << std::endl;
+      mOwnsServer = true;
+      mServerProcessId = child_id;
+    }
+    return;
+  }
+
+  int port = (rand() % 2000) + 2000;
+
+  int child_id = forkServer([&local, port]() { local.serve(port); });
   // We're in the parent process
-  else if (child_id > 0)
+  if (child_id > 0)
   {
     std::cout << "(MPC fork process id = " << child_id << ")" << std::endl;
 
@@ -76,6 +142,30 @@ MPCRemote::MPCRemote(MPCLocal& local, int /* ignored */)
   }
 }
 
+/// With the shared memory transport, this shuts down the listener thread, and
+/// the server process if we forked one, and waits for that process to exit
+MPCRemote::~MPCRemote()
+{
+  if (mSharedMemory)
+  {
+    mRunning = false;
+    if (mUpdateListenerThread.joinable())
+    {
+      mUpdateListenerThread.join();
+    }
+    if (mOwnsServer)
+    {
+      // Closing the channel makes the server's loop return, and the child
+      // exits right after, so this doesn't wait long
+      mSharedMemory->close();
+      if (mServerProcessId > 0)
+      {
+        waitpid(mServerProcessId, nullptr, 0);
+      }
+    }
+  }
+}
+
 /// This gets the force to apply to the world at this instant. If we haven't
 /// computed anything for this instant yet, this just returns 0s.
 Eigen::VectorXs MPCRemote::getControlForce(long now)
@@ -90,12 +180,27 @@ long MPCRemote::getRemainingPlanBufferMillis()
   return mBuffer.getPlanBufferMillisAfter(timeSinceEpochMillis());
 }
 
+/// This returns the transport we're using to talk to the server
+MPCTransport MPCRemote::getTransport() const
+{
+  return mSharedMemory ? MPCTransport::SHARED_MEMORY : MPCTransport::GRPC;
+}
+
 /// This records the current state of the world based on some external sensing
 /// and inference. This resets the error in our model just assuming the world
 /// is exactly following our simulation.
 void MPCRemote::recordGroundTruthState(
     long time, Eigen::VectorXs pos, Eigen::VectorXs vel, Eigen::VectorXs mass)
 {
+  if (mSharedMemory)
+  {
+    std::lock_guard<std::mutex> lock(mSendMutex);
+    packTimedVectors(time, {&pos, &vel, &mass}, mSendBuffer);
+    mSharedMemory->sendToPlanner(
+        MPC_RECORD_GROUND_TRUTH_STATE, mSendBuffer.data(), mSendBuffer.size());
+    return;
+  }
+
   // Context for the client. It could be used to convey extra information to
   // the server and/or tweak certain RPC behaviors.
   grpc::ClientContext context;
@@ -123,9 +228,49 @@ void MPCRemote::recordGroundTruthState(
 /// This starts our main thread and begins running optimizations
 void MPCRemote::start()
 {
-  if (mRunning)
+  // Checking and setting together means two racing calls can't both start
+  if (mRunning.exchange(true))
     return;
-  mRunning = true;
+
+  if (mSharedMemory)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mSendMutex);
+      mSharedMemory->sendToPlanner(MPC_START, nullptr, 0);
+    }
+
+    // Start a thread to listen for updates. This spins rather than sleeping,
+    // so plans are picked up as soon as they arrive.
+    mUpdateListenerThread = std::thread([&]() {
+      int type;
+      std::vector<char> data;
+      while (mRunning && !mSharedMemory->isClosed())
+      {
+        if (!mSharedMemory->receiveOnClient(type, data))
+        {
+          std::this_thread::yield();
+          continue;
+        }
+        if (type != MPC_PLAN_UPDATE)
+        {
+          continue;
+        }
+        long startTime;
+        long replanDurationMillis;
+        trajectory::TrajectoryRolloutReal rollout
+            = unpackPlanUpdate(data, startTime, replanDurationMillis);
+
+        mBuffer.setControlForcePlan(
+            startTime, timeSinceEpochMillis(), rollout.getControlForcesConst());
+
+        for (auto listener : mReplannedListeners)
+        {
+          listener(startTime, &rollout, replanDurationMillis);
+        }
+      }
+    });
+    return;
+  }
 
   // Context for the client. It could be used to convey extra information to
   // the server and/or tweak certain RPC behaviors.
@@ -178,9 +323,21 @@ void MPCRemote::start()
 /// This stops our main thread, waits for it to finish, and then returns
 void MPCRemote::stop()
 {
-  if (!mRunning)
+  if (!mRunning.exchange(false))
+    return;
+
+  if (mSharedMemory)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mSendMutex);
+      mSharedMemory->sendToPlanner(MPC_STOP, nullptr, 0);
+    }
+    if (mUpdateListenerThread.joinable())
+    {
+      mUpdateListenerThread.join();
+    }
     return;
-  mRunning = false;
+  }
 
   // Context for the client. It could be used to convey extra information to
   // the server and/or tweak certain RPC behaviors.
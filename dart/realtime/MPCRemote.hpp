@@ -1,14 +1,18 @@
 #ifndef DART_MPC_REMOTE
 #define DART_MPC_REMOTE
 
+#include <atomic>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include "dart/proto/MPC.grpc.pb.h"
 #include "dart/realtime/MPC.hpp"
 #include "dart/realtime/MPCLocal.hpp"
 #include "dart/realtime/RealTimeControlBuffer.hpp"
+#include "dart/realtime/SharedMemoryChannel.hpp"
 
 namespace grpc {
 class Channel;
@@ -18,6 +22,15 @@ namespace dart {
 
 namespace realtime {
 
+enum MPCTransport
+{
+  // gRPC over TCP, which works across hosts
+  GRPC,
+  // A SharedMemoryChannel, which skips the network stack, and protobuf for
+  // everything except plan updates. This only works on the same host.
+  SHARED_MEMORY
+};
+
 class MPCRemote : public MPC
 {
 public:
@@ -29,10 +42,26 @@ public:
       int steps,
       int millisPerStep);
 
+  /// This connects to an MPCLocal that's serving on `channel`, through
+  /// MPCLocal::serveSharedMemory(), either in this process or a forked one
+  MPCRemote(
+      std::shared_ptr<SharedMemoryChannel> channel,
+      int dofs,
+      int steps,
+      int millisPerStep);
+
   /// This forks the process, starts a server on another process, and connects
   /// to it
   MPCRemote(MPCLocal& local, int ignored = 0);
 
+  /// This forks the process, starts a server on another process, and connects
+  /// to it over `transport`
+  MPCRemote(MPCLocal& local, MPCTransport transport);
+
+  /// With the shared memory transport, this shuts down the listener thread, and
+  /// the server process if we forked one, and waits for that process to exit
+  ~MPCRemote() override;
+
   /// This gets the force to apply to the world at this instant. If we haven't
   /// computed anything for this instant yet, this just returns 0s.
   Eigen::VectorXs getControlForce(long now) override;
@@ -41,6 +70,9 @@ public:
   /// This can be a negative number, if we've run past our plan.
   long getRemainingPlanBufferMillis() override;
 
+  /// This returns the transport we're using to talk to the server
+  MPCTransport getTransport() const;
+
   /// This records the current state of the world based on some external sensing
   /// and inference. This resets the error in our model just assuming the world
   /// is exactly following our simulation.
@@ -62,12 +94,23 @@ public:
           replanListener) override;
 
 protected:
-  bool mRunning;
+  /// This is read by the listener thread, and written by start() and stop()
+  std::atomic<bool> mRunning;
   std::shared_ptr<grpc::Channel> mChannel;
   std::unique_ptr<proto::MPCService::Stub> mStub;
   RealTimeControlBuffer mBuffer;
   std::thread mUpdateListenerThread;
 
+  // These are only used with the shared memory transport
+  std::shared_ptr<SharedMemoryChannel> mSharedMemory;
+  bool mOwnsServer;
+  /// This is the process id of the server we forked, or -1
+  int mServerProcessId;
+  /// The channel's rings only support a single sender, so this serializes
+  /// calls to sendToPlanner() (and the use of mSendBuffer) across threads
+  std::mutex mSendMutex;
+  std::vector<char> mSendBuffer;
+
   // These are listeners that get called when we finish replanning
   std::vector<
       std::function<void(long, const trajectory::TrajectoryRollout*, long)>>
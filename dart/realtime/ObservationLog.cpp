@@ -16,33 +16,55 @@ ObservationLog::ObservationLog(
     long startTime,
     Eigen::VectorXs initialPos,
     Eigen::VectorXs initialVel,
-    Eigen::VectorXs initialMass)
-  : mDofs(initialPos.size()), mMassDim(initialMass.size()), mMass(initialMass)
+    Eigen::VectorXs initialMass,
+    int capacity)
+  : mDofs(initialPos.size()),
+    mMassDim(initialMass.size()),
+    mInitialObservation(startTime, initialPos, initialVel),
+    mObservations(VectorLog(2 * initialPos.size(), capacity)),
+    mObserveScratch(Eigen::VectorXs::Zero(2 * initialPos.size())),
+    mMass(initialMass)
 {
-  mObservations.emplace_back(startTime, initialPos, initialVel);
+  mObserveScratch.head(mDofs) = initialPos;
+  mObserveScratch.tail(mDofs) = initialVel;
+  mObservations.record(startTime, mObserveScratch);
 }
 
+/// Observations are expected in time order, so any observation older than
+/// the latest one is dropped. This doesn't allocate.
 void ObservationLog::observe(
     long time,
-    Eigen::VectorXs pos,
-    Eigen::VectorXs vel,
+    const Eigen::VectorXs& pos,
+    const Eigen::VectorXs& vel,
     // TODO(keenon): Support mass observations
-    Eigen::VectorXs /* mass */)
+    const Eigen::VectorXs& /* mass */)
 {
-  mObservations.emplace_back(time, pos, vel);
+  mObserveScratch.head(mDofs) = pos;
+  mObserveScratch.tail(mDofs) = vel;
+  mObservations.record(time, mObserveScratch);
 }
 
+/// This binary searches for the latest observation at or before `time`. If
+/// there isn't one, this falls back to the oldest observation we still
+/// have, or to the initial observation if every observation was discarded.
 Observation ObservationLog::getClosestObservationBefore(long time)
 {
-  for (int i = mObservations.size() - 1; i >= 0; i--)
+  long recordedTime;
+  Eigen::VectorXs value = Eigen::VectorXs::Zero(2 * mDofs);
+  if (mObservations.getLastValueAtOrBefore(time, recordedTime, value))
   {
-    if (mObservations[i].time <= time)
-      return mObservations[i];
+    return Observation(
+        recordedTime, value.head(mDofs), value.segment(mDofs, mDofs));
   }
-  std::cout << "WARNING: Asked for an observation before our initialization. "
-               "Returning our initialization"
+  std::cout << "WARNING: Asked for an observation before the oldest one we "
+               "have. Returning the oldest one"
             << std::endl;
-  return mObservations[0];
+  if (mObservations.getFirstValue(recordedTime, value))
+  {
+    return Observation(
+        recordedTime, value.head(mDofs), value.segment(mDofs, mDofs));
+  }
+  return mInitialObservation;
 }
 
 Eigen::VectorXs ObservationLog::getMass()
@@ -52,25 +74,8 @@ Eigen::VectorXs ObservationLog::getMass()
 
 void ObservationLog::discardBefore(long time)
 {
-  int discardBeforeIndex = -1;
-  for (int i = mObservations.size() - 1; i >= 0; i--)
-  {
-    if (mObservations[i].time < time)
-    {
-      discardBeforeIndex = i;
-      break;
-    }
-  }
-  if (discardBeforeIndex == -1)
-    return;
-
-  std::vector<Observation> newObservations;
-  for (int i = discardBeforeIndex + 1; i < mObservations.size(); i++)
-  {
-    newObservations.push_back(mObservations[i]);
-  }
-  mObservations = newObservations;
+  mObservations.discardBefore(time);
 }
 
 } // namespace realtime
-} // namespace dart
\ No newline at end of file
+} // namespace dart
@@ -6,6 +6,8 @@
 #include <Eigen/Dense>
 
 #include "dart/math/MathTypes.hpp"
+#include "dart/realtime/VectorLog.hpp"
+
 namespace dart {
 namespace realtime {
 
@@ -18,6 +20,11 @@ struct Observation
   Observation(long time, Eigen::VectorXs pos, Eigen::VectorXs vel);
 };
 
+/// This keeps the most recent `capacity` observations in a preallocated
+/// circular buffer (see VectorLog), so one thread can observe() while
+/// another looks up observations, without locks or allocating on observe().
+/// The initial observation is the first entry in the buffer, so it gets
+/// evicted like any other once enough observations come in.
 class ObservationLog
 {
 public:
@@ -25,14 +32,20 @@ public:
       long startTime,
       Eigen::VectorXs initialPos,
       Eigen::VectorXs initialVel,
-      Eigen::VectorXs initialMass);
+      Eigen::VectorXs initialMass,
+      int capacity = 1000);
 
+  /// Observations are expected in time order, so any observation older than
+  /// the latest one is dropped. This doesn't allocate.
   void observe(
       long time,
-      Eigen::VectorXs pos,
-      Eigen::VectorXs vel,
-      Eigen::VectorXs mass);
+      const Eigen::VectorXs& pos,
+      const Eigen::VectorXs& vel,
+      const Eigen::VectorXs& mass);
 
+  /// This binary searches for the latest observation at or before `time`. If
+  /// there isn't one, this falls back to the oldest observation we still
+  /// have, or to the initial observation if every observation was discarded.
   Observation getClosestObservationBefore(long time);
 
   Eigen::VectorXs getMass();
@@ -42,11 +55,15 @@ public:
 protected:
   int mDofs;
   int mMassDim;
-  std::vector<Observation> mObservations;
+  Observation mInitialObservation;
+  /// Each entry is the position followed by the velocity
+  VectorLog mObservations;
+  /// This is only touched by observe(), to stack the position and velocity
+  Eigen::VectorXs mObserveScratch;
   Eigen::VectorXs mMass;
 };
 
 } // namespace realtime
 } // namespace dart
 
-#endif
\ No newline at end of file
+#endif
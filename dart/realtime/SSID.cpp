@@ -1,7 +1,11 @@
 #include "dart/realtime/SSID.hpp"
 
+#include <future>
+#include <limits>
 #include <thread>
 
+#include <coin/IpoptConfig.h>
+
 #include "dart/realtime/Millis.hpp"
 #include "dart/simulation/World.hpp"
 #include "dart/trajectory/IPOptOptimizer.hpp"
@@ -10,6 +14,16 @@
 
 #include "signal.h"
 
+// MUMPS, IPOPT's default linear solver, isn't safe to call from several
+// threads at once until IPOPT 3.14 started guarding it with a mutex
+#if defined(IPOPT_VERSION_MAJOR) && defined(IPOPT_VERSION_MINOR)           \
+    && (IPOPT_VERSION_MAJOR > 3                                            \
+        || (IPOPT_VERSION_MAJOR == 3 && IPOPT_VERSION_MINOR >= 14))
+#define DART_IPOPT_CONCURRENT_SOLVES true
+#else
+#define DART_IPOPT_CONCURRENT_SOLVES false
+#endif
+
 namespace dart {
 
 using namespace trajectory;
@@ -28,7 +42,11 @@ SSID::SSID(
     mPlanningHistoryMillis(planningHistoryMillis),
     mSensorDims(sensorDims),
     mControlLog(VectorLog(world->getNumDofs())),
-    mPlanningSteps(steps)
+    mPlanningSteps(steps),
+    mParallelWorkers(1),
+    mCustomProblem(false),
+    mEarlyStopLoss(-std::numeric_limits<s_t>::infinity()),
+    mCancelSweep(false)
 {
   for (int i = 0; i < mSensorDims.size(); i++)
   {
@@ -55,6 +73,7 @@ SSID::SSID(
   ipoptOptimizer->setLBFGSHistoryLength(5);
   ipoptOptimizer->setSilenceOutput(true);
   mOptimizer = ipoptOptimizer;
+  registerEarlyStop(mOptimizer);
 }
 
 /// This updates the loss function that we're going to move in real time to
@@ -64,6 +83,8 @@ SSID::SSID(
 void SSID::setLoss(std::shared_ptr<trajectory::LossFn> loss)
 {
   mLoss = loss;
+  // The worker problems were built with the old loss
+  mWorkerProblems.clear();
 }
 
 /// This sets the optimizer that MPC will use. This will override the default
@@ -71,6 +92,7 @@ void SSID::setLoss(std::shared_ptr<trajectory::LossFn> loss)
 void SSID::setOptimizer(std::shared_ptr<trajectory::Optimizer> optimizer)
 {
   mOptimizer = optimizer;
+  registerEarlyStop(mOptimizer);
 }
 
 /// This returns the current optimizer that MPC is using
@@ -84,6 +106,8 @@ std::shared_ptr<trajectory::Optimizer> SSID::getOptimizer()
 void SSID::setProblem(std::shared_ptr<trajectory::Problem> problem)
 {
   mProblem = problem;
+  mCustomProblem = true;
+  mWorkerProblems.clear();
 }
 
 /// This registers a function that can be used to estimate the initial state
@@ -106,6 +130,60 @@ std::shared_ptr<trajectory::Problem> SSID::getProblem()
   return mProblem;
 }
 
+/// This sets the number of workers (each with its own cloned World) that
+/// runPlotting(), runPlotting2D() and multi-start runInference() spread
+/// their samples over. Defaults to 1, which runs everything on mWorld. Extra
+/// workers are only used with the default SingleShot problem, since we
+/// don't know how to copy a custom problem set with setProblem().
+void SSID::setParallelWorkers(int workers)
+{
+  mParallelWorkers = std::max(1, workers);
+  if (mParallelWorkers > 1)
+  {
+    // Before using Eigen in a multi-threaded environment, we need to explicitly
+    // call this (at least prior to Eigen 3.3)
+    Eigen::initParallel();
+  }
+  mWorkerWorlds.clear();
+  mWorkerProblems.clear();
+  for (int i = 1; i < mParallelWorkers; i++)
+  {
+    mWorkerWorlds.push_back(mWorld->clone());
+  }
+}
+
+/// This sets a list of mass vectors to start inference from. If this is
+/// non-empty, runInference() will optimize from every start (in parallel,
+/// across the workers) and keep the one with the lowest loss.
+void SSID::setMultiStartMasses(std::vector<Eigen::VectorXs> starts)
+{
+  mMultiStartMasses = starts;
+}
+
+/// If any inference run reaches a loss below this value, all the runs stop
+/// at their next iteration. Defaults to -infinity, which never stops early.
+void SSID::setEarlyStopLoss(s_t loss)
+{
+  mEarlyStopLoss = loss;
+}
+
+/// This registers a listener that gets called with (x index, y index, loss)
+/// as soon as each sample of runPlotting() or runPlotting2D() finishes, so
+/// results can be streamed before the whole grid is done. For 1D plots the
+/// y index is always 0. This may be called from worker threads, but calls
+/// are never concurrent.
+void SSID::registerSweepListener(std::function<void(int, int, s_t)> listener)
+{
+  mSweepListeners.push_back(listener);
+}
+
+/// This asks any running plotting sweep or inference to stop as soon as
+/// possible. Samples of a sweep that didn't get evaluated are left as NaN.
+void SSID::cancelSweep()
+{
+  mCancelSweep = true;
+}
+
 /// This logs that the sensor output is a specific vector now
 void SSID::registerSensorsNow(Eigen::VectorXs sensors, int sensor_id)
 {
@@ -152,56 +230,106 @@ void SSID::stop()
 /// This runs inference to find mutable values, starting at `startTime`
 void SSID::runInference(long startTime)
 {
-  // registerLock();
   long startComputeWallTime = timeSinceEpochMillis();
 
   int millisPerStep = static_cast<int>(ceil(mWorld->getTimeStep() * 1000.0));
   int steps = static_cast<int>(
       ceil(static_cast<s_t>(mPlanningHistoryMillis) / millisPerStep));
 
-  if (!mProblem)
+  ensureWorkers(steps);
+  loadHistory(startTime, steps);
+  mCancelSweep = false;
+
+  if (mMultiStartMasses.size() == 0)
   {
-    std::shared_ptr<SingleShot> singleshot
-        = std::make_shared<SingleShot>(mWorld, *mLoss.get(), steps, false);
-    // multishot->setParallelOperationsEnabled(true);
-    mProblem = singleshot;
+    // Then actually run the optimization
+    mSolution = mOptimizer->optimize(mProblem.get());
   }
-  // std::cout<<"Problem Created"<<std::endl;
-  //  Every turn, we need to pin all the forces
-  registerLock();
-  // Eigen::MatrixXs forceHistory = mControlLog.getValues(
-  //     startTime - mPlanningHistoryMillis, steps, millisPerStep);
-  Eigen::MatrixXs forceHistory
-      = mControlLog.getRecentValuesBefore(startTime, steps + 1);
-  for (int i = 0; i < steps; i++)
+  else
   {
-    mProblem->pinForce(i, forceHistory.col(i));
-  }
-  // std::cout<<"ForcePinned"<<std::endl;
-  //  We also need to set all the sensor history into metadata
+    // Each start gets optimized on whichever worker is free next. We don't
+    // know that an Optimizer is safe to share between threads, so each worker
+    // gets its own copy of an IPOptOptimizer. If we can't copy the optimizer,
+    // or IPOPT is too old to run solves concurrently, the workers take turns
+    // in optimize() instead.
+    int numWorkers = 1 + mWorkerProblems.size();
+    int numStarts = mMultiStartMasses.size();
+    std::shared_ptr<IPOptOptimizer> ipopt
+        = std::dynamic_pointer_cast<IPOptOptimizer>(mOptimizer);
+    bool concurrentSolves = ipopt != nullptr && DART_IPOPT_CONCURRENT_SOLVES;
+    std::vector<std::shared_ptr<Optimizer>> optimizers;
+    optimizers.push_back(mOptimizer);
+    for (int i = 1; i < numWorkers; i++)
+    {
+      // The copies keep the early-stopping callback registered on mOptimizer
+      optimizers.push_back(
+          ipopt ? std::make_shared<IPOptOptimizer>(*ipopt) : mOptimizer);
+    }
+    std::mutex solveMutex;
+    std::vector<s_t> startLosses(
+        numStarts, std::numeric_limits<s_t>::infinity());
+    std::vector<Eigen::VectorXs> startMasses(numStarts);
+    std::vector<std::shared_ptr<Solution>> startSolutions(numStarts);
+    std::atomic<int> nextStart(0);
+
+    auto runStarts = [&](std::shared_ptr<simulation::World> world,
+                         std::shared_ptr<Problem> problem,
+                         std::shared_ptr<Optimizer> optimizer) {
+      int k;
+      while (!mCancelSweep && (k = nextStart++) < numStarts)
+      {
+        world->setMasses(mMultiStartMasses[k]);
+        problem->resetDirty();
+        if (concurrentSolves)
+        {
+          startSolutions[k] = optimizer->optimize(problem.get());
+        }
+        else
+        {
+          std::lock_guard<std::mutex> lock(solveMutex);
+          startSolutions[k] = optimizer->optimize(problem.get());
+        }
+        startLosses[k] = problem->getLoss(world);
+        startMasses[k] = world->getMasses();
+      }
+    };
+
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < numWorkers - 1; i++)
+    {
+      futures.push_back(std::async(
+          std::launch::async,
+          runStarts,
+          mWorkerWorlds[i],
+          mWorkerProblems[i],
+          optimizers[i + 1]));
+    }
+    runStarts(mWorld, mProblem, optimizers[0]);
+    for (auto& future : futures)
+    {
+      future.get();
+    }
 
-  // Eigen::MatrixXs poseHistory = mSensorLogs[0].getValues(
-  //     startTime - mPlanningHistoryMillis, steps, millisPerStep);
-  // Eigen::MatrixXs velHistory = mSensorLogs[1].getValues(
-  //   startTime - mPlanningHistoryMillis, steps, millisPerStep
-  //  );
-  Eigen::MatrixXs poseHistory
-      = mSensorLogs[0].getRecentValuesBefore(startTime, steps + 1);
-  Eigen::MatrixXs velHistory
-      = mSensorLogs[1].getRecentValuesBefore(startTime, steps + 1);
-  registerUnlock();
-  // std::cout<<"In SSID Force Hist: \n"<<forceHistory<<"\nPos Hist:
-  // \n"<<poseHistory<<"\nVel Hist: \n"<<velHistory<<std::endl;
-  mProblem->setMetadata("forces", forceHistory);
-  mProblem->setMetadata("sensors", poseHistory);
-  mProblem->setMetadata("velocities", velHistory);
-  mProblem->setStartPos(mInitialPosEstimator(poseHistory, startTime));
-  // TODO: Set initial velocity
-  mProblem->setStartVel(mInitialVelEstimator(velHistory, startTime));
-  // Then actually run the optimization
-  // std::cout<<"Ready to Optimize"<<std::endl;
-  mSolution = mOptimizer->optimize(mProblem.get());
-  // std::cout<<"Optimization End"<<std::endl;
+    int best = -1;
+    for (int k = 0; k < numStarts; k++)
+    {
+      if (startSolutions[k]
+          && (best == -1 || startLosses[k] < startLosses[best]))
+        best = k;
+    }
+    if (best == -1)
+    {
+      // We were cancelled before any start finished, so there's no new
+      // estimate to report
+      mSolution = nullptr;
+      return;
+    }
+    // Put the winning masses on mWorld, so that the rollout cache we read
+    // below matches the reported masses
+    mSolution = startSolutions[best];
+    mWorld->setMasses(startMasses[best]);
+    mProblem->resetDirty();
+  }
 
   long computeDurationWallTime = timeSinceEpochMillis() - startComputeWallTime;
 
@@ -225,58 +353,26 @@ Eigen::VectorXs SSID::runPlotting(
   int steps = static_cast<int>(
       ceil(static_cast<s_t>(mPlanningHistoryMillis) / millisPerStep));
 
-  if (!mProblem)
-  {
-    std::shared_ptr<SingleShot> singleshot
-        = std::make_shared<SingleShot>(mWorld, *mLoss.get(), steps, false);
-    mProblem = singleshot;
-  }
-
-  registerLock();
-  Eigen::MatrixXs forceHistory
-      = mControlLog.getRecentValuesBefore(startTime, steps + 1);
-  for (int i = 0; i < steps; i++)
-  {
-    mProblem->pinForce(i, forceHistory.col(i));
-  }
-
-  Eigen::MatrixXs poseHistory
-      = mSensorLogs[0].getRecentValuesBefore(startTime, steps + 1);
-  Eigen::MatrixXs velHistory
-      = mSensorLogs[1].getRecentValuesBefore(startTime, steps + 1);
+  ensureWorkers(steps);
+  loadHistory(startTime, steps);
 
-  registerUnlock();
-  mProblem->setMetadata("forces", forceHistory);
-  mProblem->setMetadata("sensors", poseHistory);
-  mProblem->setMetadata("velocities", velHistory);
-  mProblem->setStartPos(mInitialPosEstimator(poseHistory, startTime));
-  mProblem->setStartVel(mInitialVelEstimator(velHistory, startTime));
-
-  Eigen::VectorXs losses;
+  std::vector<Eigen::VectorXs> probes;
   if (upper != lower)
   {
-    losses = Eigen::VectorXs::Zero(samples);
     s_t epsilon = (upper - lower) / samples;
     s_t probe = lower;
     for (int i = 0; i < samples; i++)
     {
-      mWorld->setMasses(Eigen::Vector1s(probe));
-      mProblem->resetDirty();
-      s_t loss = mProblem->getLoss(mWorld);
-      losses(i) = loss;
+      probes.push_back(Eigen::Vector1s(probe));
       probe += epsilon;
     }
   }
   else
   {
-    losses = Eigen::VectorXs::Zero(1);
-    mWorld->setMasses(Eigen::Vector1s(lower));
-    mProblem->resetDirty();
-    s_t loss = mProblem->getLoss(mWorld);
-    losses(0) = loss;
+    probes.push_back(Eigen::Vector1s(lower));
   }
 
-  return losses;
+  return sweepLosses(probes, 1);
 }
 
 Eigen::MatrixXs SSID::runPlotting2D(
@@ -291,34 +387,8 @@ Eigen::MatrixXs SSID::runPlotting2D(
   int steps = static_cast<int>(
       ceil(static_cast<s_t>(mPlanningHistoryMillis) / millisPerStep));
 
-  if (!mProblem)
-  {
-    std::shared_ptr<SingleShot> singleshot
-        = std::make_shared<SingleShot>(mWorld, *mLoss.get(), steps, false);
-    mProblem = singleshot;
-  }
-
-  registerLock();
-  Eigen::MatrixXs forceHistory
-      = mControlLog.getRecentValuesBefore(startTime, steps + 1);
-  for (int i = 0; i < steps; i++)
-  {
-    mProblem->pinForce(i, forceHistory.col(i));
-  }
-
-  Eigen::MatrixXs poseHistory
-      = mSensorLogs[0].getRecentValuesBefore(startTime, steps + 1);
-  Eigen::MatrixXs velHistory
-      = mSensorLogs[1].getRecentValuesBefore(startTime, steps + 1);
-
-  registerUnlock();
-  mProblem->setMetadata("forces", forceHistory);
-  mProblem->setMetadata("sensors", poseHistory);
-  mProblem->setMetadata("velocities", velHistory);
-  mProblem->setStartPos(mInitialPosEstimator(poseHistory, startTime));
-  mProblem->setStartVel(mInitialVelEstimator(velHistory, startTime));
-
-  Eigen::MatrixXs losses = Eigen::MatrixXs::Zero(x_samples, y_samples);
+  ensureWorkers(steps);
+  loadHistory(startTime, steps);
 
   Eigen::Vector3s probe = lower;
   assert(rest_dim < 3);
@@ -345,21 +415,161 @@ Eigen::MatrixXs SSID::runPlotting2D(
   s_t x_epsilon = (upper(probe_dim_1) - lower(probe_dim_1)) / x_samples;
   s_t y_epsilon = (upper(probe_dim_2) - lower(probe_dim_2)) / y_samples;
 
+  // Probes are laid out row-major, so sample k is (k / y_samples, k %
+  // y_samples)
+  std::vector<Eigen::VectorXs> probes;
   for (int x_i = 0; x_i < x_samples; x_i++)
   {
     probe(probe_dim_2) = lower(probe_dim_2);
     for (int y_i = 0; y_i < y_samples; y_i++)
     {
-      mWorld->setMasses(probe);
-      mProblem->resetDirty();
-      losses(x_i, y_i) = mProblem->getLoss(mWorld);
+      probes.push_back(probe);
       probe(probe_dim_2) += y_epsilon;
     }
     probe(probe_dim_1) += x_epsilon;
   }
+
+  Eigen::VectorXs flat = sweepLosses(probes, y_samples);
+  Eigen::MatrixXs losses = Eigen::MatrixXs::Zero(x_samples, y_samples);
+  for (int x_i = 0; x_i < x_samples; x_i++)
+  {
+    losses.row(x_i) = flat.segment(x_i * y_samples, y_samples).transpose();
+  }
   return losses;
 }
 
+/// This makes sure mProblem exists, and (if we're allowed to use them)
+/// that there's one cloned World and SingleShot per extra worker
+void SSID::ensureWorkers(int steps)
+{
+  if (!mProblem)
+  {
+    std::shared_ptr<SingleShot> singleshot
+        = std::make_shared<SingleShot>(mWorld, *mLoss.get(), steps, false);
+    mProblem = singleshot;
+  }
+  if (mCustomProblem || mWorkerWorlds.size() == 0)
+  {
+    mWorkerProblems.clear();
+    return;
+  }
+  if (mWorkerProblems.size() == mWorkerWorlds.size()
+      && mWorkerProblems[0]->getNumSteps() == steps)
+  {
+    return;
+  }
+  mWorkerProblems.clear();
+  for (std::shared_ptr<simulation::World> world : mWorkerWorlds)
+  {
+    mWorkerProblems.push_back(
+        std::make_shared<SingleShot>(world, *mLoss.get(), steps, false));
+  }
+}
+
+/// This reads the recent force and sensor history before `startTime` once,
+/// and loads it into mProblem and every worker problem
+void SSID::loadHistory(long startTime, int steps)
+{
+  //  Every turn, we need to pin all the forces
+  registerLock();
+  Eigen::MatrixXs forceHistory
+      = mControlLog.getRecentValuesBefore(startTime, steps + 1);
+  //  We also need to set all the sensor history into metadata
+  Eigen::MatrixXs poseHistory
+      = mSensorLogs[0].getRecentValuesBefore(startTime, steps + 1);
+  Eigen::MatrixXs velHistory
+      = mSensorLogs[1].getRecentValuesBefore(startTime, steps + 1);
+  registerUnlock();
+
+  Eigen::VectorXs startPos = mInitialPosEstimator(poseHistory, startTime);
+  Eigen::VectorXs startVel = mInitialVelEstimator(velHistory, startTime);
+
+  std::vector<std::shared_ptr<Problem>> problems = mWorkerProblems;
+  problems.push_back(mProblem);
+  for (std::shared_ptr<Problem> problem : problems)
+  {
+    for (int i = 0; i < steps; i++)
+    {
+      problem->pinForce(i, forceHistory.col(i));
+    }
+    problem->setMetadata("forces", forceHistory);
+    problem->setMetadata("sensors", poseHistory);
+    problem->setMetadata("velocities", velHistory);
+    problem->setStartPos(startPos);
+    problem->setStartVel(startVel);
+  }
+}
+
+/// This evaluates the loss at each of `probes` (a list of mass vectors),
+/// spreading the samples over the workers. `cols` is only used to split the
+/// sample index into (x, y) for the sweep listeners.
+Eigen::VectorXs SSID::sweepLosses(
+    const std::vector<Eigen::VectorXs>& probes, int cols)
+{
+  int numProbes = probes.size();
+  Eigen::VectorXs losses = Eigen::VectorXs::Constant(
+      numProbes, std::numeric_limits<s_t>::quiet_NaN());
+  mCancelSweep = false;
+
+  // Workers pull the next unevaluated sample, so a slow sample on one worker
+  // doesn't hold up the others
+  std::atomic<int> nextProbe(0);
+  auto runProbes = [&](std::shared_ptr<simulation::World> world,
+                       std::shared_ptr<Problem> problem) {
+    int k;
+    while (!mCancelSweep && (k = nextProbe++) < numProbes)
+    {
+      world->setMasses(probes[k]);
+      problem->resetDirty();
+      s_t loss = problem->getLoss(world);
+      losses(k) = loss;
+
+      std::lock_guard<std::mutex> lock(mSweepListenerMutex);
+      for (auto& listener : mSweepListeners)
+      {
+        listener(k / cols, k % cols, loss);
+      }
+    }
+  };
+
+  std::vector<std::future<void>> futures;
+  for (int i = 0; i < mWorkerProblems.size(); i++)
+  {
+    futures.push_back(std::async(
+        std::launch::async, runProbes, mWorkerWorlds[i], mWorkerProblems[i]));
+  }
+  runProbes(mWorld, mProblem);
+  for (auto& future : futures)
+  {
+    future.get();
+  }
+
+  return losses;
+}
+
+/// This registers the early-stopping callback on an optimizer, unless we've
+/// already registered it there
+void SSID::registerEarlyStop(std::shared_ptr<trajectory::Optimizer> optimizer)
+{
+  if (!optimizer)
+    return;
+  for (std::weak_ptr<trajectory::Optimizer>& registered : mEarlyStopOptimizers)
+  {
+    if (registered.lock() == optimizer)
+      return;
+  }
+  mEarlyStopOptimizers.push_back(optimizer);
+  optimizer->registerIntermediateCallback(
+      [this](Problem* /* problem */, int /* step */, s_t primal, s_t /* dual */)
+          -> bool {
+        if (primal < mEarlyStopLoss)
+        {
+          mCancelSweep = true;
+        }
+        return !mCancelSweep;
+      });
+}
+
 void SSID::saveCSVMatrix(std::string filename, Eigen::MatrixXs matrix)
 {
   const static Eigen::IOFormat CSVFormat(
@@ -1,9 +1,11 @@
 #ifndef DART_REALTIME_SSID
 #define DART_REALTIME_SSID
 
+#include <atomic>
 #include <memory>
 #include <thread>
 #include <mutex>
+#include <vector>
 
 #include <Eigen/Dense>
 #include <iostream>
@@ -67,6 +69,33 @@ public:
   /// This returns the current problem definition that MPC is using
   std::shared_ptr<trajectory::Problem> getProblem();
 
+  /// This sets the number of workers (each with its own cloned World) that
+  /// runPlotting(), runPlotting2D() and multi-start runInference() spread
+  /// their samples over. Defaults to 1, which runs everything on mWorld. Extra
+  /// workers are only used with the default SingleShot problem, since we
+  /// don't know how to copy a custom problem set with setProblem().
+  void setParallelWorkers(int workers);
+
+  /// This sets a list of mass vectors to start inference from. If this is
+  /// non-empty, runInference() will optimize from every start (in parallel,
+  /// across the workers) and keep the one with the lowest loss.
+  void setMultiStartMasses(std::vector<Eigen::VectorXs> starts);
+
+  /// If any inference run reaches a loss below this value, all the runs stop
+  /// at their next iteration. Defaults to -infinity, which never stops early.
+  void setEarlyStopLoss(s_t loss);
+
+  /// This registers a listener that gets called with (x index, y index, loss)
+  /// as soon as each sample of runPlotting() or runPlotting2D() finishes, so
+  /// results can be streamed before the whole grid is done. For 1D plots the
+  /// y index is always 0. This may be called from worker threads, but calls
+  /// are never concurrent.
+  void registerSweepListener(std::function<void(int, int, s_t)> listener);
+
+  /// This asks any running plotting sweep or inference to stop as soon as
+  /// possible. Samples of a sweep that didn't get evaluated are left as NaN.
+  void cancelSweep();
+
   /// This logs that the sensor output is a specific vector now
   void registerSensorsNow(Eigen::VectorXs sensors, int sensor_id);
 
@@ -110,6 +139,24 @@ protected:
   /// This is the function for the optimization thread to run when we're live
   void optimizationThreadLoop();
 
+  /// This makes sure mProblem exists, and (if we're allowed to use them)
+  /// that there's one cloned World and SingleShot per extra worker
+  void ensureWorkers(int steps);
+
+  /// This reads the recent force and sensor history before `startTime` once,
+  /// and loads it into mProblem and every worker problem
+  void loadHistory(long startTime, int steps);
+
+  /// This evaluates the loss at each of `probes` (a list of mass vectors),
+  /// spreading the samples over the workers. `cols` is only used to split the
+  /// sample index into (x, y) for the sweep listeners.
+  Eigen::VectorXs sweepLosses(
+      const std::vector<Eigen::VectorXs>& probes, int cols);
+
+  /// This registers the early-stopping callback on an optimizer, unless
+  /// we've already registered it there
+  void registerEarlyStop(std::shared_ptr<trajectory::Optimizer> optimizer);
+
   bool mRunning;
   std::shared_ptr<simulation::World> mWorld;
   std::shared_ptr<trajectory::LossFn> mLoss;
@@ -127,6 +174,20 @@ protected:
   bool mLockRegistered = false;
   Eigen::VectorXs mParameters;
 
+  // These are the extra workers, each with its own World and Problem.
+  // mWorld and mProblem always act as worker 0.
+  int mParallelWorkers;
+  bool mCustomProblem;
+  std::vector<std::shared_ptr<simulation::World>> mWorkerWorlds;
+  std::vector<std::shared_ptr<trajectory::Problem>> mWorkerProblems;
+  std::vector<Eigen::VectorXs> mMultiStartMasses;
+  s_t mEarlyStopLoss;
+  // These are the optimizers we've registered the early-stopping callback on
+  std::vector<std::weak_ptr<trajectory::Optimizer>> mEarlyStopOptimizers;
+  std::atomic<bool> mCancelSweep;
+  std::mutex mSweepListenerMutex;
+  std::vector<std::function<void(int, int, s_t)>> mSweepListeners;
+
   // These are listeners that get called when we finish replanning
   std::vector<std::function<void(
       long, Eigen::VectorXs, Eigen::VectorXs, Eigen::VectorXs, long)> >
@@ -0,0 +1,351 @@
+#include "dart/realtime/SharedMemoryChannel.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <thread>
+
+#include <sys/mman.h>
+
+#include "dart/proto/TrajectoryRollout.pb.h"
+
+namespace dart {
+namespace realtime {
+
+static_assert(
+    std::atomic<std::uint64_t>::is_always_lock_free
+        && std::atomic<bool>::is_always_lock_free,
+    "Shared memory rings need lock-free (and so address-free) atomics");
+
+// Every message starts with its payload size and type, and is padded so the
+// next one starts on an 8 byte boundary
+static const std::uint64_t FRAME_HEADER_BYTES = 8;
+
+//==============================================================================
+static std::uint64_t roundUp(std::uint64_t bytes, std::uint64_t alignment)
+{
+  return (bytes + alignment - 1) / alignment * alignment;
+}
+
+//==============================================================================
+/// This copies `size` bytes into the ring at `position`, wrapping around the
+/// end if it needs to
+static void copyIntoRing(
+    char* ring,
+    std::uint64_t capacity,
+    std::uint64_t position,
+    const void* src,
+    std::uint64_t size)
+{
+  if (size == 0)
+  {
+    return;
+  }
+  std::uint64_t offset = position % capacity;
+  std::uint64_t first = std::min(size, capacity - offset);
+  std::memcpy(ring + offset, src, first);
+  std::memcpy(ring, static_cast<const char*>(src) + first, size - first);
+}
+
+//==============================================================================
+/// This copies `size` bytes out of the ring at `position`, wrapping around the
+/// end if it needs to
+static void copyOutOfRing(
+    const char* ring,
+    std::uint64_t capacity,
+    std::uint64_t position,
+    void* dst,
+    std::uint64_t size)
+{
+  if (size == 0)
+  {
+    return;
+  }
+  std::uint64_t offset = position % capacity;
+  std::uint64_t first = std::min(size, capacity - offset);
+  std::memcpy(dst, ring + offset, first);
+  std::memcpy(static_cast<char*>(dst) + first, ring, size - first);
+}
+
+//==============================================================================
+char* SharedMemoryChannel::Ring::data()
+{
+  return reinterpret_cast<char*>(this) + sizeof(Ring);
+}
+
+//==============================================================================
+SharedMemoryChannel::SharedMemoryChannel(
+    std::size_t toPlannerCapacityBytes, std::size_t toClientCapacityBytes)
+{
+  std::uint64_t toPlannerCapacity = roundUp(toPlannerCapacityBytes, 64);
+  std::uint64_t toClientCapacity = roundUp(toClientCapacityBytes, 64);
+  std::uint64_t closedBytes = roundUp(sizeof(std::atomic<bool>), 64);
+  mMappedBytes = closedBytes + sizeof(Ring) + toPlannerCapacity + sizeof(Ring)
+                 + toClientCapacity;
+
+  mMemory = mmap(
+      nullptr,
+      mMappedBytes,
+      PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_ANONYMOUS,
+      -1,
+      0);
+  if (mMemory == MAP_FAILED)
+  {
+    throw std::bad_alloc();
+  }
+
+  char* cursor = static_cast<char*>(mMemory);
+  mClosed = new (cursor) std::atomic<bool>(false);
+  cursor += closedBytes;
+  mToPlanner = new (cursor) Ring();
+  cursor += sizeof(Ring) + toPlannerCapacity;
+  mToClient = new (cursor) Ring();
+
+  for (auto pair : {std::make_pair(mToPlanner, toPlannerCapacity),
+                    std::make_pair(mToClient, toClientCapacity)})
+  {
+    pair.first->head.store(0);
+    pair.first->tail.store(0);
+    pair.first->readEnd = 0;
+    pair.first->capacity = pair.second;
+  }
+}
+
+//==============================================================================
+SharedMemoryChannel::~SharedMemoryChannel()
+{
+  munmap(mMemory, mMappedBytes);
+}
+
+//==============================================================================
+/// This sends a message from the client to the planner. This returns false
+/// if the message can never fit in the ring, or if the channel is closed.
+bool SharedMemoryChannel::sendToPlanner(
+    int type, const void* data, std::size_t size)
+{
+  return send(mToPlanner, mClosed, type, data, size);
+}
+
+//==============================================================================
+/// This receives the oldest message sent to the planner, if there is one,
+/// without blocking. The message's space isn't released to the sender until
+/// the next call, so isPlannerCaughtUp() only turns true once the planner
+/// has come back for more.
+bool SharedMemoryChannel::receiveOnPlanner(
+    /* OUT */ int& type, /* OUT */ std::vector<char>& data)
+{
+  return receive(mToPlanner, type, data);
+}
+
+//==============================================================================
+/// This sends a message from the planner to the client. This returns false
+/// if the message can never fit in the ring, or if the channel is closed.
+bool SharedMemoryChannel::sendToClient(
+    int type, const void* data, std::size_t size)
+{
+  return send(mToClient, mClosed, type, data, size);
+}
+
+//==============================================================================
+/// This receives the oldest message sent to the client, if there is one,
+/// without blocking.
+bool SharedMemoryChannel::receiveOnClient(
+    /* OUT */ int& type, /* OUT */ std::vector<char>& data)
+{
+  return receive(mToClient, type, data);
+}
+
+//==============================================================================
+/// This returns true once the planner has finished with every message sent
+/// to it so far, which is the next call to receiveOnPlanner() after the
+/// last message was received.
+bool SharedMemoryChannel::isPlannerCaughtUp() const
+{
+  return mToPlanner->tail.load(std::memory_order_acquire)
+         == mToPlanner->head.load(std::memory_order_acquire);
+}
+
+//==============================================================================
+/// This wakes up any blocked senders, and tells both sides to shut down
+void SharedMemoryChannel::close()
+{
+  mClosed->store(true, std::memory_order_release);
+}
+
+//==============================================================================
+/// This returns true after close() has been called on either side
+bool SharedMemoryChannel::isClosed() const
+{
+  return mClosed->load(std::memory_order_acquire);
+}
+
+//==============================================================================
+bool SharedMemoryChannel::send(
+    Ring* ring,
+    const std::atomic<bool>* closed,
+    int type,
+    const void* data,
+    std::size_t size)
+{
+  if (closed->load(std::memory_order_acquire))
+  {
+    return false;
+  }
+  std::uint64_t frameBytes = FRAME_HEADER_BYTES + roundUp(size, 8);
+  if (frameBytes > ring->capacity)
+  {
+    std::cout << "SharedMemoryChannel can't send a " << size
+              << " byte message through a " << ring->capacity
+              << " byte ring" << std::endl;
+    return false;
+  }
+
+  std::uint64_t head = ring->head.load(std::memory_order_relaxed);
+  while (head + frameBytes - ring->tail.load(std::memory_order_acquire)
+         > ring->capacity)
+  {
+    if (closed->load(std::memory_order_acquire))
+    {
+      return false;
+    }
+    std::this_thread::yield();
+  }
+
+  std::uint32_t header[2]
+      = {static_cast<std::uint32_t>(size), static_cast<std::uint32_t>(type)};
+  copyIntoRing(ring->data(), ring->capacity, head, header, FRAME_HEADER_BYTES);
+  copyIntoRing(
+      ring->data(), ring->capacity, head + FRAME_HEADER_BYTES, data, size);
+  ring->head.store(head + frameBytes, std::memory_order_release);
+  return true;
+}
+
+//==============================================================================
+bool SharedMemoryChannel::receive(
+    Ring* ring, int& type, std::vector<char>& data)
+{
+  // Let the sender reuse the space from the last message we received
+  if (ring->tail.load(std::memory_order_relaxed) != ring->readEnd)
+  {
+    ring->tail.store(ring->readEnd, std::memory_order_release);
+  }
+
+  std::uint64_t position = ring->readEnd;
+  if (ring->head.load(std::memory_order_acquire) == position)
+  {
+    return false;
+  }
+
+  std::uint32_t header[2];
+  copyOutOfRing(
+      ring->data(), ring->capacity, position, header, FRAME_HEADER_BYTES);
+  type = header[1];
+  data.resize(header[0]);
+  copyOutOfRing(
+      ring->data(),
+      ring->capacity,
+      position + FRAME_HEADER_BYTES,
+      data.data(),
+      header[0]);
+  ring->readEnd = position + FRAME_HEADER_BYTES + roundUp(header[0], 8);
+  return true;
+}
+
+//==============================================================================
+/// This packs a timestamp and some vectors into `out`, which is how
+/// MPC_RECORD_GROUND_TRUTH_STATE and MPC_OBSERVE_FORCE messages are laid out.
+/// This reuses the memory in `out`, so it doesn't allocate on the hot path.
+void packTimedVectors(
+    long time,
+    std::initializer_list<const Eigen::VectorXs*> vectors,
+    /* OUT */ std::vector<char>& out)
+{
+  // The layout is [time][number of vectors][each size][each vector's values]
+  std::int64_t header[2] = {time, static_cast<std::int64_t>(vectors.size())};
+  std::size_t bytes = sizeof(header) + vectors.size() * sizeof(std::int64_t);
+  for (const Eigen::VectorXs* vector : vectors)
+  {
+    bytes += vector->size() * sizeof(s_t);
+  }
+  out.resize(bytes);
+
+  char* cursor = out.data();
+  std::memcpy(cursor, header, sizeof(header));
+  cursor += sizeof(header);
+  for (const Eigen::VectorXs* vector : vectors)
+  {
+    std::int64_t size = vector->size();
+    std::memcpy(cursor, &size, sizeof(size));
+    cursor += sizeof(size);
+  }
+  for (const Eigen::VectorXs* vector : vectors)
+  {
+    std::memcpy(cursor, vector->data(), vector->size() * sizeof(s_t));
+    cursor += vector->size() * sizeof(s_t);
+  }
+}
+
+//==============================================================================
+/// This reads a message written by packTimedVectors(), and returns the time
+long unpackTimedVectors(
+    const std::vector<char>& in, /* OUT */ std::vector<Eigen::VectorXs>& vectors)
+{
+  std::int64_t header[2];
+  const char* cursor = in.data();
+  std::memcpy(header, cursor, sizeof(header));
+  cursor += sizeof(header);
+  vectors.resize(header[1]);
+  for (Eigen::VectorXs& vector : vectors)
+  {
+    std::int64_t size;
+    std::memcpy(&size, cursor, sizeof(size));
+    cursor += sizeof(size);
+    vector.resize(size);
+  }
+  for (Eigen::VectorXs& vector : vectors)
+  {
+    std::memcpy(vector.data(), cursor, vector.size() * sizeof(s_t));
+    cursor += vector.size() * sizeof(s_t);
+  }
+  return header[0];
+}
+
+//==============================================================================
+/// This packs a replanned trajectory into `out`, for MPC_PLAN_UPDATE. Plans
+/// are much larger and much rarer than observations, so the rollout itself is
+/// stored as a serialized protobuf.
+void packPlanUpdate(
+    long startTime,
+    const trajectory::TrajectoryRollout* rollout,
+    long replanDurationMillis,
+    /* OUT */ std::vector<char>& out)
+{
+  proto::TrajectoryRollout proto;
+  rollout->serialize(proto);
+  std::int64_t header[2] = {startTime, replanDurationMillis};
+  out.resize(sizeof(header) + proto.ByteSizeLong());
+  std::memcpy(out.data(), header, sizeof(header));
+  proto.SerializeToArray(
+      out.data() + sizeof(header), out.size() - sizeof(header));
+}
+
+//==============================================================================
+/// This reads a message written by packPlanUpdate()
+trajectory::TrajectoryRolloutReal unpackPlanUpdate(
+    const std::vector<char>& in,
+    /* OUT */ long& startTime,
+    /* OUT */ long& replanDurationMillis)
+{
+  std::int64_t header[2];
+  std::memcpy(header, in.data(), sizeof(header));
+  startTime = header[0];
+  replanDurationMillis = header[1];
+  proto::TrajectoryRollout proto;
+  proto.ParseFromArray(in.data() + sizeof(header), in.size() - sizeof(header));
+  return trajectory::TrajectoryRollout::deserialize(proto);
+}
+
+} // namespace realtime
+} // namespace dart
@@ -0,0 +1,142 @@
+#ifndef DART_REALTIME_SHARED_MEMORY_CHANNEL
+#define DART_REALTIME_SHARED_MEMORY_CHANNEL
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "dart/math/MathTypes.hpp"
+#include "dart/trajectory/TrajectoryRollout.hpp"
+
+namespace dart {
+namespace realtime {
+
+enum SharedMemoryMessageType
+{
+  // Client -> planner
+  MPC_START,
+  MPC_STOP,
+  MPC_RECORD_GROUND_TRUTH_STATE,
+  MPC_OBSERVE_FORCE,
+  // Planner -> client
+  MPC_PLAN_UPDATE
+};
+
+/// This is a same-host replacement for the gRPC connection between MPCRemote
+/// and MPCLocal. It's a pair of single-producer single-consumer ring buffers
+/// of variable-length messages, one for each direction, in one block of
+/// anonymous shared memory. The channel must be created before fork(), and
+/// then the parent and child each see the same rings.
+///
+/// Sending never allocates. If a ring is full, the sender spins until the
+/// receiver makes room, or until the channel is closed.
+class SharedMemoryChannel
+{
+public:
+  SharedMemoryChannel(
+      std::size_t toPlannerCapacityBytes = 1 << 20,
+      std::size_t toClientCapacityBytes = 1 << 24);
+
+  ~SharedMemoryChannel();
+
+  SharedMemoryChannel(const SharedMemoryChannel&) = delete;
+  SharedMemoryChannel& operator=(const SharedMemoryChannel&) = delete;
+
+  /// This sends a message from the client to the planner. This returns false
+  /// if the message can never fit in the ring, or if the channel is closed.
+  bool sendToPlanner(int type, const void* data, std::size_t size);
+
+  /// This receives the oldest message sent to the planner, if there is one,
+  /// without blocking. The message's space isn't released to the sender until
+  /// the next call, so isPlannerCaughtUp() only turns true once the planner
+  /// has come back for more.
+  bool receiveOnPlanner(
+      /* OUT */ int& type, /* OUT */ std::vector<char>& data);
+
+  /// This sends a message from the planner to the client. This returns false
+  /// if the message can never fit in the ring, or if the channel is closed.
+  bool sendToClient(int type, const void* data, std::size_t size);
+
+  /// This receives the oldest message sent to the client, if there is one,
+  /// without blocking.
+  bool receiveOnClient(/* OUT */ int& type, /* OUT */ std::vector<char>& data);
+
+  /// This returns true once the planner has finished with every message sent
+  /// to it so far, which is the next call to receiveOnPlanner() after the
+  /// last message was received.
+  bool isPlannerCaughtUp() const;
+
+  /// This wakes up any blocked senders, and tells both sides to shut down
+  void close();
+
+  /// This returns true after close() has been called on either side
+  bool isClosed() const;
+
+protected:
+  struct Ring
+  {
+    // The writer and reader positions are in bytes since the ring was
+    // created, so (head - tail) is the number of bytes in use. They're on
+    // separate cache lines so the two sides don't fight over them.
+    alignas(64) std::atomic<std::uint64_t> head;
+    alignas(64) std::atomic<std::uint64_t> tail;
+    // This is only touched by the reader. It's the end of the message the
+    // reader is holding, which becomes the tail on the next receive().
+    alignas(64) std::uint64_t readEnd;
+    std::uint64_t capacity;
+
+    /// The ring's bytes immediately follow this header
+    char* data();
+  };
+
+  static bool send(
+      Ring* ring,
+      const std::atomic<bool>* closed,
+      int type,
+      const void* data,
+      std::size_t size);
+
+  static bool receive(Ring* ring, int& type, std::vector<char>& data);
+
+  std::size_t mMappedBytes;
+  void* mMemory;
+  std::atomic<bool>* mClosed;
+  Ring* mToPlanner;
+  Ring* mToClient;
+};
+
+/// This packs a timestamp and some vectors into `out`, which is how
+/// MPC_RECORD_GROUND_TRUTH_STATE and MPC_OBSERVE_FORCE messages are laid out.
+/// This reuses the memory in `out`, so it doesn't allocate on the hot path.
+void packTimedVectors(
+    long time,
+    std::initializer_list<const Eigen::VectorXs*> vectors,
+    /* OUT */ std::vector<char>& out);
+
+/// This reads a message written by packTimedVectors(), and returns the time
+long unpackTimedVectors(
+    const std::vector<char>& in, /* OUT */ std::vector<Eigen::VectorXs>& vectors);
+
+/// This packs a replanned trajectory into `out`, for MPC_PLAN_UPDATE. Plans
+/// are much larger and much rarer than observations, so the rollout itself is
+/// stored as a serialized protobuf.
+void packPlanUpdate(
+    long startTime,
+    const trajectory::TrajectoryRollout* rollout,
+    long replanDurationMillis,
+    /* OUT */ std::vector<char>& out);
+
+/// This reads a message written by packPlanUpdate()
+trajectory::TrajectoryRolloutReal unpackPlanUpdate(
+    const std::vector<char>& in,
+    /* OUT */ long& startTime,
+    /* OUT */ long& replanDurationMillis);
+
+} // namespace realtime
+} // namespace dart
+
+#endif
@@ -1,127 +1,258 @@
 #include "dart/realtime/VectorLog.hpp"
 
+#include <algorithm>
+#include <climits>
+
 namespace dart {
 namespace realtime {
 
-VectorObservation::VectorObservation(long time, Eigen::VectorXs value)
-  : time(time), value(value)
+VectorLog::VectorLog(int dim, int capacity)
+  : mDim(dim),
+    mCapacity(capacity),
+    mValues(Eigen::MatrixXs::Zero(dim, capacity)),
+    mTimes(capacity),
+    mWriting(-1L),
+    mEnd(0L),
+    mBegin(0L),
+    mLastTime(LONG_MIN)
 {
+  assert(capacity > 1);
 }
 
-VectorLog::VectorLog(int dim) : mDim(dim), mStartTime(0L)
+/// This copies the log. It's not safe to record() into `other` while this
+/// runs.
+VectorLog::VectorLog(const VectorLog& other)
+  : mDim(other.mDim),
+    mCapacity(other.mCapacity),
+    mValues(other.mValues),
+    mTimes(other.mCapacity),
+    mWriting(other.mWriting.load()),
+    mEnd(other.mEnd.load()),
+    mBegin(other.mBegin.load()),
+    mLastTime(other.mLastTime)
 {
+  for (int i = 0; i < mCapacity; i++)
+  {
+    mTimes[i].store(other.mTimes[i].load());
+  }
 }
 
-void VectorLog::record(long time, Eigen::VectorXs val)
+/// This appends a value. Values are expected in time order, so any value
+/// older than the latest one recorded is dropped. This doesn't allocate.
+void VectorLog::record(long time, const Eigen::VectorXs& val)
 {
-  if (mObservations.size() == 0)
-    mStartTime = time;
   assert(val.size() == mDim);
-  mObservations.emplace_back(time, val);
+  if (time < mLastTime)
+    return;
+  mLastTime = time;
+
+  // This is a seqlock: announce which slot we're about to overwrite before
+  // touching it, so readers of the old contents know to retry
+  long index = mEnd.load(std::memory_order_relaxed);
+  int slot = index % mCapacity;
+  mWriting.store(index, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  mTimes[slot].store(time, std::memory_order_relaxed);
+  mValues.col(slot) = val;
+  mEnd.store(index + 1, std::memory_order_release);
 }
 
 // start = current - mInferenceHorizon
 Eigen::MatrixXs VectorLog::getValues(long start, int steps, long millisPerStep)
 {
   Eigen::MatrixXs observations = Eigen::MatrixXs::Zero(mDim, steps);
-
   Eigen::VectorXs cursorValue = Eigen::VectorXs::Zero(mDim);
-  int cursorStep = 0;
-  for (const VectorObservation& obs : mObservations)
+
+  while (true)
   {
-    int step = static_cast<int>(
-        ceil(static_cast<s_t>(obs.time - start) / millisPerStep));
-    if (step > steps - 1)
-      break;
-    if (step >= cursorStep)
+    long begin, end;
+    getReadableRange(begin, end);
+    observations.setZero();
+    cursorValue.setZero();
+    int cursorStep = 0;
+
+    // Everything recorded at or before (start - millisPerStep) lands on a
+    // negative step, so only the last of those can affect the output
+    long first = std::max(
+        begin, findLastBefore(start - millisPerStep, true, begin, end));
+    for (long i = first; i < end; i++)
     {
-      // Sweep the last cursor value forward to the current step
-      while (cursorStep < step)
+      int step = static_cast<int>(
+          ceil(static_cast<s_t>(getTime(i) - start) / millisPerStep));
+      if (step > steps - 1)
+        break;
+      if (step >= cursorStep)
+      {
+        // Sweep the last cursor value forward to the current step
+        while (cursorStep < step)
+        {
+          observations.col(cursorStep) = cursorValue;
+          cursorStep++;
+        }
+        // Set the current value to the current state
+        cursorValue = mValues.col(i % mCapacity);
+        observations.col(step) = cursorValue;
+        assert(cursorStep == step);
+      }
+      else
       {
-        observations.col(cursorStep) = cursorValue;
-        cursorStep++;
+        cursorValue = mValues.col(i % mCapacity);
       }
-      // Set the current value to the current state
-      cursorValue = obs.value;
-      observations.col(step) = cursorValue;
-      assert(cursorStep == step);
     }
-    else
+    // Sweep the last cursor value forward to the end of the block
+    // Which may cause even the action has been taken nothing will affect
+    while (cursorStep < steps)
     {
-      cursorValue = obs.value;
+      observations.col(cursorStep) = cursorValue;
+      cursorStep++;
     }
-  }
-  // Sweep the last cursor value forward to the end of the block
-  // Which may cause even the action has been taken nothing will affect
-  while (cursorStep < steps)
-  {
-    observations.col(cursorStep) = cursorValue;
-    cursorStep++;
-  }
 
-  return observations;
+    if (!wasOverwritten(begin))
+      return observations;
+  }
 }
+
 // Assmue there are enough data prior to a particular time stamp
 Eigen::MatrixXs VectorLog::getRecentValuesBefore(long time, int steps)
 {
-  Eigen::MatrixXs observations = Eigen::MatrixXs::Zero(mDim,steps);
-  int cnt = 0;
-  for(int i=mObservations.size()-1;i>=0;i--)
+  Eigen::MatrixXs observations = Eigen::MatrixXs::Zero(mDim, steps);
+  while (true)
   {
-    if(mObservations[i].time<time)
+    long begin, end;
+    getReadableRange(begin, end);
+    observations.setZero();
+    int cnt = 0;
+    for (long i = findLastBefore(time, false, begin, end);
+         i >= begin && cnt < steps;
+         i--)
     {
       cnt++;
-      observations.col(steps-cnt) = mObservations[i].value;
-      if(cnt >= steps)
-        break;
+      observations.col(steps - cnt) = mValues.col(i % mCapacity);
     }
+    if (!wasOverwritten(begin))
+      return observations;
   }
-  return observations;
 }
 
-int VectorLog::availableStepsBefore(long time)
+/// This finds the most recent value recorded at or before `time`, and
+/// copies it and its timestamp out. This returns false if there isn't one.
+bool VectorLog::getLastValueAtOrBefore(
+    long time, /* OUT */ long& recordedTime, /* OUT */ Eigen::VectorXs& value)
 {
-  if(time - mStartTime<0)
+  while (true)
   {
-    return -1;
+    long begin, end;
+    getReadableRange(begin, end);
+    long index = findLastBefore(time, true, begin, end);
+    if (index < begin)
+      return false;
+    recordedTime = getTime(index);
+    value = mValues.col(index % mCapacity);
+    if (!wasOverwritten(begin))
+      return true;
   }
-  for(int i= mObservations.size();i>0;i--)
+}
+
+/// This copies out the oldest value that hasn't been overwritten or
+/// discarded, and its timestamp. This returns false if the log is empty.
+bool VectorLog::getFirstValue(
+    /* OUT */ long& recordedTime, /* OUT */ Eigen::VectorXs& value)
+{
+  while (true)
   {
-    if(mObservations[i-1].time<time)
-    {
-      return i;
-    }
+    long begin, end;
+    getReadableRange(begin, end);
+    if (begin == end)
+      return false;
+    recordedTime = getTime(begin);
+    value = mValues.col(begin % mCapacity);
+    if (!wasOverwritten(begin))
+      return true;
   }
-  // Should not reach here just to make compiler happy
-  return 0;
+}
+
+int VectorLog::availableStepsBefore(long time)
+{
+  long begin, end;
+  getReadableRange(begin, end);
+  if (begin == end)
+    return 0;
+  if (time < getTime(begin))
+    return -1;
+  return findLastBefore(time, false, begin, end) - begin + 1;
 }
 
 long VectorLog::availableHistoryBefore(long time)
 {
-  return time - mStartTime;
+  long begin, end;
+  getReadableRange(begin, end);
+  if (begin == end)
+    return time;
+  return time - getTime(begin);
 }
 
+/// This drops every record up to and including the last one before `time`
 void VectorLog::discardBefore(long time)
 {
-  int discardBeforeIndex = -1;
-  for (int i = mObservations.size() - 1; i >= 0; i--)
-  {
-    if (mObservations[i].time < time)
-    {
-      discardBeforeIndex = i;
-      break;
-    }
-  }
-  if (discardBeforeIndex == -1)
+  long begin, end;
+  getReadableRange(begin, end);
+  long last = findLastBefore(time, false, begin, end);
+  if (last < begin)
     return;
+  mBegin.store(last + 1, std::memory_order_release);
+}
 
-  std::vector<VectorObservation> newObservations;
-  for (int i = discardBeforeIndex + 1; i < mObservations.size(); i++)
+int VectorLog::getCapacity() const
+{
+  return mCapacity;
+}
+
+/// This returns the range of record indices [begin, end) that are currently
+/// safe to read. Indices count records since the log was created, and index
+/// i lives in slot (i % capacity).
+void VectorLog::getReadableRange(
+    /* OUT */ long& begin, /* OUT */ long& end) const
+{
+  end = mEnd.load(std::memory_order_acquire);
+  // We leave the oldest slot alone, since that's the next one the writer
+  // will overwrite
+  begin = std::max(mBegin.load(std::memory_order_acquire), end - mCapacity + 1);
+  begin = std::min(begin, end);
+}
+
+/// This binary searches [begin, end) for the last record before `time` (or
+/// at `time`, if `inclusive`), and returns its index, or (begin - 1) if
+/// there's no such record.
+long VectorLog::findLastBefore(
+    long time, bool inclusive, long begin, long end) const
+{
+  // Find the first record that's too late, and step back one
+  long lo = begin;
+  long hi = end;
+  while (lo < hi)
   {
-    newObservations.push_back(mObservations[i]);
+    long mid = lo + (hi - lo) / 2;
+    long midTime = getTime(mid);
+    if (midTime < time || (inclusive && midTime == time))
+      lo = mid + 1;
+    else
+      hi = mid;
   }
-  mObservations = newObservations;
+  return lo - 1;
+}
+
+/// This returns true if record `index` may have been overwritten since we
+/// called getReadableRange(), in which case the reader should start over.
+bool VectorLog::wasOverwritten(long index) const
+{
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return mWriting.load(std::memory_order_relaxed) >= index + mCapacity;
+}
+
+long VectorLog::getTime(long index) const
+{
+  return mTimes[index % mCapacity].load(std::memory_order_relaxed);
 }
 
 } // namespace realtime
-} // namespace dart
\ No newline at end of file
+} // namespace dart
@@ -1,6 +1,7 @@
 #ifndef DART_REALTIME_VECTOR_LOG
 #define DART_REALTIME_VECTOR_LOG
 
+#include <atomic>
 #include <vector>
 
 #include <Eigen/Dense>
@@ -10,38 +11,83 @@
 namespace dart {
 namespace realtime {
 
-struct VectorObservation
-{
-  long time;
-  Eigen::VectorXs value;
-
-  VectorObservation(long time, Eigen::VectorXs value);
-};
-
+/// This is a fixed-capacity log of timestamped vectors, stored in a circular
+/// buffer that's allocated once up front. Once it's full, each new record
+/// overwrites the oldest one, so a long-running controller uses constant
+/// memory.
+///
+/// One thread may record() while another thread reads, without locks. Reads
+/// copy what they need out of the buffer, and start over if the writer
+/// overwrote those slots in the meantime.
 class VectorLog
 {
 public:
-  VectorLog(int dim);
+  VectorLog(int dim, int capacity = 1000);
+
+  /// This copies the log. It's not safe to record() into `other` while this
+  /// runs.
+  VectorLog(const VectorLog& other);
 
-  void record(long time, Eigen::VectorXs val);
+  /// This appends a value. Values are expected in time order, so any value
+  /// older than the latest one recorded is dropped. This doesn't allocate.
+  void record(long time, const Eigen::VectorXs& val);
 
   Eigen::MatrixXs getValues(long start, int steps, long millisPerStep);
 
   Eigen::MatrixXs getRecentValuesBefore(long time, int steps);
 
+  /// This finds the most recent value recorded at or before `time`, and
+  /// copies it and its timestamp out. This returns false if there isn't one.
+  bool getLastValueAtOrBefore(
+      long time,
+      /* OUT */ long& recordedTime,
+      /* OUT */ Eigen::VectorXs& value);
+
+  /// This copies out the oldest value that hasn't been overwritten or
+  /// discarded, and its timestamp. This returns false if the log is empty.
+  bool getFirstValue(
+      /* OUT */ long& recordedTime, /* OUT */ Eigen::VectorXs& value);
+
   void discardBefore(long time);
 
   long availableHistoryBefore(long time);
 
   int availableStepsBefore(long time);
 
+  int getCapacity() const;
+
 protected:
+  /// This returns the range of record indices [begin, end) that are
+  /// currently safe to read. Indices count records since the log was
+  /// created, and index i lives in slot (i % capacity).
+  void getReadableRange(/* OUT */ long& begin, /* OUT */ long& end) const;
+
+  /// This binary searches [begin, end) for the last record before `time` (or
+  /// at `time`, if `inclusive`), and returns its index, or (begin - 1) if
+  /// there's no such record.
+  long findLastBefore(long time, bool inclusive, long begin, long end) const;
+
+  /// This returns true if record `index` may have been overwritten since we
+  /// called getReadableRange(), in which case the reader should start over.
+  bool wasOverwritten(long index) const;
+
+  long getTime(long index) const;
+
   int mDim;
-  long mStartTime;
-  std::vector<VectorObservation> mObservations;
+  int mCapacity;
+  Eigen::MatrixXs mValues;
+  std::vector<std::atomic<long>> mTimes;
+  /// This is the index the writer is about to overwrite, or -1
+  std::atomic<long> mWriting;
+  /// This is one past the newest readable record
+  std::atomic<long> mEnd;
+  /// This is the first record that hasn't been discarded
+  std::atomic<long> mBegin;
+  /// This is only touched by the writer
+  long mLastTime;
 };
 
 } // namespace realtime
 } // namespace dart
 
-#endif
\ No newline at end of file
+#endif
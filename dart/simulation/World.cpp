@@ -85,6 +85,7 @@ World::World(const std::string& _name)
     mFallbackConstraintForceMixingConstant(1e-4),
     mContactClippingDepth(0.03),
     mPenetrationCorrectionEnabled(false),
+    mContactGradientThreads(1),
     mWrtMass(std::make_shared<neural::WithRespectToMass>()),
     mUseFDOverride(false),
     mSlowDebugResultsAgainstFD(false),
@@ -123,6 +124,7 @@ WorldPtr World::clone() const
   worldClone->setPenetrationCorrectionEnabled(mPenetrationCorrectionEnabled);
   worldClone->setParallelVelocityAndPositionUpdates(
       mParallelVelocityAndPositionUpdates);
+  worldClone->setContactGradientThreads(mContactGradientThreads);
 
   // Copy the WithRespectToMass pointer, so we have the same object
   worldClone->mWrtMass = mWrtMass;
@@ -131,16 +133,11 @@ WorldPtr World::clone() const
   worldClone->getConstraintSolver()->setCollisionDetector(
       cd->cloneWithoutCollisionObjects());
 
-  // Clone and add each Skeleton
+  // Clone and add each Skeleton. BodyNode::clone() already copies each body's
+  // inertia and beta, so there's nothing to copy over afterwards.
   for (std::size_t i = 0; i < mSkeletons.size(); ++i)
   {
-
-    dart::dynamics::SkeletonPtr cloned_skel = mSkeletons[i]->cloneSkeleton();
-    cloned_skel->setLinkMasses(mSkeletons[i]->getLinkMasses());
-    cloned_skel->setLinkCOMs(mSkeletons[i]->getLinkCOMs());
-    cloned_skel->setLinkMOIs(mSkeletons[i]->getLinkMOIs());
-    cloned_skel->setLinkBetas(mSkeletons[i]->getLinkBetas());
-    worldClone->addSkeleton(cloned_skel);
+    worldClone->addSkeleton(mSkeletons[i]->cloneSkeleton());
   }
 
   // Clone and add each SimpleFrame
@@ -368,6 +365,18 @@ bool World::getPenetrationCorrectionEnabled()
   return mPenetrationCorrectionEnabled;
 }
 
+//==============================================================================
+void World::setContactGradientThreads(int numThreads)
+{
+  mContactGradientThreads = std::max(numThreads, 1);
+}
+
+//==============================================================================
+int World::getContactGradientThreads()
+{
+  return mContactGradientThreads;
+}
+
 //==============================================================================
 void World::setFallbackConstraintForceMixingConstant(s_t constant)
 {
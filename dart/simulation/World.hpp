@@ -647,6 +647,14 @@ public:
 
   bool getPenetrationCorrectionEnabled();
 
+  /// This sets how many threads backprop may use to build the per-contact
+  /// constraint force Jacobians. 1 by default, which builds them serially on
+  /// the calling thread. This is worth raising for worlds with many contacts,
+  /// like meshed feet on the ground.
+  void setContactGradientThreads(int numThreads);
+
+  int getContactGradientThreads();
+
   /// We add this value to the diagonal entries of A, ONLY IF our initial LCP
   /// solution fails, to help prevent A from being low-rank. This both increases
   /// the stability of the forward LCP solution, and it also helps prevent cases
@@ -807,6 +815,9 @@ protected:
   /// True if we want to enable artificial penetration correction forces
   bool mPenetrationCorrectionEnabled;
 
+  /// The number of threads backprop uses to build contact Jacobians
+  int mContactGradientThreads;
+
   /// We add this value to the diagonal entries of A, ONLY IF our initial LCP
   /// solution fails, to help prevent A from being low-rank. This both increases
   /// the stability of the forward LCP solution, and it also helps prevent cases
@@ -0,0 +1,76 @@
+#include "dart/trajectory/AdamOptimizer.hpp"
+
+#include <cmath>
+
+namespace dart {
+namespace trajectory {
+
+//==============================================================================
+AdamOptimizer::AdamOptimizer()
+  : mLearningRate(1e-2),
+    mBeta1(0.9),
+    mBeta2(0.999),
+    mEpsilon(1e-8),
+    mNumSteps(0)
+{
+}
+
+//==============================================================================
+void AdamOptimizer::setLearningRate(s_t learningRate)
+{
+  mLearningRate = learningRate;
+}
+
+//==============================================================================
+void AdamOptimizer::setBeta1(s_t beta1)
+{
+  mBeta1 = beta1;
+}
+
+//==============================================================================
+void AdamOptimizer::setBeta2(s_t beta2)
+{
+  mBeta2 = beta2;
+}
+
+//==============================================================================
+void AdamOptimizer::setEpsilon(s_t epsilon)
+{
+  mEpsilon = epsilon;
+}
+
+//==============================================================================
+void AdamOptimizer::resetHistory(int dim)
+{
+  mFirstMoment = Eigen::VectorXs::Zero(dim);
+  mSecondMoment = Eigen::VectorXs::Zero(dim);
+  mNumSteps = 0;
+}
+
+//==============================================================================
+Eigen::VectorXs AdamOptimizer::computeStep(
+    const Eigen::VectorXs& /* x */, const Eigen::VectorXs& grad)
+{
+  mNumSteps++;
+  mFirstMoment = mBeta1 * mFirstMoment + (1 - mBeta1) * grad;
+  mSecondMoment = mBeta2 * mSecondMoment + (1 - mBeta2) * grad.cwiseAbs2();
+  // Correct for the moments being initialized to zero
+  Eigen::VectorXs firstMomentHat
+      = mFirstMoment / (1 - std::pow(mBeta1, mNumSteps));
+  Eigen::VectorXs secondMomentHat
+      = mSecondMoment / (1 - std::pow(mBeta2, mNumSteps));
+  return -mLearningRate
+         * firstMomentHat.cwiseQuotient(
+             (secondMomentHat.cwiseSqrt().array() + mEpsilon).matrix());
+}
+
+//==============================================================================
+void AdamOptimizer::observeStep(
+    const Eigen::VectorXs& /* dx */, const Eigen::VectorXs& /* dg */)
+{
+  // Adam folds each gradient into its moments when it computes the step, so
+  // there's nothing left to do here
+}
+
+} // namespace trajectory
+} // namespace dart
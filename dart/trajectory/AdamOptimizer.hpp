@@ -0,0 +1,58 @@
+#ifndef DART_TRAJECTORY_ADAM_OPTIMIZER_HPP_
+#define DART_TRAJECTORY_ADAM_OPTIMIZER_HPP_
+
+#include <memory>
+
+#include <Eigen/Dense>
+
+#include "dart/trajectory/LineSearchOptimizer.hpp"
+#include "dart/trajectory/TrajectoryConstants.hpp"
+
+namespace dart {
+namespace trajectory {
+
+/*
+ * This is Adam (Kingma and Ba, 2014), with a line search over multiples of the
+ * Adam step. The moment estimates are reset at the start of every call to
+ * optimize().
+ */
+class AdamOptimizer : public LineSearchOptimizer
+{
+public:
+  AdamOptimizer();
+
+  virtual ~AdamOptimizer() = default;
+
+  void setLearningRate(s_t learningRate);
+
+  void setBeta1(s_t beta1);
+
+  void setBeta2(s_t beta2);
+
+  void setEpsilon(s_t epsilon);
+
+protected:
+  void resetHistory(int dim) override;
+
+  Eigen::VectorXs computeStep(
+      const Eigen::VectorXs& x, const Eigen::VectorXs& grad) override;
+
+  void observeStep(
+      const Eigen::VectorXs& dx, const Eigen::VectorXs& dg) override;
+
+  s_t mLearningRate;
+  s_t mBeta1;
+  s_t mBeta2;
+  s_t mEpsilon;
+
+  /// These are the running estimates of the first and second moments of the
+  /// gradient, and the number of steps they've seen
+  Eigen::VectorXs mFirstMoment;
+  Eigen::VectorXs mSecondMoment;
+  int mNumSteps;
+};
+
+} // namespace trajectory
+} // namespace dart
+
+#endif
@@ -26,6 +26,7 @@ IPOptOptimizer::IPOptOptimizer()
     mTolerance(1e-7),
     mLBFGSHistoryLength(1),
     mCheckDerivatives(false),
+    mGaussNewtonHessian(false),
     mPrintFrequency(1),
     mRecordPerfLog(false),
     mRecoverBest(true),
@@ -56,7 +57,8 @@ std::shared_ptr<Solution> IPOptOptimizer::optimize(
       "mumps"); // ma27, ma55, ma77, ma86, ma97, parsido, wsmp, mumps, custom
 
   app->Options()->SetStringValue(
-      "hessian_approximation", "limited-memory"); // limited-memory, exacty
+      "hessian_approximation",
+      mGaussNewtonHessian ? "exact" : "limited-memory");
 
   /*
   app->Options()->SetStringValue(
@@ -147,6 +149,11 @@ std::shared_ptr<Solution> IPOptOptimizer::optimize(
               << final_obj << '.' << std::endl;
   }
 
+  if (IsValid(app->Statistics()))
+  {
+    record->setIterationCount(app->Statistics()->IterationCount());
+  }
+
   record->setSuccess(status == Ipopt::Solve_Succeeded);
   record->registerForReoptimization(app, problemPtr);
 
@@ -177,6 +184,15 @@ void IPOptOptimizer::setCheckDerivatives(bool checkDerivatives)
   mCheckDerivatives = checkDerivatives;
 }
 
+//==============================================================================
+/// If true, IPOPT uses a Gauss-Newton approximation of the Hessian of the
+/// loss instead of its limited-memory BFGS estimate. Each iteration then
+/// costs a forward sensitivity sweep and an extra gradient evaluation.
+void IPOptOptimizer::setGaussNewtonHessian(bool enabled)
+{
+  mGaussNewtonHessian = enabled;
+}
+
 //==============================================================================
 void IPOptOptimizer::setPrintFrequency(int frequency)
 {
@@ -45,6 +45,11 @@ public:
 
   void setCheckDerivatives(bool checkDerivatives);
 
+  /// If true, IPOPT uses a Gauss-Newton approximation of the Hessian of the
+  /// loss instead of its limited-memory BFGS estimate. Each iteration then
+  /// costs a forward sensitivity sweep and an extra gradient evaluation.
+  void setGaussNewtonHessian(bool enabled);
+
   void setPrintFrequency(int frequency);
 
   void setRecordPerformanceLog(bool recordPerfLog);
@@ -66,6 +71,7 @@ protected:
   s_t mTolerance;
   int mLBFGSHistoryLength;
   bool mCheckDerivatives;
+  bool mGaussNewtonHessian;
   int mPrintFrequency;
   bool mRecordPerfLog;
   bool mRecoverBest;
@@ -80,8 +80,8 @@ bool IPOptShotWrapper::get_nlp_info(
   // Set the number of entries in the constraint Jacobian
   nnz_jac_g = mWrapped->getNumberNonZeroJacobian(mWrapped->mWorld);
 
-  // Set the number of entries in the Hessian
-  nnz_h_lag = n * n;
+  // Set the number of entries in the lower triangle of the Hessian
+  nnz_h_lag = mWrapped->getNumberNonZeroHessian(mWrapped->mWorld);
 
   // use the C style indexing (0-based)
   index_style = Ipopt::TNLP::C_STYLE;
@@ -568,37 +568,74 @@ bool IPOptShotWrapper::eval_jac_g(
 }
 
 //==============================================================================
+/// This is only called when IPOPT's "hessian_approximation" is "exact". We
+/// return the Gauss-Newton approximation of the Hessian of the loss, and
+/// drop the second derivatives of the constraints, so the multipliers in
+/// `lambda` aren't used.
 bool IPOptShotWrapper::eval_h(
-    Ipopt::Index /* _n */,
-    const Ipopt::Number* /* _x */,
-    bool /* _new_x */,
-    Ipopt::Number /* _obj_factor */,
+    Ipopt::Index _n,
+    const Ipopt::Number* _x,
+    bool _new_x,
+    Ipopt::Number _obj_factor,
     Ipopt::Index /* _m */,
     const Ipopt::Number* /* _lambda */,
     bool /* _new_lambda */,
-    Ipopt::Index /* _nele_hess */,
-    Ipopt::Index* /* _iRow */,
-    Ipopt::Index* /* _jCol */,
-    Ipopt::Number* /* _values */)
+    Ipopt::Index _nele_hess,
+    Ipopt::Index* _iRow,
+    Ipopt::Index* _jCol,
+    Ipopt::Number* _values)
 {
-  // TODO(JS): Not implemented yet.
-  std::cout << "[IPOptShotWrapper::eval_h] Not implemented yet.\n";
+  PerformanceLog* perflog = nullptr;
+#ifdef LOG_PERFORMANCE_IPOPT
+  if (mRecord->getPerfLog() != nullptr)
+  {
+    perflog = mRecord->getPerfLog()->startRun("IPOptShotWrapper.eval_h");
+  }
+#endif
 
-  /*
-  return TNLP::eval_h(
-      _n,
-      _x,
-      _new_x,
-      _obj_factor,
-      _m,
-      _lambda,
-      _new_lambda,
-      _nele_hess,
-      _iRow,
-      _jCol,
-      _values);
-      */
-  return false;
+  if (nullptr == _values)
+  {
+    // return the structure of the lower triangle of the Hessian
+    assert(_n == mWrapped->getFlatProblemDim(mWrapped->mWorld));
+    assert(
+        _nele_hess == mWrapped->getNumberNonZeroHessian(mWrapped->mWorld));
+
+    Eigen::Map<Eigen::VectorXi> rows(_iRow, _nele_hess);
+    Eigen::Map<Eigen::VectorXi> cols(_jCol, _nele_hess);
+
+    mWrapped->getHessianSparsityStructure(
+        mWrapped->mWorld, rows, cols, perflog);
+  }
+  else
+  {
+    if (_new_x && _n > 0)
+    {
+      Eigen::Map<const Eigen::VectorXd> flat(_x, _n);
+#ifdef DART_USE_ARBITRARY_PRECISION
+      Eigen::VectorXs flat_s = flat.cast<s_t>();
+      mWrapped->unflatten(mWrapped->mWorld, flat_s, perflog);
+#else
+      mWrapped->unflatten(mWrapped->mWorld, flat, perflog);
+#endif
+    }
+    Eigen::Map<Eigen::VectorXd> sparse(_values, _nele_hess);
+#ifdef DART_USE_ARBITRARY_PRECISION
+    Eigen::VectorXs sparse_s(_nele_hess);
+    mWrapped->getSparseGaussNewtonHessian(mWrapped->mWorld, sparse_s, perflog);
+    sparse = sparse_s.cast<double>();
+#else
+    mWrapped->getSparseGaussNewtonHessian(mWrapped->mWorld, sparse, perflog);
+#endif
+    sparse *= _obj_factor;
+  }
+
+#ifdef LOG_PERFORMANCE_IPOPT
+  if (perflog != nullptr)
+  {
+    perflog->end();
+  }
+#endif
+  return true;
 }
 
 //==============================================================================
@@ -773,6 +810,39 @@ void IPOptShotWrapper::prep_for_reoptimize()
   mBestIter = -1;
 }
 
+/// This returns true if we've saved the dual variables from a previous call
+/// to finalize_solution(), which we can use to warm-start a reoptimization.
+bool IPOptShotWrapper::has_saved_multipliers()
+{
+  return mSaved_zU.size() == mWrapped->getFlatProblemDim(mWrapped->mWorld)
+         && mSaved_zL.size() == mSaved_zU.size()
+         && mSaved_lambda.size() == mWrapped->getConstraintDim();
+}
+
+/// This moves the saved bound multipliers through the index `mapping`
+/// returned by Problem::advanceSteps(), so that they line up with the
+/// time-shifted problem. Indices that map to -1 get a multiplier of 0.
+void IPOptShotWrapper::remap_saved_multipliers(const Eigen::VectorXi& mapping)
+{
+  if (!has_saved_multipliers() || mapping.size() != mSaved_zU.size())
+    return;
+
+  Eigen::VectorXd zU = Eigen::VectorXd::Zero(mapping.size());
+  Eigen::VectorXd zL = Eigen::VectorXd::Zero(mapping.size());
+  for (int i = 0; i < mapping.size(); i++)
+  {
+    if (mapping(i) >= 0 && mapping(i) < mSaved_zU.size())
+    {
+      zU(i) = mSaved_zU(mapping(i));
+      zL(i) = mSaved_zL(mapping(i));
+    }
+  }
+  mSaved_zU = zU;
+  mSaved_zL = zL;
+  // The knot point constraints don't move when we advance the problem, so the
+  // constraint multipliers can be reused as-is.
+}
+
 /// This records a single call of eval_f(). If this returns false, then we
 /// need to terminate this call to eval_f().
 bool IPOptShotWrapper::can_eval_f(bool new_x)
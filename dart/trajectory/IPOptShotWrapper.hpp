@@ -111,6 +111,11 @@ public:
   ///           nullptr)
   ///        2) The values of the hessian of the lagrangian (if "values" is not
   ///           nullptr)
+  ///
+  /// This is only called when IPOPT's "hessian_approximation" is "exact". We
+  /// return the Gauss-Newton approximation of the Hessian of the loss, and
+  /// drop the second derivatives of the constraints, so the multipliers in
+  /// `lambda` aren't used.
   bool eval_h(
       Ipopt::Index _n,
       const Ipopt::Number* _x,
@@ -157,6 +162,15 @@ public:
   /// This gets called when we're about to repoptimize, to let us reset values.
   void prep_for_reoptimize();
 
+  /// This returns true if we've saved the dual variables from a previous call
+  /// to finalize_solution(), which we can use to warm-start a reoptimization.
+  bool has_saved_multipliers();
+
+  /// This moves the saved bound multipliers through the index `mapping`
+  /// returned by Problem::advanceSteps(), so that they line up with the
+  /// time-shifted problem. Indices that map to -1 get a multiplier of 0.
+  void remap_saved_multipliers(const Eigen::VectorXi& mapping);
+
   /// This records a single call of eval_f(). If this returns false, then we
   /// need to terminate this call to eval_f().
   bool can_eval_f(bool new_x);
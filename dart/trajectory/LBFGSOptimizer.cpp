@@ -0,0 +1,89 @@
+#include "dart/trajectory/LBFGSOptimizer.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace dart {
+namespace trajectory {
+
+//==============================================================================
+LBFGSOptimizer::LBFGSOptimizer() : mLBFGSHistoryLength(10)
+{
+}
+
+//==============================================================================
+/// This is the number of (dx, dg) pairs we use to approximate the Hessian
+void LBFGSOptimizer::setLBFGSHistoryLength(int historyLen)
+{
+  mLBFGSHistoryLength = historyLen;
+}
+
+//==============================================================================
+void LBFGSOptimizer::resetHistory(int /* dim */)
+{
+  mDxHistory.clear();
+  mDgHistory.clear();
+}
+
+//==============================================================================
+Eigen::VectorXs LBFGSOptimizer::computeStep(
+    const Eigen::VectorXs& /* x */, const Eigen::VectorXs& grad)
+{
+  if (mDxHistory.empty())
+  {
+    // Without any curvature information, take a gradient step that's no
+    // longer than 1
+    return -grad / std::max((s_t)1.0, grad.norm());
+  }
+
+  // This is the standard two-loop recursion, which computes -H * grad for the
+  // inverse Hessian approximation H implied by our history
+  int historySize = mDxHistory.size();
+  std::vector<s_t> alphas(historySize);
+  std::vector<s_t> rhos(historySize);
+  Eigen::VectorXs q = grad;
+  for (int i = historySize - 1; i >= 0; i--)
+  {
+    rhos[i] = 1.0 / mDgHistory[i].dot(mDxHistory[i]);
+    alphas[i] = rhos[i] * mDxHistory[i].dot(q);
+    q -= alphas[i] * mDgHistory[i];
+  }
+  const Eigen::VectorXs& lastDx = mDxHistory.back();
+  const Eigen::VectorXs& lastDg = mDgHistory.back();
+  Eigen::VectorXs r = (lastDx.dot(lastDg) / lastDg.squaredNorm()) * q;
+  for (int i = 0; i < historySize; i++)
+  {
+    s_t beta = rhos[i] * mDgHistory[i].dot(r);
+    r += (alphas[i] - beta) * mDxHistory[i];
+  }
+
+  if (r.dot(grad) <= 0)
+  {
+    // This isn't a descent direction, so our history is no good
+    resetHistory(grad.size());
+    return -grad / std::max((s_t)1.0, grad.norm());
+  }
+  return -r;
+}
+
+//==============================================================================
+void LBFGSOptimizer::observeStep(
+    const Eigen::VectorXs& dx, const Eigen::VectorXs& dg)
+{
+  // Skip pairs with too little curvature, which would make the inverse Hessian
+  // approximation lose positive definiteness
+  if (dx.dot(dg) <= 1e-10 * dx.norm() * dg.norm())
+  {
+    return;
+  }
+  mDxHistory.push_back(dx);
+  mDgHistory.push_back(dg);
+  while (mDxHistory.size() > mLBFGSHistoryLength)
+  {
+    mDxHistory.pop_front();
+    mDgHistory.pop_front();
+  }
+}
+
+} // namespace trajectory
+} // namespace dart
@@ -0,0 +1,49 @@
+#ifndef DART_TRAJECTORY_LBFGS_OPTIMIZER_HPP_
+#define DART_TRAJECTORY_LBFGS_OPTIMIZER_HPP_
+
+#include <deque>
+#include <memory>
+
+#include <Eigen/Dense>
+
+#include "dart/trajectory/LineSearchOptimizer.hpp"
+#include "dart/trajectory/TrajectoryConstants.hpp"
+
+namespace dart {
+namespace trajectory {
+
+/*
+ * This is L-BFGS, with a line search over multiples of the quasi-Newton step.
+ * The curvature history is reset at the start of every call to optimize(), and
+ * whenever a step built from it fails to make progress.
+ */
+class LBFGSOptimizer : public LineSearchOptimizer
+{
+public:
+  LBFGSOptimizer();
+
+  virtual ~LBFGSOptimizer() = default;
+
+  /// This is the number of (dx, dg) pairs we use to approximate the Hessian
+  void setLBFGSHistoryLength(int historyLen);
+
+protected:
+  void resetHistory(int dim) override;
+
+  Eigen::VectorXs computeStep(
+      const Eigen::VectorXs& x, const Eigen::VectorXs& grad) override;
+
+  void observeStep(
+      const Eigen::VectorXs& dx, const Eigen::VectorXs& dg) override;
+
+  int mLBFGSHistoryLength;
+
+  /// These are the most recent changes in x and in the gradient, oldest first
+  std::deque<Eigen::VectorXs> mDxHistory;
+  std::deque<Eigen::VectorXs> mDgHistory;
+};
+
+} // namespace trajectory
+} // namespace dart
+
+#endif
@@ -0,0 +1,431 @@
+#include "dart/trajectory/LineSearchOptimizer.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+#include "dart/simulation/World.hpp"
+
+namespace dart {
+namespace trajectory {
+
+// This is the fraction of the decrease predicted by the gradient that a step
+// needs to achieve to be accepted (the Armijo condition)
+static const s_t SUFFICIENT_DECREASE = 1e-4;
+
+//==============================================================================
+/// This returns how far each constraint is outside its bounds, or 0 for the
+/// ones that are satisfied
+static Eigen::VectorXs getConstraintViolation(
+    Problem* problem, std::shared_ptr<simulation::World> world)
+{
+  int numConstraints = problem->getConstraintDim();
+  Eigen::VectorXs constraints = Eigen::VectorXs::Zero(numConstraints);
+  Eigen::VectorXs upperBounds = Eigen::VectorXs::Zero(numConstraints);
+  Eigen::VectorXs lowerBounds = Eigen::VectorXs::Zero(numConstraints);
+  problem->computeConstraints(world, constraints);
+  problem->getConstraintUpperBounds(upperBounds);
+  problem->getConstraintLowerBounds(lowerBounds);
+  return constraints - constraints.cwiseMax(lowerBounds).cwiseMin(upperBounds);
+}
+
+//==============================================================================
+LineSearchOptimizer::LineSearchOptimizer()
+  : mIterationLimit(100),
+    mTolerance(1e-7),
+    mTimeBudgetMillis(0),
+    mStepSizes({1.0, 0.5, 0.25, 0.125}),
+    mParallelLineSearch(false),
+    mConstraintPenaltyWeight(100.0),
+    mRecordIterations(false),
+    mSilenceOutput(false),
+    mTrialSourceProblem(nullptr),
+    mTrialSourceWorld(nullptr),
+    mTrialSourceDim(0)
+{
+}
+
+//==============================================================================
+std::shared_ptr<Solution> LineSearchOptimizer::optimize(
+    Problem* shot, std::shared_ptr<Solution> reuseRecord)
+{
+  mStartTime = std::chrono::steady_clock::now();
+  std::shared_ptr<Solution> record
+      = reuseRecord ? reuseRecord : std::make_shared<Solution>();
+  std::shared_ptr<simulation::World> world = shot->mWorld;
+
+  int n = shot->getFlatProblemDim(world);
+  Eigen::VectorXs x = Eigen::VectorXs::Zero(n);
+  Eigen::VectorXs upperBounds = Eigen::VectorXs::Zero(n);
+  Eigen::VectorXs lowerBounds = Eigen::VectorXs::Zero(n);
+  shot->flatten(world, x);
+  shot->getUpperBounds(world, upperBounds);
+  shot->getLowerBounds(world, lowerBounds);
+  x = x.cwiseMax(lowerBounds).cwiseMin(upperBounds);
+  shot->unflatten(world, x);
+
+  if (shot->getConstraintDim() > 0 && mConstraintPenaltyWeight > 0)
+  {
+    int nnz = shot->getNumberNonZeroJacobian(world);
+    mJacRows = Eigen::VectorXi::Zero(nnz);
+    mJacCols = Eigen::VectorXi::Zero(nnz);
+    shot->getJacobianSparsityStructure(world, mJacRows, mJacCols);
+  }
+
+  if (mParallelLineSearch && mStepSizes.size() > 1)
+  {
+    // Before using Eigen in a multi-threaded environment, we need to explicitly
+    // call this (at least prior to Eigen 3.3)
+    Eigen::initParallel();
+    updateTrialClones(shot);
+    if (!mWorkers || mWorkers->getNumWorkers() != mStepSizes.size())
+    {
+      mWorkers = std::make_shared<common::WorkerPool>(mStepSizes.size());
+    }
+  }
+  else
+  {
+    mTrialProblems.clear();
+    mTrialWorlds.clear();
+  }
+
+  resetHistory(n);
+  s_t loss = getPenalizedLoss(shot, world);
+  Eigen::VectorXs grad = Eigen::VectorXs::Zero(n);
+  getPenalizedGradient(shot, world, grad);
+
+  int numIterations = 0;
+  bool converged = false;
+  bool historyWasReset = false;
+  while (numIterations < mIterationLimit && !isOverTimeBudget())
+  {
+    Eigen::VectorXs step = computeStep(x, grad);
+    Eigen::VectorXs newX;
+    s_t newLoss;
+    int chosen = lineSearch(
+        shot, x, grad, step, loss, lowerBounds, upperBounds, newX, newLoss);
+    if (chosen == -1)
+    {
+      // If a step built from our history doesn't help, try again once from a
+      // fresh history before deciding we've converged
+      if (historyWasReset)
+      {
+        converged = true;
+        break;
+      }
+      resetHistory(n);
+      historyWasReset = true;
+      continue;
+    }
+    historyWasReset = false;
+
+    Eigen::VectorXs newGrad = Eigen::VectorXs::Zero(n);
+    getPenalizedGradient(shot, world, newGrad);
+    observeStep(newX - x, newGrad - grad);
+    s_t improvement = loss - newLoss;
+    x = newX;
+    grad = newGrad;
+    loss = newLoss;
+    numIterations++;
+
+    if (!mSilenceOutput)
+    {
+      std::cout << "Iter " << numIterations << ": " << loss << " (step size "
+                << mStepSizes[chosen] << ")" << std::endl;
+    }
+    if (mRecordIterations)
+    {
+      record->registerIteration(
+          numIterations, shot->getRolloutCache(world), loss, 0.0);
+    }
+
+    bool keepGoing = true;
+    for (auto callback : mIntermediateCallbacks)
+    {
+      if (!callback(shot, numIterations, loss, 0.0))
+      {
+        keepGoing = false;
+      }
+    }
+    if (!keepGoing)
+    {
+      break;
+    }
+    if (improvement < mTolerance)
+    {
+      converged = true;
+      break;
+    }
+  }
+
+  record->setIterationCount(numIterations);
+  record->setSuccess(converged);
+  return record;
+}
+
+//==============================================================================
+void LineSearchOptimizer::setIterationLimit(int iterationLimit)
+{
+  mIterationLimit = iterationLimit;
+}
+
+//==============================================================================
+/// We stop once an iteration improves the loss by less than this
+void LineSearchOptimizer::setTolerance(s_t tolerance)
+{
+  mTolerance = tolerance;
+}
+
+//==============================================================================
+/// This sets a wall-clock budget for each call to optimize(). Once it's
+/// spent, we stop at the end of the current iteration and keep the best
+/// point so far. A budget <= 0 means there's no limit.
+void LineSearchOptimizer::setTimeBudgetMillis(long budgetMillis)
+{
+  mTimeBudgetMillis = budgetMillis;
+}
+
+//==============================================================================
+/// These are the multiples of the proposed step that the line search tries,
+/// in the order that they're tried when running serially.
+void LineSearchOptimizer::setLineSearchStepSizes(std::vector<s_t> stepSizes)
+{
+  assert(stepSizes.size() > 0);
+  mStepSizes = stepSizes;
+}
+
+//==============================================================================
+/// If true, all the line search step sizes are evaluated at once, each on
+/// its own thread. This clones the problem and the World once per step size,
+/// and keeps the clones across calls to optimize(). They're only rebuilt
+/// when we're handed a different problem or World, when the number of
+/// variables or step sizes changes, or when a Skeleton's version changes.
+/// Between rebuilds, each call copies over the problem's start state and
+/// metadata, which is all that advanceSteps() changes besides the variables.
+/// If you edit the problem in place some other way (like calling setLoss()),
+/// call this again to force fresh clones. The clones share the problem's
+/// loss and mappings, so those need to be safe to call from several threads
+/// at once (IKMapping, which caches its last solution, is not).
+void LineSearchOptimizer::setParallelLineSearchEnabled(bool enabled)
+{
+  mParallelLineSearch = enabled;
+  mTrialProblems.clear();
+  mTrialWorlds.clear();
+  if (!enabled)
+  {
+    mWorkers = nullptr;
+  }
+}
+
+//==============================================================================
+/// This is the weight on the squared constraint violation, which is added
+/// to the loss
+void LineSearchOptimizer::setConstraintPenaltyWeight(s_t weight)
+{
+  mConstraintPenaltyWeight = weight;
+}
+
+//==============================================================================
+void LineSearchOptimizer::setRecordIterations(bool recordIterations)
+{
+  mRecordIterations = recordIterations;
+}
+
+//==============================================================================
+void LineSearchOptimizer::setSilenceOutput(bool silenceOutput)
+{
+  mSilenceOutput = silenceOutput;
+}
+
+//==============================================================================
+/// This returns the loss plus the constraint penalty at the problem's
+/// current value
+s_t LineSearchOptimizer::getPenalizedLoss(
+    Problem* problem, std::shared_ptr<simulation::World> world)
+{
+  s_t loss = problem->getLoss(world);
+  if (problem->getConstraintDim() > 0 && mConstraintPenaltyWeight > 0)
+  {
+    Eigen::VectorXs violation = getConstraintViolation(problem, world);
+    loss += 0.5 * mConstraintPenaltyWeight * violation.squaredNorm();
+  }
+  return loss;
+}
+
+//==============================================================================
+/// This computes the gradient of getPenalizedLoss()
+void LineSearchOptimizer::getPenalizedGradient(
+    Problem* problem,
+    std::shared_ptr<simulation::World> world,
+    /* OUT */ Eigen::Ref<Eigen::VectorXs> grad)
+{
+  problem->backpropGradient(world, grad);
+  if (problem->getConstraintDim() > 0 && mConstraintPenaltyWeight > 0)
+  {
+    Eigen::VectorXs violation = getConstraintViolation(problem, world);
+
+    // grad += weight * J^T * violation, reading J in its sparse form
+    Eigen::VectorXs sparseJac = Eigen::VectorXs::Zero(mJacRows.size());
+    problem->getSparseJacobian(world, sparseJac);
+    for (int i = 0; i < sparseJac.size(); i++)
+    {
+      grad(mJacCols(i))
+          += mConstraintPenaltyWeight * sparseJac(i) * violation(mJacRows(i));
+    }
+  }
+}
+
+//==============================================================================
+/// This tries each step size, and returns the index of the one we should
+/// take, or -1 if none of them are acceptable. On return, `shot` has been
+/// unflattened to x + stepSize * step for the chosen step size, or to `x`
+/// if none was acceptable.
+int LineSearchOptimizer::lineSearch(
+    Problem* shot,
+    const Eigen::VectorXs& x,
+    const Eigen::VectorXs& grad,
+    const Eigen::VectorXs& step,
+    s_t loss,
+    const Eigen::VectorXs& lowerBounds,
+    const Eigen::VectorXs& upperBounds,
+    /* OUT */ Eigen::VectorXs& newX,
+    /* OUT */ s_t& newLoss)
+{
+  std::shared_ptr<simulation::World> world = shot->mWorld;
+  s_t slope = grad.dot(step);
+  auto isAcceptable = [&](s_t stepSize, s_t trialLoss) {
+    return std::isfinite(trialLoss) && trialLoss < loss
+           && trialLoss <= loss + SUFFICIENT_DECREASE * stepSize * slope;
+  };
+
+  if (mParallelLineSearch && !mTrialProblems.empty())
+  {
+    int numTrials = mStepSizes.size();
+    std::vector<Eigen::VectorXs> trialXs;
+    std::vector<s_t> trialLosses(numTrials);
+    for (int i = 0; i < numTrials; i++)
+    {
+      trialXs.push_back((x + mStepSizes[i] * step)
+                            .cwiseMax(lowerBounds)
+                            .cwiseMin(upperBounds));
+    }
+    mWorkers->run(numTrials, [&](int i) {
+      // Like the serial search, we always try the first step size, but don't
+      // start on any others once the time budget is spent
+      if (i > 0 && isOverTimeBudget())
+      {
+        trialLosses[i] = std::numeric_limits<s_t>::infinity();
+        return;
+      }
+      mTrialProblems[i]->unflatten(mTrialWorlds[i], trialXs[i]);
+      trialLosses[i]
+          = getPenalizedLoss(mTrialProblems[i].get(), mTrialWorlds[i]);
+    });
+
+    int best = -1;
+    for (int i = 0; i < numTrials; i++)
+    {
+      if (isAcceptable(mStepSizes[i], trialLosses[i])
+          && (best == -1 || trialLosses[i] < trialLosses[best]))
+      {
+        best = i;
+      }
+    }
+    newX = best == -1 ? x : trialXs[best];
+    newLoss = best == -1 ? loss : trialLosses[best];
+    shot->unflatten(world, newX);
+    return best;
+  }
+
+  for (int i = 0; i < mStepSizes.size(); i++)
+  {
+    newX = (x + mStepSizes[i] * step)
+               .cwiseMax(lowerBounds)
+               .cwiseMin(upperBounds);
+    shot->unflatten(world, newX);
+    newLoss = getPenalizedLoss(shot, world);
+    if (isAcceptable(mStepSizes[i], newLoss))
+    {
+      return i;
+    }
+    if (isOverTimeBudget())
+    {
+      break;
+    }
+  }
+  newX = x;
+  newLoss = loss;
+  shot->unflatten(world, x);
+  return -1;
+}
+
+//==============================================================================
+/// This returns true if we've spent the time budget for this call to
+/// optimize()
+bool LineSearchOptimizer::isOverTimeBudget() const
+{
+  if (mTimeBudgetMillis <= 0)
+  {
+    return false;
+  }
+  long elapsedMillis = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - mStartTime)
+                           .count();
+  return elapsedMillis >= mTimeBudgetMillis;
+}
+
+//==============================================================================
+/// This makes sure there's one clone of `shot` and its World per step size,
+/// reusing the ones from the last call to optimize() if nothing structural
+/// has changed since, and brings their start states up to date.
+void LineSearchOptimizer::updateTrialClones(Problem* shot)
+{
+  std::shared_ptr<simulation::World> world = shot->mWorld;
+  int dim = shot->getFlatProblemDim(world);
+  std::vector<std::size_t> versions = getSkeletonVersions(world);
+  if (mTrialProblems.size() != mStepSizes.size()
+      || mTrialSourceProblem != shot || mTrialSourceWorld != world.get()
+      || mTrialSourceDim != dim || mTrialSourceVersions != versions)
+  {
+    mTrialProblems.clear();
+    mTrialWorlds.clear();
+    for (int i = 0; i < mStepSizes.size(); i++)
+    {
+      mTrialProblems.push_back(shot->clone());
+      mTrialWorlds.push_back(world->clone());
+    }
+    mTrialSourceProblem = shot;
+    mTrialSourceWorld = world.get();
+    mTrialSourceDim = dim;
+    mTrialSourceVersions = versions;
+    return;
+  }
+
+  // The variables get unflattened into the clones on every trial, so this is
+  // the only other state that changes between replans
+  Eigen::VectorXs startPos = shot->getStartPos();
+  Eigen::VectorXs startVel = shot->getStartVel();
+  for (std::shared_ptr<Problem>& trial : mTrialProblems)
+  {
+    trial->setStartPos(startPos);
+    trial->setStartVel(startVel);
+    trial->getMetadataMap() = shot->getMetadataMap();
+  }
+}
+
+//==============================================================================
+/// This returns the version of every Skeleton in `world`, in order
+std::vector<std::size_t> LineSearchOptimizer::getSkeletonVersions(
+    std::shared_ptr<simulation::World> world)
+{
+  std::vector<std::size_t> versions;
+  for (int i = 0; i < world->getNumSkeletons(); i++)
+  {
+    versions.push_back(world->getSkeleton(i)->getVersion());
+  }
+  return versions;
+}
+
+} // namespace trajectory
+} // namespace dart
@@ -0,0 +1,174 @@
+#ifndef DART_TRAJECTORY_LINE_SEARCH_OPTIMIZER_HPP_
+#define DART_TRAJECTORY_LINE_SEARCH_OPTIMIZER_HPP_
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include "dart/common/WorkerPool.hpp"
+#include "dart/trajectory/Optimizer.hpp"
+#include "dart/trajectory/Problem.hpp"
+#include "dart/trajectory/Solution.hpp"
+#include "dart/trajectory/TrajectoryConstants.hpp"
+
+namespace dart {
+
+namespace simulation {
+class World;
+}
+
+namespace trajectory {
+
+/*
+ * This is the shared machinery for our native first-order optimizers (Adam and
+ * L-BFGS). These are meant for short-horizon problems, like the ones MPC
+ * solves, where IPOPT's setup overhead costs more than the solve itself.
+ *
+ * Each iteration, the subclass proposes a step, and we try several multiples
+ * of it (the "step sizes"), keeping the best one that sufficiently decreases
+ * the loss. With parallel line search enabled, every step size is rolled out
+ * at once, each on its own clone of the problem and the World. Otherwise the
+ * step sizes are tried in order, and we stop at the first acceptable one.
+ *
+ * Variables are clamped to the problem's bounds. Constraints (like the
+ * knot-points of a MultiShot) are folded into the loss as a quadratic penalty
+ * on their violation, so these are not a substitute for IPOPT when the
+ * constraints need to hold exactly.
+ */
+class LineSearchOptimizer : public Optimizer
+{
+public:
+  LineSearchOptimizer();
+
+  virtual ~LineSearchOptimizer() = default;
+
+  std::shared_ptr<Solution> optimize(
+      Problem* shot, std::shared_ptr<Solution> warmStart = nullptr) override;
+
+  void setIterationLimit(int iterationLimit);
+
+  /// We stop once an iteration improves the loss by less than this
+  void setTolerance(s_t tolerance);
+
+  /// This sets a wall-clock budget for each call to optimize(). Once it's
+  /// spent, we stop at the end of the current iteration and keep the best
+  /// point so far. A budget <= 0 means there's no limit.
+  void setTimeBudgetMillis(long budgetMillis);
+
+  /// These are the multiples of the proposed step that the line search tries,
+  /// in the order that they're tried when running serially.
+  void setLineSearchStepSizes(std::vector<s_t> stepSizes);
+
+  /// If true, all the line search step sizes are evaluated at once, each on
+  /// its own thread. This clones the problem and the World once per step size,
+  /// and keeps the clones across calls to optimize(). They're only rebuilt
+  /// when we're handed a different problem or World, when the number of
+  /// variables or step sizes changes, or when a Skeleton's version changes.
+  /// Between rebuilds, each call copies over the problem's start state and
+  /// metadata, which is all that advanceSteps() changes besides the variables.
+  /// If you edit the problem in place some other way (like calling setLoss()),
+  /// call this again to force fresh clones. The clones share the problem's
+  /// loss and mappings, so those need to be safe to call from several threads
+  /// at once (IKMapping, which caches its last solution, is not).
+  void setParallelLineSearchEnabled(bool enabled);
+
+  /// This is the weight on the squared constraint violation, which is added
+  /// to the loss
+  void setConstraintPenaltyWeight(s_t weight);
+
+  void setRecordIterations(bool recordIterations);
+
+  void setSilenceOutput(bool silenceOutput);
+
+protected:
+  /// This gets called at the start of each optimize(), with the number of
+  /// variables, so subclasses can reset any state from previous calls.
+  virtual void resetHistory(int dim) = 0;
+
+  /// This returns the step we'd like to take from `x`, given the gradient of
+  /// the loss there. The line search scales this by each step size.
+  virtual Eigen::VectorXs computeStep(
+      const Eigen::VectorXs& x, const Eigen::VectorXs& grad)
+      = 0;
+
+  /// This gets called after we've accepted a step, with the change in x and
+  /// the change in the gradient, so subclasses can update their history.
+  virtual void observeStep(
+      const Eigen::VectorXs& dx, const Eigen::VectorXs& dg)
+      = 0;
+
+  /// This returns the loss plus the constraint penalty at the problem's
+  /// current value
+  s_t getPenalizedLoss(
+      Problem* problem, std::shared_ptr<simulation::World> world);
+
+  /// This computes the gradient of getPenalizedLoss()
+  void getPenalizedGradient(
+      Problem* problem,
+      std::shared_ptr<simulation::World> world,
+      /* OUT */ Eigen::Ref<Eigen::VectorXs> grad);
+
+  /// This tries each step size, and returns the index of the one we should
+  /// take, or -1 if none of them are acceptable. On return, `shot` has been
+  /// unflattened to x + stepSize * step for the chosen step size, or to `x`
+  /// if none was acceptable.
+  int lineSearch(
+      Problem* shot,
+      const Eigen::VectorXs& x,
+      const Eigen::VectorXs& grad,
+      const Eigen::VectorXs& step,
+      s_t loss,
+      const Eigen::VectorXs& lowerBounds,
+      const Eigen::VectorXs& upperBounds,
+      /* OUT */ Eigen::VectorXs& newX,
+      /* OUT */ s_t& newLoss);
+
+  /// This returns true if we've spent the time budget for this call to
+  /// optimize()
+  bool isOverTimeBudget() const;
+
+  /// This makes sure there's one clone of `shot` and its World per step size,
+  /// reusing the ones from the last call to optimize() if nothing structural
+  /// has changed since, and brings their start states up to date.
+  void updateTrialClones(Problem* shot);
+
+  /// This returns the version of every Skeleton in `world`, in order
+  static std::vector<std::size_t> getSkeletonVersions(
+      std::shared_ptr<simulation::World> world);
+
+  int mIterationLimit;
+  s_t mTolerance;
+  long mTimeBudgetMillis;
+  std::vector<s_t> mStepSizes;
+  bool mParallelLineSearch;
+  s_t mConstraintPenaltyWeight;
+  bool mRecordIterations;
+  bool mSilenceOutput;
+
+  /// These are only used with parallel line search. Worker i evaluates step
+  /// size i on mTrialProblems[i] and mTrialWorlds[i].
+  std::vector<std::shared_ptr<Problem>> mTrialProblems;
+  std::vector<std::shared_ptr<simulation::World>> mTrialWorlds;
+  std::shared_ptr<common::WorkerPool> mWorkers;
+
+  /// These describe what the trial clones were made from, so we can tell
+  /// when they're stale. The pointers are only compared, never dereferenced.
+  Problem* mTrialSourceProblem;
+  simulation::World* mTrialSourceWorld;
+  int mTrialSourceDim;
+  std::vector<std::size_t> mTrialSourceVersions;
+
+  std::chrono::steady_clock::time_point mStartTime;
+
+  /// This is the sparsity structure of the constraint Jacobian, which we
+  /// compute once per call to optimize()
+  Eigen::VectorXi mJacRows;
+  Eigen::VectorXi mJacCols;
+};
+
+} // namespace trajectory
+} // namespace dart
+
+#endif
@@ -9,6 +9,101 @@ using namespace dart;
 namespace dart {
 namespace trajectory {
 
+//==============================================================================
+/// This is weight * sum_t |pos_t - targetPoses_t|^2
+LossTerm LossTerm::tracking(const Eigen::MatrixXs& targetPoses, s_t weight)
+{
+  LossTerm term;
+  term.type = TRACKING;
+  term.weight = weight;
+  term.target = targetPoses;
+  return term;
+}
+
+//==============================================================================
+/// This is weight * sum_t |force_t|^2
+LossTerm LossTerm::effort(s_t weight)
+{
+  LossTerm term;
+  term.type = EFFORT;
+  term.weight = weight;
+  return term;
+}
+
+//==============================================================================
+/// This is weight * (|pos_T - targetPos|^2 + |vel_T - targetVel|^2), for
+/// the last timestep T
+LossTerm LossTerm::terminalState(
+    const Eigen::VectorXs& targetPos,
+    const Eigen::VectorXs& targetVel,
+    s_t weight)
+{
+  assert(targetPos.size() == targetVel.size());
+  LossTerm term;
+  term.type = TERMINAL_STATE;
+  term.weight = weight;
+  term.target = Eigen::MatrixXs(targetPos.size(), 2);
+  term.target.col(0) = targetPos;
+  term.target.col(1) = targetVel;
+  return term;
+}
+
+//==============================================================================
+/// This evaluates a built-in term on the "identity" mapping of a rollout
+static s_t getTermLoss(
+    const LossTerm& term,
+    const Eigen::Ref<const Eigen::MatrixXs>& poses,
+    const Eigen::Ref<const Eigen::MatrixXs>& vels,
+    const Eigen::Ref<const Eigen::MatrixXs>& forces)
+{
+  switch (term.type)
+  {
+    case LossTerm::TRACKING:
+      assert(term.target.rows() == poses.rows());
+      assert(term.target.cols() == poses.cols());
+      return term.weight * (poses - term.target).squaredNorm();
+    case LossTerm::EFFORT:
+      return term.weight * forces.squaredNorm();
+    case LossTerm::TERMINAL_STATE:
+      assert(term.target.rows() == poses.rows());
+      return term.weight
+             * ((poses.col(poses.cols() - 1) - term.target.col(0))
+                    .squaredNorm()
+                + (vels.col(vels.cols() - 1) - term.target.col(1))
+                      .squaredNorm());
+  }
+  return 0.0;
+}
+
+//==============================================================================
+/// This adds the gradient of a built-in term to `gradWrtRollout`
+static void addTermGradient(
+    const LossTerm& term,
+    const TrajectoryRollout* rollout,
+    /* OUT */ TrajectoryRollout* gradWrtRollout)
+{
+  const Eigen::Ref<const Eigen::MatrixXs> poses = rollout->getPosesConst();
+  const Eigen::Ref<const Eigen::MatrixXs> vels = rollout->getVelsConst();
+  const Eigen::Ref<const Eigen::MatrixXs> forces
+      = rollout->getControlForcesConst();
+  switch (term.type)
+  {
+    case LossTerm::TRACKING:
+      gradWrtRollout->getPoses() += 2 * term.weight * (poses - term.target);
+      break;
+    case LossTerm::EFFORT:
+      gradWrtRollout->getControlForces() += 2 * term.weight * forces;
+      break;
+    case LossTerm::TERMINAL_STATE:
+      int last = poses.cols() - 1;
+      gradWrtRollout->getPoses().col(last)
+          += 2 * term.weight * (poses.col(last) - term.target.col(0));
+      gradWrtRollout->getVels().col(last)
+          += 2 * term.weight * (vels.col(last) - term.target.col(1));
+      break;
+  }
+}
+
 //==============================================================================
 LossFn::LossFn()
   : mLoss(tl::nullopt),
@@ -36,6 +131,17 @@ LossFn::LossFn(TrajectoryLossFn loss, TrajectoryLossFnAndGrad lossAndGrad)
 {
 }
 
+//==============================================================================
+/// This creates a loss that's the sum of built-in terms
+LossFn::LossFn(std::vector<LossTerm> terms)
+  : mLoss(tl::nullopt),
+    mLossAndGrad(tl::nullopt),
+    mTerms(terms),
+    mLowerBound(-std::numeric_limits<s_t>::infinity()),
+    mUpperBound(std::numeric_limits<s_t>::infinity())
+{
+}
+
 //==============================================================================
 LossFn::~LossFn()
 {
@@ -59,6 +165,14 @@ s_t LossFn::getLoss(
   {
     loss = mLoss.value()(rollout);
   }
+  for (const LossTerm& term : mTerms)
+  {
+    loss += getTermLoss(
+        term,
+        rollout->getPosesConst(),
+        rollout->getVelsConst(),
+        rollout->getControlForcesConst());
+  }
 
 #ifdef LOG_PERFORMANCE_LOSS_FN
   if (thisLog != nullptr)
@@ -176,6 +290,16 @@ s_t LossFn::getLossAndGradient(
     loss = 0.0;
   }
 
+  for (const LossTerm& term : mTerms)
+  {
+    loss += getTermLoss(
+        term,
+        rollout->getPosesConst(),
+        rollout->getVelsConst(),
+        rollout->getControlForcesConst());
+    addTermGradient(term, rollout, gradWrtRollout);
+  }
+
 #ifdef LOG_PERFORMANCE_LOSS_FN
   if (thisLog != nullptr)
   {
@@ -186,6 +310,80 @@ s_t LossFn::getLossAndGradient(
   return loss;
 }
 
+//==============================================================================
+/// This evaluates the loss for every candidate in `batch`. Built-in terms
+/// read the batch's contiguous storage directly, and a custom loss
+/// function gets a view of each candidate, so nothing gets copied.
+void LossFn::getLossBatch(
+    const TrajectoryRolloutBatch* batch,
+    /* OUT */ Eigen::Ref<Eigen::VectorXs> losses,
+    PerformanceLog* perflog)
+{
+  PerformanceLog* thisLog = nullptr;
+#ifdef LOG_PERFORMANCE_LOSS_FN
+  if (perflog != nullptr)
+  {
+    thisLog = perflog->startRun("LossFn.getLossBatch");
+  }
+#endif
+
+  int numCandidates = batch->getNumCandidates();
+  int steps = batch->getNumSteps();
+  assert(losses.size() == numCandidates);
+  losses.setZero();
+
+  if (mLoss)
+  {
+    for (int i = 0; i < numCandidates; i++)
+    {
+      const TrajectoryRolloutConstRef candidate = batch->getCandidateConst(i);
+      losses(i) = mLoss.value()(&candidate);
+    }
+  }
+
+  if (!mTerms.empty())
+  {
+    const TrajectoryRollout* all = batch->getAllConst();
+    const Eigen::Ref<const Eigen::MatrixXs> poses = all->getPosesConst();
+    const Eigen::Ref<const Eigen::MatrixXs> vels = all->getVelsConst();
+    const Eigen::Ref<const Eigen::MatrixXs> forces
+        = all->getControlForcesConst();
+    for (const LossTerm& term : mTerms)
+    {
+      for (int i = 0; i < numCandidates; i++)
+      {
+        losses(i) += getTermLoss(
+            term,
+            poses.middleCols(i * steps, steps),
+            vels.middleCols(i * steps, steps),
+            forces.middleCols(i * steps, steps));
+      }
+    }
+  }
+
+#ifdef LOG_PERFORMANCE_LOSS_FN
+  if (thisLog != nullptr)
+  {
+    thisLog->end();
+  }
+#endif
+}
+
+//==============================================================================
+/// This adds a built-in term to the loss. Terms are summed with each
+/// other, and with the custom loss function, if there is one.
+void LossFn::addTerm(LossTerm term)
+{
+  mTerms.push_back(term);
+}
+
+//==============================================================================
+/// This returns the built-in terms in the loss
+const std::vector<LossTerm>& LossFn::getTerms() const
+{
+  return mTerms;
+}
+
 //==============================================================================
 /// If this LossFn is being used as a constraint, this gets the lower bound
 /// it's allowed to reach
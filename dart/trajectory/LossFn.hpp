@@ -2,6 +2,7 @@
 #define DART_TRAJECTORY_LOSS_FUNCTION_HPP_
 
 #include <memory>
+#include <vector>
 
 #include <Eigen/Dense>
 
@@ -24,6 +25,41 @@ typedef std::function<s_t(
     /* OUT */ TrajectoryRollout* gradWrtRollout)>
     TrajectoryLossFnAndGrad;
 
+/// This is one of the common loss terms that LossFn can evaluate directly in
+/// C++, without calling through a std::function. Terms have analytical
+/// gradients, and are cheap to evaluate over a whole TrajectoryRolloutBatch.
+/// They're all computed on the "identity" mapping.
+struct LossTerm
+{
+  enum Type
+  {
+    TRACKING,
+    EFFORT,
+    TERMINAL_STATE
+  };
+
+  Type type;
+  s_t weight;
+  /// For TRACKING, this is the target poses (dofs x steps). For
+  /// TERMINAL_STATE, this is the target final position and velocity, as two
+  /// columns. EFFORT doesn't use it.
+  Eigen::MatrixXs target;
+
+  /// This is weight * sum_t |pos_t - targetPoses_t|^2
+  static LossTerm tracking(
+      const Eigen::MatrixXs& targetPoses, s_t weight = 1.0);
+
+  /// This is weight * sum_t |force_t|^2
+  static LossTerm effort(s_t weight = 1.0);
+
+  /// This is weight * (|pos_T - targetPos|^2 + |vel_T - targetVel|^2), for
+  /// the last timestep T
+  static LossTerm terminalState(
+      const Eigen::VectorXs& targetPos,
+      const Eigen::VectorXs& targetVel,
+      s_t weight = 1.0);
+};
+
 class LossFn
 {
 public:
@@ -33,6 +69,9 @@ public:
 
   LossFn(TrajectoryLossFn loss, TrajectoryLossFnAndGrad lossAndGrad);
 
+  /// This creates a loss that's the sum of built-in terms
+  LossFn(std::vector<LossTerm> terms);
+
   virtual ~LossFn();
 
   virtual s_t getLoss(
@@ -43,6 +82,21 @@ public:
       /* OUT */ TrajectoryRollout* gradWrtRollout,
       PerformanceLog* perflog = nullptr);
 
+  /// This evaluates the loss for every candidate in `batch`. Built-in terms
+  /// read the batch's contiguous storage directly, and a custom loss
+  /// function gets a view of each candidate, so nothing gets copied.
+  virtual void getLossBatch(
+      const TrajectoryRolloutBatch* batch,
+      /* OUT */ Eigen::Ref<Eigen::VectorXs> losses,
+      PerformanceLog* perflog = nullptr);
+
+  /// This adds a built-in term to the loss. Terms are summed with each
+  /// other, and with the custom loss function, if there is one.
+  void addTerm(LossTerm term);
+
+  /// This returns the built-in terms in the loss
+  const std::vector<LossTerm>& getTerms() const;
+
   /// If this LossFn is being used as a constraint, this gets the lower bound
   /// it's allowed to reach
   s_t getLowerBound() const;
@@ -62,6 +116,7 @@ public:
 protected:
   tl::optional<TrajectoryLossFn> mLoss;
   tl::optional<TrajectoryLossFnAndGrad> mLossAndGrad;
+  std::vector<LossTerm> mTerms;
   // If this loss function is being used as a constraint, this is the lower
   // bound it's allowed to reach
   s_t mLowerBound;
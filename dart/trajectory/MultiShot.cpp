@@ -1,6 +1,5 @@
 #include "dart/trajectory/MultiShot.hpp"
 
-#include <future>
 #include <vector>
 
 #include "dart/dynamics/Skeleton.hpp"
@@ -53,6 +52,25 @@ MultiShot::~MultiShot()
   // std::cout << "Freeing MultiShot: " << this << std::endl;
 }
 
+//==============================================================================
+/// This returns a deep copy of this shot, including all its SingleShots. The
+/// copy always starts with parallel operations disabled.
+std::shared_ptr<Problem> MultiShot::clone() const
+{
+  std::shared_ptr<MultiShot> copy = std::make_shared<MultiShot>(*this);
+  for (int i = 0; i < mShots.size(); i++)
+  {
+    copy->mShots[i] = std::static_pointer_cast<SingleShot>(mShots[i]->clone());
+  }
+  copy->mRolloutCacheDirty = true;
+  copy->mRolloutCache = nullptr;
+  copy->mGradWrtRolloutCache = nullptr;
+  copy->mParallelOperationsEnabled = false;
+  copy->mParallelWorlds.clear();
+  copy->mWorkers = nullptr;
+  return copy;
+}
+
 //==============================================================================
 void MultiShot::setParallelOperationsEnabled(bool enabled)
 {
@@ -68,6 +86,11 @@ void MultiShot::setParallelOperationsEnabled(bool enabled)
     {
       mParallelWorlds.push_back(mWorld->clone());
     }
+    mWorkers = std::make_shared<common::WorkerPool>(mShots.size());
+  }
+  else
+  {
+    mWorkers = nullptr;
   }
 }
 
@@ -182,23 +205,19 @@ void MultiShot::computeConstraints(
 
   if (mParallelOperationsEnabled)
   {
-    std::vector<std::future<void>> futures;
-    for (int i = 1; i < mShots.size(); i++)
-    {
-      futures.push_back(std::async(
-          &MultiShot::asyncPartComputeConstraints,
-          this,
+    // Worker i computes the knot point constraint at the start of shot i
+    int stateDim = getRepresentationStateSize();
+    mWorkers->run(mShots.size(), [&](int i) {
+      if (i == 0)
+        return;
+      asyncPartComputeConstraints(
           i,
           mParallelWorlds[i],
           constraints,
-          cursor,
-          thisLog));
-      cursor += getRepresentationStateSize();
-    }
-    for (int i = 0; i < futures.size(); i++)
-    {
-      futures[i].wait();
-    }
+          cursor + (i - 1) * stateDim,
+          thisLog);
+    });
+    cursor += (mShots.size() - 1) * stateDim;
   }
   else
   {
@@ -512,23 +531,28 @@ void MultiShot::backpropJacobian(
   int stateDim = getRepresentationStateSize();
   if (mParallelOperationsEnabled)
   {
-    std::vector<std::future<void>> futures;
+    std::vector<int> rowCursors;
+    std::vector<int> colCursors;
     for (int i = 1; i < mShots.size(); i++)
     {
-      int dynamicDim = mShots[i - 1]->getFlatDynamicProblemDim(world);
-      futures.push_back(std::async(
-          &MultiShot::asyncPartBackpropJacobian,
-          this,
+      rowCursors.push_back(rowCursor);
+      colCursors.push_back(colCursor);
+      colCursor += mShots[i - 1]->getFlatDynamicProblemDim(world);
+      rowCursor += stateDim;
+    }
+    // Worker i fills in the rows for the knot point at the start of shot i
+    mWorkers->run(mShots.size(), [&](int i) {
+      if (i == 0)
+        return;
+      asyncPartBackpropJacobian(
           i,
           mParallelWorlds[i],
           jacStatic,
           jacDynamic,
-          rowCursor,
-          colCursor,
-          thisLog));
-      colCursor += dynamicDim;
-      rowCursor += stateDim;
-    }
+          rowCursors[i - 1],
+          colCursors[i - 1],
+          thisLog);
+    });
   }
   else
   {
@@ -765,68 +789,46 @@ void MultiShot::getSparseJacobian(
 
   int stateDim = getRepresentationStateSize();
 
-  if (mParallelOperationsEnabled)
+  std::vector<int> cursorsStatic;
+  std::vector<int> cursorsDynamic;
+  for (int i = 1; i < mShots.size(); i++)
   {
-    std::vector<std::future<void>> futures;
-    for (int i = 1; i < mShots.size(); i++)
-    {
-      int dimStatic = mShots[i - 1]->getFlatStaticProblemDim(world);
-      int dimDynamic = mShots[i - 1]->getFlatDynamicProblemDim(world);
+    cursorsStatic.push_back(cursorStatic);
+    cursorsDynamic.push_back(cursorDynamic);
+    int dimStatic = mShots[i - 1]->getFlatStaticProblemDim(world);
+    int dimDynamic = mShots[i - 1]->getFlatDynamicProblemDim(world);
+    cursorDynamic += (dimDynamic + 1) * stateDim;
+    cursorStatic += dimStatic * stateDim;
+  }
 
-      futures.push_back(std::async(
-          &MultiShot::asyncPartGetSparseJacobian,
-          this,
+  if (mParallelOperationsEnabled)
+  {
+    // Worker i writes the entries for the knot point at the start of shot i
+    mWorkers->run(mShots.size(), [&](int i) {
+      if (i == 0)
+        return;
+      asyncPartGetSparseJacobian(
           i,
           mParallelWorlds[i],
           sparseStatic,
           sparseDynamic,
-          cursorStatic,
-          cursorDynamic,
-          thisLog));
-
-      cursorDynamic += (dimDynamic + 1) * stateDim;
-      cursorStatic += dimStatic * stateDim;
-    }
-    for (int i = 0; i < futures.size(); i++)
-    {
-      futures[i].wait();
-    }
+          cursorsStatic[i - 1],
+          cursorsDynamic[i - 1],
+          thisLog);
+    });
   }
   else
   {
-    Eigen::VectorXs neg = Eigen::VectorXs::Ones(stateDim) * -1;
     for (int i = 1; i < mShots.size(); i++)
     {
-      int dimStatic = mShots[i - 1]->getFlatStaticProblemDim(world);
-      int dimDynamic = mShots[i - 1]->getFlatDynamicProblemDim(world);
-
-      // Get the dense Jacobians for static and dynamic regions
-      Eigen::MatrixXs jacStatic = Eigen::MatrixXs::Zero(stateDim, dimStatic);
-      Eigen::MatrixXs jacDynamic = Eigen::MatrixXs::Zero(stateDim, dimDynamic);
-      mShots[i - 1]->backpropJacobianOfFinalState(
-          world, jacStatic, jacDynamic, thisLog);
-
-      // Copy over the static Jacobian to the global static region (this will
-      // overwrite the same region a bunch of times)
-
-      for (int row = 0; row < stateDim; row++)
-      {
-        sparseStatic.segment(cursorStatic, dimStatic) = jacStatic.row(row);
-        cursorStatic += dimStatic;
-      }
-
-      // Copy over the dynamic Jacobian to a unique spot in the dynamic region
-
-      for (int col = 0; col < dimDynamic; col++)
-      {
-        sparseDynamic.segment(cursorDynamic, stateDim) = jacDynamic.col(col);
-        cursorDynamic += stateDim;
-      }
-      // This is the negative identity at the end of our segment in the dynamic
-      // region
-      sparseDynamic.segment(cursorDynamic, stateDim) = neg;
-
-      cursorDynamic += stateDim;
+      asyncPartGetSparseJacobian(
+          i,
+          world,
+          sparseStatic,
+          sparseDynamic,
+          cursorsStatic[i - 1],
+          cursorsDynamic[i - 1],
+          thisLog);
     }
   }
 
@@ -854,31 +856,166 @@ void MultiShot::asyncPartGetSparseJacobian(
   int dimStatic = mShots[index - 1]->getFlatStaticProblemDim(world);
   int dimDynamic = mShots[index - 1]->getFlatDynamicProblemDim(world);
 
-  // Get the dense Jacobians for static and dynamic regions
+  // Our segment of the dynamic region holds the dynamic Jacobian column by
+  // column, which is exactly a column-major matrix, so we backprop straight
+  // into it rather than going through a dense copy. The static region is
+  // stored row by row, so that goes through a (usually tiny) scratch matrix.
   Eigen::MatrixXs jacStatic = Eigen::MatrixXs::Zero(stateDim, dimStatic);
-  Eigen::MatrixXs jacDynamic = Eigen::MatrixXs::Zero(stateDim, dimDynamic);
+  Eigen::Map<Eigen::MatrixXs> jacDynamic(
+      sparseDynamic.data() + cursorDynamic, stateDim, dimDynamic);
   mShots[index - 1]->backpropJacobianOfFinalState(
       world, jacStatic, jacDynamic, log);
+  cursorDynamic += stateDim * dimDynamic;
 
-  // Copy over the static Jacobian
+  // Copy over the static Jacobian (this will overwrite the same region a bunch
+  // of times)
+  typedef Eigen::Matrix<s_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>
+      RowMajorMatrixXs;
+  Eigen::Map<RowMajorMatrixXs>(
+      sparseStatic.data() + cursorStatic, stateDim, dimStatic)
+      = jacStatic;
 
-  for (int row = 0; row < stateDim; row++)
+  // This is the negative identity at the end
+  sparseDynamic.segment(cursorDynamic, stateDim).setConstant(-1);
+}
+
+//==============================================================================
+/// This gets the number of non-zero entries in the lower triangle of the
+/// Gauss-Newton Hessian. Under Gauss-Newton the shots only interact
+/// through the knot point constraints, whose second derivatives we drop,
+/// so this is one dense block per shot down the diagonal.
+int MultiShot::getNumberNonZeroHessianDynamic(
+    std::shared_ptr<simulation::World> world)
+{
+  int nnzh = Problem::getNumberNonZeroHessianDynamic(world);
+  for (int i = 0; i < mShots.size(); i++)
   {
-    sparseStatic.segment(cursorStatic, dimStatic) = jacStatic.row(row);
-    cursorStatic += dimStatic;
+    nnzh += mShots[i]->getNumberNonZeroHessianDynamic(world);
   }
+  return nnzh;
+}
 
-  // Copy over the dynamic Jacobian
+//==============================================================================
+/// This gets the structure of the lower triangle of the Gauss-Newton
+/// Hessian, shot by shot
+void MultiShot::getHessianSparsityStructureDynamic(
+    std::shared_ptr<simulation::World> world,
+    Eigen::Ref<Eigen::VectorXi> rows,
+    Eigen::Ref<Eigen::VectorXi> cols,
+    PerformanceLog* log)
+{
+  int sparseCursor = Problem::getNumberNonZeroHessianDynamic(world);
+  Problem::getHessianSparsityStructureDynamic(
+      world,
+      rows.segment(0, sparseCursor),
+      cols.segment(0, sparseCursor),
+      log);
 
-  for (int col = 0; col < dimDynamic; col++)
+  int dimCursor = 0;
+  for (int i = 0; i < mShots.size(); i++)
   {
-    sparseDynamic.segment(cursorDynamic, stateDim) = jacDynamic.col(col);
-    cursorDynamic += stateDim;
+    int nnzh = mShots[i]->getNumberNonZeroHessianDynamic(world);
+    mShots[i]->getHessianSparsityStructureDynamic(
+        world,
+        rows.segment(sparseCursor, nnzh),
+        cols.segment(sparseCursor, nnzh),
+        log);
+    rows.segment(sparseCursor, nnzh).array() += dimCursor;
+    cols.segment(sparseCursor, nnzh).array() += dimCursor;
+    sparseCursor += nnzh;
+    dimCursor += mShots[i]->getFlatDynamicProblemDim(world);
+  }
+  assert(sparseCursor == rows.size());
+}
+
+//==============================================================================
+/// This writes the Gauss-Newton Hessian of the dynamic variables to a
+/// sparse vector, shot by shot
+void MultiShot::getSparseGaussNewtonHessianDynamic(
+    std::shared_ptr<simulation::World> world,
+    const TrajectoryRollout* lossCurvature,
+    /* OUT */ Eigen::Ref<Eigen::VectorXs> sparseDynamic,
+    PerformanceLog* log)
+{
+  PerformanceLog* thisLog = nullptr;
+#ifdef LOG_PERFORMANCE_MULTI_SHOT
+  if (log != nullptr)
+  {
+    thisLog = log->startRun("MultiShot.getSparseGaussNewtonHessianDynamic");
   }
-  // This is the negative identity at the end
-  Eigen::VectorXs neg = Eigen::VectorXs::Ones(stateDim) * -1;
-  sparseDynamic.segment(cursorDynamic, stateDim) = neg;
-  cursorDynamic += stateDim;
+#endif
+
+  int sparseCursor = Problem::getNumberNonZeroHessianDynamic(world);
+  Problem::getSparseGaussNewtonHessianDynamic(
+      world,
+      lossCurvature,
+      sparseDynamic.segment(0, sparseCursor),
+      thisLog);
+
+  std::vector<int> cursorsSparse;
+  std::vector<int> cursorsSteps;
+  int stepCursor = 0;
+  for (int i = 0; i < mShots.size(); i++)
+  {
+    cursorsSparse.push_back(sparseCursor);
+    cursorsSteps.push_back(stepCursor);
+    sparseCursor += mShots[i]->getNumberNonZeroHessianDynamic(world);
+    stepCursor += mShots[i]->getNumSteps();
+  }
+
+  if (mParallelOperationsEnabled)
+  {
+    mWorkers->run(mShots.size(), [&](int i) {
+      asyncPartGetSparseGaussNewtonHessian(
+          i,
+          mParallelWorlds[i],
+          lossCurvature,
+          sparseDynamic,
+          cursorsSparse[i],
+          cursorsSteps[i],
+          thisLog);
+    });
+  }
+  else
+  {
+    for (int i = 0; i < mShots.size(); i++)
+    {
+      asyncPartGetSparseGaussNewtonHessian(
+          i,
+          world,
+          lossCurvature,
+          sparseDynamic,
+          cursorsSparse[i],
+          cursorsSteps[i],
+          thisLog);
+    }
+  }
+
+#ifdef LOG_PERFORMANCE_MULTI_SHOT
+  if (thisLog != nullptr)
+  {
+    thisLog->end();
+  }
+#endif
+}
+
+//==============================================================================
+/// This writes the Gauss-Newton Hessian block for a single shot
+void MultiShot::asyncPartGetSparseGaussNewtonHessian(
+    int index,
+    std::shared_ptr<simulation::World> world,
+    const TrajectoryRollout* lossCurvature,
+    /* OUT */ Eigen::Ref<Eigen::VectorXs> sparseDynamic,
+    int cursorSparse,
+    int cursorSteps,
+    PerformanceLog* log)
+{
+  int steps = mShots[index]->getNumSteps();
+  int nnzh = mShots[index]->getNumberNonZeroHessianDynamic(world);
+  const TrajectoryRolloutConstRef slice
+      = lossCurvature->sliceConst(cursorSteps, steps);
+  mShots[index]->getSparseGaussNewtonHessianDynamic(
+      world, &slice, sparseDynamic.segment(cursorSparse, nnzh), log);
 }
 
 //==============================================================================
@@ -930,25 +1067,21 @@ void MultiShot::getStates(
   {
     if (mParallelOperationsEnabled)
     {
-      std::vector<std::future<void>> futures;
+      std::vector<int> cursors;
       for (int i = 0; i < mShots.size(); i++)
       {
-        int steps = mShots[i]->getNumSteps();
-        futures.push_back(std::async(
-            &MultiShot::asyncPartGetStates,
-            this,
+        cursors.push_back(cursor);
+        cursor += mShots[i]->getNumSteps();
+      }
+      mWorkers->run(mShots.size(), [&](int i) {
+        asyncPartGetStates(
             i,
             mParallelWorlds[i],
             rollout,
-            cursor,
-            steps,
-            thisLog));
-        cursor += steps;
-      }
-      for (int i = 0; i < futures.size(); i++)
-      {
-        futures[i].wait();
-      }
+            cursors[i],
+            mShots[i]->getNumSteps(),
+            thisLog);
+      });
     }
     else
     {
@@ -1065,18 +1198,55 @@ void MultiShot::setControlForcesRaw(Eigen::MatrixXs forces, PerformanceLog* log)
 //==============================================================================
 /// This moves the trajectory forward in time, setting the starting point to
 /// the new given starting point, and shifting the forces over by `steps`,
-/// padding the remainder with 0s
+/// padding the remainder with 0s. This returns a mapping from each index in
+/// the new flat problem to the index it was shifted from in the old flat
+/// problem (or -1 for padded values), so that we can warm-start lagrange
+/// multipliers etc.
 Eigen::VectorXi MultiShot::advanceSteps(
     std::shared_ptr<simulation::World> world,
     Eigen::VectorXs startPos,
     Eigen::VectorXs startVel,
     int steps)
 {
-  Eigen::VectorXi mapping = Eigen::VectorXi::Zero(getFlatProblemDim(world));
+  Eigen::VectorXi mapping
+      = Eigen::VectorXi::Constant(getFlatProblemDim(world), -1);
+  int staticDim = getFlatStaticProblemDim(world);
+  for (int i = 0; i < staticDim; i++)
+  {
+    mapping(i) = i;
+  }
 
   RestorableSnapshot snapshot(world);
 
-  const TrajectoryRollout* rollout = getRolloutCache(world);
+  // We need our own copy of the forces, because advancing the individual shots
+  // will dirty the rollout cache
+  Eigen::MatrixXs oldForces = getRolloutCache(world)->getControlForcesConst();
+  int forceDim = oldForces.rows();
+
+  // We shift the forces across the whole trajectory, rather than within each
+  // shot, so that the tail of each shot gets the head of the next shot
+  // instead of zeros. Only the tail of the last shot gets padded.
+  Eigen::MatrixXs newForces = Eigen::MatrixXs::Zero(forceDim, mSteps);
+  if (steps < mSteps)
+  {
+    newForces.block(0, 0, forceDim, mSteps - steps)
+        = oldForces.block(0, steps, forceDim, mSteps - steps);
+  }
+
+  // These are the offsets of the force block for each shot in the flat problem
+  std::vector<int> forceOffsets;
+  int flatCursor = staticDim;
+  for (int i = 0; i < mShots.size(); i++)
+  {
+    int knotDim = mShots[i]->mTuneStartingState ? forceDim * 2 : 0;
+    // Knot points keep their place in the flat problem
+    for (int j = 0; j < knotDim; j++)
+    {
+      mapping(flatCursor + j) = flatCursor + j;
+    }
+    forceOffsets.push_back(flatCursor + knotDim);
+    flatCursor += mShots[i]->getFlatDynamicProblemDim(world);
+  }
 
   int cursor = 0;
   for (int i = 0; i < mShots.size(); i++)
@@ -1099,9 +1269,9 @@ Eigen::VectorXi MultiShot::advanceSteps(
       for (int j = 0; j < steps; j++)
       {
         int t = cursor + j;
-        if (t < rollout->getControlForcesConst().cols())
+        if (t < oldForces.cols())
         {
-          world->setControlForces(rollout->getControlForcesConst().col(t));
+          world->setControlForces(oldForces.col(t));
         }
         else
         {
@@ -1112,11 +1282,34 @@ Eigen::VectorXi MultiShot::advanceSteps(
       mShots[i]->advanceSteps(
           world, world->getPositions(), world->getVelocities(), steps);
     }
+    mShots[i]->setControlForcesRaw(newForces.block(0, cursor, forceDim, len));
+
+    // Record where each shifted force came from, which may be a different shot
+    int oldShot = i;
+    int oldShotStart = cursor;
+    for (int t = 0; t < len; t++)
+    {
+      int oldT = cursor + t + steps;
+      if (oldT >= mSteps)
+        break;
+      while (oldT >= oldShotStart + mShots[oldShot]->getNumSteps())
+      {
+        oldShotStart += mShots[oldShot]->getNumSteps();
+        oldShot++;
+      }
+      for (int j = 0; j < forceDim; j++)
+      {
+        mapping(forceOffsets[i] + t * forceDim + j)
+            = forceOffsets[oldShot] + (oldT - oldShotStart) * forceDim + j;
+      }
+    }
 
     cursor += len;
   }
   snapshot.restore();
 
+  mRolloutCacheDirty = true;
+
   return mapping;
 }
 
@@ -1244,31 +1437,31 @@ void MultiShot::backpropGradientWrt(
   int cursorSteps = 0;
   if (mParallelOperationsEnabled)
   {
-    std::vector<std::future<void>> futures;
     Eigen::VectorXs gradStaticScratch
         = Eigen::VectorXs::Zero(gradStatic.size() * mShots.size());
+    std::vector<int> cursorsSteps;
+    std::vector<int> cursorsDynamicDims;
     for (int i = 0; i < mShots.size(); i++)
     {
-      int steps = mShots[i]->getNumSteps();
-      int dynamicDim = mShots[i]->getFlatDynamicProblemDim(world);
-      futures.push_back(std::async(
-          &MultiShot::asyncPartBackpropGradientWrt,
-          this,
+      cursorsSteps.push_back(cursorSteps);
+      cursorsDynamicDims.push_back(cursorDynamicDims);
+      cursorSteps += mShots[i]->getNumSteps();
+      cursorDynamicDims += mShots[i]->getFlatDynamicProblemDim(world);
+    }
+    mWorkers->run(mShots.size(), [&](int i) {
+      asyncPartBackpropGradientWrt(
           i,
           mParallelWorlds[i],
           gradWrtRollout,
           gradStaticScratch.segment(i * gradStatic.size(), gradStatic.size()),
           gradDynamic,
-          cursorDynamicDims,
-          cursorSteps,
-          thisLog));
-      cursorSteps += steps;
-      cursorDynamicDims += dynamicDim;
-    }
+          cursorsDynamicDims[i],
+          cursorsSteps[i],
+          thisLog);
+    });
     gradStatic.setZero();
-    for (int i = 0; i < futures.size(); i++)
+    for (int i = 0; i < mShots.size(); i++)
     {
-      futures[i].wait();
       gradStatic += gradStaticScratch.segment(
           i * gradStatic.size(), gradStatic.size());
     }
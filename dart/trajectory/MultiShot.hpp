@@ -6,6 +6,7 @@
 
 #include <Eigen/Dense>
 
+#include "dart/common/WorkerPool.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 #include "dart/neural/BackpropSnapshot.hpp"
 #include "dart/neural/NeuralUtils.hpp"
@@ -34,9 +35,17 @@ public:
   /// Destructor
   virtual ~MultiShot() override;
 
+  /// This returns a deep copy of this shot, including all its SingleShots. The
+  /// copy always starts with parallel operations disabled.
+  std::shared_ptr<Problem> clone() const override;
+
   /// If TRUE, this will use multiple independent threads to compute each
   /// SingleShot's values internally. Currently defaults to FALSE. This should
   /// be considered EXPERIMENTAL! Expect bugs.
+  ///
+  /// Enabling this starts one persistent worker thread per shot, each bound to
+  /// its own clone of the World, which live until this is disabled again or
+  /// the MultiShot is destroyed.
   void setParallelOperationsEnabled(bool enabled);
 
   /// This adds a mapping through which the loss function can interpret the
@@ -197,7 +206,10 @@ public:
 
   /// This moves the trajectory forward in time, setting the starting point to
   /// the new given starting point, and shifting the forces over by `steps`,
-  /// padding the remainder with 0s
+  /// padding the remainder with 0s. This returns a mapping from each index in
+  /// the new flat problem to the index it was shifted from in the old flat
+  /// problem (or -1 for padded values), so that we can warm-start lagrange
+  /// multipliers etc.
   Eigen::VectorXi advanceSteps(
       std::shared_ptr<simulation::World> world,
       Eigen::VectorXs startPos,
@@ -269,6 +281,39 @@ public:
       int cursorDynamic,
       PerformanceLog* log = nullptr);
 
+  /// This gets the number of non-zero entries in the lower triangle of the
+  /// Gauss-Newton Hessian. Under Gauss-Newton the shots only interact
+  /// through the knot point constraints, whose second derivatives we drop,
+  /// so this is one dense block per shot down the diagonal.
+  int getNumberNonZeroHessianDynamic(
+      std::shared_ptr<simulation::World> world) override;
+
+  /// This gets the structure of the lower triangle of the Gauss-Newton
+  /// Hessian, shot by shot
+  void getHessianSparsityStructureDynamic(
+      std::shared_ptr<simulation::World> world,
+      Eigen::Ref<Eigen::VectorXi> rows,
+      Eigen::Ref<Eigen::VectorXi> cols,
+      PerformanceLog* log = nullptr) override;
+
+  /// This writes the Gauss-Newton Hessian of the dynamic variables to a
+  /// sparse vector, shot by shot
+  void getSparseGaussNewtonHessianDynamic(
+      std::shared_ptr<simulation::World> world,
+      const TrajectoryRollout* lossCurvature,
+      /* OUT */ Eigen::Ref<Eigen::VectorXs> sparseDynamic,
+      PerformanceLog* log = nullptr) override;
+
+  /// This writes the Gauss-Newton Hessian block for a single shot
+  void asyncPartGetSparseGaussNewtonHessian(
+      int index,
+      std::shared_ptr<simulation::World> world,
+      const TrajectoryRollout* lossCurvature,
+      /* OUT */ Eigen::Ref<Eigen::VectorXs> sparseDynamic,
+      int cursorSparse,
+      int cursorSteps,
+      PerformanceLog* log = nullptr);
+
   /// This returns the snapshots from a fresh unroll
   std::vector<neural::MappedBackpropSnapshotPtr> getSnapshots(
       std::shared_ptr<simulation::World> world,
@@ -281,6 +326,8 @@ public:
 private:
   std::vector<std::shared_ptr<SingleShot>> mShots;
   std::vector<simulation::WorldPtr> mParallelWorlds;
+  /// Worker i always does the work for shot i, on mParallelWorlds[i]
+  std::shared_ptr<common::WorkerPool> mWorkers;
   int mShotLength;
   bool mParallelOperationsEnabled;
 };
@@ -745,6 +745,132 @@ void Problem::getSparseJacobian(
       log);
 }
 
+//==============================================================================
+/// This gets the number of non-zero entries in the lower triangle of the
+/// Gauss-Newton Hessian (see getSparseGaussNewtonHessian())
+int Problem::getNumberNonZeroHessian(std::shared_ptr<simulation::World> world)
+{
+  return getNumberNonZeroHessianDynamic(world);
+}
+
+//==============================================================================
+/// This gets the structure of the lower triangle of the Gauss-Newton
+/// Hessian, so every entry has rows(i) >= cols(i)
+void Problem::getHessianSparsityStructure(
+    std::shared_ptr<simulation::World> world,
+    Eigen::Ref<Eigen::VectorXi> rows,
+    Eigen::Ref<Eigen::VectorXi> cols,
+    PerformanceLog* log)
+{
+  int nnzh = getNumberNonZeroHessianDynamic(world);
+  assert(nnzh == rows.size() && nnzh == cols.size());
+  getHessianSparsityStructureDynamic(world, rows, cols, log);
+  // Bump all the dynamic elements past the static variables
+  int staticDim = getFlatStaticProblemDim(world);
+  rows += Eigen::VectorXi::Ones(nnzh) * staticDim;
+  cols += Eigen::VectorXi::Ones(nnzh) * staticDim;
+}
+
+//==============================================================================
+/// This writes a Gauss-Newton approximation of the Hessian of the loss to a
+/// sparse vector, in the order of getHessianSparsityStructure(). The loss's
+/// curvature with respect to the rollout (see estimateLossCurvature()) is
+/// chained through the Jacobians of each timestep, and the second
+/// derivatives of the dynamics are dropped, so the result is always
+/// positive semi-definite. Entries for the static variables (like masses),
+/// and the second derivatives of the constraints, are left out.
+void Problem::getSparseGaussNewtonHessian(
+    std::shared_ptr<simulation::World> world,
+    /* OUT */ Eigen::Ref<Eigen::VectorXs> sparse,
+    PerformanceLog* log)
+{
+  PerformanceLog* thisLog = nullptr;
+#ifdef LOG_PERFORMANCE_PROBLEM
+  if (log != nullptr)
+  {
+    thisLog = log->startRun("Problem.getSparseGaussNewtonHessian");
+  }
+#endif
+
+  assert(sparse.size() == getNumberNonZeroHessianDynamic(world));
+  TrajectoryRolloutReal curvature = TrajectoryRolloutReal(this);
+  estimateLossCurvature(world, &curvature, thisLog);
+  getSparseGaussNewtonHessianDynamic(world, &curvature, sparse, thisLog);
+
+#ifdef LOG_PERFORMANCE_PROBLEM
+  if (thisLog != nullptr)
+  {
+    thisLog->end();
+  }
+#endif
+}
+
+//==============================================================================
+/// This estimates the diagonal of the Hessian of the loss with respect to
+/// the "identity" poses, velocities and control forces of the rollout, and
+/// writes it into `curvature`. We finite difference the loss gradient along
+/// a perturbation of every entry at once, which is exact for losses that
+/// are a sum of separate terms for each entry (like most sums of squares),
+/// and gives the row sums of the Hessian otherwise. Negative curvature is
+/// clamped to 0.
+void Problem::estimateLossCurvature(
+    std::shared_ptr<simulation::World> world,
+    /* OUT */ TrajectoryRollout* curvature,
+    PerformanceLog* log)
+{
+  const s_t EPS = 1e-3;
+
+  const TrajectoryRollout* rollout = getRolloutCache(world, log);
+  TrajectoryRolloutReal grad = TrajectoryRolloutReal(this);
+  mLoss.getLossAndGradient(rollout, &grad, log);
+
+  TrajectoryRolloutReal perturbed = TrajectoryRolloutReal(rollout);
+  perturbed.getPoses().array() += EPS;
+  perturbed.getVels().array() += EPS;
+  perturbed.getControlForces().array() += EPS;
+  TrajectoryRolloutReal perturbedGrad = TrajectoryRolloutReal(this);
+  mLoss.getLossAndGradient(&perturbed, &perturbedGrad, log);
+
+  curvature->getPoses()
+      = ((perturbedGrad.getPoses() - grad.getPoses()) / EPS).cwiseMax(0);
+  curvature->getVels()
+      = ((perturbedGrad.getVels() - grad.getVels()) / EPS).cwiseMax(0);
+  curvature->getControlForces()
+      = ((perturbedGrad.getControlForces() - grad.getControlForces()) / EPS)
+            .cwiseMax(0);
+}
+
+//==============================================================================
+/// This gets the number of non-zero entries in the lower triangle of the
+/// Gauss-Newton Hessian, which only covers the dynamic variables
+int Problem::getNumberNonZeroHessianDynamic(
+    std::shared_ptr<simulation::World> /* world */)
+{
+  return 0;
+}
+
+//==============================================================================
+/// This gets the structure of the lower triangle of the Gauss-Newton
+/// Hessian, indexed from the start of the dynamic variables
+void Problem::getHessianSparsityStructureDynamic(
+    std::shared_ptr<simulation::World> /* world */,
+    Eigen::Ref<Eigen::VectorXi> /* rows */,
+    Eigen::Ref<Eigen::VectorXi> /* cols */,
+    PerformanceLog* /* log */)
+{
+}
+
+//==============================================================================
+/// This writes the Gauss-Newton Hessian of the dynamic variables to a
+/// sparse vector, given the output of estimateLossCurvature()
+void Problem::getSparseGaussNewtonHessianDynamic(
+    std::shared_ptr<simulation::World> /* world */,
+    const TrajectoryRollout* /* lossCurvature */,
+    /* OUT */ Eigen::Ref<Eigen::VectorXs> /* sparseDynamic */,
+    PerformanceLog* /* log */)
+{
+}
+
 //==============================================================================
 /// This computes the gradient in the flat problem space, automatically
 /// computing the gradients of the loss function as part of the call
@@ -30,6 +30,7 @@ class Problem
 public:
   friend class IPOptShotWrapper;
   friend class SGDOptimizer;
+  friend class LineSearchOptimizer;
 
   /// Default constructor
   Problem(std::shared_ptr<simulation::World> world, LossFn loss, int steps);
@@ -37,6 +38,11 @@ public:
   /// Abstract destructor
   virtual ~Problem();
 
+  /// This returns a deep copy of this problem, which can be unflattened and
+  /// rolled out independently of this one, on a different World. The loss,
+  /// constraints and mappings are shared with the original.
+  virtual std::shared_ptr<Problem> clone() const = 0;
+
   /// This prevents a force from changing in optimization, keeping it fixed at a
   /// specified value.
   virtual void pinForce(int time, Eigen::VectorXs value) = 0;
@@ -210,7 +216,10 @@ public:
 
   /// This moves the trajectory forward in time, setting the starting point to
   /// the new given starting point, and shifting the forces over by `steps`,
-  /// padding the remainder with 0s
+  /// padding the remainder with 0s. This returns a mapping from each index in
+  /// the new flat problem to the index it was shifted from in the old flat
+  /// problem (or -1 for padded values), so that we can warm-start lagrange
+  /// multipliers etc.
   virtual Eigen::VectorXi advanceSteps(
       std::shared_ptr<simulation::World> world,
       Eigen::VectorXs startPos,
@@ -292,6 +301,42 @@ public:
       Eigen::Ref<Eigen::VectorXs> sparse,
       PerformanceLog* log = nullptr);
 
+  /// This gets the number of non-zero entries in the lower triangle of the
+  /// Gauss-Newton Hessian (see getSparseGaussNewtonHessian())
+  int getNumberNonZeroHessian(std::shared_ptr<simulation::World> world);
+
+  /// This gets the structure of the lower triangle of the Gauss-Newton
+  /// Hessian, so every entry has rows(i) >= cols(i)
+  void getHessianSparsityStructure(
+      std::shared_ptr<simulation::World> world,
+      Eigen::Ref<Eigen::VectorXi> rows,
+      Eigen::Ref<Eigen::VectorXi> cols,
+      PerformanceLog* log = nullptr);
+
+  /// This writes a Gauss-Newton approximation of the Hessian of the loss to a
+  /// sparse vector, in the order of getHessianSparsityStructure(). The loss's
+  /// curvature with respect to the rollout (see estimateLossCurvature()) is
+  /// chained through the Jacobians of each timestep, and the second
+  /// derivatives of the dynamics are dropped, so the result is always
+  /// positive semi-definite. Entries for the static variables (like masses),
+  /// and the second derivatives of the constraints, are left out.
+  void getSparseGaussNewtonHessian(
+      std::shared_ptr<simulation::World> world,
+      /* OUT */ Eigen::Ref<Eigen::VectorXs> sparse,
+      PerformanceLog* log = nullptr);
+
+  /// This estimates the diagonal of the Hessian of the loss with respect to
+  /// the "identity" poses, velocities and control forces of the rollout, and
+  /// writes it into `curvature`. We finite difference the loss gradient along
+  /// a perturbation of every entry at once, which is exact for losses that
+  /// are a sum of separate terms for each entry (like most sums of squares),
+  /// and gives the row sums of the Hessian otherwise. Negative curvature is
+  /// clamped to 0.
+  void estimateLossCurvature(
+      std::shared_ptr<simulation::World> world,
+      /* OUT */ TrajectoryRollout* curvature,
+      PerformanceLog* log = nullptr);
+
   /// This returns the snapshots from a fresh unroll
   virtual std::vector<neural::MappedBackpropSnapshotPtr> getSnapshots(
       std::shared_ptr<simulation::World> world, PerformanceLog* log = nullptr)
@@ -439,6 +484,27 @@ protected:
       PerformanceLog* log = nullptr)
       = 0;
 
+  /// This gets the number of non-zero entries in the lower triangle of the
+  /// Gauss-Newton Hessian, which only covers the dynamic variables
+  virtual int getNumberNonZeroHessianDynamic(
+      std::shared_ptr<simulation::World> world);
+
+  /// This gets the structure of the lower triangle of the Gauss-Newton
+  /// Hessian, indexed from the start of the dynamic variables
+  virtual void getHessianSparsityStructureDynamic(
+      std::shared_ptr<simulation::World> world,
+      Eigen::Ref<Eigen::VectorXi> rows,
+      Eigen::Ref<Eigen::VectorXi> cols,
+      PerformanceLog* log = nullptr);
+
+  /// This writes the Gauss-Newton Hessian of the dynamic variables to a
+  /// sparse vector, given the output of estimateLossCurvature()
+  virtual void getSparseGaussNewtonHessianDynamic(
+      std::shared_ptr<simulation::World> world,
+      const TrajectoryRollout* lossCurvature,
+      /* OUT */ Eigen::Ref<Eigen::VectorXs> sparseDynamic,
+      PerformanceLog* log = nullptr);
+
 protected:
   std::shared_ptr<simulation::World> mWorld;
   LossFn mLoss;
@@ -48,6 +48,20 @@ SingleShot::~SingleShot()
   // std::cout << "Freeing SingleShot: " << this << std::endl;
 }
 
+//==============================================================================
+/// This returns a deep copy of this shot
+std::shared_ptr<Problem> SingleShot::clone() const
+{
+  std::shared_ptr<SingleShot> copy = std::make_shared<SingleShot>(*this);
+  // Don't share the rollout caches, since those get written to in place
+  copy->mRolloutCacheDirty = true;
+  copy->mRolloutCache = nullptr;
+  copy->mGradWrtRolloutCache = nullptr;
+  copy->mSnapshotsCacheDirty = true;
+  copy->mSnapshotsCache.clear();
+  return copy;
+}
+
 //==============================================================================
 /// This prevents a force from changing in optimization, keeping it fixed at a
 /// specified value.
@@ -483,6 +497,143 @@ void SingleShot::backpropJacobianOfFinalState(
 #endif
 }
 
+//==============================================================================
+/// This gets the number of non-zero entries in the lower triangle of the
+/// Gauss-Newton Hessian. Every variable of a shot affects the states after
+/// it, so the block for a single shot is dense.
+int SingleShot::getNumberNonZeroHessianDynamic(
+    std::shared_ptr<simulation::World> world)
+{
+  int dim = getFlatDynamicProblemDim(world);
+  return dim * (dim + 1) / 2;
+}
+
+//==============================================================================
+/// This gets the structure of the lower triangle of the Gauss-Newton
+/// Hessian, in column-major order
+void SingleShot::getHessianSparsityStructureDynamic(
+    std::shared_ptr<simulation::World> world,
+    Eigen::Ref<Eigen::VectorXi> rows,
+    Eigen::Ref<Eigen::VectorXi> cols,
+    PerformanceLog* /* log */)
+{
+  int dim = getFlatDynamicProblemDim(world);
+  int cursor = 0;
+  for (int col = 0; col < dim; col++)
+  {
+    for (int row = col; row < dim; row++)
+    {
+      rows(cursor) = row;
+      cols(cursor) = col;
+      cursor++;
+    }
+  }
+  assert(cursor == rows.size());
+}
+
+//==============================================================================
+/// This writes the Gauss-Newton Hessian of the dynamic variables to a
+/// sparse vector. This runs the Jacobians of each timestep forward, to get
+/// the Jacobian of every state in the shot with respect to the shot's
+/// variables, and sums up J^T * diag(lossCurvature) * J.
+void SingleShot::getSparseGaussNewtonHessianDynamic(
+    std::shared_ptr<simulation::World> world,
+    const TrajectoryRollout* lossCurvature,
+    /* OUT */ Eigen::Ref<Eigen::VectorXs> sparseDynamic,
+    PerformanceLog* log)
+{
+  PerformanceLog* thisLog = nullptr;
+#ifdef LOG_PERFORMANCE_SINGLE_SHOT
+  if (log != nullptr)
+  {
+    thisLog = log->startRun("SingleShot.getSparseGaussNewtonHessianDynamic");
+  }
+#endif
+
+  std::vector<MappedBackpropSnapshotPtr> snapshots
+      = getSnapshots(world, thisLog);
+
+  int dofs = world->getNumDofs();
+  int dim = getFlatDynamicProblemDim(world);
+  Eigen::MatrixXs hessian = Eigen::MatrixXs::Zero(dim, dim);
+
+  // These are the Jacobians of the current state wrt the shot's variables.
+  // Only the variables before `cursor` have had a chance to affect the state
+  // yet, so the columns after that stay zero.
+  Eigen::MatrixXs posJac = Eigen::MatrixXs::Zero(dofs, dim);
+  Eigen::MatrixXs velJac = Eigen::MatrixXs::Zero(dofs, dim);
+  int cursor = 0;
+  if (mTuneStartingState)
+  {
+    posJac.block(0, 0, dofs, dofs) = Eigen::MatrixXs::Identity(dofs, dofs);
+    velJac.block(0, dofs, dofs, dofs) = Eigen::MatrixXs::Identity(dofs, dofs);
+    cursor += 2 * dofs;
+  }
+
+  RestorableSnapshot restoreSnapshot(world);
+
+  for (int i = 0; i < mSteps; i++)
+  {
+    MappedBackpropSnapshotPtr ptr = snapshots[i];
+
+    world->setPositions(ptr->getPreStepPosition());
+    world->setVelocities(ptr->getPreStepVelocity());
+    world->setControlForces(ptr->getPreStepTorques());
+    world->setCachedLCPSolution(ptr->getPreStepLCPCache());
+
+    const Eigen::MatrixXs& forceVel
+        = ptr->getControlForceVelJacobian(world, thisLog);
+    const Eigen::MatrixXs& posPos = ptr->getPosPosJacobian(world, thisLog);
+    const Eigen::MatrixXs& posVel = ptr->getPosVelJacobian(world, thisLog);
+    const Eigen::MatrixXs& velPos = ptr->getVelPosJacobian(world, thisLog);
+    const Eigen::MatrixXs& velVel = ptr->getVelVelJacobian(world, thisLog);
+
+    // p_t+1 <- x = (p_t+1 <- p_t * p_t <- x) + (p_t+1 <- v_t * v_t <- x)
+    Eigen::MatrixXs nextPosJac = posPos * posJac.leftCols(cursor)
+                                 + velPos * velJac.leftCols(cursor);
+    // v_t+1 <- x = (v_t+1 <- p_t * p_t <- x) + (v_t+1 <- v_t * v_t <- x)
+    Eigen::MatrixXs nextVelJac = posVel * posJac.leftCols(cursor)
+                                 + velVel * velJac.leftCols(cursor);
+    posJac.leftCols(cursor) = nextPosJac;
+    velJac.leftCols(cursor) = nextVelJac;
+    // The force at this timestep only reaches the state through v_t+1
+    velJac.block(0, cursor, dofs, dofs) = forceVel;
+
+    // The loss also sees the force directly
+    hessian.block(cursor, cursor, dofs, dofs).diagonal()
+        += lossCurvature->getControlForcesConst().col(i);
+    cursor += dofs;
+
+    hessian.topLeftCorner(cursor, cursor).noalias()
+        += posJac.leftCols(cursor).transpose()
+           * lossCurvature->getPosesConst().col(i).asDiagonal()
+           * posJac.leftCols(cursor);
+    hessian.topLeftCorner(cursor, cursor).noalias()
+        += velJac.leftCols(cursor).transpose()
+           * lossCurvature->getVelsConst().col(i).asDiagonal()
+           * velJac.leftCols(cursor);
+  }
+  assert(cursor == dim);
+
+  restoreSnapshot.restore();
+
+  int sparseCursor = 0;
+  for (int col = 0; col < dim; col++)
+  {
+    sparseDynamic.segment(sparseCursor, dim - col)
+        = hessian.col(col).tail(dim - col);
+    sparseCursor += dim - col;
+  }
+  assert(sparseCursor == sparseDynamic.size());
+
+#ifdef LOG_PERFORMANCE_SINGLE_SHOT
+  if (thisLog != nullptr)
+  {
+    thisLog->end();
+  }
+#endif
+}
+
 //==============================================================================
 /// This computes finite difference Jacobians analagous to backpropJacobians()
 void SingleShot::finiteDifferenceJacobianOfFinalState(
@@ -788,26 +939,60 @@ void SingleShot::setControlForcesRaw(
 //==============================================================================
 /// This moves the trajectory forward in time, setting the starting point to
 /// the new given starting point, and shifting the forces over by `steps`,
-/// padding the remainder with 0s
+/// padding the remainder with 0s. This returns a mapping from each index in
+/// the new flat problem to the index it was shifted from in the old flat
+/// problem (or -1 for padded values), so that we can warm-start lagrange
+/// multipliers etc.
 Eigen::VectorXi SingleShot::advanceSteps(
     std::shared_ptr<simulation::World> world,
     Eigen::VectorXs startPos,
     Eigen::VectorXs startVel,
     int steps)
 {
-  Eigen::VectorXi mapping = Eigen::VectorXi::Zero(getFlatProblemDim(world));
+  // mapping(i) is the index in the old flat problem that the new index i was
+  // shifted from, or -1 if index i holds a freshly padded value.
+  Eigen::VectorXi mapping
+      = Eigen::VectorXi::Constant(getFlatProblemDim(world), -1);
+
+  int staticDim = getFlatStaticProblemDim(world);
+  for (int i = 0; i < staticDim; i++)
+  {
+    mapping(i) = i;
+  }
+  int cursor = staticDim;
+  if (mTuneStartingState)
+  {
+    // The knot point is still the same variable, it's just been moved forward
+    for (int i = 0; i < mWorld->getNumDofs() * 2; i++)
+    {
+      mapping(cursor + i) = cursor + i;
+    }
+    cursor += mWorld->getNumDofs() * 2;
+  }
 
   mStartPos = startPos;
   mStartVel = startVel;
 
-  Eigen::MatrixXs newForces = Eigen::MatrixXs::Zero(mForces.rows(), mSteps);
+  int forceDim = mForces.rows();
+  Eigen::MatrixXs newForces = Eigen::MatrixXs::Zero(forceDim, mSteps);
   if (steps < mSteps)
   {
-    newForces.block(0, 0, mForces.rows(), mSteps - steps)
-        = mForces.block(0, steps, mForces.rows(), mSteps - steps);
+    newForces.block(0, 0, forceDim, mSteps - steps)
+        = mForces.block(0, steps, forceDim, mSteps - steps);
+    for (int t = 0; t < mSteps - steps; t++)
+    {
+      for (int j = 0; j < forceDim; j++)
+      {
+        mapping(cursor + t * forceDim + j)
+            = cursor + (t + steps) * forceDim + j;
+      }
+    }
   }
   mForces = newForces;
 
+  mRolloutCacheDirty = true;
+  mSnapshotsCacheDirty = true;
+
   return mapping;
 }
 
@@ -35,6 +35,9 @@ public:
   /// Destructor
   virtual ~SingleShot() override;
 
+  /// This returns a deep copy of this shot
+  std::shared_ptr<Problem> clone() const override;
+
   /// This prevents a force from changing in optimization, keeping it fixed at a
   /// specified value.
   void pinForce(int time, Eigen::VectorXs value) override;
@@ -102,6 +105,30 @@ public:
       /* OUT */ Eigen::Ref<Eigen::MatrixXs> jacDynamic,
       PerformanceLog* log = nullptr);
 
+  /// This gets the number of non-zero entries in the lower triangle of the
+  /// Gauss-Newton Hessian. Every variable of a shot affects the states after
+  /// it, so the block for a single shot is dense.
+  int getNumberNonZeroHessianDynamic(
+      std::shared_ptr<simulation::World> world) override;
+
+  /// This gets the structure of the lower triangle of the Gauss-Newton
+  /// Hessian, in column-major order
+  void getHessianSparsityStructureDynamic(
+      std::shared_ptr<simulation::World> world,
+      Eigen::Ref<Eigen::VectorXi> rows,
+      Eigen::Ref<Eigen::VectorXi> cols,
+      PerformanceLog* log = nullptr) override;
+
+  /// This writes the Gauss-Newton Hessian of the dynamic variables to a
+  /// sparse vector. This runs the Jacobians of each timestep forward, to get
+  /// the Jacobian of every state in the shot with respect to the shot's
+  /// variables, and sums up J^T * diag(lossCurvature) * J.
+  void getSparseGaussNewtonHessianDynamic(
+      std::shared_ptr<simulation::World> world,
+      const TrajectoryRollout* lossCurvature,
+      /* OUT */ Eigen::Ref<Eigen::VectorXs> sparseDynamic,
+      PerformanceLog* log = nullptr) override;
+
   /// This computes the gradient in the flat problem space, taking into accounts
   /// incoming gradients with respect to any of the shot's values.
   void backpropGradientWrt(
@@ -135,7 +162,10 @@ public:
 
   /// This moves the trajectory forward in time, setting the starting point to
   /// the new given starting point, and shifting the forces over by `steps`,
-  /// padding the remainder with 0s
+  /// padding the remainder with 0s. This returns a mapping from each index in
+  /// the new flat problem to the index it was shifted from in the old flat
+  /// problem (or -1 for padded values), so that we can warm-start lagrange
+  /// multipliers etc.
   Eigen::VectorXi advanceSteps(
       std::shared_ptr<simulation::World> world,
       Eigen::VectorXs startPos,
@@ -19,7 +19,7 @@ namespace dart {
 namespace trajectory {
 
 //==============================================================================
-Solution::Solution() : mSuccess(false), mPerfLog(nullptr)
+Solution::Solution() : mSuccess(false), mIterationCount(-1), mPerfLog(nullptr)
 {
 }
 
@@ -89,29 +89,62 @@ void Solution::registerForReoptimization(
 }
 
 //==============================================================================
-/// This will attempt to run another round of optimization.
-void Solution::reoptimize()
+/// This will attempt to run another round of optimization. If `mapping` is
+/// non-empty, it is interpreted as the index mapping returned by
+/// Problem::advanceSteps(), and IPOPT gets warm-started from the
+/// (time-shifted) dual variables of the previous solve, in addition to the
+/// primal variables, which are always reused.
+void Solution::reoptimize(const Eigen::VectorXi& mapping)
 {
-  std::string oldWarmStart;
   mIpoptProblem->prep_for_reoptimize();
-  // mIpopt->Options()->GetStringValue("warm_start_init_point", oldWarmStart,
-  // ""); mIpopt->Options()->SetStringValue("warm_start_init_point", "yes");
+
+  if (mapping.size() > 0 && mIpoptProblem->has_saved_multipliers())
+  {
+    mIpoptProblem->remap_saved_multipliers(mapping);
+    mIpopt->Options()->SetStringValue("warm_start_init_point", "yes");
+    // We start close to the old solution, so we don't want IPOPT to push us
+    // far into the interior, or to start with a large barrier parameter.
+    mIpopt->Options()->SetNumericValue("warm_start_bound_push", 1e-6);
+    mIpopt->Options()->SetNumericValue("warm_start_mult_bound_push", 1e-6);
+    mIpopt->Options()->SetNumericValue("mu_init", 1e-4);
+  }
+  else
+  {
+    // Undo anything a previous warm start set, back to IPOPT's defaults
+    mIpopt->Options()->SetStringValue("warm_start_init_point", "no");
+    mIpopt->Options()->SetNumericValue("warm_start_bound_push", 1e-3);
+    mIpopt->Options()->SetNumericValue("warm_start_mult_bound_push", 1e-3);
+    mIpopt->Options()->SetNumericValue("mu_init", 0.1);
+  }
+
   ApplicationReturnStatus status = mIpopt->ReOptimizeTNLP(mIpoptProblem);
-  // mIpopt->Options()->SetStringValue("warm_start_init_point", oldWarmStart);
 
-  if (status == Solve_Succeeded)
+  if (IsValid(mIpopt->Statistics()))
   {
-    // Retrieve some statistics about the solve
-    /*
-    Index iter_count = mIpopt->Statistics()->IterationCount();
-    Number final_obj = mIpopt->Statistics()->FinalObjective();
-    */
+    this->setIterationCount(mIpopt->Statistics()->IterationCount());
   }
 
   this->setSuccess(status == Ipopt::Solve_Succeeded);
   this->registerForReoptimization(mIpopt, mIpoptProblem);
 }
 
+//==============================================================================
+/// This records the number of iterations the optimizer took to produce this
+/// solution. For a reoptimized solution, this is the count for the most
+/// recent round of optimization.
+void Solution::setIterationCount(int iterationCount)
+{
+  mIterationCount = iterationCount;
+}
+
+//==============================================================================
+/// This returns the number of iterations the most recent round of
+/// optimization took, or -1 if the optimizer didn't report one.
+int Solution::getIterationCount()
+{
+  return mIterationCount;
+}
+
 //==============================================================================
 void Solution::setSuccess(bool success)
 {
@@ -122,11 +122,25 @@ public:
       SmartPtr<Ipopt::IpoptApplication> ipopt,
       SmartPtr<trajectory::IPOptShotWrapper> ipoptProblem);
 
-  /// This will attempt to run another round of optimization.
-  void reoptimize();
+  /// This will attempt to run another round of optimization. If `mapping` is
+  /// non-empty, it is interpreted as the index mapping returned by
+  /// Problem::advanceSteps(), and IPOPT gets warm-started from the
+  /// (time-shifted) dual variables of the previous solve, in addition to the
+  /// primal variables, which are always reused.
+  void reoptimize(const Eigen::VectorXi& mapping = Eigen::VectorXi::Zero(0));
+
+  /// This records the number of iterations the optimizer took to produce this
+  /// solution. For a reoptimized solution, this is the count for the most
+  /// recent round of optimization.
+  void setIterationCount(int iterationCount);
+
+  /// This returns the number of iterations the most recent round of
+  /// optimization took, or -1 if the optimizer didn't report one.
+  int getIterationCount();
 
 protected:
   bool mSuccess;
+  int mIterationCount;
   std::vector<OptimizationStep> mSteps;
   performance::PerformanceLog* mPerfLog;
   std::vector<Eigen::VectorXs> mXs;
@@ -597,5 +597,94 @@ void TrajectoryRolloutConstRef::setMetadata(
   assert(false && "It should be impossible to get a mutable reference from a TrajectorRolloutConstRef");
 }
 
+//==============================================================================
+TrajectoryRolloutBatch::TrajectoryRolloutBatch(
+    const std::unordered_map<std::string, std::shared_ptr<neural::Mapping>>
+        mappings,
+    int steps,
+    int massDim,
+    int numCandidates,
+    const std::unordered_map<std::string, Eigen::MatrixXs> metadata)
+  : mSteps(steps),
+    mNumCandidates(numCandidates),
+    mAll(mappings, steps * numCandidates, massDim, metadata)
+{
+}
+
+//==============================================================================
+/// Create a fresh batch of rollouts for a shot
+TrajectoryRolloutBatch::TrajectoryRolloutBatch(
+    Problem* shot, int numCandidates)
+  : TrajectoryRolloutBatch(
+      shot->getMappings(),
+      shot->getNumSteps(),
+      shot->getMassDims(),
+      numCandidates,
+      shot->getMetadataMap())
+{
+}
+
+//==============================================================================
+int TrajectoryRolloutBatch::getNumCandidates() const
+{
+  return mNumCandidates;
+}
+
+//==============================================================================
+int TrajectoryRolloutBatch::getNumSteps() const
+{
+  return mSteps;
+}
+
+//==============================================================================
+/// This returns a view of a single candidate, without copying it
+TrajectoryRolloutRef TrajectoryRolloutBatch::getCandidate(int i)
+{
+  assert(i >= 0 && i < mNumCandidates);
+  return mAll.slice(i * mSteps, mSteps);
+}
+
+//==============================================================================
+/// This returns a view of a single candidate, without copying it
+const TrajectoryRolloutConstRef TrajectoryRolloutBatch::getCandidateConst(
+    int i) const
+{
+  assert(i >= 0 && i < mNumCandidates);
+  return mAll.sliceConst(i * mSteps, mSteps);
+}
+
+//==============================================================================
+/// This copies the poses, velocities and control forces of `rollout` into
+/// candidate `i`
+void TrajectoryRolloutBatch::setCandidate(
+    int i, const TrajectoryRollout* rollout)
+{
+  assert(i >= 0 && i < mNumCandidates);
+  for (const std::string& key : mAll.getMappings())
+  {
+    assert(rollout->getPosesConst(key).cols() == mSteps);
+    mAll.getPoses(key).middleCols(i * mSteps, mSteps)
+        = rollout->getPosesConst(key);
+    mAll.getVels(key).middleCols(i * mSteps, mSteps)
+        = rollout->getVelsConst(key);
+    mAll.getControlForces(key).middleCols(i * mSteps, mSteps)
+        = rollout->getControlForcesConst(key);
+  }
+}
+
+//==============================================================================
+/// This returns every candidate, back to back
+TrajectoryRollout* TrajectoryRolloutBatch::getAll()
+{
+  return &mAll;
+}
+
+//==============================================================================
+/// This returns every candidate, back to back
+const TrajectoryRollout* TrajectoryRolloutBatch::getAllConst() const
+{
+  return &mAll;
+}
+
 } // namespace trajectory
 } // namespace dart
\ No newline at end of file
@@ -216,6 +216,51 @@ protected:
   int mLen;
 };
 
+/// This holds a batch of candidate rollouts of the same length, so a loss
+/// can be evaluated over all of them at once (see LossFn::getLossBatch()).
+/// The candidates are stored back to back, in one contiguous matrix per
+/// mapping: timestep t of candidate i is column (i * steps + t) of
+/// getAll(). The candidates share their masses and metadata.
+class TrajectoryRolloutBatch
+{
+public:
+  TrajectoryRolloutBatch(
+      const std::unordered_map<std::string, std::shared_ptr<neural::Mapping>>
+          mappings,
+      int steps,
+      int massDim,
+      int numCandidates,
+      const std::unordered_map<std::string, Eigen::MatrixXs> metadata);
+
+  /// Create a fresh batch of rollouts for a shot
+  TrajectoryRolloutBatch(Problem* shot, int numCandidates);
+
+  int getNumCandidates() const;
+
+  int getNumSteps() const;
+
+  /// This returns a view of a single candidate, without copying it
+  TrajectoryRolloutRef getCandidate(int i);
+
+  /// This returns a view of a single candidate, without copying it
+  const TrajectoryRolloutConstRef getCandidateConst(int i) const;
+
+  /// This copies the poses, velocities and control forces of `rollout` into
+  /// candidate `i`
+  void setCandidate(int i, const TrajectoryRollout* rollout);
+
+  /// This returns every candidate, back to back
+  TrajectoryRollout* getAll();
+
+  /// This returns every candidate, back to back
+  const TrajectoryRollout* getAllConst() const;
+
+protected:
+  int mSteps;
+  int mNumCandidates;
+  TrajectoryRolloutReal mAll;
+};
+
 } // namespace trajectory
 } // namespace dart
 
@@ -24,12 +24,14 @@ AccelerationSmoother::AccelerationSmoother(
     s_t smoothingWeight,
     s_t regularizationWeight,
     bool useSparse,
-    bool useIterativeSolver)
+    bool useIterativeSolver,
+    bool useBandedSolver)
   : mTimesteps(timesteps),
     mSmoothingWeight(smoothingWeight),
     mRegularizationWeight(regularizationWeight),
     mUseSparse(useSparse),
     mUseIterativeSolver(useIterativeSolver),
+    mUseBandedSolver(useBandedSolver),
     mIterations(10000)
 {
   Eigen::Vector4s stamp;
@@ -37,7 +39,14 @@ AccelerationSmoother::AccelerationSmoother(
   stamp *= mSmoothingWeight;
   mSmoothedTimesteps = max(0, mTimesteps - 3);
 
-  if (useSparse)
+  if (mUseBandedSolver)
+  {
+    // The normal equations of the least squares problem are the same banded
+    // system for every row of the series, so we only need to factor them once
+    mBandedFactor
+        = math::BandedCholesky::factorSmoothingSystem(stamp, mTimesteps);
+  }
+  else if (useSparse)
   {
     typedef Eigen::Triplet<s_t> T;
     std::vector<T> tripletList;
@@ -98,6 +107,25 @@ Eigen::MatrixXs AccelerationSmoother::smooth(Eigen::MatrixXs series)
 {
   assert(series.cols() == mTimesteps);
 
+  if (mUseBandedSolver)
+  {
+    // Minimizing |B * x - c|^2 has the normal equations
+    // (I + D^T * D) * x = regularizationWeight * series, and we then scale x
+    // back down by the regularization weight, so that weight cancels out and
+    // all the rows can be solved against the same factor in one block.
+    Eigen::MatrixXs smoothed = series;
+    mBandedFactor->solveRowsInPlace(smoothed);
+    for (int row = 0; row < series.rows(); row++)
+    {
+      // Keep locked joints exactly constant, like the row-by-row solvers do
+      if (series.row(row).maxCoeff() == series.row(row).minCoeff())
+      {
+        smoothed.row(row) = series.row(row);
+      }
+    }
+    return smoothed;
+  }
+
   Eigen::MatrixXs smoothed = Eigen::MatrixXs::Zero(series.rows(), mTimesteps);
 
   for (int row = 0; row < series.rows(); row++)
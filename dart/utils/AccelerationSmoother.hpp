@@ -1,9 +1,12 @@
 #ifndef UTILS_PATH_SMOOTHER
 #define UTILS_PATH_SMOOTHER
 
+#include <memory>
+
 #include <Eigen/Sparse>
 #include <Eigen/SparseQR>
 
+#include "dart/math/BandedCholesky.hpp"
 #include "dart/math/MathTypes.hpp"
 
 namespace dart {
@@ -15,13 +18,20 @@ public:
   /**
    * Create (and pre-factor) a smoother that can remove the "jerk" from a time
    * seriese of data.
+   *
+   * By default this uses a banded Cholesky factorization of the normal
+   * equations, which is shared between smoothers with the same length and
+   * weights and smooths every row of the series in one pass. Setting
+   * `useBandedSolver` to false falls back to the sparse/dense and iterative
+   * least squares solvers selected by `useSparse` and `useIterativeSolver`.
    */
   AccelerationSmoother(
       int timesteps,
       s_t smoothingWeight,
       s_t regularizationWeight,
       bool useSparse = true,
-      bool useIterativeSolver = true);
+      bool useIterativeSolver = true,
+      bool useBandedSolver = true);
 
   /**
    * Adjust a time series of points to minimize the jerk (d/dt of acceleration)
@@ -66,6 +76,7 @@ private:
   s_t mRegularizationWeight;
   bool mUseSparse;
   bool mUseIterativeSolver;
+  bool mUseBandedSolver;
   int mIterations;
   Eigen::MatrixXs mB;
   Eigen::HouseholderQR<Eigen::MatrixXs> mFactoredB;
@@ -73,6 +84,8 @@ private:
   Eigen::SparseMatrix<s_t> mB_sparse;
   Eigen::SparseQR<Eigen::SparseMatrix<s_t>, Eigen::NaturalOrdering<int>>
       mB_sparseSolver;
+
+  std::shared_ptr<const math::BandedCholesky> mBandedFactor;
 };
 
 } // namespace utils
@@ -21,19 +21,27 @@ VelocityMinimizingSmoother::VelocityMinimizingSmoother(
     s_t smoothingWeight,
     s_t regularizationWeight,
     bool useSparse,
-    bool useIterativeSolver)
+    bool useIterativeSolver,
+    bool useBandedSolver)
   : mTimesteps(timesteps),
     mSmoothingWeight(smoothingWeight),
     mRegularizationWeight(regularizationWeight),
     mUseSparse(useSparse),
-    mUseIterativeSolver(useIterativeSolver)
+    mUseIterativeSolver(useIterativeSolver),
+    mUseBandedSolver(useBandedSolver)
 {
   Eigen::Vector2s stamp;
   stamp << -1, 1;
   stamp *= mSmoothingWeight;
   mSmoothedTimesteps = max(0, mTimesteps - 1);
 
-  if (useSparse)
+  if (mUseBandedSolver)
+  {
+    // This is a tridiagonal system shared by every row of the series
+    mBandedFactor
+        = math::BandedCholesky::factorSmoothingSystem(stamp, mTimesteps);
+  }
+  else if (useSparse)
   {
     typedef Eigen::Triplet<s_t> T;
     std::vector<T> tripletList;
@@ -94,6 +102,15 @@ Eigen::MatrixXs VelocityMinimizingSmoother::smooth(Eigen::MatrixXs series)
 {
   assert(series.cols() == mTimesteps);
 
+  if (mUseBandedSolver)
+  {
+    // Same as AccelerationSmoother, the regularization weight cancels out of
+    // the normal equations, so every row is solved against one factor
+    Eigen::MatrixXs smoothed = series;
+    mBandedFactor->solveRowsInPlace(smoothed);
+    return smoothed;
+  }
+
   Eigen::MatrixXs smoothed = Eigen::MatrixXs::Zero(series.rows(), mTimesteps);
 
   for (int row = 0; row < series.rows(); row++)
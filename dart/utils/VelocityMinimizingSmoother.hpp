@@ -1,9 +1,12 @@
 #ifndef UTILS_VEL_MINIMIZING_SMOOTHER
 #define UTILS_VEL_MINIMIZING_SMOOTHER
 
+#include <memory>
+
 #include <Eigen/Sparse>
 #include <Eigen/SparseQR>
 
+#include "dart/math/BandedCholesky.hpp"
 #include "dart/math/MathTypes.hpp"
 
 namespace dart {
@@ -15,13 +18,20 @@ public:
   /**
    * Create (and pre-factor) a smoother that can remove the "jerk" from a time
    * seriese of data.
+   *
+   * By default this uses a banded Cholesky factorization of the normal
+   * equations, which is shared between smoothers with the same length and
+   * weights and smooths every row of the series in one pass. Setting
+   * `useBandedSolver` to false falls back to the sparse/dense and iterative
+   * least squares solvers selected by `useSparse` and `useIterativeSolver`.
    */
   VelocityMinimizingSmoother(
       int timesteps,
       s_t smoothingWeight,
       s_t regularizationWeight,
       bool useSparse = true,
-      bool useIterativeSolver = true);
+      bool useIterativeSolver = true,
+      bool useBandedSolver = true);
 
   /**
    * Adjust a time series of points to minimize the jerk (d/dt of acceleration)
@@ -57,12 +67,15 @@ private:
   s_t mRegularizationWeight;
   bool mUseSparse;
   bool mUseIterativeSolver;
+  bool mUseBandedSolver;
   Eigen::MatrixXs mB;
   Eigen::HouseholderQR<Eigen::MatrixXs> mFactoredB;
 
   Eigen::SparseMatrix<s_t> mB_sparse;
   Eigen::SparseQR<Eigen::SparseMatrix<s_t>, Eigen::NaturalOrdering<int>>
       mB_sparseSolver;
+
+  std::shared_ptr<const math::BandedCholesky> mBandedFactor;
 };
 
 } // namespace utils
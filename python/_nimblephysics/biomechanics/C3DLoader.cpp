@@ -51,6 +51,12 @@ void C3DLoader(py::module& m)
       .def_readwrite("markers", &dart::biomechanics::C3D::markers)
       .def_readwrite(
           "markerTimesteps", &dart::biomechanics::C3D::markerTimesteps)
+      .def_readwrite(
+          "markerPositions", &dart::biomechanics::C3D::markerPositions)
+      .def_readwrite(
+          "markerObserved", &dart::biomechanics::C3D::markerObserved)
+      .def_readwrite(
+          "markerIndices", &dart::biomechanics::C3D::markerIndices)
       .def_readwrite("forcePlates", &dart::biomechanics::C3D::forcePlates)
       .def_readwrite("dataRotation", &dart::biomechanics::C3D::dataRotation)
       .def_readwrite(
@@ -58,11 +64,23 @@ void C3DLoader(py::module& m)
           &dart::biomechanics::C3D::shuffledMarkersMatrix)
       .def_readwrite(
           "shuffledMarkersMatrixMask",
-          &dart::biomechanics::C3D::shuffledMarkersMatrixMask);
+          &dart::biomechanics::C3D::shuffledMarkersMatrixMask)
+      .def(
+          "rebuildMarkerTimestepsFromDense",
+          &dart::biomechanics::C3D::rebuildMarkerTimestepsFromDense)
+      .def(
+          "rebuildDenseFromMarkerTimesteps",
+          &dart::biomechanics::C3D::rebuildDenseFromMarkerTimesteps);
 
   ::py::class_<dart::biomechanics::C3DLoader>(m, "C3DLoader")
       .def_static(
           "loadC3D", &dart::biomechanics::C3DLoader::loadC3D, ::py::arg("uri"))
+      .def_static(
+          "loadC3DMarkerChunks",
+          &dart::biomechanics::C3DLoader::loadC3DMarkerChunks,
+          ::py::arg("uri"),
+          ::py::arg("chunkFrames"),
+          ::py::arg("onChunk"))
       .def_static(
           "fixupMarkerFlips",
           &dart::biomechanics::C3DLoader::fixupMarkerFlips,
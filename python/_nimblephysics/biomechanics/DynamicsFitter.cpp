@@ -464,6 +464,19 @@ protected:
       .def(
           "setNumThreads",
           &dart::biomechanics::DynamicsFitProblemConfig::setNumThreads,
+          ::py::arg("value"))
+      .def(
+          "setCoarseToFineDecimation",
+          &dart::biomechanics::DynamicsFitProblemConfig::
+              setCoarseToFineDecimation,
+          ::py::arg("value"),
+          "If this is > 1, runIPOPTOptimization() first solves on every N'th "
+          "frame of each trial, then uses that to warm start a shorter solve "
+          "at the full rate.")
+      .def(
+          "setCoarseToFineRefineIterationLimit",
+          &dart::biomechanics::DynamicsFitProblemConfig::
+              setCoarseToFineRefineIterationLimit,
           ::py::arg("value"));
   ;
 
@@ -573,19 +586,22 @@ protected:
           "estimateFootGroundContacts",
           &dart::biomechanics::DynamicsFitter::estimateFootGroundContacts,
           ::py::arg("init"),
-          ::py::arg("ignoreFootNotOverForcePlate") = false)
+          ::py::arg("ignoreFootNotOverForcePlate") = false,
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "smoothAccelerations",
           &dart::biomechanics::DynamicsFitter::smoothAccelerations,
           ::py::arg("init"),
           ::py::arg("smoothingWeight") = 1e1,
-          ::py::arg("regularizationWeight") = 1e-3)
+          ::py::arg("regularizationWeight") = 1e-3,
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "optimizeMarkerOffsets",
           &dart::biomechanics::DynamicsFitter::optimizeMarkerOffsets,
           ::py::arg("init"),
           ::py::arg("reoptimizeAnatomicalMarkers") = false,
-          ::py::arg("reoptimizeTrackingMarkers") = true)
+          ::py::arg("reoptimizeTrackingMarkers") = true,
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "applyInitToSkeleton",
           &dart::biomechanics::DynamicsFitter::applyInitToSkeleton,
@@ -609,14 +625,16 @@ protected:
           ::py::arg("maxTrialsToSolveMassOver") = 4,
           ::py::arg("detectExternalForce") = true,
           ::py::arg("driftCorrectionBlurRadius") = 250,
-          ::py::arg("driftCorrectionBlurInterval") = 250)
+          ::py::arg("driftCorrectionBlurInterval") = 250,
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "multimassZeroLinearResidualsOnCOMTrajectory",
           &dart::biomechanics::DynamicsFitter::
               multimassZeroLinearResidualsOnCOMTrajectory,
           ::py::arg("init"),
           ::py::arg("maxTrialsToSolveMassOver") = 4,
-          ::py::arg("boundPush") = 0.01)
+          ::py::arg("boundPush") = 0.01,
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "zeroLinearResidualsAndOptimizeAngular",
           &dart::biomechanics::DynamicsFitter::
@@ -637,7 +655,8 @@ protected:
           ::py::arg("commitCopDriftCompensation") = false,
           ::py::arg("detectUnmeasuredTorque") = true,
           ::py::arg("avgPositionChangeThreshold") = 0.08,
-          ::py::arg("avgAngularChangeThreshold") = 0.15)
+          ::py::arg("avgAngularChangeThreshold") = 0.15,
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "timeSyncTrialGRF",
           &dart::biomechanics::DynamicsFitter::timeSyncTrialGRF,
@@ -651,7 +670,8 @@ protected:
           ::py::arg("regularizeLinearResiduals") = 0.5,
           ::py::arg("regularizeAngularResiduals") = 0.5,
           ::py::arg("regularizeCopDriftCompensation") = 1.0,
-          ::py::arg("maxBuckets") = 20)
+          ::py::arg("maxBuckets") = 20,
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "timeSyncAndInitializePipeline",
           &dart::biomechanics::DynamicsFitter::timeSyncAndInitializePipeline,
@@ -671,7 +691,8 @@ protected:
           ::py::arg("avgPositionChangeThreshold") = 0.08,
           ::py::arg("avgAngularChangeThreshold") = 0.15,
           ::py::arg("reoptimizeAnatomicalMarkers") = false,
-          ::py::arg("reoptimizeTrackingMarkers") = true)
+          ::py::arg("reoptimizeTrackingMarkers") = true,
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "optimizeSpatialResidualsOnCOMTrajectory",
           &dart::biomechanics::DynamicsFitter::
@@ -684,53 +705,63 @@ protected:
           ::py::arg("weightAngular") = 2.0,
           ::py::arg("weightLastFewTimesteps") = 5.0,
           ::py::arg("offsetRegularization") = 0.001,
-          ::py::arg("regularizeResiduals") = true)
+          ::py::arg("regularizeResiduals") = true,
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "recalibrateForcePlates",
           &dart::biomechanics::DynamicsFitter::recalibrateForcePlatesOffset,
           ::py::arg("init"),
           ::py::arg("trial"),
-          ::py::arg("maxMovement") = 0.03)
+          ::py::arg("maxMovement") = 0.03,
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "scaleLinkMassesFromGravity",
           &dart::biomechanics::DynamicsFitter::scaleLinkMassesFromGravity,
-          ::py::arg("init"))
+          ::py::arg("init"),
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "estimateLinkMassesFromAcceleration",
           &dart::biomechanics::DynamicsFitter::
               estimateLinkMassesFromAcceleration,
           ::py::arg("init"),
-          ::py::arg("regularizationWeight") = 50.0)
+          ::py::arg("regularizationWeight") = 50.0,
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "runIPOPTOptimization",
           &dart::biomechanics::DynamicsFitter::runIPOPTOptimization,
           ::py::arg("init"),
-          ::py::arg("config"))
+          ::py::arg("config"),
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "runConstrainedSGDOptimization",
           &dart::biomechanics::DynamicsFitter::runConstrainedSGDOptimization,
           ::py::arg("init"),
-          ::py::arg("config"))
+          ::py::arg("config"),
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "runUnconstrainedSGDOptimization",
           &dart::biomechanics::DynamicsFitter::runUnconstrainedSGDOptimization,
           ::py::arg("init"),
-          ::py::arg("config"))
+          ::py::arg("config"),
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "computePerfectGRFs",
           &dart::biomechanics::DynamicsFitter::computePerfectGRFs,
-          ::py::arg("init"))
+          ::py::arg("init"),
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "computeInverseDynamics",
           &dart::biomechanics::DynamicsFitter::computeInverseDynamics,
           ::py::arg("init"),
-          ::py::arg("trial"))
+          ::py::arg("trial"),
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "checkPhysicalConsistency",
           &dart::biomechanics::DynamicsFitter::checkPhysicalConsistency,
           ::py::arg("init"),
           ::py::arg("maxAcceptableErrors") = 1e-3,
-          ::py::arg("maxTimestepsToTest") = 50)
+          ::py::arg("maxTimestepsToTest") = 50,
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "computeAverageMarkerRMSE",
           &dart::biomechanics::DynamicsFitter::computeAverageMarkerRMSE,
@@ -237,6 +237,18 @@ void MarkerFitter(py::module& m)
           &dart::biomechanics::InitialMarkerFitParams::
               setMaxTimestepsToUseForMultiTrialScaling,
           ::py::arg("numTimesteps"))
+      .def(
+          "setCoarseToFineDecimation",
+          &dart::biomechanics::InitialMarkerFitParams::
+              setCoarseToFineDecimation,
+          ::py::arg("decimation"),
+          "If this is > 1, the kinematics pipeline first runs on every N'th "
+          "frame, then uses that to warm start IK at the full rate.")
+      .def(
+          "setCoarseToFineRefineIKTries",
+          &dart::biomechanics::InitialMarkerFitParams::
+              setCoarseToFineRefineIKTries,
+          ::py::arg("retries"))
       .def(
           "setJointCentersAndWeights",
           &dart::biomechanics::InitialMarkerFitParams::
@@ -382,14 +394,16 @@ void MarkerFitter(py::module& m)
           &dart::biomechanics::MarkerFitter::findJointCenters,
           ::py::arg("initializations"),
           ::py::arg("newClip"),
-          ::py::arg("markerObservations"))
+          ::py::arg("markerObservations"),
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "optimizeBilevel",
           &dart::biomechanics::MarkerFitter::optimizeBilevel,
           ::py::arg("markerObservations"),
           ::py::arg("initialization"),
           ::py::arg("numSamples"),
-          ::py::arg("applyInnerProblemGradientConstraints") = true)
+          ::py::arg("applyInnerProblemGradientConstraints") = true,
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "checkForEnoughMarkers",
           &dart::biomechanics::MarkerFitter::checkForEnoughMarkers,
@@ -410,7 +424,8 @@ void MarkerFitter(py::module& m)
           &dart::biomechanics::MarkerFitter::runMultiTrialKinematicsPipeline,
           ::py::arg("markerTrials"),
           ::py::arg("params"),
-          ::py::arg("numSamples") = 50)
+          ::py::arg("numSamples") = 50,
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "runKinematicsPipeline",
           &dart::biomechanics::MarkerFitter::runKinematicsPipeline,
@@ -418,12 +433,14 @@ void MarkerFitter(py::module& m)
           ::py::arg("newClip"),
           ::py::arg("params"),
           ::py::arg("numSamples") = 20,
-          ::py::arg("skipFinalIK") = false)
+          ::py::arg("skipFinalIK") = false,
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "runPrescaledPipeline",
           &dart::biomechanics::MarkerFitter::runPrescaledPipeline,
           ::py::arg("markerObservations"),
-          ::py::arg("params"))
+          ::py::arg("params"),
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "setMinJointVarianceCutoff",
           &dart::biomechanics::MarkerFitter::setMinJointVarianceCutoff,
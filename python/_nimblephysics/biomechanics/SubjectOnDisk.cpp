@@ -237,6 +237,7 @@ Note that these are specified in the local body frame, acting on the body at its
                 "readSkel",
                 &dart::biomechanics::SubjectOnDisk::readSkel,
                 ::py::arg("geometryFolder") = "",
+                ::py::call_guard<py::gil_scoped_release>(),
                 "This will read the skeleton from the binary, and optionally "
                 "use the passed in :code:`geometryFolder` to load meshes. We "
                 "do not bundle meshes with :code:`SubjectOnDisk` files, to "
@@ -257,6 +258,7 @@ Note that these are specified in the local body frame, acting on the body at its
                 ::py::arg("numFramesToRead") = 1,
                 ::py::arg("stride") = 1,
                 ::py::arg("contactThreshold") = 1.0,
+                ::py::call_guard<py::gil_scoped_release>(),
                 "This will read from disk and allocate a number of "
                 ":code:`Frame` "
                 "objects. These Frame objects are assumed to be short-lived, "
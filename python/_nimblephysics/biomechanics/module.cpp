@@ -53,6 +53,7 @@ void IKErrorReport(py::module& sm);
 void Anthropometrics(py::module& sm);
 void C3DLoader(py::module& sm);
 void SubjectOnDisk(py::module& sm);
+void SkeletonSnapshot(py::module& sm);
 
 void dart_biomechanics(py::module& m)
 {
@@ -75,6 +76,7 @@ void dart_biomechanics(py::module& m)
   MarkerLabeller(sm);
   IKErrorReport(sm);
   SubjectOnDisk(sm);
+  SkeletonSnapshot(sm);
 }
 
 } // namespace python
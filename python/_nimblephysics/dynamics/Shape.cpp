@@ -464,7 +464,36 @@ void Shape(py::module& m)
           +[]() -> const std::string& {
             return dart::dynamics::MeshShape::getStaticType();
           },
-          ::py::return_value_policy::reference_internal);
+          ::py::return_value_policy::reference_internal)
+      .def_static(
+          "setMeshCacheEnabled",
+          +[](bool enabled) {
+            dart::dynamics::MeshShape::setMeshCacheEnabled(enabled);
+          },
+          ::py::arg("enabled"))
+      .def_static(
+          "setMeshCacheDirectory",
+          +[](const std::string& directory) {
+            dart::dynamics::MeshShape::setMeshCacheDirectory(directory);
+          },
+          ::py::arg("directory"))
+      .def_static(
+          "clearMeshCache",
+          +[]() { dart::dynamics::MeshShape::clearMeshCache(); })
+      .def_static(
+          "setMeshCacheCapacity",
+          +[](std::size_t capacity) {
+            dart::dynamics::MeshShape::setMeshCacheCapacity(capacity);
+          },
+          ::py::arg("capacity"))
+      .def_static(
+          "getMeshCacheCapacity",
+          +[]() -> std::size_t {
+            return dart::dynamics::MeshShape::getMeshCacheCapacity();
+          })
+      .def_static("getMeshCacheSize", +[]() -> std::size_t {
+        return dart::dynamics::MeshShape::getMeshCacheSize();
+      });
 
   auto attr = m.attr("MeshShape");
 
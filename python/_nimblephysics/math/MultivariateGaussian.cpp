@@ -87,6 +87,15 @@ void MultivariateGaussian(py::module& m)
           "computeLogPDFGrad",
           &dart::math::MultivariateGaussian::computeLogPDFGrad,
           ::py::arg("x"))
+      .def(
+          "computeLogPDFBatch",
+          &dart::math::MultivariateGaussian::computeLogPDFBatch,
+          ::py::arg("xs"),
+          ::py::arg("normalized") = true)
+      .def(
+          "computeLogPDFGradBatch",
+          &dart::math::MultivariateGaussian::computeLogPDFGradBatch,
+          ::py::arg("xs"))
       .def(
           "getVariableNameAtIndex",
           &dart::math::MultivariateGaussian::getVariableNameAtIndex,
@@ -85,6 +85,10 @@ void MPCLocal(py::module& m)
           "setEnableOptimizationGuards",
           &dart::realtime::MPCLocal::setEnableOptimizationGuards,
           ::py::arg("enabled"))
+      .def(
+          "setEnableWarmStart",
+          &dart::realtime::MPCLocal::setEnableWarmStart,
+          ::py::arg("enabled"))
       .def(
           "setRecordIterations",
           &dart::realtime::MPCLocal::setRecordIterations,
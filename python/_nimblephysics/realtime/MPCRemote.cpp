@@ -47,6 +47,10 @@ namespace python {
 
 void MPCRemote(py::module& m)
 {
+  ::py::enum_<dart::realtime::MPCTransport>(m, "MPCTransport")
+      .value("GRPC", dart::realtime::MPCTransport::GRPC)
+      .value("SHARED_MEMORY", dart::realtime::MPCTransport::SHARED_MEMORY);
+
   ::py::class_<
       dart::realtime::MPCRemote,
       dart::realtime::MPC,
@@ -58,6 +62,12 @@ void MPCRemote(py::module& m)
           ::py::arg("dofs"),
           ::py::arg("steps"),
           ::py::arg("millisPerStep"))
+      // MPCTransport has __index__, so this has to come before the int
+      // overload, or pybind11 would hand the transport to `ignored`
+      .def(
+          ::py::init<dart::realtime::MPCLocal&, dart::realtime::MPCTransport>(),
+          ::py::arg("local"),
+          ::py::arg("transport"))
       .def(
           ::py::init<dart::realtime::MPCLocal&, int>(),
           ::py::arg("local"),
@@ -65,6 +75,7 @@ void MPCRemote(py::module& m)
       .def(
           "getRemainingPlanBufferMillis",
           &dart::realtime::MPCRemote::getRemainingPlanBufferMillis)
+      .def("getTransport", &dart::realtime::MPCRemote::getTransport)
       .def(
           "recordGroundTruthState",
           &dart::realtime::MPCRemote::recordGroundTruthState,
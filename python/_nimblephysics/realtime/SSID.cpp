@@ -38,6 +38,7 @@
 #include <pybind11/eigen.h>
 #include <pybind11/functional.h>
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 
 namespace py = pybind11;
 
@@ -104,7 +105,24 @@ void SSID(py::module& m)
       .def(
           "registerInferListener",
           &dart::realtime::SSID::registerInferListener,
-          ::py::arg("inferListener"));
+          ::py::arg("inferListener"))
+      .def(
+          "setParallelWorkers",
+          &dart::realtime::SSID::setParallelWorkers,
+          ::py::arg("workers"))
+      .def(
+          "setMultiStartMasses",
+          &dart::realtime::SSID::setMultiStartMasses,
+          ::py::arg("starts"))
+      .def(
+          "setEarlyStopLoss",
+          &dart::realtime::SSID::setEarlyStopLoss,
+          ::py::arg("loss"))
+      .def(
+          "registerSweepListener",
+          &dart::realtime::SSID::registerSweepListener,
+          ::py::arg("listener"))
+      .def("cancelSweep", &dart::realtime::SSID::cancelSweep);
 }
 
 } // namespace python
@@ -63,7 +63,34 @@ void IKMapping(py::module& m)
           "addAngularBodyNode",
           &dart::neural::IKMapping::addAngularBodyNode,
           "This adds the angular (3D) coordinates of a body node to the "
-          "mapping, increasing the dimension of the mapped space by 3");
+          "mapping, increasing the dimension of the mapped space by 3")
+      .def(
+          "setWarmStart",
+          &dart::neural::IKMapping::setWarmStart,
+          ::py::arg("warmStart"),
+          "When this is on, each IK solve starts from the previous solution "
+          "instead of from zero, and reuses its Jacobian with rank-one "
+          "updates where they stay accurate. Defaults to off.")
+      .def("getWarmStart", &dart::neural::IKMapping::getWarmStart)
+      .def(
+          "solveTrajectory",
+          &dart::neural::IKMapping::solveTrajectory,
+          ::py::arg("world"),
+          ::py::arg("mappedPositions"),
+          ::py::call_guard<py::gil_scoped_release>(),
+          "Each column of `mappedPositions` is a target for setPositions(). "
+          "This solves them in order, warm starting each from the one "
+          "before, and returns the real positions with one column per "
+          "target.")
+      .def(
+          "getNumPosJacobianEvaluations",
+          &dart::neural::IKMapping::getNumPosJacobianEvaluations,
+          "This is the number of times the IK solves have computed the pos "
+          "Jacobian from scratch since the last call to "
+          "resetNumPosJacobianEvaluations().")
+      .def(
+          "resetNumPosJacobianEvaluations",
+          &dart::neural::IKMapping::resetNumPosJacobianEvaluations);
 }
 
 } // namespace python
@@ -254,13 +254,15 @@ void World(
           +[](dart::simulation::World* self) -> void { return self->reset(); })
       .def(
           "step",
-          +[](dart::simulation::World* self) -> void { return self->step(); })
+          +[](dart::simulation::World* self) -> void { return self->step(); },
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "step",
           +[](dart::simulation::World* self, bool _resetCommand) -> void {
             return self->step(_resetCommand);
           },
-          ::py::arg("resetCommand"))
+          ::py::arg("resetCommand"),
+          ::py::call_guard<py::gil_scoped_release>())
       .def(
           "integratePositions",
           +[](dart::simulation::World* self, Eigen::VectorXs initialVelocity)
@@ -466,6 +468,13 @@ void World(
           "setPenetrationCorrectionEnabled",
           &dart::simulation::World::setPenetrationCorrectionEnabled,
           ::py::arg("enabled"))
+      .def(
+          "getContactGradientThreads",
+          &dart::simulation::World::getContactGradientThreads)
+      .def(
+          "setContactGradientThreads",
+          &dart::simulation::World::setContactGradientThreads,
+          ::py::arg("numThreads"))
       .def(
           "getContactClippingDepth",
           &dart::simulation::World::getContactClippingDepth)
@@ -52,6 +52,7 @@ void IKMapping(py::module& sm);
 void IdentityMapping(py::module& sm);
 void BackpropSnapshot(py::module& sm);
 void MappedBackpropSnapshot(py::module& sm);
+void BatchedTimestep(py::module& sm);
 
 // Simulation
 void World(
@@ -83,6 +84,7 @@ void dart_simulation_and_neural(
   IdentityMapping(neural);
   BackpropSnapshot(neural);
   MappedBackpropSnapshot(neural);
+  BatchedTimestep(neural);
   NeuralGlobalMethods(neural);
 
   World(simulation, world);
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2011-2019, The DART development contributors
+ * All rights reserved.
+ *
+ * The list of contributors can be found at:
+ *   https://github.com/dartsim/dart/blob/master/LICENSE
+ *
+ * This file is provided under the following "BSD-style" License:
+ *   Redistribution and use in source and binary forms, with or
+ *   without modification, are permitted provided that the following
+ *   conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ *   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ *   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *   LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF
+ *   USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *   AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *   LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *   ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *   POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <Python.h>
+#include <dart/trajectory/AdamOptimizer.hpp>
+#include <pybind11/eigen.h>
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+namespace dart {
+namespace python {
+
+void AdamOptimizer(py::module& m)
+{
+  ::py::class_<
+      dart::trajectory::AdamOptimizer,
+      std::shared_ptr<dart::trajectory::AdamOptimizer>,
+      dart::trajectory::LineSearchOptimizer>(m, "AdamOptimizer")
+      .def(::py::init<>())
+      .def(
+          "setLearningRate",
+          &dart::trajectory::AdamOptimizer::setLearningRate,
+          ::py::arg("learningRate") = 1e-2)
+      .def(
+          "setBeta1",
+          &dart::trajectory::AdamOptimizer::setBeta1,
+          ::py::arg("beta1") = 0.9)
+      .def(
+          "setBeta2",
+          &dart::trajectory::AdamOptimizer::setBeta2,
+          ::py::arg("beta2") = 0.999)
+      .def(
+          "setEpsilon",
+          &dart::trajectory::AdamOptimizer::setEpsilon,
+          ::py::arg("epsilon") = 1e-8);
+}
+
+} // namespace python
+} // namespace dart
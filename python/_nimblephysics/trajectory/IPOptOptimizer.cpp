@@ -69,6 +69,10 @@ void IPOptOptimizer(py::module& m)
           "setCheckDerivatives",
           &dart::trajectory::IPOptOptimizer::setCheckDerivatives,
           ::py::arg("checkDerivatives") = true)
+      .def(
+          "setGaussNewtonHessian",
+          &dart::trajectory::IPOptOptimizer::setGaussNewtonHessian,
+          ::py::arg("enabled") = true)
       .def(
           "setPrintFrequency",
           &dart::trajectory::IPOptOptimizer::setPrintFrequency,
@@ -36,6 +36,7 @@
 #include <pybind11/eigen.h>
 #include <pybind11/functional.h>
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 
 namespace py = pybind11;
 
@@ -44,6 +45,31 @@ namespace python {
 
 void LossFn(py::module& m)
 {
+  ::py::class_<dart::trajectory::LossTerm> lossTerm(m, "LossTerm");
+  ::py::enum_<dart::trajectory::LossTerm::Type>(lossTerm, "Type")
+      .value("TRACKING", dart::trajectory::LossTerm::Type::TRACKING)
+      .value("EFFORT", dart::trajectory::LossTerm::Type::EFFORT)
+      .value("TERMINAL_STATE", dart::trajectory::LossTerm::Type::TERMINAL_STATE)
+      .export_values();
+  lossTerm.def_readwrite("type", &dart::trajectory::LossTerm::type)
+      .def_readwrite("weight", &dart::trajectory::LossTerm::weight)
+      .def_readwrite("target", &dart::trajectory::LossTerm::target)
+      .def_static(
+          "tracking",
+          &dart::trajectory::LossTerm::tracking,
+          ::py::arg("targetPoses"),
+          ::py::arg("weight") = 1.0)
+      .def_static(
+          "effort",
+          &dart::trajectory::LossTerm::effort,
+          ::py::arg("weight") = 1.0)
+      .def_static(
+          "terminalState",
+          &dart::trajectory::LossTerm::terminalState,
+          ::py::arg("targetPos"),
+          ::py::arg("targetVel"),
+          ::py::arg("weight") = 1.0);
+
   ::py::class_<
       dart::trajectory::LossFn,
       std::shared_ptr<dart::trajectory::LossFn>>(m, "LossFn")
@@ -55,6 +81,9 @@ void LossFn(py::module& m)
               dart::trajectory::TrajectoryLossFnAndGrad>(),
           ::py::arg("loss"),
           ::py::arg("lossFnAndGrad"))
+      .def(
+          ::py::init<std::vector<dart::trajectory::LossTerm>>(),
+          ::py::arg("terms"))
       .def(
           "getLoss",
           &dart::trajectory::LossFn::getLoss,
@@ -66,6 +95,20 @@ void LossFn(py::module& m)
           ::py::arg("rollout"),
           ::py::arg("gradWrtRollout"),
           ::py::arg("perfLog") = nullptr)
+      .def(
+          "getLossBatch",
+          [](dart::trajectory::LossFn* self,
+             const dart::trajectory::TrajectoryRolloutBatch* batch,
+             dart::performance::PerformanceLog* perfLog) {
+            Eigen::VectorXs losses
+                = Eigen::VectorXs::Zero(batch->getNumCandidates());
+            self->getLossBatch(batch, losses, perfLog);
+            return losses;
+          },
+          ::py::arg("batch"),
+          ::py::arg("perfLog") = nullptr)
+      .def("addTerm", &dart::trajectory::LossFn::addTerm, ::py::arg("term"))
+      .def("getTerms", &dart::trajectory::LossFn::getTerms)
       .def(
           "setUpperBound",
           &dart::trajectory::LossFn::setUpperBound,
@@ -32,6 +32,7 @@
 
 #include <dart/simulation/World.hpp>
 #include <dart/trajectory/Solution.hpp>
+#include <pybind11/eigen.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
@@ -64,7 +65,13 @@ void Solution(py::module& m)
           "getPerfLog",
           &dart::trajectory::Solution::getPerfLog,
           ::py::return_value_policy::reference)
-      .def("reoptimize", &dart::trajectory::Solution::reoptimize);
+      .def(
+          "getIterationCount",
+          &dart::trajectory::Solution::getIterationCount)
+      .def(
+          "reoptimize",
+          &dart::trajectory::Solution::reoptimize,
+          ::py::arg("mapping") = Eigen::VectorXi::Zero(0));
 }
 
 } // namespace python
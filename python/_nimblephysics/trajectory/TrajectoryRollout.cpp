@@ -31,6 +31,7 @@
  */
 
 #include <dart/simulation/World.hpp>
+#include <dart/trajectory/Problem.hpp>
 #include <dart/trajectory/TrajectoryConstants.hpp>
 #include <dart/trajectory/TrajectoryRollout.hpp>
 #include <pybind11/eigen.h>
@@ -75,6 +76,27 @@ void TrajectoryRollout(py::module& m)
           "copy",
           &dart::trajectory::TrajectoryRollout::copy,
           ::py::return_value_policy::automatic);
+
+  ::py::class_<dart::trajectory::TrajectoryRolloutBatch>(
+      m, "TrajectoryRolloutBatch")
+      .def(
+          ::py::init<dart::trajectory::Problem*, int>(),
+          ::py::arg("shot"),
+          ::py::arg("numCandidates"))
+      .def(
+          "getNumCandidates",
+          &dart::trajectory::TrajectoryRolloutBatch::getNumCandidates)
+      .def(
+          "getNumSteps", &dart::trajectory::TrajectoryRolloutBatch::getNumSteps)
+      .def(
+          "setCandidate",
+          &dart::trajectory::TrajectoryRolloutBatch::setCandidate,
+          ::py::arg("i"),
+          ::py::arg("rollout"))
+      .def(
+          "getAll",
+          &dart::trajectory::TrajectoryRolloutBatch::getAll,
+          ::py::return_value_policy::reference_internal);
 }
 
 } // namespace python
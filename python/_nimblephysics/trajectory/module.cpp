@@ -42,6 +42,9 @@ namespace python {
 void Optimizer(py::module& sm);
 void IPOptOptimizer(py::module& sm);
 void SGDOptimizer(py::module& sm);
+void LineSearchOptimizer(py::module& sm);
+void AdamOptimizer(py::module& sm);
+void LBFGSOptimizer(py::module& sm);
 void LossFn(py::module& sm);
 void Problem(py::module& sm);
 void MultiShot(py::module& sm);
@@ -64,6 +67,9 @@ void dart_trajectory(py::module& m)
   Optimizer(sm);
   IPOptOptimizer(sm);
   SGDOptimizer(sm);
+  LineSearchOptimizer(sm);
+  AdamOptimizer(sm);
+  LBFGSOptimizer(sm);
   MultiShot(sm);
   SingleShot(sm);
 }
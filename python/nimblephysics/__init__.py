@@ -1,5 +1,5 @@
 from nimblephysics_libs._nimblephysics import *
-from .timestep import timestep
+from .timestep import timestep, batched_timestep
 from .get_height import get_height
 from .get_lowest_point import get_lowest_point
 from .get_anthropometric_log_pdf import get_anthropometric_log_pdf
@@ -37,7 +37,9 @@ class TimestepLayer(torch.autograd.Function):
     ctx.backprop_snapshot = backprop_snapshot
     ctx.world = world
 
-    return torch.tensor(world.getState())
+    # getState() hands back a freshly allocated array, so we can wrap it
+    # without copying
+    return torch.from_numpy(world.getState())
 
   @staticmethod
   def backward(ctx, grad_state):
@@ -67,3 +69,54 @@ def timestep(world: nimble.simulation.World, state: torch.Tensor,
   in order to do a backwards pass.
   """
   return TimestepLayer.apply(world, state, action, mass)  # type: ignore
+
+
+class BatchedTimestepLayer(torch.autograd.Function):
+  """
+  This implements a differentiable timestep for every row of a minibatch as a
+  PyTorch layer, with the whole batch stepped (and backpropagated) in parallel
+  in a single call into C++
+  """
+
+  @staticmethod
+  def forward(ctx, batched, states, actions, masses):
+    """
+    batched: nimble.neural.BatchedTimestep
+    states: torch.Tensor, one row per element of the batch
+    actions: torch.Tensor, one row per element of the batch
+    masses: Optional[torch.Tensor], one row per element of the batch
+    -> torch.Tensor
+    """
+    ctx.use_mass = masses is not None
+    snapshot: nimble.neural.BatchedBackpropSnapshot = batched.forwardPass(
+        states.detach().numpy(),
+        actions.detach().numpy(),
+        masses.detach().numpy() if ctx.use_mass else np.zeros((0, 0)))
+    if snapshot is None:
+      raise ValueError(
+          'batched_timestep() got states, actions or masses of the wrong shape')
+    ctx.snapshot = snapshot
+    return torch.from_numpy(snapshot.getNextStates())
+
+  @staticmethod
+  def backward(ctx, grad_states):
+    snapshot: nimble.neural.BatchedBackpropSnapshot = ctx.snapshot
+    grads: nimble.neural.BatchedLossGradient = snapshot.backpropState(
+        grad_states.detach().numpy())
+    return (
+        None,
+        torch.tensor(grads.lossWrtState, dtype=torch.float64),
+        torch.tensor(grads.lossWrtAction, dtype=torch.float64),
+        torch.tensor(grads.lossWrtMass, dtype=torch.float64) if ctx.use_mass else None
+    )
+
+
+def batched_timestep(batched: nimble.neural.BatchedTimestep,
+    states: torch.Tensor, actions: torch.Tensor,
+    masses: Optional[torch.Tensor] = None) -> torch.Tensor:
+  """
+  This takes a timestep for every row of `states` and `actions` (and `masses`,
+  if given), spread across the world clones in `batched`, storing the
+  information needed in order to do a backwards pass.
+  """
+  return BatchedTimestepLayer.apply(batched, states, actions, masses)  # type: ignore
@@ -0,0 +1,154 @@
+import os
+import time
+import numpy as np
+import torch
+import nimblephysics as dart
+from nimblephysics import NativeLossFn, NativeTrajectoryRollout
+
+
+def createCartpole():
+  world = dart.simulation.World()
+  world.setGravity([0, -9.81, 0])
+
+  cartpole = dart.dynamics.Skeleton()
+  cartRail, cart = cartpole.createPrismaticJointAndBodyNodePair()
+  cartRail.setAxis([1, 0, 0])
+  cart.createShapeNode(dart.dynamics.BoxShape([.5, .1, .1]))
+  cartRail.setPositionUpperLimit(0, 10)
+  cartRail.setPositionLowerLimit(0, -10)
+  cartRail.setControlForceUpperLimit(0, 10)
+  cartRail.setControlForceLowerLimit(0, -10)
+
+  poleJoint, pole = cartpole.createRevoluteJointAndBodyNodePair(cart)
+  poleJoint.setAxis([0, 0, 1])
+  pole.createShapeNode(dart.dynamics.BoxShape([.1, 1.0, .1]))
+  poleJoint.setControlForceUpperLimit(0, 0)
+  poleJoint.setControlForceLowerLimit(0, 0)
+
+  poleOffset = dart.math.Isometry3()
+  poleOffset.set_translation([0, -0.5, 0])
+  poleJoint.setTransformFromChildBodyNode(poleOffset)
+
+  world.addSkeleton(cartpole)
+  world.setTimeStep(world.getTimeStep()*10)
+  world.setPositions([1, 1])
+  return world
+
+
+def createJumpWorm():
+  world = dart.simulation.World()
+  world.setGravity([0, -9.81, 0])
+
+  jumpworm = dart.dynamics.Skeleton()
+  rootJoint, root = jumpworm.createTranslationalJoint2DAndBodyNodePair()
+  rootJoint.setXYPlane()
+  rootShape = root.createShapeNode(dart.dynamics.BoxShape([.1, .1, .1]))
+  rootShape.createCollisionAspect()
+  for i in range(2):
+    rootJoint.setControlForceUpperLimit(i, 0)
+    rootJoint.setControlForceLowerLimit(i, 0)
+    rootJoint.setVelocityUpperLimit(i, 1000.0)
+    rootJoint.setVelocityLowerLimit(i, -1000.0)
+
+  def createTailSegment(parent):
+    poleJoint, pole = jumpworm.createRevoluteJointAndBodyNodePair(parent)
+    poleJoint.setAxis([0, 0, 1])
+    poleShape = pole.createShapeNode(dart.dynamics.BoxShape([.05, 0.25, .05]))
+    poleShape.createCollisionAspect()
+    poleJoint.setControlForceUpperLimit(0, 100.0)
+    poleJoint.setControlForceLowerLimit(0, -100.0)
+    poleJoint.setVelocityUpperLimit(0, 10000.0)
+    poleJoint.setVelocityLowerLimit(0, -10000.0)
+
+    poleOffset = dart.math.Isometry3()
+    poleOffset.set_translation([0, -0.125, 0])
+    poleJoint.setTransformFromChildBodyNode(poleOffset)
+    poleJoint.setPositionUpperLimit(0, 180 * 3.1415 / 180)
+    poleJoint.setPositionLowerLimit(0, 0 * 3.1415 / 180)
+
+    if parent != root:
+      childOffset = dart.math.Isometry3()
+      childOffset.set_translation([0, 0.125, 0])
+      poleJoint.setTransformFromParentBodyNode(childOffset)
+    return pole
+
+  tail1 = createTailSegment(root)
+  tail2 = createTailSegment(tail1)
+  createTailSegment(tail2)
+
+  jumpworm.setPositions(np.array([0, 0, 90, 90, 45]) * 3.1415 / 180)
+  jumpworm.setPosition(1, -0.14)
+  world.addSkeleton(jumpworm)
+
+  floor = dart.dynamics.Skeleton()
+  floorJoint, floorBody = floor.createWeldJointAndBodyNodePair()
+  floorOffset = dart.math.Isometry3()
+  floorOffset.set_translation([0, -0.7, 0])
+  floorJoint.setTransformFromParentBodyNode(floorOffset)
+  floorShape = floorBody.createShapeNode(dart.dynamics.BoxShape([2.5, 0.25, .5]))
+  floorShape.createCollisionAspect()
+  world.addSkeleton(floor)
+  return world
+
+
+def createHalfCheetah():
+  world: dart.simulation.World = dart.simulation.World.loadFrom(os.path.join(
+      os.path.dirname(__file__), "../../data/skel/half_cheetah.skel"))
+
+  cheetah = world.getSkeleton(1)
+  forceLimits = np.ones([cheetah.getNumDofs()]) * 500
+  forceLimits[0:1] = 0
+  cheetah.setControlForceUpperLimits(forceLimits)
+  cheetah.setControlForceLowerLimits(forceLimits * -1)
+  cheetah.setPosition(2, 0.03)
+  cheetah.setPosition(1, -0.1)
+  return world
+
+
+def runOptimizer(world: dart.simulation.World, steps: int, shotLength: int, gaussNewton: bool):
+  """
+  This drives the first degree of freedom forward by a meter, and then
+  returns the number of IPOPT iterations and the wall-clock time it took.
+  """
+  target = world.getPositions()
+  target[0] += 1.0
+  target = torch.tensor(target)
+
+  def loss(rollout: NativeTrajectoryRollout):
+    posLoss = (rollout.getPoses('identity')[:, -1] - target).square().sum()
+    velLoss = rollout.getVels('identity')[:, -1].square().sum()
+    forceLoss = rollout.getControlForces('identity').square().sum()
+    return posLoss + velLoss + 1e-3 * forceLoss
+  dartLoss: dart.trajectory.LossFn = NativeLossFn(loss)
+
+  trajectory = dart.trajectory.MultiShot(world, dartLoss, steps, shotLength, False)
+  trajectory.setParallelOperationsEnabled(True)
+
+  optimizer = dart.trajectory.IPOptOptimizer()
+  optimizer.setLBFGSHistoryLength(5)
+  optimizer.setTolerance(1e-6)
+  optimizer.setIterationLimit(500)
+  optimizer.setSilenceOutput(True)
+  optimizer.setGaussNewtonHessian(gaussNewton)
+
+  start = time.time()
+  result = optimizer.optimize(trajectory)
+  return result.getIterationCount(), time.time() - start
+
+
+def main():
+  benchmarks = [
+      ("cartpole", createCartpole, 100, 20),
+      ("jump worm", createJumpWorm, 100, 20),
+      ("half cheetah", createHalfCheetah, 50, 10),
+  ]
+  print("%-14s %-14s %10s %10s" % ("world", "hessian", "iterations", "seconds"))
+  for name, create, steps, shotLength in benchmarks:
+    for gaussNewton in [False, True]:
+      iterations, seconds = runOptimizer(create(), steps, shotLength, gaussNewton)
+      print("%-14s %-14s %10d %10.2f" % (name, "gauss-newton" if gaussNewton else "l-bfgs",
+                                         iterations, seconds))
+
+
+if __name__ == "__main__":
+  main()
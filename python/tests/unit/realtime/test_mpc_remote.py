@@ -0,0 +1,30 @@
+import pytest
+import nimblephysics as dart
+
+
+def create_cartpole_mpc():
+  world = dart.simulation.World()
+  world.setGravity([0, -9.81, 0])
+
+  cartpole = dart.dynamics.Skeleton()
+  cartRail, cart = cartpole.createPrismaticJointAndBodyNodePair()
+  cartRail.setAxis([1, 0, 0])
+  poleJoint, pole = cartpole.createRevoluteJointAndBodyNodePair(cart)
+  poleJoint.setAxis([0, 0, 1])
+  world.addSkeleton(cartpole)
+
+  loss = dart.trajectory.LossFn([dart.trajectory.LossTerm.effort(1.0)])
+  return dart.realtime.MPCLocal(world, loss, 100)
+
+
+def test_shared_memory_transport_is_selected():
+  # MPCTransport has __index__, so this used to match the (local, ignored: int)
+  # overload, and silently connect over gRPC
+  local = create_cartpole_mpc()
+  remote = dart.realtime.MPCRemote(
+      local, dart.realtime.MPCTransport.SHARED_MEMORY)
+  assert remote.getTransport() == dart.realtime.MPCTransport.SHARED_MEMORY
+
+
+if __name__ == "__main__":
+  pytest.main()
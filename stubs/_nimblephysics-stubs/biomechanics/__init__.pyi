@@ -44,6 +44,7 @@ __all__ = [
     "OpenSimTRC",
     "ResidualForceHelper",
     "SkeletonConverter",
+    "SkeletonSnapshot",
     "SubjectOnDisk",
     "forceDiscrepancy",
     "measuredGrfZeroWhenAccelerationNonZero",
@@ -70,6 +71,7 @@ class Anthropometrics():
     @staticmethod
     def loadFromFile(uri: str) -> Anthropometrics: ...
     def measure(self, skel: nimblephysics_libs._nimblephysics.dynamics.Skeleton) -> typing.Dict[str, float]: ...
+    def measureVector(self, skel: nimblephysics_libs._nimblephysics.dynamics.Skeleton) -> numpy.ndarray[numpy.float64, _Shape[m, 1]]: ...
     def setDistribution(self, dist: nimblephysics_libs._nimblephysics.math.MultivariateGaussian) -> None: ...
     pass
 class BatchGaitInverseDynamics():
@@ -132,6 +134,8 @@ class BilevelFitResult():
         pass
     pass
 class C3D():
+    def rebuildDenseFromMarkerTimesteps(self) -> None: ...
+    def rebuildMarkerTimestepsFromDense(self) -> None: ...
     @property
     def dataRotation(self) -> numpy.ndarray[numpy.float64, _Shape[3, 3]]:
         """
@@ -157,6 +161,30 @@ class C3D():
     def framesPerSecond(self, arg0: int) -> None:
         pass
     @property
+    def markerIndices(self) -> typing.Dict[str, int]:
+        """
+        :type: typing.Dict[str, int]
+        """
+    @markerIndices.setter
+    def markerIndices(self, arg0: typing.Dict[str, int]) -> None:
+        pass
+    @property
+    def markerObserved(self) -> numpy.ndarray[bool, _Shape[m, n]]:
+        """
+        :type: numpy.ndarray[bool, _Shape[m, n]]
+        """
+    @markerObserved.setter
+    def markerObserved(self, arg0: numpy.ndarray[bool, _Shape[m, n]]) -> None:
+        pass
+    @property
+    def markerPositions(self) -> numpy.ndarray[numpy.float64, _Shape[m, n]]:
+        """
+        :type: numpy.ndarray[numpy.float64, _Shape[m, n]]
+        """
+    @markerPositions.setter
+    def markerPositions(self, arg0: numpy.ndarray[numpy.float64, _Shape[m, n]]) -> None:
+        pass
+    @property
     def markerTimesteps(self) -> typing.List[typing.Dict[str, numpy.ndarray[numpy.float64, _Shape[3, 1]]]]:
         """
         :type: typing.List[typing.Dict[str, numpy.ndarray[numpy.float64, _Shape[3, 1]]]]
@@ -204,6 +232,8 @@ class C3DLoader():
     def fixupMarkerFlips(c3d: C3D) -> None: ...
     @staticmethod
     def loadC3D(uri: str) -> C3D: ...
+    @staticmethod
+    def loadC3DMarkerChunks(uri: str, chunkFrames: int, onChunk: typing.Callable[[int, numpy.ndarray[numpy.float64, _Shape[m, n]], numpy.ndarray[bool, _Shape[m, n]]], None]) -> typing.List[str]: ...
     pass
 class ContactRegimeSection():
     @property
@@ -242,6 +272,11 @@ class ContactRegimeSection():
 class DynamicsFitProblemConfig():
     def __init__(self, skeleton: nimblephysics_libs._nimblephysics.dynamics.Skeleton) -> None: ...
     def setBoundMoveDistance(self, distance: float) -> DynamicsFitProblemConfig: ...
+    def setCoarseToFineDecimation(self, value: int) -> DynamicsFitProblemConfig: 
+        """
+        If this is > 1, runIPOPTOptimization() first solves on every N'th frame of each trial, then uses that to warm start a shorter solve at the full rate.
+        """
+    def setCoarseToFineRefineIterationLimit(self, value: int) -> DynamicsFitProblemConfig: ...
     def setConstrainAngularResiduals(self, value: float) -> DynamicsFitProblemConfig: ...
     def setConstrainLinearResiduals(self, value: float) -> DynamicsFitProblemConfig: ...
     def setConstrainResidualsZero(self, constrain: bool) -> DynamicsFitProblemConfig: ...
@@ -1181,6 +1216,11 @@ class IMUFineTuneProblem():
 class InitialMarkerFitParams():
     def __init__(self) -> None: ...
     def __repr__(self) -> str: ...
+    def setCoarseToFineDecimation(self, decimation: int) -> InitialMarkerFitParams: 
+        """
+        If this is > 1, the kinematics pipeline first runs on every N'th frame, then uses that to warm start IK at the full rate.
+        """
+    def setCoarseToFineRefineIKTries(self, retries: int) -> InitialMarkerFitParams: ...
     def setDontRescaleBodies(self, dontRescaleBodies: bool) -> InitialMarkerFitParams: ...
     def setGroupScales(self, groupScales: numpy.ndarray[numpy.float64, _Shape[m, 1]]) -> InitialMarkerFitParams: ...
     def setInitPoses(self, initPoses: numpy.ndarray[numpy.float64, _Shape[m, n]]) -> InitialMarkerFitParams: ...
@@ -1932,6 +1972,16 @@ class SkeletonConverter():
     def linkJoints(self, sourceJoint: nimblephysics_libs._nimblephysics.dynamics.Joint, targetJoint: nimblephysics_libs._nimblephysics.dynamics.Joint) -> None: ...
     def rescaleAndPrepTarget(self, addFakeMarkers: int = 3, weightFakeMarkers: float = 0.1, convergenceThreshold: float = 1e-15, maxStepCount: int = 1000, leastSquaresDamping: float = 0.01, lineSearch: bool = True, logOutput: bool = False) -> None: ...
     pass
+class SkeletonSnapshot():
+    @staticmethod
+    def readOpenSimFile(path: str) -> OpenSimFile: ...
+    @staticmethod
+    def readSkeleton(path: str) -> nimblephysics_libs._nimblephysics.dynamics.Skeleton: ...
+    @staticmethod
+    def writeOpenSimFile(path: str, file: OpenSimFile) -> None: ...
+    @staticmethod
+    def writeSkeleton(path: str, skel: nimblephysics_libs._nimblephysics.dynamics.Skeleton) -> None: ...
+    pass
 class SubjectOnDisk():
     """
     This is for doing ML and large-scale data analysis. The idea here is to
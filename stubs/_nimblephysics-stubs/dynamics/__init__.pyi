@@ -3017,8 +3017,14 @@ class MeshShape(Shape):
     def __init__(self, scale: numpy.ndarray[numpy.float64, _Shape[3, 1]], path: str) -> None: ...
     @typing.overload
     def __init__(self, scale: numpy.ndarray[numpy.float64, _Shape[3, 1]], path: str, resourceRetriever: nimblephysics_libs._nimblephysics.common.ResourceRetriever) -> None: ...
+    @staticmethod
+    def clearMeshCache() -> None: ...
     def computeInertia(self, mass: float) -> numpy.ndarray[numpy.float64, _Shape[3, 3]]: ...
     def getDisplayList(self) -> int: ...
+    @staticmethod
+    def getMeshCacheCapacity() -> int: ...
+    @staticmethod
+    def getMeshCacheSize() -> int: ...
     def getMeshPath(self) -> str: ...
     def getMeshUri(self) -> str: ...
     def getMeshUri2(self) -> nimblephysics_libs._nimblephysics.common.Uri: ...
@@ -3039,6 +3045,12 @@ class MeshShape(Shape):
     def setMesh(self, mesh: SharedMeshWrapper, path: str) -> None: ...
     @typing.overload
     def setMesh(self, mesh: SharedMeshWrapper, path: str, resourceRetriever: nimblephysics_libs._nimblephysics.common.ResourceRetriever) -> None: ...
+    @staticmethod
+    def setMeshCacheCapacity(capacity: int) -> None: ...
+    @staticmethod
+    def setMeshCacheDirectory(directory: str) -> None: ...
+    @staticmethod
+    def setMeshCacheEnabled(enabled: bool) -> None: ...
     def setScale(self, scale: numpy.ndarray[numpy.float64, _Shape[3, 1]]) -> None: ...
     def update(self) -> None: ...
     COLOR_INDEX: nimblephysics_libs._nimblephysics.dynamics.MeshShape.ColorMode # value = <ColorMode.COLOR_INDEX: 1>
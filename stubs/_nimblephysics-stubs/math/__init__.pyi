@@ -136,7 +136,9 @@ class Isometry3():
 class MultivariateGaussian():
     def __init__(self, variables: typing.List[str], mu: numpy.ndarray[numpy.float64, _Shape[m, 1]], cov: numpy.ndarray[numpy.float64, _Shape[m, n]]) -> None: ...
     def computeLogPDF(self, values: numpy.ndarray[numpy.float64, _Shape[m, 1]], normalized: bool = True) -> float: ...
+    def computeLogPDFBatch(self, xs: numpy.ndarray[numpy.float64, _Shape[m, n]], normalized: bool = True) -> numpy.ndarray[numpy.float64, _Shape[m, 1]]: ...
     def computeLogPDFGrad(self, x: numpy.ndarray[numpy.float64, _Shape[m, 1]]) -> numpy.ndarray[numpy.float64, _Shape[m, 1]]: ...
+    def computeLogPDFGradBatch(self, xs: numpy.ndarray[numpy.float64, _Shape[m, n]]) -> numpy.ndarray[numpy.float64, _Shape[m, n]]: ...
     def computePDF(self, values: numpy.ndarray[numpy.float64, _Shape[m, 1]]) -> float: ...
     def condition(self, observedValues: typing.Dict[str, float]) -> MultivariateGaussian: ...
     def convertFromMap(self, values: typing.Dict[str, float]) -> numpy.ndarray[numpy.float64, _Shape[m, 1]]: ...
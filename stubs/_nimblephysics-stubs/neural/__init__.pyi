@@ -10,6 +10,9 @@ _Shape = typing.Tuple[int, ...]
 
 __all__ = [
     "BackpropSnapshot",
+    "BatchedBackpropSnapshot",
+    "BatchedLossGradient",
+    "BatchedTimestep",
     "COM",
     "COM_POS",
     "COM_VEL_LINEAR",
@@ -83,6 +86,44 @@ class BackpropSnapshot():
     def getVelPosJacobian(self, world: nimblephysics_libs._nimblephysics.simulation.World, perfLog: nimblephysics_libs._nimblephysics.performance.PerformanceLog = None) -> numpy.ndarray[numpy.float64, _Shape[m, n]]: ...
     def getVelVelJacobian(self, world: nimblephysics_libs._nimblephysics.simulation.World, perfLog: nimblephysics_libs._nimblephysics.performance.PerformanceLog = None) -> numpy.ndarray[numpy.float64, _Shape[m, n]]: ...
     pass
+class BatchedBackpropSnapshot():
+    def backpropState(self, nextStateLossGrads: numpy.ndarray[numpy.float64, _Shape[m, n]]) -> BatchedLossGradient: ...
+    def getBatchSize(self) -> int: ...
+    def getNextStates(self) -> numpy.ndarray[numpy.float64, _Shape[m, n]]: ...
+    def getSnapshot(self, row: int) -> BackpropSnapshot: ...
+    pass
+class BatchedLossGradient():
+    def __init__(self) -> None: ...
+    @property
+    def lossWrtAction(self) -> numpy.ndarray[numpy.float64, _Shape[m, n]]:
+        """
+        :type: numpy.ndarray[numpy.float64, _Shape[m, n]]
+        """
+    @lossWrtAction.setter
+    def lossWrtAction(self, arg0: numpy.ndarray[numpy.float64, _Shape[m, n]]) -> None:
+        pass
+    @property
+    def lossWrtMass(self) -> numpy.ndarray[numpy.float64, _Shape[m, n]]:
+        """
+        :type: numpy.ndarray[numpy.float64, _Shape[m, n]]
+        """
+    @lossWrtMass.setter
+    def lossWrtMass(self, arg0: numpy.ndarray[numpy.float64, _Shape[m, n]]) -> None:
+        pass
+    @property
+    def lossWrtState(self) -> numpy.ndarray[numpy.float64, _Shape[m, n]]:
+        """
+        :type: numpy.ndarray[numpy.float64, _Shape[m, n]]
+        """
+    @lossWrtState.setter
+    def lossWrtState(self, arg0: numpy.ndarray[numpy.float64, _Shape[m, n]]) -> None:
+        pass
+    pass
+class BatchedTimestep():
+    def __init__(self, world: nimblephysics_libs._nimblephysics.simulation.World, numThreads: int = -1) -> None: ...
+    def forwardPass(self, states: numpy.ndarray[numpy.float64, _Shape[m, n]], actions: numpy.ndarray[numpy.float64, _Shape[m, n]], masses: numpy.ndarray[numpy.float64, _Shape[m, n]] = ...) -> BatchedBackpropSnapshot: ...
+    def getNumThreads(self) -> int: ...
+    pass
 class ConvertToSpace():
     """
     Members:
@@ -318,6 +359,20 @@ class IKMapping(Mapping):
         """
         This adds the spatial (6D) coordinates of a body node to the mapping, increasing the dimension of the mapped space by 6
         """
+    def getNumPosJacobianEvaluations(self) -> int: 
+        """
+        This is the number of times the IK solves have computed the pos Jacobian from scratch since the last call to resetNumPosJacobianEvaluations().
+        """
+    def getWarmStart(self) -> bool: ...
+    def resetNumPosJacobianEvaluations(self) -> None: ...
+    def setWarmStart(self, warmStart: bool) -> None: 
+        """
+        When this is on, each IK solve starts from the previous solution instead of from zero, and reuses its Jacobian with rank-one updates where they stay accurate. Defaults to off.
+        """
+    def solveTrajectory(self, world: nimblephysics_libs._nimblephysics.simulation.World, mappedPositions: numpy.ndarray[numpy.float64, _Shape[m, n]]) -> numpy.ndarray[numpy.float64, _Shape[m, n]]: 
+        """
+        Each column of `mappedPositions` is a target for setPositions(). This solves them in order, warm starting each from the one before, and returns the real positions with one column per target.
+        """
     pass
 class WithRespectTo():
     @typing.overload
@@ -11,6 +11,7 @@ __all__ = [
     "MPC",
     "MPCLocal",
     "MPCRemote",
+    "MPCTransport",
     "Ticker"
 ]
 
@@ -43,6 +44,7 @@ class MPCLocal(MPC):
         """
     def setEnableLineSearch(self, enabled: bool) -> None: ...
     def setEnableOptimizationGuards(self, enabled: bool) -> None: ...
+    def setEnableWarmStart(self, enabled: bool) -> None: ...
     def setLoss(self, loss: nimblephysics_libs._nimblephysics.trajectory.LossFn) -> None: ...
     def setMaxIterations(self, maxIterations: int) -> None: ...
     def setOptimizer(self, optimizer: nimblephysics_libs._nimblephysics.trajectory.Optimizer) -> None: ...
@@ -56,15 +58,49 @@ class MPCRemote(MPC):
     @typing.overload
     def __init__(self, host: str, port: int, dofs: int, steps: int, millisPerStep: int) -> None: ...
     @typing.overload
+    def __init__(self, local: MPCLocal, transport: MPCTransport) -> None: ...
+    @typing.overload
     def __init__(self, local: MPCLocal, ignored: int = 0) -> None: ...
     def getControlForce(self, now: int) -> numpy.ndarray[numpy.float64, _Shape[m, 1]]: ...
     def getRemainingPlanBufferMillis(self) -> int: ...
+    def getTransport(self) -> MPCTransport: ...
     def recordGroundTruthState(self, time: int, pos: numpy.ndarray[numpy.float64, _Shape[m, 1]], vel: numpy.ndarray[numpy.float64, _Shape[m, 1]], mass: numpy.ndarray[numpy.float64, _Shape[m, 1]]) -> None: ...
     def recordGroundTruthStateNow(self, pos: numpy.ndarray[numpy.float64, _Shape[m, 1]], vel: numpy.ndarray[numpy.float64, _Shape[m, 1]], mass: numpy.ndarray[numpy.float64, _Shape[m, 1]]) -> None: ...
     def registerReplaningListener(self, replanListener: typing.Callable[[int, nimblephysics_libs._nimblephysics.trajectory.TrajectoryRollout, int], None]) -> None: ...
     def start(self) -> None: ...
     def stop(self) -> None: ...
     pass
+class MPCTransport():
+    """
+    Members:
+
+      GRPC
+
+      SHARED_MEMORY
+    """
+    def __eq__(self, other: object) -> bool: ...
+    def __getstate__(self) -> int: ...
+    def __hash__(self) -> int: ...
+    def __index__(self) -> int: ...
+    def __init__(self, value: int) -> None: ...
+    def __int__(self) -> int: ...
+    def __ne__(self, other: object) -> bool: ...
+    def __repr__(self) -> str: ...
+    def __setstate__(self, state: int) -> None: ...
+    @property
+    def name(self) -> str:
+        """
+        :type: str
+        """
+    @property
+    def value(self) -> int:
+        """
+        :type: int
+        """
+    GRPC: nimblephysics_libs._nimblephysics.realtime.MPCTransport # value = <MPCTransport.GRPC: 0>
+    SHARED_MEMORY: nimblephysics_libs._nimblephysics.realtime.MPCTransport # value = <MPCTransport.SHARED_MEMORY: 1>
+    __members__: dict # value = {'GRPC': <MPCTransport.GRPC: 0>, 'SHARED_MEMORY': <MPCTransport.SHARED_MEMORY: 1>}
+    pass
 class Ticker():
     def __init__(self, secondsPerTick: float) -> None: ...
     def clear(self) -> None: ...
@@ -38,6 +38,7 @@ class World():
     def getCachedLCPSolution(self) -> numpy.ndarray[numpy.float64, _Shape[m, 1]]: ...
     def getConstraintSolver(self) -> nimblephysics_libs._nimblephysics.constraint.ConstraintSolver: ...
     def getContactClippingDepth(self) -> float: ...
+    def getContactGradientThreads(self) -> int: ...
     def getControlForceLowerLimits(self) -> numpy.ndarray[numpy.float64, _Shape[m, 1]]: ...
     def getControlForceUpperLimits(self) -> numpy.ndarray[numpy.float64, _Shape[m, 1]]: ...
     def getControlForces(self) -> numpy.ndarray[numpy.float64, _Shape[m, 1]]: ...
@@ -100,6 +101,7 @@ class World():
     def setAction(self, action: numpy.ndarray[numpy.float64, _Shape[m, 1]]) -> None: ...
     def setActionSpace(self, actionSpaceMapping: typing.List[int]) -> None: ...
     def setCachedLCPSolution(self, cachedLCPSolution: numpy.ndarray[numpy.float64, _Shape[m, 1]]) -> None: ...
+    def setContactGradientThreads(self, numThreads: int) -> None: ...
     def setControlForces(self, arg0: numpy.ndarray[numpy.float64, _Shape[m, 1]]) -> None: ...
     def setControlForcesLowerLimits(self, arg0: numpy.ndarray[numpy.float64, _Shape[m, 1]]) -> None: ...
     def setControlForcesUpperLimits(self, arg0: numpy.ndarray[numpy.float64, _Shape[m, 1]]) -> None: ...
@@ -9,8 +9,12 @@ import numpy
 _Shape = typing.Tuple[int, ...]
 
 __all__ = [
+    "AdamOptimizer",
     "IPOptOptimizer",
+    "LBFGSOptimizer",
+    "LineSearchOptimizer",
     "LossFn",
+    "LossTerm",
     "MultiShot",
     "OptimizationStep",
     "Optimizer",
@@ -18,7 +22,8 @@ __all__ = [
     "SGDOptimizer",
     "SingleShot",
     "Solution",
-    "TrajectoryRollout"
+    "TrajectoryRollout",
+    "TrajectoryRolloutBatch"
 ]
 
 
@@ -32,13 +37,87 @@ class LossFn():
     def __init__(self, loss: typing.Callable[[TrajectoryRollout], float]) -> None: ...
     @typing.overload
     def __init__(self, loss: typing.Callable[[TrajectoryRollout], float], lossFnAndGrad: typing.Callable[[TrajectoryRollout, TrajectoryRollout], float]) -> None: ...
+    @typing.overload
+    def __init__(self, terms: typing.List[LossTerm]) -> None: ...
+    def addTerm(self, term: LossTerm) -> None: ...
     def getLoss(self, rollout: TrajectoryRollout, perfLog: nimblephysics_libs._nimblephysics.performance.PerformanceLog = None) -> float: ...
     def getLossAndGradient(self, rollout: TrajectoryRollout, gradWrtRollout: TrajectoryRollout, perfLog: nimblephysics_libs._nimblephysics.performance.PerformanceLog = None) -> float: ...
+    def getLossBatch(self, batch: TrajectoryRolloutBatch, perfLog: nimblephysics_libs._nimblephysics.performance.PerformanceLog = None) -> numpy.ndarray[numpy.float64, _Shape[m, 1]]: ...
     def getLowerBound(self) -> float: ...
+    def getTerms(self) -> typing.List[LossTerm]: ...
     def getUpperBound(self) -> float: ...
     def setLowerBound(self, lowerBound: float) -> None: ...
     def setUpperBound(self, upperBound: float) -> None: ...
     pass
+class LossTerm():
+    class Type():
+        """
+        Members:
+
+          TRACKING
+
+          EFFORT
+
+          TERMINAL_STATE
+        """
+        def __eq__(self, other: object) -> bool: ...
+        def __getstate__(self) -> int: ...
+        def __hash__(self) -> int: ...
+        def __index__(self) -> int: ...
+        def __init__(self, value: int) -> None: ...
+        def __int__(self) -> int: ...
+        def __ne__(self, other: object) -> bool: ...
+        def __repr__(self) -> str: ...
+        def __setstate__(self, state: int) -> None: ...
+        @property
+        def name(self) -> str:
+            """
+            :type: str
+            """
+        @property
+        def value(self) -> int:
+            """
+            :type: int
+            """
+        EFFORT: nimblephysics_libs._nimblephysics.trajectory.LossTerm.Type # value = <Type.EFFORT: 1>
+        TERMINAL_STATE: nimblephysics_libs._nimblephysics.trajectory.LossTerm.Type # value = <Type.TERMINAL_STATE: 2>
+        TRACKING: nimblephysics_libs._nimblephysics.trajectory.LossTerm.Type # value = <Type.TRACKING: 0>
+        __members__: dict # value = {'TRACKING': <Type.TRACKING: 0>, 'EFFORT': <Type.EFFORT: 1>, 'TERMINAL_STATE': <Type.TERMINAL_STATE: 2>}
+        pass
+    @staticmethod
+    def effort(weight: float = 1.0) -> LossTerm: ...
+    @staticmethod
+    def terminalState(targetPos: numpy.ndarray[numpy.float64, _Shape[m, 1]], targetVel: numpy.ndarray[numpy.float64, _Shape[m, 1]], weight: float = 1.0) -> LossTerm: ...
+    @staticmethod
+    def tracking(targetPoses: numpy.ndarray[numpy.float64, _Shape[m, n]], weight: float = 1.0) -> LossTerm: ...
+    @property
+    def target(self) -> numpy.ndarray[numpy.float64, _Shape[m, n]]:
+        """
+        :type: numpy.ndarray[numpy.float64, _Shape[m, n]]
+        """
+    @target.setter
+    def target(self, arg0: numpy.ndarray[numpy.float64, _Shape[m, n]]) -> None:
+        pass
+    @property
+    def type(self) -> LossTerm.Type:
+        """
+        :type: LossTerm.Type
+        """
+    @type.setter
+    def type(self, arg0: LossTerm.Type) -> None:
+        pass
+    @property
+    def weight(self) -> float:
+        """
+        :type: float
+        """
+    @weight.setter
+    def weight(self, arg0: float) -> None:
+        pass
+    EFFORT: nimblephysics_libs._nimblephysics.trajectory.LossTerm.Type # value = <Type.EFFORT: 1>
+    TERMINAL_STATE: nimblephysics_libs._nimblephysics.trajectory.LossTerm.Type # value = <Type.TERMINAL_STATE: 2>
+    TRACKING: nimblephysics_libs._nimblephysics.trajectory.LossTerm.Type # value = <Type.TRACKING: 0>
+    pass
 class Problem():
     def addConstraint(self, constraint: LossFn) -> None: ...
     def addMapping(self, key: str, mapping: nimblephysics_libs._nimblephysics.neural.Mapping) -> None: ...
@@ -91,6 +170,7 @@ class IPOptOptimizer(Optimizer):
     def optimize(self, shot: Problem, reuseRecord: Solution = None) -> Solution: ...
     def setCheckDerivatives(self, checkDerivatives: bool = True) -> None: ...
     def setDisableLinesearch(self, disableLinesearch: bool = True) -> None: ...
+    def setGaussNewtonHessian(self, enabled: bool = True) -> None: ...
     def setIterationLimit(self, iterationLimit: int = 500) -> None: ...
     def setLBFGSHistoryLength(self, historyLen: int = 1) -> None: ...
     def setPrintFrequency(self, printFrequency: int = 1) -> None: ...
@@ -101,6 +181,28 @@ class IPOptOptimizer(Optimizer):
     def setSuppressOutput(self, suppressOutput: bool = True) -> None: ...
     def setTolerance(self, tol: float = 1e-07) -> None: ...
     pass
+class LineSearchOptimizer(Optimizer):
+    def optimize(self, shot: Problem, reuseRecord: Solution = None) -> Solution: ...
+    def setConstraintPenaltyWeight(self, weight: float) -> None: ...
+    def setIterationLimit(self, iterationLimit: int = 100) -> None: ...
+    def setLineSearchStepSizes(self, stepSizes: typing.List[float]) -> None: ...
+    def setParallelLineSearchEnabled(self, enabled: bool = True) -> None: ...
+    def setRecordIterations(self, recordIterations: bool = True) -> None: ...
+    def setSilenceOutput(self, silenceOutput: bool = True) -> None: ...
+    def setTimeBudgetMillis(self, budgetMillis: int) -> None: ...
+    def setTolerance(self, tol: float = 1e-07) -> None: ...
+    pass
+class AdamOptimizer(LineSearchOptimizer):
+    def __init__(self) -> None: ...
+    def setBeta1(self, beta1: float = 0.9) -> None: ...
+    def setBeta2(self, beta2: float = 0.999) -> None: ...
+    def setEpsilon(self, epsilon: float = 1e-08) -> None: ...
+    def setLearningRate(self, learningRate: float = 0.01) -> None: ...
+    pass
+class LBFGSOptimizer(LineSearchOptimizer):
+    def __init__(self) -> None: ...
+    def setLBFGSHistoryLength(self, historyLen: int = 10) -> None: ...
+    pass
 class MultiShot(Problem):
     def __init__(self, world: nimblephysics_libs._nimblephysics.simulation.World, loss: LossFn, steps: int, shotLength: int, tuneStartingState: bool = False) -> None: ...
     def setParallelOperationsEnabled(self, enabled: bool) -> None: ...
@@ -116,10 +218,11 @@ class SingleShot(Problem):
     def __init__(self, world: nimblephysics_libs._nimblephysics.simulation.World, loss: LossFn, steps: int, tuneStartingState: bool = False) -> None: ...
     pass
 class Solution():
+    def getIterationCount(self) -> int: ...
     def getNumSteps(self) -> int: ...
     def getPerfLog(self) -> nimblephysics_libs._nimblephysics.performance.PerformanceLog: ...
     def getStep(self, step: int) -> OptimizationStep: ...
-    def reoptimize(self) -> None: ...
+    def reoptimize(self, mapping: numpy.ndarray[numpy.int32, _Shape[m, 1]] = array([], dtype=int32)) -> None: ...
     def toJson(self, world: nimblephysics_libs._nimblephysics.simulation.World) -> str: ...
     pass
 class TrajectoryRollout():
@@ -131,3 +234,10 @@ class TrajectoryRollout():
     def getVels(self, mapping: str = 'identity') -> numpy.ndarray[numpy.float64, _Shape[m, n]]: ...
     def toJson(self, world: nimblephysics_libs._nimblephysics.simulation.World) -> str: ...
     pass
+class TrajectoryRolloutBatch():
+    def __init__(self, shot: Problem, numCandidates: int) -> None: ...
+    def getAll(self) -> TrajectoryRollout: ...
+    def getNumCandidates(self) -> int: ...
+    def getNumSteps(self) -> int: ...
+    def setCandidate(self, i: int, rollout: TrajectoryRollout) -> None: ...
+    pass
@@ -19,7 +19,7 @@ __all__ = [
 
 
 class AccelerationSmoother():
-    def __init__(self, timesteps: int, smoothingWeight: float, regularizationWeight: float, useSparse: bool = True, useIterative: bool = True) -> None: ...
+    def __init__(self, timesteps: int, smoothingWeight: float, regularizationWeight: float, useSparse: bool = True, useIterative: bool = True, useBanded: bool = True) -> None: ...
     def debugTimeSeries(self, series: numpy.ndarray[numpy.float64, _Shape[m, 1]]) -> None: ...
     def setIterations(self, iterations: int) -> None: ...
     def smooth(self, series: numpy.ndarray[numpy.float64, _Shape[m, n]]) -> numpy.ndarray[numpy.float64, _Shape[m, n]]: ...
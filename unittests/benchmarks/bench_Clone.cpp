@@ -0,0 +1,47 @@
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include "dart/biomechanics/OpenSimParser.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/simulation/World.hpp"
+
+using namespace dart;
+using namespace biomechanics;
+
+// These time the clones that IKInitializer, MarkerFitter and MultiShot make
+// per worker thread, on the Rajagopal model (~40 bodies)
+
+static std::shared_ptr<dynamics::Skeleton> loadRajagopal()
+{
+  return OpenSimParser::parseOsim(
+             "dart://sample/osim/Rajagopal2015/Rajagopal2015.osim")
+      .skeleton;
+}
+
+static void BM_CloneSkeleton(benchmark::State& state)
+{
+  std::shared_ptr<dynamics::Skeleton> skel = loadRajagopal();
+  for (auto _ : state)
+  {
+    std::shared_ptr<dynamics::Skeleton> clone = skel->cloneSkeleton();
+    benchmark::DoNotOptimize(clone.get());
+  }
+}
+// Register the function as a benchmark
+BENCHMARK(BM_CloneSkeleton)->Unit(benchmark::kMicrosecond);
+
+static void BM_CloneWorld(benchmark::State& state)
+{
+  std::shared_ptr<simulation::World> world = simulation::World::create();
+  world->addSkeleton(loadRajagopal());
+  for (auto _ : state)
+  {
+    std::shared_ptr<simulation::World> clone = world->clone();
+    benchmark::DoNotOptimize(clone.get());
+  }
+}
+// Register the function as a benchmark
+BENCHMARK(BM_CloneWorld)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
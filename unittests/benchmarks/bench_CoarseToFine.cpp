@@ -0,0 +1,89 @@
+#include <cmath>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "dart/biomechanics/MarkerFitter.hpp"
+#include "dart/biomechanics/OpenSimParser.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/math/MathTypes.hpp"
+
+using namespace dart;
+using namespace biomechanics;
+
+// These run the whole kinematics pipeline on a long synthetic trial of the
+// Rajagopal model at 200Hz, `state.range(0)` seconds long, with a
+// coarse-to-fine decimation of `state.range(1)` (1 means every stage runs at
+// the full rate). 600 seconds is a 10 minute trial.
+
+static std::vector<std::map<std::string, Eigen::Vector3s>>
+createSyntheticTrial(OpenSimFile& osim, int numFrames)
+{
+  std::shared_ptr<dynamics::Skeleton> skel = osim.skeleton;
+  Eigen::VectorXs phases = Eigen::VectorXs::Zero(skel->getNumDofs());
+  for (int i = 0; i < skel->getNumDofs(); i++)
+  {
+    phases(i) = i * 0.7;
+  }
+
+  std::vector<std::map<std::string, Eigen::Vector3s>> markerObservations;
+  for (int t = 0; t < numFrames; t++)
+  {
+    s_t time = t / 200.0;
+    Eigen::VectorXs pose = Eigen::VectorXs::Zero(skel->getNumDofs());
+    for (int i = 0; i < skel->getNumDofs(); i++)
+    {
+      pose(i) = 0.2 * sin(2 * M_PI * time + phases(i));
+    }
+    // Walk forward, and stand at roughly the right height
+    pose(3) = time;
+    pose(4) = 1.0;
+    skel->setPositions(pose);
+    markerObservations.push_back(
+        skel->getMarkerMapWorldPositions(osim.markersMap));
+  }
+  return markerObservations;
+}
+
+static void BM_MarkerFitter_RunKinematicsPipeline(benchmark::State& state)
+{
+  OpenSimFile osim = OpenSimParser::parseOsim(
+      "dart://sample/osim/Rajagopal2015/Rajagopal2015.osim");
+  std::vector<std::map<std::string, Eigen::Vector3s>> markerObservations
+      = createSyntheticTrial(osim, state.range(0) * 200);
+  std::vector<bool> newClip;
+  for (int t = 0; t < markerObservations.size(); t++)
+  {
+    newClip.push_back(t == 0);
+  }
+  osim.skeleton->setPositions(
+      Eigen::VectorXs::Zero(osim.skeleton->getNumDofs()));
+
+  MarkerFitter fitter(osim.skeleton, osim.markersMap);
+  fitter.setInitialIKSatisfactoryLoss(1e-5);
+  fitter.setInitialIKMaxRestarts(50);
+  fitter.setIterationLimit(100);
+  fitter.setTrackingMarkers(osim.trackingMarkers);
+
+  for (auto _ : state)
+  {
+    MarkerInitialization init = fitter.runKinematicsPipeline(
+        markerObservations,
+        newClip,
+        InitialMarkerFitParams().setCoarseToFineDecimation(state.range(1)));
+    benchmark::DoNotOptimize(init.poses.data());
+  }
+  state.SetItemsProcessed(state.iterations() * markerObservations.size());
+}
+// Register the function as a benchmark
+BENCHMARK(BM_MarkerFitter_RunKinematicsPipeline)
+    ->Args({60, 1})
+    ->Args({60, 8})
+    ->Args({600, 1})
+    ->Args({600, 8})
+    ->Iterations(1)
+    ->Unit(benchmark::kSecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,90 @@
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/BoxShape.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/dynamics/WeldJoint.hpp"
+#include "dart/neural/BackpropSnapshot.hpp"
+#include "dart/neural/NeuralUtils.hpp"
+#include "dart/simulation/World.hpp"
+
+using namespace dart;
+using namespace dynamics;
+using namespace simulation;
+using namespace neural;
+
+// These time building the constraint force Jacobians of every clamping
+// contact in a world with a 5x5 grid of boxes resting on the floor, which is
+// a few hundred contact constraints over 150 DOFs. Each iteration takes a
+// fresh snapshot (untimed), so none of the per-contact caches are warm.
+// `state.range(0)` is World::setContactGradientThreads().
+
+static std::shared_ptr<World> createBoxGridWorld()
+{
+  std::shared_ptr<World> world = World::create();
+  world->setGravity(Eigen::Vector3s::UnitY() * -9.81);
+  world->setPenetrationCorrectionEnabled(false);
+
+  for (int x = 0; x < 5; x++)
+  {
+    for (int z = 0; z < 5; z++)
+    {
+      SkeletonPtr box
+          = Skeleton::create("box_" + std::to_string(x) + std::to_string(z));
+      std::pair<FreeJoint*, BodyNode*> pair
+          = box->createJointAndBodyNodePair<FreeJoint>(nullptr);
+      pair.second->createShapeNodeWith<VisualAspect, CollisionAspect>(
+          std::make_shared<BoxShape>(Eigen::Vector3s(0.5, 0.5, 0.5)));
+      pair.second->setFrictionCoeff(1.0);
+      world->addSkeleton(box);
+      // Sink each box 1cm into the floor, so all four bottom corners touch
+      box->setPosition(3, x - 2.0);
+      box->setPosition(4, 0.25 - 1e-2);
+      box->setPosition(5, z - 2.0);
+    }
+  }
+
+  SkeletonPtr floor = Skeleton::create("floor");
+  std::pair<WeldJoint*, BodyNode*> floorPair
+      = floor->createJointAndBodyNodePair<WeldJoint>(nullptr);
+  Eigen::Isometry3s floorPosition = Eigen::Isometry3s::Identity();
+  floorPosition.translation() = Eigen::Vector3s(0, -0.5, 0);
+  floorPair.first->setTransformFromParentBodyNode(floorPosition);
+  floorPair.second->createShapeNodeWith<VisualAspect, CollisionAspect>(
+      std::make_shared<BoxShape>(Eigen::Vector3s(10.0, 1.0, 10.0)));
+  floorPair.second->setFrictionCoeff(1.0);
+  world->addSkeleton(floor);
+
+  return world;
+}
+
+static void BM_ClampingConstraintJacobians(benchmark::State& state)
+{
+  std::shared_ptr<World> world = createBoxGridWorld();
+  world->setContactGradientThreads(state.range(0));
+
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    std::shared_ptr<BackpropSnapshot> snapshot
+        = neural::forwardPass(world, true);
+    Eigen::VectorXs f0 = snapshot->getClampingConstraintImpulses();
+    state.counters["clamping"] = f0.size();
+    state.ResumeTiming();
+
+    benchmark::DoNotOptimize(
+        snapshot->getJacobianOfClampingConstraints(world, f0));
+  }
+}
+BENCHMARK(BM_ClampingConstraintJacobians)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
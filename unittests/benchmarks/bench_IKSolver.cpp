@@ -0,0 +1,125 @@
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "dart/biomechanics/OpenSimParser.hpp"
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/math/IKSolver.hpp"
+#include "dart/math/MathTypes.hpp"
+
+using namespace dart;
+using namespace biomechanics;
+
+// These time the random-restart search that IKInitializer::estimatePosesWithIK
+// runs at the start of every clip: marker IK on the ball joint version of the
+// Rajagopal model, from 100 restarts. `state.range(0)` is the number of
+// problem copies, so 1 is the serial solveIK() and anything more runs the
+// restarts in batches through solveIKParallel().
+
+struct BallJointIKQuery
+{
+  std::shared_ptr<dynamics::Skeleton> skel;
+  std::vector<std::shared_ptr<dynamics::Skeleton>> skels;
+  std::vector<std::shared_ptr<dynamics::Skeleton>> ballSkels;
+  dynamics::MarkerMap markers;
+  Eigen::VectorXs markerTarget;
+};
+
+static BallJointIKQuery createBallJointIKQuery(int numCopies)
+{
+  BallJointIKQuery query;
+  OpenSimFile osim = OpenSimParser::parseOsim(
+      "dart://sample/osim/Rajagopal2015/Rajagopal2015.osim");
+  query.skel = osim.skeleton;
+  query.markers = osim.markersMap;
+  srand(42);
+  query.skel->setPositions(query.skel->getRandomPose());
+  std::vector<std::pair<dynamics::BodyNode*, Eigen::Vector3s>> markers;
+  for (auto& pair : query.markers)
+  {
+    markers.push_back(pair.second);
+  }
+  query.markerTarget = query.skel->getMarkerWorldPositions(markers);
+  query.skel->setPositions(Eigen::VectorXs::Zero(query.skel->getNumDofs()));
+  for (int i = 0; i < numCopies; i++)
+  {
+    query.skels.push_back(query.skel->cloneSkeleton());
+    query.ballSkels.push_back(
+        query.skels.back()->convertSkeletonToBallJoints());
+  }
+  return query;
+}
+
+static math::IKProblemCopy createIKProblemCopy(BallJointIKQuery& query, int i)
+{
+  std::shared_ptr<dynamics::Skeleton> skel = query.skels[i];
+  std::shared_ptr<dynamics::Skeleton> ballSkel = query.ballSkels[i];
+  std::vector<std::pair<dynamics::BodyNode*, Eigen::Vector3s>> markers;
+  for (auto& pair : query.markers)
+  {
+    markers.emplace_back(
+        ballSkel->getBodyNode(pair.second.first->getName()),
+        pair.second.second);
+  }
+  Eigen::VectorXs markerTarget = query.markerTarget;
+
+  math::IKProblemCopy copy;
+  copy.setPosAndClamp
+      = [skel, ballSkel](const Eigen::VectorXs& pos, bool clamp) {
+          ballSkel->setPositions(pos);
+          if (clamp)
+          {
+            skel->setPositions(skel->convertPositionsFromBallSpace(pos));
+            skel->clampPositionsToLimits();
+            ballSkel->setPositions(
+                skel->convertPositionsToBallSpace(skel->getPositions()));
+          }
+          return ballSkel->getPositions();
+        };
+  copy.eval = [ballSkel, markers, markerTarget](
+                  Eigen::Ref<Eigen::VectorXs> diff,
+                  Eigen::Ref<Eigen::MatrixXs> jac) {
+    diff = ballSkel->getMarkerWorldPositions(markers) - markerTarget;
+    jac = ballSkel->getMarkerWorldPositionsJacobianWrtJointPositions(markers);
+  };
+  return copy;
+}
+
+static void BM_IKSolver_BallJointRestarts(benchmark::State& state)
+{
+  BallJointIKQuery query = createBallJointIKQuery(state.range(0));
+  std::vector<math::IKProblemCopy> copies;
+  for (int i = 0; i < state.range(0); i++)
+  {
+    copies.push_back(createIKProblemCopy(query, i));
+  }
+  std::shared_ptr<dynamics::Skeleton> restartSkel = query.ballSkels[0];
+  for (auto _ : state)
+  {
+    srand(42);
+    s_t loss = math::solveIKParallel(
+        query.skel->convertPositionsToBallSpace(
+            Eigen::VectorXs::Zero(query.skel->getNumDofs())),
+        query.skel->getPositionUpperLimits(),
+        query.skel->getPositionLowerLimits(),
+        query.markerTarget.size(),
+        copies,
+        [&](Eigen::Ref<Eigen::VectorXs> pos) {
+          pos = restartSkel->getRandomPose();
+        },
+        math::IKConfig().setMaxRestarts(100).setConvergenceThreshold(1e-10));
+    benchmark::DoNotOptimize(loss);
+  }
+}
+// Register the function as a benchmark
+BENCHMARK(BM_IKSolver_BallJointRestarts)
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(8)
+    ->Arg(16)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
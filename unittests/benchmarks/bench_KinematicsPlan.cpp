@@ -0,0 +1,112 @@
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "dart/biomechanics/OpenSimParser.hpp"
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/Joint.hpp"
+#include "dart/dynamics/KinematicsPlan.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/math/MathTypes.hpp"
+
+using namespace dart;
+using namespace biomechanics;
+using namespace dynamics;
+
+// These compare the Skeleton marker/joint queries that MarkerFitter and
+// IKInitializer make on every iteration against a KinematicsPlan, evaluating
+// positions and Jacobians for `state.range(0)` random poses of the Rajagopal
+// model, with a marker set shaped like a typical lab capture.
+
+struct RajagopalQuery
+{
+  std::shared_ptr<Skeleton> skel;
+  std::vector<std::pair<BodyNode*, Eigen::Vector3s>> markers;
+  std::vector<Joint*> joints;
+  Eigen::MatrixXs poses;
+};
+
+static RajagopalQuery createRajagopalQuery(int numPoses)
+{
+  RajagopalQuery query;
+  query.skel = OpenSimParser::parseOsim(
+                   "dart://sample/osim/Rajagopal2015/Rajagopal2015.osim")
+                   .skeleton;
+  srand(42);
+  // 4 markers per body comes out at roughly the size of a 90-marker set
+  for (int i = 0; i < query.skel->getNumBodyNodes(); i++)
+  {
+    for (int j = 0; j < 4; j++)
+    {
+      query.markers.push_back(std::make_pair(
+          query.skel->getBodyNode(i), Eigen::Vector3s::Random() * 0.1));
+    }
+  }
+  for (int i = 0; i < query.skel->getNumJoints(); i++)
+  {
+    query.joints.push_back(query.skel->getJoint(i));
+  }
+  query.poses = Eigen::MatrixXs::Zero(query.skel->getNumDofs(), numPoses);
+  for (int t = 0; t < numPoses; t++)
+  {
+    query.poses.col(t) = query.skel->getRandomPose();
+  }
+  return query;
+}
+
+static void BM_Skeleton_MarkerAndJointJacobians(benchmark::State& state)
+{
+  RajagopalQuery query = createRajagopalQuery(state.range(0));
+  for (auto _ : state)
+  {
+    for (int t = 0; t < query.poses.cols(); t++)
+    {
+      query.skel->setPositions(query.poses.col(t));
+      Eigen::VectorXs markerPositions
+          = query.skel->getMarkerWorldPositions(query.markers);
+      Eigen::VectorXs jointPositions
+          = query.skel->getJointWorldPositions(query.joints);
+      Eigen::MatrixXs markerJac
+          = query.skel->getMarkerWorldPositionsJacobianWrtJointPositions(
+              query.markers);
+      Eigen::MatrixXs jointJac
+          = query.skel->getJointWorldPositionsJacobianWrtJointPositions(
+              query.joints);
+      benchmark::DoNotOptimize(markerPositions.data());
+      benchmark::DoNotOptimize(jointPositions.data());
+      benchmark::DoNotOptimize(markerJac.data());
+      benchmark::DoNotOptimize(jointJac.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * query.poses.cols());
+}
+// Register the function as a benchmark
+BENCHMARK(BM_Skeleton_MarkerAndJointJacobians)
+    ->Arg(10)
+    ->Arg(100)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_KinematicsPlan_MarkerAndJointJacobians(benchmark::State& state)
+{
+  RajagopalQuery query = createRajagopalQuery(state.range(0));
+  KinematicsPlan plan(query.skel, query.markers, query.joints);
+  for (auto _ : state)
+  {
+    Eigen::MatrixXs positions = plan.getWorldPositionsForPoses(query.poses);
+    std::vector<Eigen::SparseMatrix<s_t, Eigen::RowMajor>> jacs
+        = plan.getWorldPositionsJacobiansWrtJointPositionsForPoses(
+            query.poses);
+    benchmark::DoNotOptimize(positions.data());
+    benchmark::DoNotOptimize(jacs.data());
+  }
+  state.SetItemsProcessed(state.iterations() * query.poses.cols());
+}
+// Register the function as a benchmark
+BENCHMARK(BM_KinematicsPlan_MarkerAndJointJacobians)
+    ->Arg(10)
+    ->Arg(100)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
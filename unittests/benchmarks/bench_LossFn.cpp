@@ -0,0 +1,118 @@
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/BoxShape.hpp"
+#include "dart/dynamics/RevoluteJoint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/simulation/World.hpp"
+#include "dart/trajectory/LossFn.hpp"
+#include "dart/trajectory/SingleShot.hpp"
+#include "dart/trajectory/TrajectoryRollout.hpp"
+
+using namespace dart;
+using namespace trajectory;
+
+// These time scoring `state.range(0)` candidate rollouts of 50 steps on a
+// 10 dof chain, with a tracking + effort + terminal state loss. The first
+// builds a TrajectoryRolloutReal for each candidate and calls a
+// std::function loss on it, which is what callers had to do before
+// TrajectoryRolloutBatch. The second uses the built-in terms on a batch.
+
+static const int STEPS = 50;
+
+static std::shared_ptr<simulation::World> createChainWorld()
+{
+  std::shared_ptr<simulation::World> world = simulation::World::create();
+  std::shared_ptr<dynamics::Skeleton> chain = dynamics::Skeleton::create();
+  dynamics::BodyNode* parent = nullptr;
+  for (int i = 0; i < 10; i++)
+  {
+    dynamics::RevoluteJoint::Properties jointProps;
+    jointProps.mT_ParentBodyToJoint.translation()
+        = Eigen::Vector3s(0, parent == nullptr ? 0 : -0.5, 0);
+    auto pair = chain->createJointAndBodyNodePair<dynamics::RevoluteJoint>(
+        parent, jointProps);
+    pair.second->createShapeNodeWith<dynamics::VisualAspect>(
+        std::make_shared<dynamics::BoxShape>(Eigen::Vector3s(0.1, 0.5, 0.1)));
+    parent = pair.second;
+  }
+  world->addSkeleton(chain);
+  return world;
+}
+
+static void BM_LossPerCandidate(benchmark::State& state)
+{
+  std::shared_ptr<simulation::World> world = createChainWorld();
+  int dofs = world->getNumDofs();
+  SingleShot shot(world, LossFn(), STEPS);
+  int numCandidates = state.range(0);
+  TrajectoryRolloutBatch batch(&shot, numCandidates);
+  batch.getAll()->getPoses().setRandom();
+  batch.getAll()->getVels().setRandom();
+  batch.getAll()->getControlForces().setRandom();
+
+  Eigen::MatrixXs targetPoses = Eigen::MatrixXs::Random(dofs, STEPS);
+  Eigen::VectorXs targetPos = Eigen::VectorXs::Random(dofs);
+  LossFn loss([&](const TrajectoryRollout* rollout) {
+    const Eigen::MatrixXs& poses = rollout->getPosesConst();
+    const Eigen::MatrixXs& vels = rollout->getVelsConst();
+    return (poses - targetPoses).squaredNorm()
+           + 1e-3 * rollout->getControlForcesConst().squaredNorm()
+           + (poses.col(STEPS - 1) - targetPos).squaredNorm()
+           + vels.col(STEPS - 1).squaredNorm();
+  });
+
+  Eigen::VectorXs losses = Eigen::VectorXs::Zero(numCandidates);
+  for (auto _ : state)
+  {
+    for (int i = 0; i < numCandidates; i++)
+    {
+      const TrajectoryRolloutConstRef view = batch.getCandidateConst(i);
+      TrajectoryRolloutReal candidate = TrajectoryRolloutReal(&view);
+      losses(i) = loss.getLoss(&candidate);
+    }
+    benchmark::DoNotOptimize(losses.data());
+  }
+}
+// Register the function as a benchmark
+BENCHMARK(BM_LossPerCandidate)
+    ->Arg(16)
+    ->Arg(64)
+    ->Arg(256)
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_LossBatch(benchmark::State& state)
+{
+  std::shared_ptr<simulation::World> world = createChainWorld();
+  int dofs = world->getNumDofs();
+  SingleShot shot(world, LossFn(), STEPS);
+  int numCandidates = state.range(0);
+  TrajectoryRolloutBatch batch(&shot, numCandidates);
+  batch.getAll()->getPoses().setRandom();
+  batch.getAll()->getVels().setRandom();
+  batch.getAll()->getControlForces().setRandom();
+
+  LossFn loss(std::vector<LossTerm>{
+      LossTerm::tracking(Eigen::MatrixXs::Random(dofs, STEPS)),
+      LossTerm::effort(1e-3),
+      LossTerm::terminalState(
+          Eigen::VectorXs::Random(dofs), Eigen::VectorXs::Zero(dofs))});
+
+  Eigen::VectorXs losses = Eigen::VectorXs::Zero(numCandidates);
+  for (auto _ : state)
+  {
+    loss.getLossBatch(&batch, losses);
+    benchmark::DoNotOptimize(losses.data());
+  }
+}
+// Register the function as a benchmark
+BENCHMARK(BM_LossBatch)
+    ->Arg(16)
+    ->Arg(64)
+    ->Arg(256)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,91 @@
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/RevoluteJoint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/realtime/MPCLocal.hpp"
+#include "dart/realtime/MPCRemote.hpp"
+#include "dart/realtime/SharedMemoryChannel.hpp"
+#include "dart/simulation/World.hpp"
+#include "dart/trajectory/LossFn.hpp"
+
+using namespace dart;
+using namespace realtime;
+
+// These time how long an observation takes to get from an MPCRemote to the
+// MPCLocal planning for it, on the same host. The planner is never started,
+// so nothing else competes for the CPU.
+
+static std::shared_ptr<simulation::World> createChainWorld()
+{
+  std::shared_ptr<simulation::World> world = simulation::World::create();
+  std::shared_ptr<dynamics::Skeleton> chain = dynamics::Skeleton::create();
+  dynamics::BodyNode* parent = nullptr;
+  for (int i = 0; i < 5; i++)
+  {
+    auto pair
+        = chain->createJointAndBodyNodePair<dynamics::RevoluteJoint>(parent);
+    parent = pair.second;
+  }
+  world->addSkeleton(chain);
+  return world;
+}
+
+static void BM_GrpcObservationLatency(benchmark::State& state)
+{
+  std::shared_ptr<simulation::World> world = createChainWorld();
+  MPCLocal local(world, std::make_shared<trajectory::LossFn>(), 100);
+
+  // MPCLocal::serve() never returns, so the server lives until we exit
+  int port = (rand() % 2000) + 4000;
+  std::thread server([&local, port]() { local.serve(port); });
+  server.detach();
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  MPCRemote remote("localhost", port, world->getNumDofs(), 100, 1);
+
+  Eigen::VectorXs pos = world->getPositions();
+  Eigen::VectorXs vel = world->getVelocities();
+  Eigen::VectorXs mass = world->getMasses();
+  long time = 0;
+  for (auto _ : state)
+  {
+    // This is a unary RPC, so it returns once the planner has the observation
+    remote.recordGroundTruthState(time++, pos, vel, mass);
+  }
+}
+BENCHMARK(BM_GrpcObservationLatency)->Unit(benchmark::kMicrosecond);
+
+static void BM_SharedMemoryObservationLatency(benchmark::State& state)
+{
+  std::shared_ptr<simulation::World> world = createChainWorld();
+  MPCLocal local(world, std::make_shared<trajectory::LossFn>(), 100);
+
+  std::shared_ptr<SharedMemoryChannel> channel
+      = std::make_shared<SharedMemoryChannel>();
+  std::thread server([&local, channel]() { local.serveSharedMemory(channel); });
+  MPCRemote remote(channel, world->getNumDofs(), 100, 1);
+
+  Eigen::VectorXs pos = world->getPositions();
+  Eigen::VectorXs vel = world->getVelocities();
+  Eigen::VectorXs mass = world->getMasses();
+  long time = 0;
+  for (auto _ : state)
+  {
+    remote.recordGroundTruthState(time++, pos, vel, mass);
+    // Sending doesn't wait, so wait until the planner has handled it
+    while (!channel->isPlannerCaughtUp())
+    {
+    }
+  }
+
+  channel->close();
+  server.join();
+}
+BENCHMARK(BM_SharedMemoryObservationLatency)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,96 @@
+#include <cmath>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "dart/biomechanics/MarkerFixer.hpp"
+#include "dart/biomechanics/MarkerLabeller.hpp"
+#include "dart/math/MathTypes.hpp"
+
+using namespace dart;
+using namespace biomechanics;
+
+// This makes a synthetic optical capture at 200Hz: `numMarkers` markers
+// scattered over a 2m cube, each moving along its own smooth path, with a few
+// percent of the observations dropped on every frame.
+static std::vector<std::map<std::string, Eigen::Vector3s>>
+createSyntheticMarkers(int numMarkers, int numFrames)
+{
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+  std::vector<Eigen::Vector3s> centers;
+  std::vector<Eigen::Vector3s> phases;
+  for (int i = 0; i < numMarkers; i++)
+  {
+    centers.push_back(
+        Eigen::Vector3s(uniform(gen), uniform(gen), uniform(gen)));
+    phases.push_back(
+        Eigen::Vector3s(uniform(gen), uniform(gen), uniform(gen)) * M_PI);
+  }
+
+  std::vector<std::map<std::string, Eigen::Vector3s>> markerObservations;
+  for (int t = 0; t < numFrames; t++)
+  {
+    s_t time = t / 200.0;
+    markerObservations.emplace_back();
+    for (int i = 0; i < numMarkers; i++)
+    {
+      if (uniform(gen) > 0.95)
+        continue;
+      Eigen::Vector3s offset;
+      for (int axis = 0; axis < 3; axis++)
+        offset(axis) = 0.1 * sin(2 * M_PI * time + phases[i](axis));
+      markerObservations.back()["M" + std::to_string(i)] = centers[i] + offset;
+    }
+  }
+  return markerObservations;
+}
+
+static void BM_MarkerTrace_CreateRawTraces(benchmark::State& state)
+{
+  std::vector<std::vector<Eigen::Vector3s>> pointClouds;
+  for (auto& frame : createSyntheticMarkers(state.range(0), 1000))
+  {
+    pointClouds.emplace_back();
+    for (auto& pair : frame)
+    {
+      pointClouds.back().push_back(pair.second);
+    }
+  }
+  for (auto _ : state)
+  {
+    std::vector<MarkerTrace> traces = MarkerTrace::createRawTraces(pointClouds);
+    benchmark::DoNotOptimize(traces.data());
+  }
+  state.SetItemsProcessed(state.iterations() * pointClouds.size());
+}
+// Register the function as a benchmark
+BENCHMARK(BM_MarkerTrace_CreateRawTraces)
+    ->Arg(50)
+    ->Arg(150)
+    ->Arg(300)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_LabeledMarkerTrace_CreateRawTraces(benchmark::State& state)
+{
+  std::vector<std::map<std::string, Eigen::Vector3s>> markerObservations
+      = createSyntheticMarkers(state.range(0), 1000);
+  for (auto _ : state)
+  {
+    std::vector<LabeledMarkerTrace> traces
+        = LabeledMarkerTrace::createRawTraces(markerObservations);
+    benchmark::DoNotOptimize(traces.data());
+  }
+  state.SetItemsProcessed(state.iterations() * markerObservations.size());
+}
+// Register the function as a benchmark
+BENCHMARK(BM_LabeledMarkerTrace_CreateRawTraces)
+    ->Arg(50)
+    ->Arg(150)
+    ->Arg(300)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
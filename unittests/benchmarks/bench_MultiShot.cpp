@@ -0,0 +1,67 @@
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+#include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/BoxShape.hpp"
+#include "dart/dynamics/RevoluteJoint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/simulation/World.hpp"
+#include "dart/trajectory/LossFn.hpp"
+#include "dart/trajectory/MultiShot.hpp"
+
+using namespace dart;
+using namespace trajectory;
+
+// These time the work MultiShot does on every IPOPT iteration (a new x, then
+// the constraints and the sparse Jacobian), for `state.range(0)` shots of 10
+// steps each, either serially (`state.range(1)` == 0) or on the per-shot
+// worker threads.
+
+static std::shared_ptr<simulation::World> createChainWorld()
+{
+  std::shared_ptr<simulation::World> world = simulation::World::create();
+  std::shared_ptr<dynamics::Skeleton> chain = dynamics::Skeleton::create();
+  dynamics::BodyNode* parent = nullptr;
+  for (int i = 0; i < 5; i++)
+  {
+    dynamics::RevoluteJoint::Properties jointProps;
+    jointProps.mT_ParentBodyToJoint.translation()
+        = Eigen::Vector3s(0, parent == nullptr ? 0 : -0.5, 0);
+    auto pair = chain->createJointAndBodyNodePair<dynamics::RevoluteJoint>(
+        parent, jointProps);
+    pair.second->createShapeNodeWith<dynamics::VisualAspect>(
+        std::make_shared<dynamics::BoxShape>(Eigen::Vector3s(0.1, 0.5, 0.1)));
+    parent = pair.second;
+  }
+  world->addSkeleton(chain);
+  return world;
+}
+
+static void BM_MultiShotIteration(benchmark::State& state)
+{
+  std::shared_ptr<simulation::World> world = createChainWorld();
+  int numShots = state.range(0);
+  MultiShot shot(world, LossFn(), numShots * 10, 10, true);
+  shot.setParallelOperationsEnabled(state.range(1) != 0);
+
+  Eigen::VectorXs flat = Eigen::VectorXs::Zero(shot.getFlatProblemDim(world));
+  shot.Problem::flatten(world, flat);
+  Eigen::VectorXs constraints = Eigen::VectorXs::Zero(shot.getConstraintDim());
+  Eigen::VectorXs sparse
+      = Eigen::VectorXs::Zero(shot.getNumberNonZeroJacobian(world));
+  for (auto _ : state)
+  {
+    // Setting a new x dirties the rollout cache, like IPOPT does
+    shot.Problem::unflatten(world, flat);
+    shot.computeConstraints(world, constraints);
+    shot.Problem::getSparseJacobian(world, sparse);
+    benchmark::DoNotOptimize(sparse.data());
+  }
+}
+// Register the function as a benchmark
+BENCHMARK(BM_MultiShotIteration)
+    ->ArgsProduct({{1, 2, 4, 8, 16, 32, 64}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
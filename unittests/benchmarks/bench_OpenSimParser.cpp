@@ -0,0 +1,170 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "dart/biomechanics/ForcePlate.hpp"
+#include "dart/biomechanics/OpenSimParser.hpp"
+#include "dart/biomechanics/SkeletonSnapshot.hpp"
+#include "dart/common/Uri.hpp"
+
+using namespace dart;
+using namespace biomechanics;
+
+// These write synthetic files shaped like real lab exports (52 markers for the
+// TRC, 2 plates for the GRF) with `state.range(0)` frames, so that the largest
+// sizes are several hundred MB on disk.
+
+static std::string writeSyntheticTRC(int numFrames, int numMarkers)
+{
+  std::string path = (std::filesystem::temp_directory_path()
+                      / ("bench_OpenSimParser_" + std::to_string(numFrames)
+                         + ".trc"))
+                         .string();
+  if (std::filesystem::exists(path))
+    return path;
+
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dist(-1500.0, 1500.0);
+  std::ofstream file(path);
+  file << "PathFileType\t4\t(X/Y/Z)\t" << path << "\n";
+  file << "DataRate\tCameraRate\tNumFrames\tNumMarkers\tUnits\tOrigDataRate"
+          "\tOrigDataStartFrame\tOrigNumFrames\n";
+  file << "100\t100\t" << numFrames << "\t" << numMarkers << "\tmm\t100\t0\t"
+       << numFrames << "\n";
+  file << "Frame#\tTime";
+  for (int i = 0; i < numMarkers; i++)
+    file << "\tM" << i << "\t\t";
+  file << "\n\t";
+  for (int i = 0; i < numMarkers; i++)
+    file << "\tX" << (i + 1) << "\tY" << (i + 1) << "\tZ" << (i + 1);
+  file << "\n\n";
+
+  char buf[32];
+  for (int t = 0; t < numFrames; t++)
+  {
+    file << (t + 1) << "\t" << (t * 0.01);
+    for (int i = 0; i < numMarkers * 3; i++)
+    {
+      std::snprintf(buf, sizeof(buf), "\t%.13f", dist(gen));
+      file << buf;
+    }
+    file << "\n";
+  }
+  return path;
+}
+
+static std::string writeSyntheticGRF(int numFrames)
+{
+  std::string path = (std::filesystem::temp_directory_path()
+                      / ("bench_OpenSimParser_" + std::to_string(numFrames)
+                         + "_grf.mot"))
+                         .string();
+  if (std::filesystem::exists(path))
+    return path;
+
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dist(-800.0, 800.0);
+  std::ofstream file(path);
+  file << "name " << path << "\ndatacolumns 19\ndatarows " << numFrames
+       << "\nrange 0 " << (numFrames * 0.001) << "\nendheader\n";
+  file << "time";
+  for (std::string side : {"r", "l"})
+  {
+    file << "\tground_force_" << side << "_vx\tground_force_" << side
+         << "_vy\tground_force_" << side << "_vz\tground_force_" << side
+         << "_px\tground_force_" << side << "_py\tground_force_" << side
+         << "_pz\tground_torque_" << side << "_x\tground_torque_" << side
+         << "_y\tground_torque_" << side << "_z";
+  }
+  file << "\n";
+
+  char buf[32];
+  for (int t = 0; t < numFrames; t++)
+  {
+    file << (t * 0.001);
+    for (int i = 0; i < 18; i++)
+    {
+      std::snprintf(buf, sizeof(buf), "\t%.12f", dist(gen));
+      file << buf;
+    }
+    file << "\n";
+  }
+  return path;
+}
+
+static void BM_LoadTRC(benchmark::State& state)
+{
+  std::string path = writeSyntheticTRC(state.range(0), 52);
+  common::Uri uri = common::Uri::createFromPath(path);
+  for (auto _ : state)
+  {
+    OpenSimTRC trc = OpenSimParser::loadTRC(uri);
+    benchmark::DoNotOptimize(trc.markerTimesteps.data());
+  }
+  state.SetBytesProcessed(
+      (int64_t)state.iterations() * std::filesystem::file_size(path));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_LoadTRC)
+    ->Arg(1000)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_LoadGRF(benchmark::State& state)
+{
+  std::string path = writeSyntheticGRF(state.range(0));
+  common::Uri uri = common::Uri::createFromPath(path);
+  for (auto _ : state)
+  {
+    std::vector<ForcePlate> plates = OpenSimParser::loadGRF(uri);
+    benchmark::DoNotOptimize(plates.data());
+  }
+  state.SetBytesProcessed(
+      (int64_t)state.iterations() * std::filesystem::file_size(path));
+}
+// Register the function as a benchmark
+BENCHMARK(BM_LoadGRF)
+    ->Arg(10000)
+    ->Arg(100000)
+    ->Arg(1000000)
+    ->Unit(benchmark::kMillisecond);
+
+// These compare loading a full-body model from the .osim XML against loading
+// the same model from a precompiled SkeletonSnapshot
+
+static const std::string RAJAGOPAL_PATH
+    = "dart://sample/osim/Rajagopal2015/Rajagopal2015.osim";
+
+static void BM_ParseOsim(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    OpenSimFile file = OpenSimParser::parseOsim(RAJAGOPAL_PATH);
+    benchmark::DoNotOptimize(file.skeleton.get());
+  }
+}
+// Register the function as a benchmark
+BENCHMARK(BM_ParseOsim)->Unit(benchmark::kMillisecond);
+
+static void BM_ReadSkeletonSnapshot(benchmark::State& state)
+{
+  std::string path = (std::filesystem::temp_directory_path()
+                      / "bench_OpenSimParser_Rajagopal2015.bin")
+                         .string();
+  SkeletonSnapshot::writeOpenSimFile(
+      path, OpenSimParser::parseOsim(RAJAGOPAL_PATH));
+  for (auto _ : state)
+  {
+    OpenSimFile file = SkeletonSnapshot::readOpenSimFile(path);
+    benchmark::DoNotOptimize(file.skeleton.get());
+  }
+}
+// Register the function as a benchmark
+BENCHMARK(BM_ReadSkeletonSnapshot)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
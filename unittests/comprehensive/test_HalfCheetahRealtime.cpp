@@ -46,6 +46,7 @@
 #include "dart/realtime/MPC.hpp"
 #include "dart/realtime/MPCLocal.hpp"
 #include "dart/realtime/MPCRemote.hpp"
+#include "dart/realtime/Millis.hpp"
 #include "dart/realtime/SSID.hpp"
 #include "dart/realtime/Ticker.hpp"
 #include "dart/server/GUIWebsocketServer.hpp"
@@ -53,6 +54,7 @@
 #include "dart/trajectory/IPOptOptimizer.hpp"
 #include "dart/trajectory/LossFn.hpp"
 #include "dart/trajectory/MultiShot.hpp"
+#include "dart/trajectory/Solution.hpp"
 #include "dart/utils/DartResourceRetriever.hpp"
 #include "dart/utils/UniversalLoader.hpp"
 #include "dart/utils/sdf/sdf.hpp"
@@ -398,6 +400,98 @@ TEST(REALTIME, HALF_CHEETAH_PLOT)
   sfile<<solutionVec;
   sfile.close();
 }
+
+/// This replans the half cheetah `replans` times, every `millisPerReplan`
+/// millis, and returns the average number of IPOPT iterations per replan. If
+/// `changeMass` is true, every replan also reports a new mass, which forces
+/// MPCLocal to rebuild its problem, like it does when driven by SSID.
+s_t averageReplanIterations(
+    std::shared_ptr<simulation::World> world,
+    bool warmStart,
+    bool changeMass,
+    int replans,
+    int millisPerReplan)
+{
+  int millisPerTimestep = world->getTimeStep() * 1000;
+  int planningHorizonMillis = 100 * millisPerTimestep;
+
+  MPCLocal mpcLocal = MPCLocal(world, getMPCLoss(), planningHorizonMillis);
+  mpcLocal.setSilent(true);
+  mpcLocal.setMaxIterations(50);
+  mpcLocal.setEnableWarmStart(warmStart);
+
+  long startTime = timeSinceEpochMillis();
+  mpcLocal.recordGroundTruthState(
+      startTime,
+      world->getPositions(),
+      world->getVelocities(),
+      world->getMasses());
+  mpcLocal.optimizePlan(startTime);
+
+  std::shared_ptr<simulation::World> realWorld = world->clone();
+  int totalIterations = 0;
+  for (int i = 1; i <= replans; i++)
+  {
+    long time = startTime + i * millisPerReplan;
+    for (int t = 0; t < millisPerReplan / millisPerTimestep; t++)
+    {
+      long now = time - millisPerReplan + t * millisPerTimestep;
+      realWorld->setControlForces(mpcLocal.getControlForce(now));
+      realWorld->step();
+    }
+    mpcLocal.recordGroundTruthState(
+        time,
+        realWorld->getPositions(),
+        realWorld->getVelocities(),
+        realWorld->getMasses());
+    if (changeMass)
+    {
+      mpcLocal.setMasschange(1.0 + 0.01 * i);
+    }
+    mpcLocal.optimizePlan(time);
+    int iterations = mpcLocal.getCurrentSolution()->getIterationCount();
+    EXPECT_GE(iterations, 0);
+    totalIterations += iterations;
+  }
+  return (s_t)totalIterations / replans;
+}
+
+TEST(REALTIME, HALF_CHEETAH_WARM_START_BENCHMARK)
+{
+  std::shared_ptr<simulation::World> world = dart::utils::UniversalLoader::loadWorld(
+      "dart://sample/skel/half_cheetah.skel");
+  world->setPositions(Eigen::VectorXs::Zero(world->getNumDofs()));
+  world->setVelocities(Eigen::VectorXs::Zero(world->getNumDofs()));
+  Eigen::VectorXs forceLimits
+    = Eigen::VectorXs::Ones(world->getNumDofs()) * 100;
+  forceLimits(0) = 0;
+  forceLimits(1) = 0;
+  world->setControlForceUpperLimits(forceLimits);
+  world->setControlForceLowerLimits(-1 * forceLimits);
+  world->setTimeStep(1.0 / 1000);
+
+  int replans = 10;
+  int millisPerReplan = 10;
+
+  s_t coldAdvance
+      = averageReplanIterations(world, false, false, replans, millisPerReplan);
+  s_t warmAdvance
+      = averageReplanIterations(world, true, false, replans, millisPerReplan);
+  s_t coldRebuild
+      = averageReplanIterations(world, false, true, replans, millisPerReplan);
+  s_t warmRebuild
+      = averageReplanIterations(world, true, true, replans, millisPerReplan);
+
+  std::cout << "Average IPOPT iterations per replan:" << std::endl;
+  std::cout << "  Advancing plan:  cold " << coldAdvance << ", warm "
+            << warmAdvance << std::endl;
+  std::cout << "  Rebuilding plan: cold " << coldRebuild << ", warm "
+            << warmRebuild << std::endl;
+
+  // Warm starting from the shifted multipliers should never cost iterations
+  EXPECT_LE(warmAdvance, coldAdvance);
+  EXPECT_LE(warmRebuild, coldRebuild);
+}
 #endif
 
 #ifdef ALL_TESTS
@@ -357,4 +357,71 @@ TEST(GRADIENTS, WORLD_SPACE_BOXES_FREE_JOINT)
 {
   testWorldSpaceWithBoxes(2);
 }
-#endif
\ No newline at end of file
+#endif
+
+#ifdef ALL_TESTS
+TEST(IK_MAPPING, WARM_STARTED_TRAJECTORY)
+{
+  WorldPtr world = World::create();
+  SkeletonPtr arm = Skeleton::create("arm");
+  BodyNode* parent = nullptr;
+  for (int i = 0; i < 3; i++)
+  {
+    std::pair<RevoluteJoint*, BodyNode*> jointPair
+        = arm->createJointAndBodyNodePair<RevoluteJoint>(parent);
+    Eigen::Isometry3s armOffset = Eigen::Isometry3s::Identity();
+    armOffset.translation() = Eigen::Vector3s(0, 1.0, 0);
+    jointPair.first->setTransformFromParentBodyNode(armOffset);
+    jointPair.first->setAxis(Eigen::Vector3s(1, 0, 0));
+    parent = jointPair.second;
+  }
+  world->addSkeleton(arm);
+
+  std::shared_ptr<IKMapping> mapping = std::make_shared<IKMapping>(world);
+  for (dynamics::BodyNode* node : arm->getBodyNodes())
+  {
+    mapping->addSpatialBodyNode(node);
+  }
+
+  // A smooth trajectory, so each frame is a good warm start for the next
+  int numFrames = 20;
+  Eigen::MatrixXs poses = Eigen::MatrixXs::Zero(3, numFrames);
+  Eigen::MatrixXs targets
+      = Eigen::MatrixXs::Zero(mapping->getPosDim(), numFrames);
+  for (int t = 0; t < numFrames; t++)
+  {
+    poses.col(t) = Eigen::Vector3s(0.3, -0.2, 0.5) * sin(t * 0.1);
+    world->setPositions(poses.col(t));
+    targets.col(t) = mapping->getPositions(world);
+  }
+
+  // Cold solves, each starting from zero
+  EXPECT_FALSE(mapping->getWarmStart());
+  Eigen::MatrixXs solved = Eigen::MatrixXs::Zero(3, numFrames);
+  mapping->resetNumPosJacobianEvaluations();
+  for (int t = 0; t < numFrames; t++)
+  {
+    Eigen::VectorXs target = targets.col(t);
+    mapping->setPositions(world, target);
+    solved.col(t) = world->getPositions();
+  }
+  int coldJacobianEvaluations = mapping->getNumPosJacobianEvaluations();
+  EXPECT_TRUE(equals(solved, poses, 1e-6));
+
+  Eigen::MatrixXs trajectory = mapping->solveTrajectory(world, targets);
+  EXPECT_FALSE(mapping->getWarmStart());
+  EXPECT_TRUE(equals(trajectory, solved, 1e-6));
+
+  // Warm-started setPositions() should agree with the cold solves, while
+  // computing the Jacobian from scratch less often
+  mapping->setWarmStart(true);
+  mapping->resetNumPosJacobianEvaluations();
+  for (int t = 0; t < numFrames; t++)
+  {
+    Eigen::VectorXs target = targets.col(t);
+    mapping->setPositions(world, target);
+    EXPECT_TRUE(equals(world->getPositions(), solved.col(t).eval(), 1e-6));
+  }
+  EXPECT_LT(mapping->getNumPosJacobianEvaluations(), coldJacobianEvaluations);
+}
+#endif
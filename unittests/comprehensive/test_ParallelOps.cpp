@@ -40,10 +40,14 @@
 #include "dart/collision/CollisionObject.hpp"
 #include "dart/collision/Contact.hpp"
 #include "dart/dynamics/BodyNode.hpp"
+#include "dart/dynamics/BoxShape.hpp"
+#include "dart/dynamics/FreeJoint.hpp"
 #include "dart/dynamics/RevoluteJoint.hpp"
 #include "dart/dynamics/Skeleton.hpp"
+#include "dart/dynamics/WeldJoint.hpp"
 #include "dart/math/Geometry.hpp"
 #include "dart/neural/BackpropSnapshot.hpp"
+#include "dart/neural/BatchedTimestep.hpp"
 #include "dart/neural/ConstrainedGroupGradientMatrices.hpp"
 #include "dart/neural/DifferentiableContactConstraint.hpp"
 #include "dart/neural/IKMapping.hpp"
@@ -52,6 +56,7 @@
 #include "dart/neural/NeuralConstants.hpp"
 #include "dart/neural/NeuralUtils.hpp"
 #include "dart/neural/RestorableSnapshot.hpp"
+#include "dart/neural/WithRespectToMass.hpp"
 #include "dart/simulation/World.hpp"
 #include "dart/trajectory/IPOptOptimizer.hpp"
 #include "dart/trajectory/MultiShot.hpp"
@@ -820,4 +825,186 @@ TEST(TRAJECTORY, JUMP_WORM)
       std::cout << "Off on force-vel Jac at step " << i << std::endl;
     }
   }
+}
+
+// This is worth running in a -fsanitize=thread build too, since it's the one
+// test that drives computeConstraintForcesJacobians() across several threads
+TEST(CONTACT_JACOBIANS, THREADED_MATCHES_SERIAL)
+{
+  WorldPtr world = World::create();
+  world->setGravity(Eigen::Vector3s(0, -9.81, 0));
+  world->setPenetrationCorrectionEnabled(false);
+
+  // A 3x3 grid of boxes sunk slightly into the floor, so every box has
+  // several contacts. The boxes slide sideways on low friction, so some of the
+  // frictional contacts hit their bounds and become upper-bound constraints.
+  for (int x = 0; x < 3; x++)
+  {
+    for (int z = 0; z < 3; z++)
+    {
+      SkeletonPtr box
+          = Skeleton::create("box_" + std::to_string(x) + std::to_string(z));
+      std::pair<FreeJoint*, BodyNode*> pair
+          = box->createJointAndBodyNodePair<FreeJoint>(nullptr);
+      pair.second->createShapeNodeWith<VisualAspect, CollisionAspect>(
+          std::make_shared<BoxShape>(Eigen::Vector3s(0.5, 0.5, 0.5)));
+      pair.second->setFrictionCoeff(0.2);
+      world->addSkeleton(box);
+      box->setPosition(3, x - 1.0);
+      box->setPosition(4, 0.25 - 1e-2);
+      box->setPosition(5, z - 1.0);
+      box->setVelocity(3, 1.0);
+    }
+  }
+  SkeletonPtr floor = Skeleton::create("floor");
+  std::pair<WeldJoint*, BodyNode*> floorPair
+      = floor->createJointAndBodyNodePair<WeldJoint>(nullptr);
+  Eigen::Isometry3s floorPosition = Eigen::Isometry3s::Identity();
+  floorPosition.translation() = Eigen::Vector3s(0, -0.5, 0);
+  floorPair.first->setTransformFromParentBodyNode(floorPosition);
+  floorPair.second->createShapeNodeWith<VisualAspect, CollisionAspect>(
+      std::make_shared<BoxShape>(Eigen::Vector3s(10.0, 1.0, 10.0)));
+  floorPair.second->setFrictionCoeff(0.2);
+  world->addSkeleton(floor);
+
+  Eigen::VectorXs positions = world->getPositions();
+  Eigen::VectorXs velocities = world->getVelocities();
+
+  // Each snapshot fills its own per-contact caches, so take a fresh one for
+  // each thread count
+  auto getJacobians = [&](int threads) {
+    world->setContactGradientThreads(threads);
+    world->setPositions(positions);
+    world->setVelocities(velocities);
+    BackpropSnapshotPtr snapshot = neural::forwardPass(world, true);
+
+    srand(42);
+    Eigen::VectorXs f0 = Eigen::VectorXs::Random(snapshot->getNumClamping());
+    Eigen::VectorXs E_f0
+        = Eigen::VectorXs::Random(snapshot->getNumUpperBound());
+    Eigen::VectorXs v0 = Eigen::VectorXs::Random(world->getNumDofs());
+
+    std::vector<Eigen::MatrixXs> jacobians;
+    jacobians.push_back(snapshot->getJacobianOfClampingConstraints(world, f0));
+    jacobians.push_back(
+        snapshot->getJacobianOfClampingConstraintsTranspose(world, v0));
+    jacobians.push_back(
+        snapshot->getJacobianOfUpperBoundConstraints(world, E_f0));
+    jacobians.push_back(
+        snapshot->getJacobianOfUpperBoundConstraintsTranspose(world, v0));
+    EXPECT_GT(snapshot->getNumClamping(), 0u);
+    EXPECT_GT(snapshot->getNumUpperBound(), 0u);
+    return jacobians;
+  };
+
+  std::vector<Eigen::MatrixXs> serial = getJacobians(1);
+  for (int threads : {4, 8})
+  {
+    std::vector<Eigen::MatrixXs> parallel = getJacobians(threads);
+    ASSERT_EQ(serial.size(), parallel.size());
+    for (int i = 0; i < serial.size(); i++)
+    {
+      // Every constraint is computed the same way on any thread, so these
+      // should match exactly
+      EXPECT_TRUE(serial[i] == parallel[i])
+          << "Jacobian " << i << " differs at " << threads << " threads";
+    }
+  }
+}
+
+TEST(BATCHED, MATCHES_SINGLE_TIMESTEPS)
+{
+  // World
+  WorldPtr world = World::create();
+  world->setGravity(Eigen::Vector3s(0, -9.81, 0));
+
+  // A three link arm, hanging from the origin
+  SkeletonPtr arm = Skeleton::create("arm");
+  BodyNode* parent = nullptr;
+  for (int i = 0; i < 3; i++)
+  {
+    std::pair<RevoluteJoint*, BodyNode*> pair
+        = arm->createJointAndBodyNodePair<RevoluteJoint>(parent);
+    pair.first->setAxis(Eigen::Vector3s::UnitZ());
+    Eigen::Isometry3s offset = Eigen::Isometry3s::Identity();
+    offset.translation() = Eigen::Vector3s(0, 0.25, 0);
+    pair.first->setTransformFromChildBodyNode(offset);
+    pair.second->setMass(1.0 + i);
+    parent = pair.second;
+  }
+  world->addSkeleton(arm);
+  for (int i = 0; i < 3; i++)
+  {
+    world->getWrtMass()->registerNode(
+        arm->getBodyNode(i),
+        WrtMassBodyNodeEntryType::INERTIA_MASS,
+        Eigen::VectorXs::Ones(1) * 10.0,
+        Eigen::VectorXs::Ones(1) * 0.1);
+  }
+  Eigen::VectorXs initialMasses = world->getMasses();
+
+  // An odd batch size, so the rows don't split evenly over the threads
+  const int BATCH = 13;
+  srand(42);
+  Eigen::MatrixXs states
+      = Eigen::MatrixXs::Random(BATCH, world->getStateSize());
+  Eigen::MatrixXs actions
+      = Eigen::MatrixXs::Random(BATCH, world->getActionSize());
+  Eigen::MatrixXs nextStateGrads
+      = Eigen::MatrixXs::Random(BATCH, world->getStateSize());
+
+  // Every row should exactly match a plain timestep of the same inputs
+  WorldPtr reference = world->clone();
+  auto expectMatchesSingleTimesteps
+      = [&](std::shared_ptr<BatchedBackpropSnapshot> snapshot,
+            const Eigen::MatrixXs& masses) {
+          ASSERT_TRUE(snapshot != nullptr);
+          EXPECT_EQ(snapshot->getBatchSize(), BATCH);
+          BatchedLossGradient batchedGrad
+              = snapshot->backpropState(nextStateGrads);
+          for (int row = 0; row < BATCH; row++)
+          {
+            reference->setMasses(masses.row(row).transpose());
+            reference->setState(states.row(row).transpose());
+            reference->setAction(actions.row(row).transpose());
+            reference->setCachedLCPSolution(world->getCachedLCPSolution());
+            std::shared_ptr<BackpropSnapshot> rowSnapshot
+                = neural::forwardPass(reference);
+            Eigen::VectorXs nextState = reference->getState();
+            Eigen::VectorXs batchedNextState
+                = snapshot->getNextStates().row(row).transpose();
+            EXPECT_TRUE(equals(nextState, batchedNextState, 0.0));
+
+            LossGradientHighLevelAPI rowGrad = rowSnapshot->backpropState(
+                reference, nextStateGrads.row(row).transpose());
+            Eigen::VectorXs lossWrtState
+                = batchedGrad.lossWrtState.row(row).transpose();
+            Eigen::VectorXs lossWrtAction
+                = batchedGrad.lossWrtAction.row(row).transpose();
+            Eigen::VectorXs lossWrtMass
+                = batchedGrad.lossWrtMass.row(row).transpose();
+            EXPECT_TRUE(equals(rowGrad.lossWrtState, lossWrtState, 0.0));
+            EXPECT_TRUE(equals(rowGrad.lossWrtAction, lossWrtAction, 0.0));
+            EXPECT_TRUE(equals(rowGrad.lossWrtMass, lossWrtMass, 0.0));
+          }
+        };
+
+  BatchedTimestep batched(world, 4);
+  Eigen::MatrixXs defaultMasses = initialMasses.transpose().replicate(BATCH, 1);
+  expectMatchesSingleTimesteps(
+      batched.forwardPass(states, actions), defaultMasses);
+
+  // A batch with its own masses, and then a batch without any, which should
+  // go back to the masses the world had at construction rather than keeping
+  // whatever the last batch left on each clone
+  Eigen::MatrixXs masses
+      = Eigen::MatrixXs::Random(BATCH, world->getMassDims()).array() + 2.0;
+  expectMatchesSingleTimesteps(
+      batched.forwardPass(states, actions, masses), masses);
+  expectMatchesSingleTimesteps(
+      batched.forwardPass(states, actions), defaultMasses);
+
+  // Inputs of the wrong shape are rejected
+  EXPECT_TRUE(
+      batched.forwardPass(states, actions.topRows(BATCH - 1)) == nullptr);
 }
\ No newline at end of file
@@ -30,6 +30,7 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <atomic>
 #include <chrono>
 #include <fstream>
 #include <iostream>
@@ -44,6 +45,7 @@
 #include "dart/realtime/MPC.hpp"
 #include "dart/realtime/MPCLocal.hpp"
 #include "dart/realtime/MPCRemote.hpp"
+#include "dart/realtime/Millis.hpp"
 #include "dart/realtime/SSID.hpp"
 #include "dart/realtime/Ticker.hpp"
 #include "dart/server/GUIWebsocketServer.hpp"
@@ -1411,4 +1413,316 @@ TEST(REALTIME, CARTPOLE_COM_PLOT)
     solutionMat.row(i) = solutions[i];
   }
   ssid.saveCSVMatrix("/workspaces/nimblephysics/dart/realtime/saved_data/raw_data/Solutions.csv",solutionMat);
-}
\ No newline at end of file
+}
+#ifdef ALL_TESTS
+TEST(REALTIME, CARTPOLE_PARALLEL_PLOT)
+{
+  // World
+  WorldPtr world = World::create();
+  world->setGravity(Eigen::Vector3s(0, -9.81, 0));
+  world->setTimeStep(1.0 / 100);
+
+  SkeletonPtr cartpole = Skeleton::create("cartpole");
+
+  std::pair<PrismaticJoint*, BodyNode*> sledPair
+      = cartpole->createJointAndBodyNodePair<PrismaticJoint>(nullptr);
+  sledPair.first->setAxis(Eigen::Vector3s(1, 0, 0));
+
+  std::pair<RevoluteJoint*, BodyNode*> armPair
+      = cartpole->createJointAndBodyNodePair<RevoluteJoint>(sledPair.second);
+  armPair.first->setAxis(Eigen::Vector3s(0, 0, 1));
+  Eigen::Isometry3s armOffset = Eigen::Isometry3s::Identity();
+  armOffset.translation() = Eigen::Vector3s(0, -0.5, 0);
+  armPair.first->setTransformFromChildBodyNode(armOffset);
+
+  world->addSkeleton(cartpole);
+  cartpole->setPosition(1, 15.0 / 180.0 * 3.1415);
+
+  world->tuneMass(
+      armPair.second,
+      WrtMassBodyNodeEntryType::INERTIA_MASS,
+      Eigen::VectorXs::Ones(1) * 5.0,
+      Eigen::VectorXs::Ones(1) * 0.2);
+
+  int millisPerTimestep = world->getTimeStep() * 1000;
+  int steps = 5;
+  int inferenceHistoryMillis = steps * millisPerTimestep;
+  Eigen::VectorXs sensorDims = Eigen::VectorXs::Zero(2);
+  sensorDims(0) = world->getNumDofs();
+  sensorDims(1) = world->getNumDofs();
+
+  // The serial and parallel SSIDs each get their own world, so that the
+  // sweeps can't interfere with each other
+  WorldPtr serialWorld = world->clone();
+  WorldPtr parallelWorld = world->clone();
+  SSID serial(
+      serialWorld, getSSIDPosLoss(), inferenceHistoryMillis, sensorDims, steps);
+  SSID parallel(
+      parallelWorld,
+      getSSIDPosLoss(),
+      inferenceHistoryMillis,
+      sensorDims,
+      steps);
+  parallel.setParallelWorkers(4);
+
+  for (SSID* ssid : {&serial, &parallel})
+  {
+    ssid->setInitialPosEstimator(
+        [](Eigen::MatrixXs sensors, long /* timestamp */) {
+          return sensors.col(0);
+        });
+    ssid->setInitialVelEstimator(
+        [](Eigen::MatrixXs sensors, long /* timestamp */) {
+          return sensors.col(0);
+        });
+  }
+
+  long time = 0;
+  for (int i = 0; i < 10; i++)
+  {
+    time = i * millisPerTimestep;
+    Eigen::VectorXs forces = Eigen::VectorXs::Ones(world->getNumDofs());
+    world->setControlForces(forces);
+    world->step();
+    for (SSID* ssid : {&serial, &parallel})
+    {
+      ssid->registerControls(time, forces);
+      ssid->registerSensors(time, world->getPositions(), 0);
+      ssid->registerSensors(time, world->getVelocities(), 1);
+    }
+  }
+
+  int samples = 40;
+  Eigen::VectorXs streamed
+      = Eigen::VectorXs::Constant(samples, std::nan(""));
+  parallel.registerSweepListener([&](int x, int y, s_t loss) {
+    EXPECT_EQ(y, 0);
+    streamed(x) = loss;
+  });
+
+  Eigen::VectorXs serialLosses = serial.runPlotting(time, 5.0, 0.2, samples);
+  Eigen::VectorXs parallelLosses
+      = parallel.runPlotting(time, 5.0, 0.2, samples);
+
+  EXPECT_TRUE(equals(serialLosses, parallelLosses, 1e-10));
+  EXPECT_TRUE(equals(streamed, parallelLosses, 1e-10));
+
+  // Multi-start inference should land at least as low as inference from any
+  // one of its starting points. Only the mass is free (the forces are pinned
+  // and the starting state comes from the estimators), so we compare the loss
+  // at each inferred mass.
+  s_t inferredMass = -1;
+  parallel.registerInferListener(
+      [&](long, Eigen::VectorXs, Eigen::VectorXs, Eigen::VectorXs mass, long) {
+        inferredMass = mass(0);
+      });
+  auto inferLoss = [&](std::vector<Eigen::VectorXs> starts) {
+    parallel.setMultiStartMasses(starts);
+    inferredMass = -1;
+    parallel.runInference(time);
+    EXPECT_GE(inferredMass, 0.2);
+    EXPECT_LE(inferredMass, 5.0);
+    return parallel.runPlotting(time, inferredMass, inferredMass, 1)(0);
+  };
+
+  std::vector<Eigen::VectorXs> starts;
+  starts.push_back(Eigen::VectorXs::Ones(1) * 0.5);
+  starts.push_back(Eigen::VectorXs::Ones(1) * 2.5);
+  starts.push_back(Eigen::VectorXs::Ones(1) * 4.5);
+  s_t multiStartLoss = inferLoss(starts);
+  for (Eigen::VectorXs start : starts)
+  {
+    s_t singleStartLoss = inferLoss({start});
+    EXPECT_LE(multiStartLoss, singleStartLoss + 1e-8);
+  }
+}
+#endif
+
+#ifdef ALL_TESTS
+TEST(REALTIME, CARTPOLE_CANCEL_SWEEP)
+{
+  // World
+  WorldPtr world = World::create();
+  world->setGravity(Eigen::Vector3s(0, -9.81, 0));
+  world->setTimeStep(1.0 / 100);
+
+  SkeletonPtr cartpole = Skeleton::create("cartpole");
+
+  std::pair<PrismaticJoint*, BodyNode*> sledPair
+      = cartpole->createJointAndBodyNodePair<PrismaticJoint>(nullptr);
+  sledPair.first->setAxis(Eigen::Vector3s(1, 0, 0));
+
+  std::pair<RevoluteJoint*, BodyNode*> armPair
+      = cartpole->createJointAndBodyNodePair<RevoluteJoint>(sledPair.second);
+  armPair.first->setAxis(Eigen::Vector3s(0, 0, 1));
+  Eigen::Isometry3s armOffset = Eigen::Isometry3s::Identity();
+  armOffset.translation() = Eigen::Vector3s(0, -0.5, 0);
+  armPair.first->setTransformFromChildBodyNode(armOffset);
+
+  world->addSkeleton(cartpole);
+  cartpole->setPosition(1, 15.0 / 180.0 * 3.1415);
+
+  world->tuneMass(
+      armPair.second,
+      WrtMassBodyNodeEntryType::INERTIA_MASS,
+      Eigen::VectorXs::Ones(1) * 5.0,
+      Eigen::VectorXs::Ones(1) * 0.2);
+
+  int millisPerTimestep = world->getTimeStep() * 1000;
+  int steps = 5;
+  int inferenceHistoryMillis = steps * millisPerTimestep;
+  Eigen::VectorXs sensorDims = Eigen::VectorXs::Zero(2);
+  sensorDims(0) = world->getNumDofs();
+  sensorDims(1) = world->getNumDofs();
+
+  for (int workers : {1, 4})
+  {
+    SSID ssid(
+        world->clone(),
+        getSSIDPosLoss(),
+        inferenceHistoryMillis,
+        sensorDims,
+        steps);
+    ssid.setParallelWorkers(workers);
+    ssid.setInitialPosEstimator(
+        [](Eigen::MatrixXs sensors, long /* timestamp */) {
+          return sensors.col(0);
+        });
+    ssid.setInitialVelEstimator(
+        [](Eigen::MatrixXs sensors, long /* timestamp */) {
+          return sensors.col(0);
+        });
+
+    WorldPtr recording = world->clone();
+    long time = 0;
+    for (int i = 0; i < 10; i++)
+    {
+      time = i * millisPerTimestep;
+      Eigen::VectorXs forces = Eigen::VectorXs::Ones(world->getNumDofs());
+      recording->setControlForces(forces);
+      recording->step();
+      ssid.registerControls(time, forces);
+      ssid.registerSensors(time, recording->getPositions(), 0);
+      ssid.registerSensors(time, recording->getVelocities(), 1);
+    }
+
+    // Cancel from inside the sweep, once a few samples have come back
+    int samples = 40;
+    int cancelAfter = 5;
+    int numEvaluated = 0;
+    ssid.registerSweepListener([&](int, int, s_t) {
+      numEvaluated++;
+      if (numEvaluated == cancelAfter)
+      {
+        ssid.cancelSweep();
+      }
+    });
+    Eigen::VectorXs losses = ssid.runPlotting(time, 5.0, 0.2, samples);
+
+    // Each worker can finish the sample it was already evaluating, but
+    // nothing past that gets started
+    EXPECT_GE(numEvaluated, cancelAfter);
+    EXPECT_LE(numEvaluated, cancelAfter + workers - 1);
+    EXPECT_EQ(losses.size(), samples);
+    int numNaN = 0;
+    for (int i = 0; i < samples; i++)
+    {
+      if (std::isnan(losses(i)))
+        numNaN++;
+    }
+    EXPECT_EQ(numNaN, samples - numEvaluated);
+  }
+}
+#endif
+
+#ifdef ALL_TESTS
+TEST(REALTIME, MPC_REMOTE_TRANSPORT)
+{
+  WorldPtr world = World::create();
+  SkeletonPtr cartpole = Skeleton::create("cartpole");
+  std::pair<PrismaticJoint*, BodyNode*> sledPair
+      = cartpole->createJointAndBodyNodePair<PrismaticJoint>(nullptr);
+  cartpole->createJointAndBodyNodePair<RevoluteJoint>(sledPair.second);
+  world->addSkeleton(cartpole);
+
+  MPCLocal mpcLocal(world, getMPCLoss(), 100);
+  mpcLocal.setSilent(true);
+
+  // This forks a server that we talk to over shared memory, and which shuts
+  // down when `remote` goes out of scope
+  MPCRemote remote(mpcLocal, MPCTransport::SHARED_MEMORY);
+  EXPECT_EQ(remote.getTransport(), MPCTransport::SHARED_MEMORY);
+
+  MPCRemote byChannel(
+      std::make_shared<SharedMemoryChannel>(), world->getNumDofs(), 100, 10);
+  EXPECT_EQ(byChannel.getTransport(), MPCTransport::SHARED_MEMORY);
+
+  MPCRemote byHost("localhost", 9000, world->getNumDofs(), 100, 10);
+  EXPECT_EQ(byHost.getTransport(), MPCTransport::GRPC);
+}
+#endif
+
+#ifdef ALL_TESTS
+TEST(REALTIME, MPC_REMOTE_SHARED_MEMORY_ROUND_TRIP)
+{
+  WorldPtr world = World::create();
+  world->setGravity(Eigen::Vector3s(0, -9.81, 0));
+  world->setTimeStep(1.0 / 100);
+  SkeletonPtr cartpole = Skeleton::create("cartpole");
+  std::pair<PrismaticJoint*, BodyNode*> sledPair
+      = cartpole->createJointAndBodyNodePair<PrismaticJoint>(nullptr);
+  sledPair.first->setAxis(Eigen::Vector3s(1, 0, 0));
+  std::pair<RevoluteJoint*, BodyNode*> armPair
+      = cartpole->createJointAndBodyNodePair<RevoluteJoint>(sledPair.second);
+  armPair.first->setAxis(Eigen::Vector3s(0, 0, 1));
+  world->addSkeleton(cartpole);
+  cartpole->setControlForceUpperLimit(0, 15);
+  cartpole->setControlForceLowerLimit(0, -15);
+  cartpole->setControlForceUpperLimit(1, 0);
+  cartpole->setControlForceLowerLimit(1, 0);
+
+  int millisPerStep = 10;
+  int planningHorizonMillis = 20 * millisPerStep;
+  MPCLocal mpcLocal(world, getMPCLoss(), planningHorizonMillis);
+  mpcLocal.setSilent(true);
+  mpcLocal.setMaxIterations(3);
+
+  // Serve on a thread in this process, so the whole round trip goes through
+  // the channel without forking the test runner
+  std::shared_ptr<SharedMemoryChannel> channel
+      = std::make_shared<SharedMemoryChannel>();
+  std::thread server([&]() { mpcLocal.serveSharedMemory(channel); });
+
+  MPCRemote remote(
+      channel, world->getNumDofs(), planningHorizonMillis / millisPerStep,
+      millisPerStep);
+  std::atomic<int> numPlans(0);
+  std::atomic<long> lastPlanStart(0);
+  remote.registerReplanningListener(
+      [&](long startTime, const TrajectoryRollout* rollout, long) {
+        EXPECT_EQ(rollout->getPosesConst().rows(), world->getNumDofs());
+        lastPlanStart = startTime;
+        numPlans++;
+      });
+
+  long now = timeSinceEpochMillis();
+  Eigen::VectorXs pos = Eigen::VectorXs::Zero(world->getNumDofs());
+  pos(1) = 0.3;
+  remote.recordGroundTruthState(
+      now, pos, Eigen::VectorXs::Zero(world->getNumDofs()), world->getMasses());
+  remote.start();
+
+  // Wait for a plan to come back over the channel
+  long deadline = now + 30000;
+  while (numPlans == 0 && timeSinceEpochMillis() < deadline)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  remote.stop();
+  channel->close();
+  server.join();
+
+  EXPECT_GT(numPlans.load(), 0);
+  EXPECT_GE(lastPlanStart.load(), now);
+}
+#endif
@@ -778,6 +778,82 @@ TEST(Skeleton, CloneNodeOrdering)
   }
 }
 
+TEST(Skeleton, CloneCopiesStateAndSharesShapes)
+{
+  // This checks that clones come out with correctly sized dynamics caches
+  // (which are now built once at the end of the clone, instead of once per
+  // BodyNode), and that they share Shapes with the original while keeping
+  // their own state.
+  std::vector<SkeletonPtr> skeletons = getSkeletons();
+  for (const SkeletonPtr& skel : skeletons)
+  {
+    skel->setPositions(Eigen::VectorXs::Random(skel->getNumDofs()));
+    skel->getBodyNode(0)->setBeta(Eigen::Vector3s(0.5, 1.5, 2.0));
+
+    SkeletonPtr clone = skel->cloneSkeleton();
+    ASSERT_EQ(clone->getNumBodyNodes(), skel->getNumBodyNodes());
+    ASSERT_EQ(clone->getNumDofs(), skel->getNumDofs());
+    ASSERT_EQ(clone->getNumTrees(), skel->getNumTrees());
+    EXPECT_EQ(clone->getMass(), skel->getMass());
+    EXPECT_TRUE(equals(clone->getLinkBetas(), skel->getLinkBetas()));
+    EXPECT_TRUE(equals(clone->getPositions(), skel->getPositions()));
+    EXPECT_TRUE(equals(clone->getMassMatrix(), skel->getMassMatrix()));
+    EXPECT_TRUE(equals(
+        clone->getCoriolisAndGravityForces(),
+        skel->getCoriolisAndGravityForces()));
+    for (std::size_t i = 0; i < skel->getNumTrees(); ++i)
+    {
+      EXPECT_TRUE(equals(clone->getMassMatrix(i), skel->getMassMatrix(i)));
+    }
+
+    for (std::size_t i = 0; i < skel->getNumBodyNodes(); ++i)
+    {
+      BodyNode* original = skel->getBodyNode(i);
+      BodyNode* cloned = clone->getBodyNode(i);
+      EXPECT_EQ(cloned->getName(), original->getName());
+      ASSERT_EQ(cloned->getNumShapeNodes(), original->getNumShapeNodes());
+      for (std::size_t j = 0; j < original->getNumShapeNodes(); ++j)
+      {
+        EXPECT_EQ(
+            cloned->getShapeNode(j)->getShape(),
+            original->getShapeNode(j)->getShape());
+      }
+    }
+
+    Eigen::VectorXs originalPositions = skel->getPositions();
+    clone->setPositions(Eigen::VectorXs::Zero(clone->getNumDofs()));
+    EXPECT_TRUE(equals(skel->getPositions(), originalPositions));
+  }
+}
+
+TEST(Skeleton, CloneRemapsOnlyItsOwnMimicJoints)
+{
+  SkeletonPtr leader = Skeleton::create("leader");
+  RevoluteJoint* leaderJoint
+      = leader->createJointAndBodyNodePair<RevoluteJoint>().first;
+
+  SkeletonPtr follower = Skeleton::create("follower");
+  std::pair<RevoluteJoint*, BodyNode*> pair
+      = follower->createJointAndBodyNodePair<RevoluteJoint>();
+  RevoluteJoint* followerRoot = pair.first;
+  RevoluteJoint* followerChild
+      = follower->createJointAndBodyNodePair<RevoluteJoint>(pair.second).first;
+
+  // The root mimics a joint in another Skeleton, and the child mimics a
+  // joint in its own Skeleton
+  followerRoot->setActuatorType(Joint::MIMIC);
+  followerRoot->setMimicJoint(leaderJoint, 2.0, 0.5);
+  followerChild->setActuatorType(Joint::MIMIC);
+  followerChild->setMimicJoint(followerRoot, -1.0, 0.0);
+
+  SkeletonPtr clone = follower->cloneSkeleton();
+  EXPECT_EQ(clone->getJoint(0)->getMimicJoint(), leaderJoint);
+  EXPECT_EQ(clone->getJoint(0)->getMimicMultiplier(), 2.0);
+  EXPECT_EQ(clone->getJoint(0)->getMimicOffset(), 0.5);
+  EXPECT_EQ(clone->getJoint(1)->getMimicJoint(), clone->getJoint(0));
+  EXPECT_EQ(clone->getJoint(1)->getMimicMultiplier(), -1.0);
+}
+
 TEST(Skeleton, ZeroDofJointInReferential)
 {
   // This is a regression test which makes sure that the BodyNodes of
@@ -53,7 +53,9 @@
 #include "dart/neural/RestorableSnapshot.hpp"
 #include "dart/neural/WithRespectToMass.hpp"
 #include "dart/simulation/World.hpp"
+#include "dart/trajectory/AdamOptimizer.hpp"
 #include "dart/trajectory/IPOptOptimizer.hpp"
+#include "dart/trajectory/LBFGSOptimizer.hpp"
 #include "dart/trajectory/MultiShot.hpp"
 #include "dart/trajectory/Problem.hpp"
 #include "dart/trajectory/SingleShot.hpp"
@@ -1426,4 +1428,477 @@ TEST(TRAJECTORY, REOPTIMIZATION)
     record->reoptimize();
   }
 }
-#endif
\ No newline at end of file
+#endif
+#ifdef ALL_TESTS
+TEST(TRAJECTORY, ADVANCE_STEPS_MAPPING)
+{
+  // World
+  WorldPtr world = World::create();
+  world->setGravity(Eigen::Vector3s(0, -9.81, 0));
+
+  SkeletonPtr box = Skeleton::create("box");
+  std::pair<TranslationalJoint2D*, BodyNode*> pair
+      = box->createJointAndBodyNodePair<TranslationalJoint2D>(nullptr);
+  pair.first->setXYPlane();
+  pair.second->setMass(1.0);
+  world->addSkeleton(box);
+
+  TrajectoryLossFn loss = [](const TrajectoryRollout* rollout) {
+    return rollout->getControlForcesConst().squaredNorm();
+  };
+
+  int steps = 12;
+  int shift = 3;
+  std::shared_ptr<Problem> shot
+      = std::make_shared<MultiShot>(world, LossFn(loss), steps, 4);
+
+  Eigen::MatrixXs forces
+      = Eigen::MatrixXs::Random(world->getNumDofs(), steps);
+  shot->setControlForcesRaw(forces);
+
+  Eigen::VectorXs oldFlat
+      = Eigen::VectorXs::Zero(shot->getFlatProblemDim(world));
+  shot->flatten(world, oldFlat);
+
+  Eigen::VectorXi mapping = shot->advanceSteps(
+      world, world->getPositions(), world->getVelocities(), shift);
+  EXPECT_EQ(mapping.size(), oldFlat.size());
+
+  // Forces should shift across the shot boundaries, and only the tail of the
+  // whole trajectory should be padded with zeros
+  Eigen::MatrixXs newForces
+      = shot->getRolloutCache(world)->getControlForcesConst();
+  Eigen::MatrixXs expectedForces
+      = Eigen::MatrixXs::Zero(forces.rows(), steps);
+  expectedForces.block(0, 0, forces.rows(), steps - shift)
+      = forces.block(0, shift, forces.rows(), steps - shift);
+  EXPECT_TRUE(equals(newForces, expectedForces, 1e-12));
+
+  // Every shifted entry in the new flat problem should hold the value it was
+  // shifted from in the old flat problem
+  Eigen::VectorXs newFlat = Eigen::VectorXs::Zero(oldFlat.size());
+  shot->flatten(world, newFlat);
+  for (int i = 0; i < mapping.size(); i++)
+  {
+    if (mapping(i) == -1)
+    {
+      EXPECT_EQ(newFlat(i), 0.0);
+    }
+    else if (mapping(i) != i)
+    {
+      EXPECT_EQ(newFlat(i), oldFlat(mapping(i)));
+    }
+  }
+}
+#endif
+
+#ifdef ALL_TESTS
+TEST(TRAJECTORY, LINE_SEARCH_OPTIMIZERS)
+{
+  // World
+  WorldPtr world = World::create();
+  world->setGravity(Eigen::Vector3s(0, -9.81, 0));
+
+  SkeletonPtr box = Skeleton::create("box");
+  std::pair<TranslationalJoint2D*, BodyNode*> pair
+      = box->createJointAndBodyNodePair<TranslationalJoint2D>(nullptr);
+  pair.first->setXYPlane();
+  pair.second->setMass(1.0);
+  world->addSkeleton(box);
+
+  // Push the box to a target, with a little regularization on the forces
+  TrajectoryLossFn loss = [](const TrajectoryRollout* rollout) {
+    const Eigen::MatrixXs& poses = rollout->getPosesConst("identity");
+    Eigen::Vector2s target(1.0, 2.0);
+    return (poses.col(poses.cols() - 1) - target).squaredNorm()
+           + 1e-3 * rollout->getControlForcesConst().squaredNorm();
+  };
+
+  int steps = 12;
+  std::vector<std::shared_ptr<LineSearchOptimizer>> optimizers;
+  std::shared_ptr<AdamOptimizer> adam = std::make_shared<AdamOptimizer>();
+  adam->setLearningRate(1.0);
+  optimizers.push_back(adam);
+  optimizers.push_back(std::make_shared<LBFGSOptimizer>());
+
+  for (std::shared_ptr<LineSearchOptimizer> optimizer : optimizers)
+  {
+    optimizer->setIterationLimit(50);
+    optimizer->setSilenceOutput(true);
+    for (bool parallel : {false, true})
+    {
+      optimizer->setParallelLineSearchEnabled(parallel);
+
+      std::shared_ptr<Problem> singleShot = std::make_shared<SingleShot>(
+          world, LossFn(loss), steps, false);
+      s_t initialLoss = singleShot->getLoss(world);
+      std::shared_ptr<Solution> solution
+          = optimizer->optimize(singleShot.get());
+      EXPECT_GT(solution->getIterationCount(), 0);
+      EXPECT_LT(singleShot->getLoss(world), 0.1 * initialLoss);
+
+      // The knot-points of a MultiShot are enforced through a penalty, so we
+      // should end up close to a consistent trajectory
+      std::shared_ptr<Problem> multiShot
+          = std::make_shared<MultiShot>(world, LossFn(loss), steps, 4, false);
+      initialLoss = multiShot->getLoss(world);
+      optimizer->optimize(multiShot.get());
+      EXPECT_LT(multiShot->getLoss(world), 0.1 * initialLoss);
+      Eigen::VectorXs knots
+          = Eigen::VectorXs::Zero(multiShot->getConstraintDim());
+      multiShot->computeConstraints(world, knots);
+      EXPECT_LT(knots.norm(), 0.1);
+    }
+  }
+
+  // A time budget stops the optimizer early
+  std::shared_ptr<LBFGSOptimizer> budgeted
+      = std::make_shared<LBFGSOptimizer>();
+  budgeted->setSilenceOutput(true);
+  budgeted->setTolerance(0);
+  budgeted->setIterationLimit(1000000);
+  budgeted->setTimeBudgetMillis(50);
+  std::shared_ptr<Problem> shot
+      = std::make_shared<SingleShot>(world, LossFn(loss), steps, false);
+  auto start = std::chrono::steady_clock::now();
+  budgeted->optimize(shot.get());
+  long elapsedMillis = std::chrono::duration_cast<std::chrono::milliseconds>(
+                           std::chrono::steady_clock::now() - start)
+                           .count();
+  EXPECT_LT(elapsedMillis, 1000);
+}
+#endif
+
+#ifdef ALL_TESTS
+TEST(TRAJECTORY, PARALLEL_LINE_SEARCH_REUSES_CLONES)
+{
+  // World
+  WorldPtr world = World::create();
+  world->setGravity(Eigen::Vector3s(0, -9.81, 0));
+
+  SkeletonPtr box = Skeleton::create("box");
+  std::pair<TranslationalJoint2D*, BodyNode*> pair
+      = box->createJointAndBodyNodePair<TranslationalJoint2D>(nullptr);
+  pair.first->setXYPlane();
+  pair.second->setMass(1.0);
+  world->addSkeleton(box);
+
+  TrajectoryLossFn loss = [](const TrajectoryRollout* rollout) {
+    const Eigen::MatrixXs& poses = rollout->getPosesConst("identity");
+    return poses.col(poses.cols() - 1).squaredNorm()
+           + 1e-3 * rollout->getControlForcesConst().squaredNorm();
+  };
+
+  std::shared_ptr<LBFGSOptimizer> optimizer
+      = std::make_shared<LBFGSOptimizer>();
+  optimizer->setSilenceOutput(true);
+  optimizer->setIterationLimit(5);
+  optimizer->setRecordIterations(true);
+  optimizer->setParallelLineSearchEnabled(true);
+
+  std::shared_ptr<Problem> shot
+      = std::make_shared<SingleShot>(world, LossFn(loss), 12, false);
+
+  // The loss the optimizer records comes from the line search clones, so it
+  // only matches the real problem if the clones are up to date
+  auto expectClonesInSync = [&]() {
+    std::shared_ptr<Solution> solution = optimizer->optimize(shot.get());
+    ASSERT_GT(solution->getNumSteps(), 0);
+    EXPECT_NEAR(
+        solution->getStep(solution->getNumSteps() - 1).loss,
+        shot->getLoss(world),
+        1e-8);
+  };
+  expectClonesInSync();
+
+  // Replanning from a new start state reuses the clones, so they need to
+  // pick up the new start state
+  shot->advanceSteps(
+      world, Eigen::Vector2s(0.5, -0.3), Eigen::Vector2s(1.0, 0.2), 3);
+  expectClonesInSync();
+
+  // Growing the World changes the problem's size, so the clones get rebuilt
+  SkeletonPtr box2 = box->cloneSkeleton("box2");
+  world->addSkeleton(box2);
+  shot = std::make_shared<SingleShot>(world, LossFn(loss), 12, false);
+  expectClonesInSync();
+}
+#endif
+
+#ifdef ALL_TESTS
+TEST(TRAJECTORY, CLONE_PROBLEM)
+{
+  // World
+  WorldPtr world = World::create();
+  world->setGravity(Eigen::Vector3s(0, -9.81, 0));
+
+  SkeletonPtr box = Skeleton::create("box");
+  std::pair<TranslationalJoint2D*, BodyNode*> pair
+      = box->createJointAndBodyNodePair<TranslationalJoint2D>(nullptr);
+  pair.first->setXYPlane();
+  pair.second->setMass(1.0);
+  world->addSkeleton(box);
+
+  TrajectoryLossFn loss = [](const TrajectoryRollout* rollout) {
+    return rollout->getPosesConst("identity").squaredNorm();
+  };
+
+  std::vector<std::shared_ptr<Problem>> problems;
+  problems.push_back(std::make_shared<SingleShot>(world, LossFn(loss), 12));
+  problems.push_back(std::make_shared<MultiShot>(world, LossFn(loss), 12, 4));
+  for (std::shared_ptr<Problem> original : problems)
+  {
+    int dim = original->getFlatProblemDim(world);
+    Eigen::VectorXs originalFlat = Eigen::VectorXs::Random(dim);
+    original->unflatten(world, originalFlat);
+    s_t originalLoss = original->getLoss(world);
+
+    std::shared_ptr<Problem> copy = original->clone();
+    WorldPtr worldCopy = world->clone();
+    Eigen::VectorXs copyFlat = Eigen::VectorXs::Zero(dim);
+    copy->flatten(worldCopy, copyFlat);
+    EXPECT_TRUE(equals(copyFlat, originalFlat, 0));
+    EXPECT_EQ(copy->getLoss(worldCopy), originalLoss);
+
+    // Changing the copy leaves the original alone
+    copy->unflatten(worldCopy, Eigen::VectorXs::Random(dim));
+    EXPECT_NE(copy->getLoss(worldCopy), originalLoss);
+    Eigen::VectorXs flat = Eigen::VectorXs::Zero(dim);
+    original->flatten(world, flat);
+    EXPECT_TRUE(equals(flat, originalFlat, 0));
+    EXPECT_EQ(original->getLoss(world), originalLoss);
+  }
+}
+#endif
+
+#ifdef ALL_TESTS
+TEST(TRAJECTORY, GAUSS_NEWTON_HESSIAN)
+{
+  // World
+  WorldPtr world = World::create();
+  world->setGravity(Eigen::Vector3s(0, -9.81, 0));
+
+  SkeletonPtr box = Skeleton::create("box");
+  std::pair<TranslationalJoint2D*, BodyNode*> pair
+      = box->createJointAndBodyNodePair<TranslationalJoint2D>(nullptr);
+  pair.first->setXYPlane();
+  pair.second->setMass(1.0);
+  world->addSkeleton(box);
+
+  // A box in free space has linear dynamics, and this loss is a diagonal
+  // quadratic in the rollout, so the Gauss-Newton Hessian should be exact
+  TrajectoryLossFn loss = [](const TrajectoryRollout* rollout) {
+    const Eigen::MatrixXs& poses = rollout->getPosesConst("identity");
+    const Eigen::MatrixXs& vels = rollout->getVelsConst("identity");
+    Eigen::Vector2s target(1.0, 2.0);
+    return (poses.col(poses.cols() - 1) - target).squaredNorm()
+           + 0.5 * vels.col(vels.cols() - 1).squaredNorm()
+           + 1e-3 * rollout->getControlForcesConst().squaredNorm();
+  };
+
+  std::vector<std::shared_ptr<Problem>> problems;
+  problems.push_back(
+      std::make_shared<SingleShot>(world, LossFn(loss), 12, false));
+  problems.push_back(std::make_shared<SingleShot>(world, LossFn(loss), 12));
+  problems.push_back(
+      std::make_shared<MultiShot>(world, LossFn(loss), 12, 4, false));
+  for (std::shared_ptr<Problem> shot : problems)
+  {
+    int dim = shot->getFlatProblemDim(world);
+    Eigen::VectorXs flat = Eigen::VectorXs::Random(dim);
+    shot->unflatten(world, flat);
+
+    int nnzh = shot->getNumberNonZeroHessian(world);
+    Eigen::VectorXi rows = Eigen::VectorXi::Zero(nnzh);
+    Eigen::VectorXi cols = Eigen::VectorXi::Zero(nnzh);
+    shot->getHessianSparsityStructure(world, rows, cols);
+    Eigen::VectorXs sparse = Eigen::VectorXs::Zero(nnzh);
+    shot->getSparseGaussNewtonHessian(world, sparse);
+
+    Eigen::MatrixXs hessian = Eigen::MatrixXs::Zero(dim, dim);
+    for (int i = 0; i < nnzh; i++)
+    {
+      // IPOPT only wants the lower triangle
+      EXPECT_GE(rows(i), cols(i));
+      hessian(rows(i), cols(i)) += sparse(i);
+      if (rows(i) != cols(i))
+        hessian(cols(i), rows(i)) += sparse(i);
+    }
+
+    // Within each shot this should match finite differencing the gradient.
+    // Across MultiShot shots, the true Hessian is zero too, since the loss
+    // doesn't couple steps.
+    const s_t EPS = 1e-6;
+    Eigen::MatrixXs expected = Eigen::MatrixXs::Zero(dim, dim);
+    Eigen::VectorXs gradPlus = Eigen::VectorXs::Zero(dim);
+    Eigen::VectorXs gradMinus = Eigen::VectorXs::Zero(dim);
+    for (int i = 0; i < dim; i++)
+    {
+      Eigen::VectorXs perturbed = flat;
+      perturbed(i) += EPS;
+      shot->unflatten(world, perturbed);
+      shot->backpropGradient(world, gradPlus);
+      perturbed(i) = flat(i) - EPS;
+      shot->unflatten(world, perturbed);
+      shot->backpropGradient(world, gradMinus);
+      expected.col(i) = (gradPlus - gradMinus) / (2 * EPS);
+    }
+    shot->unflatten(world, flat);
+
+    if (!equals(hessian, expected, 1e-5))
+    {
+      std::cout << "Gauss-Newton Hessian:" << std::endl
+                << hessian << std::endl
+                << "Finite difference Hessian:" << std::endl
+                << expected << std::endl;
+    }
+    EXPECT_TRUE(equals(hessian, expected, 1e-5));
+  }
+}
+#endif
+
+#ifdef ALL_TESTS
+TEST(TRAJECTORY, GAUSS_NEWTON_HESSIAN_OPTIMIZE)
+{
+  // World
+  WorldPtr world = World::create();
+  world->setGravity(Eigen::Vector3s(0, -9.81, 0));
+
+  SkeletonPtr box = Skeleton::create("box");
+  std::pair<TranslationalJoint2D*, BodyNode*> pair
+      = box->createJointAndBodyNodePair<TranslationalJoint2D>(nullptr);
+  pair.first->setXYPlane();
+  pair.second->setMass(1.0);
+  world->addSkeleton(box);
+
+  TrajectoryLossFn loss = [](const TrajectoryRollout* rollout) {
+    const Eigen::MatrixXs& poses = rollout->getPosesConst("identity");
+    Eigen::Vector2s target(1.0, 2.0);
+    return (poses.col(poses.cols() - 1) - target).squaredNorm()
+           + 1e-3 * rollout->getControlForcesConst().squaredNorm();
+  };
+
+  for (bool multiShot : {false, true})
+  {
+    // Solve the same problem with the limited-memory BFGS Hessian and with
+    // the Gauss-Newton Hessian, and check they agree
+    std::vector<s_t> finalLosses;
+    for (bool gaussNewton : {false, true})
+    {
+      std::shared_ptr<Problem> shot;
+      if (multiShot)
+        shot = std::make_shared<MultiShot>(world, LossFn(loss), 12, 4, false);
+      else
+        shot = std::make_shared<SingleShot>(world, LossFn(loss), 12, false);
+      s_t initialLoss = shot->getLoss(world);
+
+      IPOptOptimizer optimizer = IPOptOptimizer();
+      optimizer.setIterationLimit(100);
+      optimizer.setSuppressOutput(true);
+      optimizer.setSilenceOutput(true);
+      optimizer.setGaussNewtonHessian(gaussNewton);
+      std::shared_ptr<Solution> solution = optimizer.optimize(shot.get());
+
+      s_t finalLoss = shot->getLoss(world);
+      EXPECT_GT(solution->getIterationCount(), 0);
+      EXPECT_LT(finalLoss, 0.01 * initialLoss);
+      if (multiShot)
+      {
+        Eigen::VectorXs knots = Eigen::VectorXs::Zero(shot->getConstraintDim());
+        shot->computeConstraints(world, knots);
+        EXPECT_LT(knots.norm(), 1e-4);
+      }
+      finalLosses.push_back(finalLoss);
+    }
+    EXPECT_NEAR(finalLosses[0], finalLosses[1], 1e-4);
+  }
+}
+#endif
+
+#ifdef ALL_TESTS
+TEST(TRAJECTORY, LOSS_FN_BATCH)
+{
+  // World
+  WorldPtr world = World::create();
+  world->setGravity(Eigen::Vector3s(0, -9.81, 0));
+
+  SkeletonPtr box = Skeleton::create("box");
+  std::pair<TranslationalJoint2D*, BodyNode*> pair
+      = box->createJointAndBodyNodePair<TranslationalJoint2D>(nullptr);
+  pair.first->setXYPlane();
+  pair.second->setMass(1.0);
+  world->addSkeleton(box);
+
+  int steps = 8;
+  int dofs = world->getNumDofs();
+  Eigen::MatrixXs targetPoses = Eigen::MatrixXs::Random(dofs, steps);
+  Eigen::VectorXs targetPos = Eigen::VectorXs::Random(dofs);
+  Eigen::VectorXs targetVel = Eigen::VectorXs::Random(dofs);
+
+  // The built-in terms should agree with the same loss written by hand
+  LossFn builtIn(std::vector<LossTerm>{
+      LossTerm::tracking(targetPoses, 2.0),
+      LossTerm::effort(1e-3),
+      LossTerm::terminalState(targetPos, targetVel, 0.5)});
+  TrajectoryLossFn byHand = [&](const TrajectoryRollout* rollout) {
+    const Eigen::MatrixXs& poses = rollout->getPosesConst();
+    const Eigen::MatrixXs& vels = rollout->getVelsConst();
+    return 2.0 * (poses - targetPoses).squaredNorm()
+           + 1e-3 * rollout->getControlForcesConst().squaredNorm()
+           + 0.5
+                 * ((poses.col(steps - 1) - targetPos).squaredNorm()
+                    + (vels.col(steps - 1) - targetVel).squaredNorm());
+  };
+  LossFn custom(byHand);
+
+  SingleShot shot(world, LossFn(), steps);
+  int numCandidates = 5;
+  TrajectoryRolloutBatch batch(&shot, numCandidates);
+  for (int i = 0; i < numCandidates; i++)
+  {
+    TrajectoryRolloutReal rollout = TrajectoryRolloutReal(&shot);
+    rollout.getPoses().setRandom();
+    rollout.getVels().setRandom();
+    rollout.getControlForces().setRandom();
+    batch.setCandidate(i, &rollout);
+    EXPECT_TRUE(equals(
+        Eigen::MatrixXs(batch.getCandidateConst(i).getPosesConst()),
+        Eigen::MatrixXs(rollout.getPosesConst()),
+        0));
+  }
+
+  Eigen::VectorXs builtInLosses = Eigen::VectorXs::Zero(numCandidates);
+  builtIn.getLossBatch(&batch, builtInLosses);
+  Eigen::VectorXs customLosses = Eigen::VectorXs::Zero(numCandidates);
+  custom.getLossBatch(&batch, customLosses);
+  for (int i = 0; i < numCandidates; i++)
+  {
+    const TrajectoryRolloutConstRef view = batch.getCandidateConst(i);
+    s_t expected = byHand(&view);
+    EXPECT_NEAR(builtInLosses(i), expected, 1e-9);
+    EXPECT_NEAR(customLosses(i), expected, 1e-9);
+    EXPECT_NEAR(builtIn.getLoss(&view), expected, 1e-9);
+  }
+
+  // The analytical gradients of the built-in terms should match finite
+  // differences of the hand written loss
+  const TrajectoryRolloutConstRef view = batch.getCandidateConst(0);
+  TrajectoryRolloutReal builtInGrad = TrajectoryRolloutReal(&shot);
+  TrajectoryRolloutReal customGrad = TrajectoryRolloutReal(&shot);
+  s_t builtInLoss = builtIn.getLossAndGradient(&view, &builtInGrad);
+  custom.getLossAndGradient(&view, &customGrad);
+  EXPECT_NEAR(builtInLoss, byHand(&view), 1e-9);
+  EXPECT_TRUE(equals(
+      Eigen::MatrixXs(builtInGrad.getPosesConst()),
+      Eigen::MatrixXs(customGrad.getPosesConst()),
+      1e-6));
+  EXPECT_TRUE(equals(
+      Eigen::MatrixXs(builtInGrad.getVelsConst()),
+      Eigen::MatrixXs(customGrad.getVelsConst()),
+      1e-6));
+  EXPECT_TRUE(equals(
+      Eigen::MatrixXs(builtInGrad.getControlForcesConst()),
+      Eigen::MatrixXs(customGrad.getControlForcesConst()),
+      1e-6));
+}
+#endif
@@ -5,6 +5,7 @@
 
 #include "dart/math/MathTypes.hpp"
 #include "dart/utils/AccelerationSmoother.hpp"
+#include "dart/utils/VelocityMinimizingSmoother.hpp"
 
 #include "TestHelpers.hpp"
 
@@ -101,4 +102,46 @@ TEST(ACCEL_SMOOTHER, LOCKED_ROW)
 
   EXPECT_TRUE(smoothedIterative.row(1).isConstant(0.0));
 }
+#endif
+
+#ifdef ALL_TESTS
+TEST(ACCEL_SMOOTHER, BANDED_V_SPARSE)
+{
+  int dofs = 5;
+  int timesteps = 300;
+  Eigen::MatrixXs data = Eigen::MatrixXs::Random(dofs, timesteps);
+  data.row(2).setConstant(0.3);
+
+  AccelerationSmoother smootherSparse(timesteps, 1, 0.05, true, false, false);
+  Eigen::MatrixXs smoothedSparse = smootherSparse.smooth(data);
+
+  AccelerationSmoother smootherBanded(timesteps, 1, 0.05);
+  Eigen::MatrixXs smoothedBanded = smootherBanded.smooth(data);
+
+  EXPECT_TRUE(equals(smoothedSparse, smoothedBanded, 1e-8));
+  EXPECT_TRUE(smoothedBanded.row(2).isConstant(0.3));
+
+  // A second smoother of the same size should reuse the cached factor, and
+  // get exactly the same answer
+  AccelerationSmoother smootherCached(timesteps, 1, 0.05);
+  EXPECT_TRUE(smoothedBanded == smootherCached.smooth(data));
+}
+#endif
+
+#ifdef ALL_TESTS
+TEST(VEL_SMOOTHER, BANDED_V_DENSE)
+{
+  int dofs = 3;
+  int timesteps = 100;
+  Eigen::MatrixXs data = Eigen::MatrixXs::Random(dofs, timesteps);
+
+  VelocityMinimizingSmoother smootherDense(
+      timesteps, 1, 0.01, false, false, false);
+  Eigen::MatrixXs smoothedDense = smootherDense.smooth(data);
+
+  VelocityMinimizingSmoother smootherBanded(timesteps, 1, 0.01);
+  Eigen::MatrixXs smoothedBanded = smootherBanded.smooth(data);
+
+  EXPECT_TRUE(equals(smoothedDense, smoothedBanded, 1e-8));
+}
 #endif
\ No newline at end of file
@@ -52,6 +52,7 @@ TEST(ANTHROPOMETRICS, LOAD)
 
   Eigen::VectorXs mu = gauss->getMu();
   Eigen::VectorXs x = gauss->convertFromMap(result->measure(skel));
+  EXPECT_TRUE(equals(result->measureVector(skel), x, 0));
   Eigen::MatrixXs compare = Eigen::MatrixXs(mu.size(), 3);
   compare.col(0) = x;
   compare.col(1) = mu;
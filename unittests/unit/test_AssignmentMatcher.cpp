@@ -161,4 +161,120 @@ TEST(C3D, MAPPING_STR_MORE_TARGET)
     std::string t = std::to_string(mapVec[i]);
     EXPECT_EQ(mapStr[s], t);
   }
+}
+
+TEST(C3D, SPARSE_MATCHES_DENSE)
+{
+  srand(42);
+  for (int trial = 0; trial < 20; trial++)
+  {
+    int rows = 5 + (trial % 7);
+    int cols = 4 + (trial % 5);
+    Eigen::MatrixXs weights = Eigen::MatrixXs::Random(rows, cols);
+    std::vector<Eigen::Triplet<s_t>> candidates;
+    for (int i = 0; i < rows; i++)
+    {
+      for (int j = 0; j < cols; j++)
+      {
+        // Knock out most of the pairs, and force a few ties
+        if (weights(i, j) < -0.3)
+        {
+          weights(i, j) = -1 * std::numeric_limits<double>::infinity();
+          continue;
+        }
+        if (weights(i, j) > 0.9)
+        {
+          weights(i, j) = 1.0;
+        }
+        candidates.emplace_back(i, j, weights(i, j));
+      }
+    }
+    // The order the candidates come in shouldn't matter
+    std::reverse(candidates.begin(), candidates.end());
+
+    Eigen::VectorXi dense
+        = math::AssignmentMatcher::assignRowsToColumns(weights);
+    Eigen::VectorXi sparse = math::AssignmentMatcher::assignRowsToColumnsSparse(
+        rows, cols, candidates);
+    EXPECT_EQ(dense, sparse);
+  }
+}
+
+// This finds the best possible total weight by trying every assignment of
+// rows starting at `row`, skipping pairs that aren't in `weights`.
+static s_t bruteForceBestTotal(
+    const Eigen::MatrixXs& weights, int row, std::vector<bool>& colUsed)
+{
+  if (row == weights.rows())
+  {
+    return 0.0;
+  }
+  // Leaving the row unassigned is always an option
+  s_t best = bruteForceBestTotal(weights, row + 1, colUsed);
+  for (int col = 0; col < weights.cols(); col++)
+  {
+    if (colUsed[col] || !std::isfinite((double)weights(row, col)))
+    {
+      continue;
+    }
+    colUsed[col] = true;
+    s_t total
+        = weights(row, col) + bruteForceBestTotal(weights, row + 1, colUsed);
+    best = std::max(best, total);
+    colUsed[col] = false;
+  }
+  return best;
+}
+
+// This sums the weights used by `mapping`, and checks it's a valid assignment
+static s_t assignmentTotal(
+    const Eigen::MatrixXs& weights, const Eigen::VectorXi& mapping)
+{
+  s_t total = 0.0;
+  std::vector<bool> colUsed(weights.cols(), false);
+  for (int row = 0; row < mapping.size(); row++)
+  {
+    int col = mapping(row);
+    if (col == -1)
+    {
+      continue;
+    }
+    EXPECT_FALSE(colUsed[col]);
+    EXPECT_TRUE(std::isfinite((double)weights(row, col)));
+    colUsed[col] = true;
+    total += weights(row, col);
+  }
+  return total;
+}
+
+TEST(C3D, OPTIMAL_MATCHES_BRUTE_FORCE)
+{
+  srand(42);
+  for (int trial = 0; trial < 50; trial++)
+  {
+    int rows = 1 + (trial % 7);
+    int cols = 1 + (trial % 6);
+    Eigen::MatrixXs weights = Eigen::MatrixXs::Random(rows, cols);
+    std::vector<Eigen::Triplet<s_t>> candidates;
+    for (int i = 0; i < rows; i++)
+    {
+      for (int j = 0; j < cols; j++)
+      {
+        // Knock out some of the pairs, and leave some negative weights in
+        if (weights(i, j) < -0.6)
+        {
+          weights(i, j) = -1 * std::numeric_limits<double>::infinity();
+          continue;
+        }
+        candidates.emplace_back(i, j, weights(i, j));
+      }
+    }
+
+    std::vector<bool> colUsed(cols, false);
+    s_t bestTotal = bruteForceBestTotal(weights, 0, colUsed);
+    Eigen::VectorXi mapping
+        = math::AssignmentMatcher::assignRowsToColumnsOptimal(
+            rows, cols, candidates);
+    EXPECT_NEAR(bestTotal, assignmentTotal(weights, mapping), 1e-8);
+  }
 }
\ No newline at end of file
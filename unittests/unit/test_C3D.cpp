@@ -105,4 +105,93 @@ TEST(C3D, TEST_VERTICAL_CONVENTION)
   // We expect the total force to be pointing upwards, overall
   EXPECT_GE(sum(1), 0);
 }
-#endif
\ No newline at end of file
+#endif
+#ifdef ALL_TESTS
+TEST(C3D, DENSE_MATCHES_MAP_VIEW)
+{
+  biomechanics::C3D c3d
+      = biomechanics::C3DLoader::loadC3D("dart://sample/c3d/JA1Gait35.c3d");
+
+  EXPECT_EQ(c3d.markerPositions.rows(), c3d.markers.size() * 3);
+  EXPECT_EQ(c3d.markerPositions.cols(), c3d.markerTimesteps.size());
+  EXPECT_EQ(c3d.markerObserved.rows(), c3d.markers.size());
+  EXPECT_EQ(c3d.markerObserved.cols(), c3d.markerTimesteps.size());
+  for (int t = 0; t < c3d.markerTimesteps.size(); t++)
+  {
+    int numObserved = 0;
+    for (int i = 0; i < c3d.markers.size(); i++)
+    {
+      EXPECT_EQ(c3d.markerIndices.at(c3d.markers[i]), i);
+      if (c3d.markerObserved(i, t))
+      {
+        numObserved++;
+        ASSERT_TRUE(c3d.markerTimesteps[t].count(c3d.markers[i]));
+        EXPECT_TRUE(equals(
+            c3d.markerTimesteps[t].at(c3d.markers[i]),
+            (Eigen::Vector3s)c3d.markerPositions.block<3, 1>(i * 3, t),
+            1e-12));
+      }
+    }
+    EXPECT_EQ(numObserved, c3d.markerTimesteps[t].size());
+  }
+
+  // Streaming the markers in chunks should see the same (unrotated) data
+  int seenFrames = 0;
+  std::vector<std::string> markers
+      = biomechanics::C3DLoader::loadC3DMarkerChunks(
+          "dart://sample/c3d/JA1Gait35.c3d",
+          64,
+          [&](int startFrame,
+              const Eigen::MatrixXs& positions,
+              const Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic>&
+                  observed) {
+            EXPECT_EQ(startFrame, seenFrames);
+            EXPECT_LE(positions.cols(), 64);
+            for (int t = 0; t < observed.cols(); t++)
+            {
+              for (int i = 0; i < observed.rows(); i++)
+              {
+                EXPECT_EQ(
+                    observed(i, t), c3d.markerObserved(i, startFrame + t));
+                if (observed(i, t))
+                {
+                  Eigen::Vector3s rotated
+                      = c3d.dataRotation * positions.block<3, 1>(i * 3, t);
+                  EXPECT_TRUE(equals(
+                      rotated,
+                      (Eigen::Vector3s)c3d.markerPositions.block<3, 1>(
+                          i * 3, startFrame + t),
+                      1e-9));
+                }
+              }
+            }
+            seenFrames += positions.cols();
+          });
+  EXPECT_EQ(markers, c3d.markers);
+  EXPECT_EQ(seenFrames, c3d.markerTimesteps.size());
+}
+#endif
+
+#ifdef ALL_TESTS
+TEST(C3D, MAP_VIEW_DUPLICATE_MARKERS_LAST_WINS)
+{
+  biomechanics::C3D c3d;
+  c3d.markers = {"A", "B", "A"};
+  c3d.markerPositions = Eigen::MatrixXs::Zero(9, 2);
+  c3d.markerPositions.col(0) << 1, 1, 1, 2, 2, 2, 3, 3, 3;
+  c3d.markerPositions.col(1) << 4, 4, 4, 5, 5, 5, 6, 6, 6;
+  c3d.markerObserved
+      = Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic>::Constant(
+          3, 2, true);
+  // On the second frame, only the first copy of "A" was observed
+  c3d.markerObserved(2, 1) = false;
+  c3d.rebuildMarkerTimestepsFromDense();
+
+  ASSERT_EQ(c3d.markerTimesteps.size(), 2);
+  EXPECT_EQ(c3d.markerTimesteps[0].size(), 2);
+  Eigen::Vector3s a = c3d.markerTimesteps[0].at("A");
+  EXPECT_TRUE(equals(a, Eigen::Vector3s(3, 3, 3), 0));
+  a = c3d.markerTimesteps[1].at("A");
+  EXPECT_TRUE(equals(a, Eigen::Vector3s(4, 4, 4), 0));
+}
+#endif
@@ -1598,6 +1598,84 @@ TEST(IKInitializer, SYNTHETIC_OSIM_SCALES_GIVEN)
 }
 #endif
 
+#ifdef ALL_TESTS
+TEST(IKInitializer, SYNTHETIC_CLIP_IK_STARTS_FROM_BALL_JOINT_SOLVE)
+{
+  // A single continuous clip, so only the first frame gets the ball joint
+  // solve with random restarts, and the ordinary joint solves for the clip
+  // start from its result
+  srand(42);
+  auto osim = OpenSimParser::parseOsim(
+      "dart://sample/grf/subject18_synthetic/"
+      "unscaled_generic.osim");
+  s_t targetHeight = 1.8;
+  s_t currentHeight = osim.skeleton->getHeight(
+      Eigen::VectorXs::Zero(osim.skeleton->getNumDofs()));
+  osim.skeleton->setBodyScales(
+      Eigen::VectorXs::Ones(osim.skeleton->getNumBodyNodes() * 3)
+      * (targetHeight / currentHeight));
+
+  std::vector<std::map<std::string, Eigen::Vector3s>> markerObservations;
+  std::vector<bool> newClip;
+  Eigen::VectorXs startPose = osim.skeleton->getRandomPose();
+  Eigen::VectorXs endPose = osim.skeleton->getRandomPose();
+  for (int t = 0; t < 5; t++)
+  {
+    // Move a little way towards another pose each frame
+    Eigen::VectorXs pose = startPose + (endPose - startPose) * (t * 0.02);
+    osim.skeleton->setPositions(pose);
+    markerObservations.push_back(
+        osim.skeleton->getMarkerMapWorldPositions(osim.markersMap));
+    newClip.push_back(t == 0);
+  }
+  std::shared_ptr<dynamics::Skeleton> recoveredSkel
+      = osim.skeleton->cloneSkeleton();
+
+  std::map<std::string, bool> markerIsAnatomical;
+  for (auto& pair : osim.markersMap)
+  {
+    markerIsAnatomical[pair.first] = false;
+  }
+  for (std::string& marker : osim.anatomicalMarkers)
+  {
+    markerIsAnatomical[marker] = true;
+  }
+
+  IKInitializer initializer(
+      osim.skeleton,
+      osim.markersMap,
+      markerIsAnatomical,
+      markerObservations,
+      newClip,
+      targetHeight);
+  initializer.closedFormMDSJointCenterSolver(false);
+  initializer.closedFormPivotFindingJointCenterSolver(false);
+  initializer.recenterAxisJointsBasedOnBoneAngles(false);
+  initializer.estimateGroupScalesClosedForm(false);
+  initializer.estimatePosesWithIK(false);
+
+  // Every frame of the clip, including the first, should put the markers back
+  // close to where we observed them
+  std::vector<Eigen::VectorXs> recoveredPoses = initializer.getPoses();
+  ASSERT_EQ(recoveredPoses.size(), markerObservations.size());
+  recoveredSkel->setGroupScales(initializer.getGroupScales());
+  for (int t = 0; t < markerObservations.size(); t++)
+  {
+    recoveredSkel->setPositions(recoveredPoses[t]);
+    std::map<std::string, Eigen::Vector3s> recoveredMarkers
+        = recoveredSkel->getMarkerMapWorldPositions(
+            recoveredSkel->convertMarkerMap(osim.markersMap));
+    s_t avgMarkerError = 0.0;
+    for (auto& pair : markerObservations[t])
+    {
+      avgMarkerError += (recoveredMarkers[pair.first] - pair.second).norm();
+    }
+    avgMarkerError /= markerObservations[t].size();
+    EXPECT_LT(avgMarkerError, 0.03);
+  }
+}
+#endif
+
 #ifdef ALL_TESTS
 TEST(IKInitializer, MARKER_RECONSTRUCTION)
 {
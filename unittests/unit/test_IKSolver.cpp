@@ -0,0 +1,203 @@
+#include <cstdlib>
+#include <vector>
+
+#include <Eigen/Dense>
+#include <gtest/gtest.h>
+
+#include "dart/math/IKSolver.hpp"
+#include "dart/math/MathTypes.hpp"
+
+#include "TestHelpers.hpp"
+
+using namespace dart;
+
+// #define ALL_TESTS
+
+namespace {
+
+/// This is a planar two-link arm with unit links, reaching for `target`. Each
+/// copy owns its own joint angles, the way a copy built around a cloned
+/// Skeleton would. The joint limits are a full turn either way, so clamping
+/// never cuts the arm off from a pose it could otherwise reach.
+math::IKProblemCopy createArmProblem(
+    std::shared_ptr<Eigen::VectorXs> state, Eigen::Vector2s target)
+{
+  Eigen::VectorXs upper = Eigen::VectorXs::Ones(2) * 2 * M_PI;
+  Eigen::VectorXs lower = Eigen::VectorXs::Ones(2) * -2 * M_PI;
+
+  math::IKProblemCopy copy;
+  copy.setPosAndClamp
+      = [state, upper, lower](const Eigen::VectorXs& pos, bool clamp) {
+          *state = pos;
+          if (clamp)
+          {
+            *state = state->cwiseMin(upper).cwiseMax(lower);
+          }
+          return *state;
+        };
+  copy.eval = [state, target](
+                  Eigen::Ref<Eigen::VectorXs> diff,
+                  Eigen::Ref<Eigen::MatrixXs> jac) {
+    s_t a = (*state)(0);
+    s_t b = (*state)(0) + (*state)(1);
+    diff(0) = cos(a) + cos(b) - target(0);
+    diff(1) = sin(a) + sin(b) - target(1);
+    jac(0, 0) = -sin(a) - sin(b);
+    jac(0, 1) = -sin(b);
+    jac(1, 0) = cos(a) + cos(b);
+    jac(1, 1) = cos(b);
+  };
+  return copy;
+}
+
+/// This returns where the hand of the arm from createArmProblem() is
+Eigen::Vector2s getArmHand(const Eigen::VectorXs& state)
+{
+  s_t a = state(0);
+  s_t b = state(0) + state(1);
+  return Eigen::Vector2s(cos(a) + cos(b), sin(a) + sin(b));
+}
+
+} // namespace
+
+TEST(IKSolver, PARALLEL_RESTARTS_MATCH_SERIAL)
+{
+  // This target is out of reach, so no restart can hit the loss lower bound,
+  // and every batch of restarts gets run
+  Eigen::Vector2s target(3.0, 0.5);
+  Eigen::VectorXs upper = Eigen::VectorXs::Ones(2) * 2 * M_PI;
+  Eigen::VectorXs lower = Eigen::VectorXs::Ones(2) * -2 * M_PI;
+  Eigen::VectorXs initialPos = Eigen::VectorXs::Ones(2) * 0.3;
+  auto getRandomRestart = [](Eigen::Ref<Eigen::VectorXs> pos) {
+    pos = Eigen::VectorXs::Random(2) * M_PI;
+  };
+  math::IKConfig config = math::IKConfig().setMaxRestarts(10);
+
+  std::shared_ptr<Eigen::VectorXs> serialState
+      = std::make_shared<Eigen::VectorXs>(Eigen::VectorXs::Zero(2));
+  math::IKProblemCopy serial = createArmProblem(serialState, target);
+  srand(42);
+  s_t serialLoss = math::solveIK(
+      initialPos,
+      upper,
+      lower,
+      2,
+      serial.setPosAndClamp,
+      serial.eval,
+      getRandomRestart,
+      config);
+
+  std::vector<math::IKProblemCopy> copies;
+  std::vector<std::shared_ptr<Eigen::VectorXs>> states;
+  for (int i = 0; i < 4; i++)
+  {
+    states.push_back(
+        std::make_shared<Eigen::VectorXs>(Eigen::VectorXs::Zero(2)));
+    copies.push_back(createArmProblem(states[i], target));
+  }
+  srand(42);
+  s_t parallelLoss = math::solveIKParallel(
+      initialPos, upper, lower, 2, copies, getRandomRestart, config);
+
+  EXPECT_EQ(serialLoss, parallelLoss);
+  // The solution should be left on the first copy
+  EXPECT_TRUE(equals(*serialState, *states[0], 1e-12));
+
+  // The closest the arm can get is fully stretched out towards the target
+  s_t shortfall = target.norm() - 2.0;
+  EXPECT_NEAR(serialLoss, shortfall * shortfall, 1e-4);
+  Eigen::Vector2s stretchedHand = 2.0 * target.normalized();
+  EXPECT_TRUE(equals(getArmHand(*serialState), stretchedHand, 1e-3));
+}
+
+TEST(IKSolver, REACHABLE_TARGET)
+{
+  // solveIK() runs through solveIKParallel() with a single copy, so check
+  // both against a target the arm can reach exactly
+  Eigen::Vector2s target(0.4, 1.2);
+  Eigen::VectorXs upper = Eigen::VectorXs::Ones(2) * 2 * M_PI;
+  Eigen::VectorXs lower = Eigen::VectorXs::Ones(2) * -2 * M_PI;
+  Eigen::VectorXs initialPos = Eigen::VectorXs::Ones(2) * 0.3;
+  auto getRandomRestart = [](Eigen::Ref<Eigen::VectorXs> pos) {
+    pos = Eigen::VectorXs::Random(2) * M_PI;
+  };
+  math::IKConfig config = math::IKConfig().setMaxRestarts(10);
+
+  std::shared_ptr<Eigen::VectorXs> serialState
+      = std::make_shared<Eigen::VectorXs>(Eigen::VectorXs::Zero(2));
+  math::IKProblemCopy serial = createArmProblem(serialState, target);
+  srand(42);
+  s_t serialLoss = math::solveIK(
+      initialPos,
+      upper,
+      lower,
+      2,
+      serial.setPosAndClamp,
+      serial.eval,
+      getRandomRestart,
+      config);
+  EXPECT_NEAR(serialLoss, 0.0, 1e-8);
+  EXPECT_TRUE(equals(getArmHand(*serialState), target, 1e-4));
+
+  std::vector<math::IKProblemCopy> copies;
+  std::vector<std::shared_ptr<Eigen::VectorXs>> states;
+  for (int i = 0; i < 4; i++)
+  {
+    states.push_back(
+        std::make_shared<Eigen::VectorXs>(Eigen::VectorXs::Zero(2)));
+    copies.push_back(createArmProblem(states[i], target));
+  }
+  srand(42);
+  s_t parallelLoss = math::solveIKParallel(
+      initialPos, upper, lower, 2, copies, getRandomRestart, config);
+  EXPECT_NEAR(parallelLoss, 0.0, 1e-8);
+  EXPECT_TRUE(equals(getArmHand(*states[0]), target, 1e-4));
+}
+
+TEST(IKSolver, DAMPED_LEAST_SQUARES_TALL_AND_WIDE)
+{
+  // Damped least squares factors whichever of J^T J and J J^T is smaller, so
+  // check that both shapes of a linear problem converge to the right answer
+  srand(42);
+  for (int rows : {12, 3})
+  {
+    int cols = 15 - rows;
+    Eigen::MatrixXs A = Eigen::MatrixXs::Random(rows, cols);
+    Eigen::VectorXs b = Eigen::VectorXs::Random(rows);
+    Eigen::VectorXs upper = Eigen::VectorXs::Ones(cols) * 1e3;
+    Eigen::VectorXs lower = Eigen::VectorXs::Ones(cols) * -1e3;
+
+    std::shared_ptr<Eigen::VectorXs> state
+        = std::make_shared<Eigen::VectorXs>(Eigen::VectorXs::Zero(cols));
+    math::IKResult result = math::refineIK(
+        Eigen::VectorXs::Zero(cols),
+        upper,
+        lower,
+        rows,
+        [state](const Eigen::VectorXs& pos, bool) {
+          *state = pos;
+          return *state;
+        },
+        [state, A, b](
+            Eigen::Ref<Eigen::VectorXs> diff, Eigen::Ref<Eigen::MatrixXs> jac) {
+          diff = A * (*state) - b;
+          jac = A;
+        },
+        math::IKConfig()
+            .setMaxStepCount(500)
+            .setConvergenceThreshold(1e-14)
+            .setLineSearch(false));
+
+    if (rows > cols)
+    {
+      // Overdetermined, so we should land on the least squares solution
+      Eigen::VectorXs leastSquares = A.colPivHouseholderQr().solve(b);
+      EXPECT_TRUE(equals(result.pos, leastSquares, 1e-6));
+    }
+    else
+    {
+      // Underdetermined, so we should hit the target exactly
+      EXPECT_TRUE(equals(Eigen::VectorXs(A * result.pos), b, 1e-6));
+    }
+  }
+}
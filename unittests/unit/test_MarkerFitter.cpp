@@ -2192,6 +2192,107 @@ void evaluateOnSyntheticData(
   }
 }
 
+TEST(MarkerFitter, DECIMATED_TIMESTEPS)
+{
+  // Every 4th frame of each clip, plus the last frame of each clip
+  std::vector<bool> newClip(10, false);
+  newClip[0] = true;
+  newClip[6] = true;
+  std::vector<int> timesteps = MarkerFitter::getDecimatedTimesteps(newClip, 4);
+  std::vector<int> expected = {0, 4, 5, 6, 9};
+  EXPECT_EQ(timesteps, expected);
+
+  // A clip shorter than the decimation keeps just its first and last frame
+  std::vector<bool> shortClip(3, false);
+  shortClip[0] = true;
+  timesteps = MarkerFitter::getDecimatedTimesteps(shortClip, 5);
+  expected = {0, 2};
+  EXPECT_EQ(timesteps, expected);
+
+  // A single frame is kept once
+  timesteps
+      = MarkerFitter::getDecimatedTimesteps(std::vector<bool>(1, true), 3);
+  expected = {0};
+  EXPECT_EQ(timesteps, expected);
+
+  // When the length is a multiple of the decimation plus one, the last frame
+  // is already on the grid, and isn't duplicated
+  timesteps = MarkerFitter::getDecimatedTimesteps(std::vector<bool>(7), 3);
+  expected = {0, 3, 6};
+  EXPECT_EQ(timesteps, expected);
+}
+
+TEST(MarkerFitter, INTERPOLATE_DECIMATED_ROUND_TRIP)
+{
+  // Anything linear within each clip survives decimating and interpolating
+  // back up exactly, including across the clip boundary
+  std::vector<bool> newClip(11, false);
+  newClip[0] = true;
+  newClip[7] = true;
+  Eigen::MatrixXs full = Eigen::MatrixXs::Zero(2, 11);
+  for (int t = 0; t < 11; t++)
+  {
+    full(0, t) = t < 7 ? 0.5 * t : 10.0 - 2.0 * t;
+    full(1, t) = t < 7 ? -1.0 : 3.0 + 0.25 * t;
+  }
+  std::vector<int> timesteps = MarkerFitter::getDecimatedTimesteps(newClip, 3);
+  Eigen::MatrixXs decimated = Eigen::MatrixXs::Zero(2, timesteps.size());
+  for (int i = 0; i < timesteps.size(); i++)
+  {
+    decimated.col(i) = full.col(timesteps[i]);
+  }
+  Eigen::MatrixXs recovered
+      = MarkerFitter::interpolateDecimatedColumns(decimated, timesteps, 11);
+  EXPECT_TRUE(equals(recovered, full, 1e-12));
+
+  // Wrapped rows take the short way around, and other rows don't
+  std::vector<int> ends = {0, 4};
+  Eigen::MatrixXs angles = Eigen::MatrixXs::Zero(2, 2);
+  angles.col(0) << M_PI - 0.1, M_PI - 0.1;
+  angles.col(1) << -M_PI + 0.1, -M_PI + 0.1;
+  std::vector<bool> wrapRows = {true, false};
+  Eigen::MatrixXs interpolated
+      = MarkerFitter::interpolateDecimatedColumns(angles, ends, 5, wrapRows);
+  EXPECT_NEAR(interpolated(0, 2), M_PI, 1e-12);
+  EXPECT_NEAR(interpolated(0, 1), M_PI - 0.05, 1e-12);
+  EXPECT_NEAR(interpolated(1, 2), 0.0, 1e-12);
+  EXPECT_NEAR(interpolated(0, 4), -M_PI + 0.1, 1e-12);
+}
+
+TEST(MarkerFitter, INTERPOLATE_DECIMATED_JOINT_AXIS)
+{
+  std::vector<int> ends = {0, 2};
+  Eigen::MatrixXs axis = Eigen::MatrixXs::Zero(12, 2);
+  // A joint whose axis swings 90 degrees, and one whose axis flips sign
+  axis.block<3, 1>(0, 0) = Eigen::Vector3s(1, 2, 3);
+  axis.block<3, 1>(0, 1) = Eigen::Vector3s(3, 2, 1);
+  axis.block<3, 1>(3, 0) = Eigen::Vector3s::UnitX();
+  axis.block<3, 1>(3, 1) = Eigen::Vector3s::UnitY();
+  axis.block<3, 1>(9, 0) = Eigen::Vector3s::UnitZ();
+  axis.block<3, 1>(9, 1) = -Eigen::Vector3s::UnitZ();
+
+  Eigen::MatrixXs interpolated
+      = MarkerFitter::interpolateDecimatedJointAxis(axis, ends, 3);
+  EXPECT_TRUE(equals(
+      Eigen::Vector3s(interpolated.block<3, 1>(0, 1)),
+      Eigen::Vector3s(2, 2, 2),
+      1e-12));
+  Eigen::Vector3s swung = interpolated.block<3, 1>(3, 1);
+  EXPECT_NEAR(swung.norm(), 1.0, 1e-12);
+  EXPECT_TRUE(equals(
+      Eigen::Vector3s(interpolated.block<3, 1>(3, 1)),
+      Eigen::Vector3s(sqrt(0.5), sqrt(0.5), 0),
+      1e-12));
+  Eigen::Vector3s flipped = interpolated.block<3, 1>(9, 1);
+  EXPECT_NEAR(flipped.norm(), 1.0, 1e-12);
+  EXPECT_NEAR(std::abs(interpolated(11, 1)), 1.0, 1e-12);
+  // The kept frames come through untouched
+  EXPECT_TRUE(equals(
+      Eigen::MatrixXs(interpolated.col(0)), Eigen::MatrixXs(axis.col(0))));
+  EXPECT_TRUE(equals(
+      Eigen::MatrixXs(interpolated.col(2)), Eigen::MatrixXs(axis.col(1))));
+}
+
 #ifdef FUNCTIONAL_TESTS
 TEST(MarkerFitter, ROTATE_IN_BOUNDS)
 {
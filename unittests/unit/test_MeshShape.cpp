@@ -0,0 +1,194 @@
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include <assimp/cexport.h>
+#include <gtest/gtest.h>
+
+#include "dart/common/LocalResourceRetriever.hpp"
+#include "dart/dynamics/MeshShape.hpp"
+#include "dart/utils/CompositeResourceRetriever.hpp"
+#include "dart/utils/DartResourceRetriever.hpp"
+
+using namespace dart;
+
+static common::ResourceRetrieverPtr createRetriever()
+{
+  auto retriever = std::make_shared<utils::CompositeResourceRetriever>();
+  retriever->addSchemaRetriever(
+      "file", std::make_shared<common::LocalResourceRetriever>());
+  retriever->addSchemaRetriever("dart", utils::DartResourceRetriever::create());
+  return retriever;
+}
+
+TEST(MeshShape, CACHE_SHARES_IDENTICAL_MESHES)
+{
+  common::ResourceRetrieverPtr retriever = createRetriever();
+  std::string leftFootPath = "dart://sample/sdf/atlas/l_foot.dae";
+  std::string rightFootPath = "dart://sample/sdf/atlas/r_foot.dae";
+
+  dynamics::MeshShape::setMeshCacheEnabled(true);
+  dynamics::MeshShape::clearMeshCache();
+  EXPECT_EQ(dynamics::MeshShape::getMeshCacheSize(), 0u);
+
+  std::shared_ptr<dynamics::SharedMeshWrapper> first
+      = dynamics::MeshShape::loadMesh(leftFootPath, retriever);
+  std::shared_ptr<dynamics::SharedMeshWrapper> second
+      = dynamics::MeshShape::loadMesh(leftFootPath, retriever);
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(dynamics::MeshShape::getMeshCacheSize(), 1u);
+
+  std::shared_ptr<dynamics::SharedMeshWrapper> other
+      = dynamics::MeshShape::loadMesh(rightFootPath, retriever);
+  ASSERT_NE(other, nullptr);
+  EXPECT_NE(first, other);
+  EXPECT_EQ(dynamics::MeshShape::getMeshCacheSize(), 2u);
+
+  // Meshes handed out before a clear stay valid
+  dynamics::MeshShape::clearMeshCache();
+  EXPECT_EQ(dynamics::MeshShape::getMeshCacheSize(), 0u);
+  EXPECT_NE(first->mesh, nullptr);
+
+  // With the cache off, every load imports its own copy
+  dynamics::MeshShape::setMeshCacheEnabled(false);
+  std::shared_ptr<dynamics::SharedMeshWrapper> uncached
+      = dynamics::MeshShape::loadMesh(leftFootPath, retriever);
+  ASSERT_NE(uncached, nullptr);
+  EXPECT_NE(first, uncached);
+  EXPECT_EQ(first->mesh->mNumMeshes, uncached->mesh->mNumMeshes);
+  EXPECT_EQ(dynamics::MeshShape::getMeshCacheSize(), 0u);
+  dynamics::MeshShape::setMeshCacheEnabled(true);
+}
+
+static std::size_t countFilesWithExtension(
+    const std::filesystem::path& directory, const std::string& extension)
+{
+  std::size_t count = 0;
+  for (const auto& file : std::filesystem::directory_iterator(directory))
+  {
+    if (file.path().extension() == extension)
+      count++;
+  }
+  return count;
+}
+
+static aiColor4D getDiffuseColor(
+    const std::shared_ptr<dynamics::SharedMeshWrapper>& mesh)
+{
+  aiColor4D color;
+  const aiScene* scene = mesh->mesh;
+  scene->mMaterials[scene->mMeshes[0]->mMaterialIndex]->Get(
+      AI_MATKEY_COLOR_DIFFUSE, color);
+  return color;
+}
+
+TEST(MeshShape, CACHE_DIRECTORY_WRITES_RELOADS_AND_INVALIDATES)
+{
+  common::ResourceRetrieverPtr retriever = createRetriever();
+  const std::filesystem::path root
+      = std::filesystem::temp_directory_path() / "nimble_test_mesh_cache";
+  const std::filesystem::path cacheDirectory = root / "cache";
+  std::filesystem::remove_all(root);
+  std::filesystem::create_directories(cacheDirectory);
+
+  // A triangle that pulls its color from a material file next to it
+  const std::filesystem::path meshPath = root / "triangle.obj";
+  const std::filesystem::path materialPath = root / "triangle.mtl";
+  std::ofstream(meshPath) << "mtllib triangle.mtl\n"
+                          << "usemtl paint\n"
+                          << "v 0 0 0\nv 1 0 0\nv 0 1 0\n"
+                          << "f 1 2 3\n";
+  std::ofstream(materialPath) << "newmtl paint\nKd 1 0 0\n";
+  const std::string meshUri = "file://" + meshPath.string();
+
+  dynamics::MeshShape::setMeshCacheEnabled(true);
+  dynamics::MeshShape::setMeshCacheDirectory(cacheDirectory.string());
+  dynamics::MeshShape::clearMeshCache();
+
+  // The first load imports the mesh, and writes it to the cache directory
+  std::shared_ptr<dynamics::SharedMeshWrapper> first
+      = dynamics::MeshShape::loadMesh(meshUri, retriever);
+  ASSERT_NE(first, nullptr);
+  EXPECT_EQ(getDiffuseColor(first).r, 1.0);
+  EXPECT_EQ(countFilesWithExtension(cacheDirectory, ".assbin"), 1u);
+  EXPECT_EQ(countFilesWithExtension(cacheDirectory, ".deps"), 1u);
+
+  // Swap a different mesh into the file on disk, so we can tell a read from
+  // the cache directory apart from importing the triangle again
+  std::filesystem::path cachePath;
+  for (const auto& file : std::filesystem::directory_iterator(cacheDirectory))
+  {
+    if (file.path().extension() == ".assbin")
+      cachePath = file.path();
+  }
+  dynamics::MeshShape::setMeshCacheEnabled(false);
+  std::string leftFootPath = "dart://sample/sdf/atlas/l_foot.dae";
+  std::shared_ptr<dynamics::SharedMeshWrapper> foot
+      = dynamics::MeshShape::loadMesh(leftFootPath, retriever);
+  dynamics::MeshShape::setMeshCacheEnabled(true);
+  ASSERT_NE(foot, nullptr);
+  ASSERT_EQ(
+      aiExportScene(foot->mesh, "assbin", cachePath.string().c_str(), 0),
+      aiReturn_SUCCESS);
+
+  // After dropping the in-memory copy, the next load reads the file back
+  dynamics::MeshShape::clearMeshCache();
+  std::shared_ptr<dynamics::SharedMeshWrapper> reloaded
+      = dynamics::MeshShape::loadMesh(meshUri, retriever);
+  ASSERT_NE(reloaded, nullptr);
+  EXPECT_NE(reloaded, first);
+  EXPECT_EQ(
+      reloaded->mesh->mMeshes[0]->mNumVertices,
+      foot->mesh->mMeshes[0]->mNumVertices);
+  EXPECT_EQ(countFilesWithExtension(cacheDirectory, ".assbin"), 1u);
+
+  // Changing only the material file changes the key, in memory and on disk,
+  // so we import the triangle again instead of reusing a stale copy
+  std::ofstream(materialPath) << "newmtl paint\nKd 0 1 0\n";
+  std::shared_ptr<dynamics::SharedMeshWrapper> recolored
+      = dynamics::MeshShape::loadMesh(meshUri, retriever);
+  ASSERT_NE(recolored, nullptr);
+  EXPECT_EQ(recolored->mesh->mMeshes[0]->mNumVertices, 3u);
+  EXPECT_EQ(getDiffuseColor(recolored).r, 0.0);
+  EXPECT_EQ(getDiffuseColor(recolored).g, 1.0);
+  EXPECT_EQ(countFilesWithExtension(cacheDirectory, ".assbin"), 2u);
+
+  dynamics::MeshShape::setMeshCacheDirectory("");
+  dynamics::MeshShape::clearMeshCache();
+  std::filesystem::remove_all(root);
+}
+
+TEST(MeshShape, CACHE_EVICTS_LEAST_RECENTLY_USED)
+{
+  common::ResourceRetrieverPtr retriever = createRetriever();
+  std::string leftFootPath = "dart://sample/sdf/atlas/l_foot.dae";
+  std::string rightFootPath = "dart://sample/sdf/atlas/r_foot.dae";
+  std::string headPath = "dart://sample/sdf/atlas/head.dae";
+
+  dynamics::MeshShape::setMeshCacheEnabled(true);
+  dynamics::MeshShape::clearMeshCache();
+  const std::size_t defaultCapacity
+      = dynamics::MeshShape::getMeshCacheCapacity();
+  dynamics::MeshShape::setMeshCacheCapacity(2);
+
+  std::shared_ptr<dynamics::SharedMeshWrapper> leftFoot
+      = dynamics::MeshShape::loadMesh(leftFootPath, retriever);
+  std::shared_ptr<dynamics::SharedMeshWrapper> rightFoot
+      = dynamics::MeshShape::loadMesh(rightFootPath, retriever);
+  // Touch the left foot, so the right foot is the one that gets evicted
+  EXPECT_EQ(dynamics::MeshShape::loadMesh(leftFootPath, retriever), leftFoot);
+  dynamics::MeshShape::loadMesh(headPath, retriever);
+  EXPECT_EQ(dynamics::MeshShape::getMeshCacheSize(), 2u);
+  EXPECT_EQ(dynamics::MeshShape::loadMesh(leftFootPath, retriever), leftFoot);
+  EXPECT_NE(
+      dynamics::MeshShape::loadMesh(rightFootPath, retriever), rightFoot);
+
+  // Shrinking the capacity evicts right away
+  dynamics::MeshShape::setMeshCacheCapacity(1);
+  EXPECT_EQ(dynamics::MeshShape::getMeshCacheSize(), 1u);
+
+  dynamics::MeshShape::setMeshCacheCapacity(defaultCapacity);
+  dynamics::MeshShape::clearMeshCache();
+}
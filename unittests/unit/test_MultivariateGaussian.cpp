@@ -170,4 +170,37 @@ TEST(MultivariateGaussian, OBSERVE)
   EXPECT_EQ(conditioned->getCov().rows(), conditioned->getMu().size());
 
   conditioned->debugToStdout();
+}
+
+//==============================================================================
+TEST(MultivariateGaussian, BATCH_MATCHES_SINGLE)
+{
+  srand(42);
+  int n = 6;
+  Eigen::MatrixXs A = Eigen::MatrixXs::Random(n, n);
+  Eigen::MatrixXs cov
+      = A * A.transpose() + Eigen::MatrixXs::Identity(n, n) * 0.1;
+  std::vector<std::string> vars;
+  for (int i = 0; i < n; i++)
+  {
+    vars.push_back("var" + std::to_string(i));
+  }
+  MultivariateGaussian gauss(vars, Eigen::VectorXs::Random(n), cov);
+
+  Eigen::MatrixXs xs = Eigen::MatrixXs::Random(n, 20);
+  Eigen::VectorXs logPDFs = gauss.computeLogPDFBatch(xs);
+  Eigen::VectorXs unnormalizedLogPDFs = gauss.computeLogPDFBatch(xs, false);
+  Eigen::MatrixXs grads = gauss.computeLogPDFGradBatch(xs);
+  for (int i = 0; i < xs.cols(); i++)
+  {
+    Eigen::VectorXs x = xs.col(i);
+    Eigen::VectorXs diff = x - gauss.getMu();
+    s_t expected = gauss.getLogNormalizationConstant()
+                   - 0.5 * diff.dot(cov.inverse() * diff);
+    EXPECT_NEAR(gauss.computeLogPDF(x), expected, 1e-9);
+    EXPECT_NEAR(logPDFs(i), gauss.computeLogPDF(x), 1e-12);
+    EXPECT_NEAR(unnormalizedLogPDFs(i), gauss.computeLogPDF(x, false), 1e-12);
+    EXPECT_TRUE(equals(
+        Eigen::VectorXs(grads.col(i)), gauss.computeLogPDFGrad(x), 1e-12));
+  }
 }
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include "dart/biomechanics/ForcePlate.hpp"
 #include "dart/biomechanics/OpenSimParser.hpp"
 #include "dart/biomechanics/SkeletonConverter.hpp"
+#include "dart/biomechanics/SkeletonSnapshot.hpp"
 #include "dart/dynamics/EulerFreeJoint.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 #include "dart/math/MathTypes.hpp"
@@ -1278,4 +1279,78 @@ TEST(OpenSimParser, LOAD_MOCO_TRAJECTORY)
       mocoTraj,
       "dart://sample/osim/MocoPlotting/plot.csv");
 }
-#endif
\ No newline at end of file
+#endif
+
+#ifdef ALL_TESTS
+TEST(OpenSimParser, SKELETON_SNAPSHOT_ROUND_TRIP)
+{
+  OpenSimFile original = OpenSimParser::parseOsim(
+      "dart://sample/osim/Rajagopal2015/Rajagopal2015.osim");
+  std::shared_ptr<dynamics::Skeleton> skel = original.skeleton;
+  skel->autogroupSymmetricSuffixes();
+  skel->setGroupScales(Eigen::VectorXs::Random(skel->getGroupScaleDim()) * 0.1
+                       + Eigen::VectorXs::Ones(skel->getGroupScaleDim()));
+
+  SkeletonSnapshot::writeOpenSimFile("./testSkeletonSnapshot.bin", original);
+  OpenSimFile loaded
+      = SkeletonSnapshot::readOpenSimFile("./testSkeletonSnapshot.bin");
+  std::shared_ptr<dynamics::Skeleton> copy = loaded.skeleton;
+  ASSERT_NE(copy, nullptr);
+
+  ASSERT_EQ(skel->getNumBodyNodes(), copy->getNumBodyNodes());
+  ASSERT_EQ(skel->getNumDofs(), copy->getNumDofs());
+  EXPECT_EQ(skel->getNumScaleGroups(), copy->getNumScaleGroups());
+  for (int i = 0; i < skel->getNumBodyNodes(); i++)
+  {
+    EXPECT_EQ(skel->getBodyNode(i)->getName(), copy->getBodyNode(i)->getName());
+    EXPECT_EQ(
+        skel->getBodyNode(i)->getShapeNodes().size(),
+        copy->getBodyNode(i)->getShapeNodes().size());
+  }
+  for (int i = 0; i < skel->getNumDofs(); i++)
+  {
+    EXPECT_EQ(skel->getDof(i)->getName(), copy->getDof(i)->getName());
+  }
+  EXPECT_TRUE(equals(skel->getPositions(), copy->getPositions()));
+  EXPECT_TRUE(
+      equals(skel->getPositionLowerLimits(), copy->getPositionLowerLimits()));
+  EXPECT_TRUE(
+      equals(skel->getPositionUpperLimits(), copy->getPositionUpperLimits()));
+  EXPECT_TRUE(equals(skel->getBodyScales(), copy->getBodyScales()));
+  EXPECT_TRUE(equals(skel->getGroupScales(), copy->getGroupScales()));
+  EXPECT_TRUE(equals(skel->getLinkMasses(), copy->getLinkMasses()));
+
+  ASSERT_EQ(original.markersMap.size(), loaded.markersMap.size());
+  EXPECT_EQ(original.anatomicalMarkers, loaded.anatomicalMarkers);
+  EXPECT_EQ(original.trackingMarkers, loaded.trackingMarkers);
+  std::vector<std::pair<dynamics::BodyNode*, Eigen::Vector3s>> markers;
+  std::vector<std::pair<dynamics::BodyNode*, Eigen::Vector3s>> copyMarkers;
+  for (auto& pair : original.markersMap)
+  {
+    ASSERT_EQ(loaded.markersMap.count(pair.first), 1);
+    markers.push_back(pair.second);
+    copyMarkers.push_back(loaded.markersMap[pair.first]);
+  }
+  std::vector<dynamics::Joint*> joints;
+  std::vector<dynamics::Joint*> copyJoints;
+  for (int i = 0; i < skel->getNumJoints(); i++)
+  {
+    joints.push_back(skel->getJoint(i));
+    copyJoints.push_back(copy->getJoint(i));
+  }
+
+  for (int i = 0; i < 5; i++)
+  {
+    Eigen::VectorXs pose = skel->getRandomPose();
+    skel->setPositions(pose);
+    copy->setPositions(pose);
+    EXPECT_TRUE(equals(
+        skel->getMarkerWorldPositions(markers),
+        copy->getMarkerWorldPositions(copyMarkers)));
+    EXPECT_TRUE(equals(
+        skel->getJointWorldPositions(joints),
+        copy->getJointWorldPositions(copyJoints)));
+    EXPECT_TRUE(equals(skel->getMassMatrix(), copy->getMassMatrix()));
+  }
+}
+#endif
@@ -0,0 +1,776 @@
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dart/biomechanics/ForcePlate.hpp"
+#include "dart/biomechanics/OpenSimParser.hpp"
+#include "dart/dynamics/DegreeOfFreedom.hpp"
+#include "dart/dynamics/EulerFreeJoint.hpp"
+#include "dart/dynamics/Joint.hpp"
+#include "dart/dynamics/PrismaticJoint.hpp"
+#include "dart/dynamics/Skeleton.hpp"
+#include "dart/dynamics/TranslationalJoint.hpp"
+#include "dart/dynamics/TranslationalJoint2D.hpp"
+#include "dart/math/Geometry.hpp"
+#include "dart/math/MathTypes.hpp"
+#include "dart/utils/DartResourceRetriever.hpp"
+
+using namespace dart;
+using namespace biomechanics;
+
+// These check the TRC/MOT/GRF loaders, which parse their numeric rows in
+// parallel with OpenSimParser::parseDecimal(), against the straightforward
+// token-by-token atof() loaders they replaced. The old loaders are kept here
+// as reference implementations.
+
+namespace {
+
+/// This is true if `a` and `b` are the same double, bit for bit (so NaNs match
+/// each other, and 0.0 doesn't match -0.0)
+bool sameBits(double a, double b)
+{
+  return std::memcmp(&a, &b, sizeof(double)) == 0;
+}
+
+/// This is true if `a` and `b` are the same size and match bit for bit
+template <typename A, typename B>
+bool sameBits(const Eigen::MatrixBase<A>& a, const Eigen::MatrixBase<B>& b)
+{
+  if (a.rows() != b.rows() || a.cols() != b.cols())
+    return false;
+  for (int i = 0; i < a.rows(); i++)
+  {
+    for (int j = 0; j < a.cols(); j++)
+    {
+      if (!sameBits((double)a(i, j), (double)b(i, j)))
+        return false;
+    }
+  }
+  return true;
+}
+
+/// This checks parseDecimal() against strtod() on `token`, both with the token
+/// on its own and with it followed by the separators we see in real files
+void expectParseDecimalMatchesStrtod(const std::string& token)
+{
+  for (const std::string& after : {"", "\t", " ", "\n", "\r\n"})
+  {
+    std::string line = token + after;
+    double expected = std::strtod(line.c_str(), nullptr);
+    double parsed = OpenSimParser::parseDecimal(
+        line.c_str(), line.c_str() + token.size());
+    EXPECT_TRUE(sameBits(parsed, expected))
+        << "Token \"" << token << "\" parsed as " << parsed
+        << ", but strtod() gives " << expected;
+  }
+}
+
+std::string readFixture(const std::string& uri)
+{
+  return utils::DartResourceRetriever::create()->readAll(uri);
+}
+
+/// This is the TRC loader from before rows were parsed in parallel
+OpenSimTRC legacyLoadTRC(const std::string& content)
+{
+  OpenSimTRC result;
+  double unitsMultiplier = 1.0;
+
+  std::vector<std::string> markerNames;
+  Eigen::Vector3s markerSwapSpace = Eigen::Vector3s::Zero();
+
+  int lineNumber = 0;
+  auto start = 0U;
+  auto end = content.find("\n");
+  while (end != std::string::npos)
+  {
+    std::string line = content.substr(start, end - start);
+
+    std::map<std::string, Eigen::Vector3s> markerPositions;
+    double timestamp = 0.0;
+
+    int tokenNumber = 0;
+    std::string whitespace = " \t";
+    auto tokenStart = line.find_first_not_of(whitespace);
+    while (tokenStart != std::string::npos)
+    {
+      auto tokenEnd = line.find_first_of(whitespace, tokenStart + 1);
+      std::string token = line.substr(tokenStart, tokenEnd - tokenStart);
+
+      if (lineNumber == 2)
+      {
+        if (tokenNumber == 4)
+        { // Units
+          if (token == "m")
+            unitsMultiplier = 1.0;
+          else if (token == "mm")
+            unitsMultiplier = 1.0 / 1000;
+        }
+      }
+      else if (lineNumber == 3 && tokenNumber > 1)
+      {
+        markerNames.push_back(token);
+      }
+      else if (lineNumber > 5)
+      {
+        if (tokenNumber == 1)
+        {
+          timestamp = atof(token.c_str());
+        }
+        else if (tokenNumber > 1)
+        {
+          int offset
+              = tokenNumber - 2; // first two cols are "frame #" and "time"
+          int markerNumber = (int)floor((double)offset / 3);
+          int axisNumber = offset - (markerNumber * 3);
+          markerSwapSpace(axisNumber) = atof(token.c_str()) * unitsMultiplier;
+          if (axisNumber == 2)
+          {
+            if (!markerSwapSpace.hasNaN()
+                && (markerSwapSpace != Eigen::Vector3s::Zero()))
+            {
+              markerPositions[markerNames[markerNumber]]
+                  = Eigen::Vector3s(markerSwapSpace);
+            }
+          }
+        }
+      }
+
+      tokenNumber++;
+      if (tokenEnd == std::string::npos)
+      {
+        break;
+      }
+      tokenStart = line.find_first_not_of(whitespace, tokenEnd + 1);
+    }
+
+    if (lineNumber > 5)
+    {
+      result.markerTimesteps.push_back(markerPositions);
+      result.timestamps.push_back(timestamp);
+    }
+
+    start = end + 1; // "\n".length()
+    end = content.find("\n", start);
+    lineNumber++;
+  }
+
+  return result;
+}
+
+/// This is the MOT loader from before rows were parsed in parallel
+OpenSimMot legacyLoadMot(
+    std::shared_ptr<dynamics::Skeleton> skel,
+    const std::string& content,
+    Eigen::Matrix3s rotateBy,
+    int downsampleByFactor)
+{
+  std::vector<int> columnToDof;
+  std::vector<bool> rotationalDof;
+
+  std::vector<Eigen::VectorXs> poses;
+  std::vector<double> timestamps;
+
+  bool inHeader = true;
+  bool inDegrees = false;
+
+  int downsampleClock = 0;
+  int lineNumber = 0;
+  auto start = 0U;
+  auto end = content.find("\n");
+  while (end != std::string::npos)
+  {
+    std::string line = content.substr(start, end - start);
+
+    // Trim '\r', in case this file was saved on a Windows machine
+    if (line.size() > 0 && line[line.size() - 1] == '\r')
+    {
+      line = line.substr(0, line.size() - 1);
+    }
+
+    if (inHeader)
+    {
+      std::string ENDHEADER = "endheader";
+      if (line.size() >= ENDHEADER.size()
+          && line.substr(0, ENDHEADER.size()) == ENDHEADER)
+      {
+        inHeader = false;
+      }
+      auto tokenEnd = line.find("=");
+      if (tokenEnd != std::string::npos)
+      {
+        std::string variable = line.substr(0, tokenEnd);
+        std::string value
+            = line.substr(tokenEnd + 1, line.size() - tokenEnd - 1);
+        if (variable == "inDegrees")
+        {
+          inDegrees = (value == "yes");
+        }
+      }
+    }
+    else
+    {
+      int tokenNumber = 0;
+      std::string whitespace = " \t";
+      auto tokenStart = line.find_first_not_of(whitespace);
+      Eigen::VectorXs pose = Eigen::VectorXs::Zero(skel->getNumDofs());
+      double timestamp = 0.0;
+      while (tokenStart != std::string::npos)
+      {
+        auto tokenEnd = line.find_first_of(whitespace, tokenStart + 1);
+        std::string token = line.substr(tokenStart, tokenEnd - tokenStart);
+
+        if (lineNumber == 0)
+        {
+          if (tokenNumber > 0)
+          {
+            dynamics::DegreeOfFreedom* dof = skel->getDof(token);
+            bool isRotationalJoint = true;
+            if (dof != nullptr)
+            {
+              columnToDof.push_back(dof->getIndexInSkeleton());
+              dynamics::Joint* joint = dof->getJoint();
+              if (joint->getType()
+                      == dynamics::TranslationalJoint2D::getStaticType()
+                  || joint->getType()
+                         == dynamics::TranslationalJoint::getStaticType()
+                  || joint->getType()
+                         == dynamics::PrismaticJoint::getStaticType())
+              {
+                isRotationalJoint = false;
+              }
+              if (joint->getType() == dynamics::EulerFreeJoint::getStaticType()
+                  && dof->getIndexInJoint() >= 3)
+              {
+                isRotationalJoint = false;
+              }
+            }
+            else
+            {
+              columnToDof.push_back(-1);
+            }
+            rotationalDof.push_back(isRotationalJoint);
+          }
+        }
+        else
+        {
+          double value = atof(token.c_str());
+          if (tokenNumber == 0)
+          {
+            timestamp = value;
+          }
+          else
+          {
+            int dofIndex = columnToDof[tokenNumber - 1];
+            if (dofIndex != -1)
+            {
+              bool isRotationalJoint = rotationalDof[tokenNumber - 1];
+              if (inDegrees && isRotationalJoint)
+              {
+                value *= M_PI / 180.0;
+              }
+              pose(dofIndex) = value;
+            }
+          }
+        }
+
+        tokenNumber++;
+        if (tokenEnd == std::string::npos)
+        {
+          break;
+        }
+        tokenStart = line.find_first_not_of(whitespace, tokenEnd + 1);
+      }
+
+      if (lineNumber > 0)
+      {
+        downsampleClock--;
+        if (downsampleClock <= 0)
+        {
+          downsampleClock = downsampleByFactor;
+          poses.push_back(pose);
+          timestamps.push_back(timestamp);
+        }
+      }
+      lineNumber++;
+    }
+
+    start = end + 1; // "\n".length()
+    end = content.find("\n", start);
+  }
+
+  Eigen::MatrixXs posesMatrix
+      = Eigen::MatrixXs::Zero(skel->getNumDofs(), poses.size());
+  for (int i = 0; i < poses.size(); i++)
+  {
+    if (skel->getJoint(0)->getType()
+        == dynamics::EulerFreeJoint::getStaticType())
+    {
+      Eigen::VectorXs ballPoses = skel->convertPositionsToBallSpace(poses[i]);
+
+      // Rotate the orientation
+      Eigen::Vector3s so3 = ballPoses.segment<3>(0);
+      Eigen::Matrix3s R = math::expMapRot(so3);
+      ballPoses.segment<3>(0) = math::logMap(rotateBy * R);
+
+      // Rotate the offset
+      ballPoses.segment<3>(3) = rotateBy * ballPoses.segment<3>(3);
+
+      posesMatrix.col(i) = skel->convertPositionsFromBallSpace(ballPoses);
+    }
+    else
+    {
+      posesMatrix.col(i) = poses[i];
+    }
+  }
+  OpenSimMot mot;
+  mot.poses = posesMatrix;
+  mot.timestamps = timestamps;
+  return mot;
+}
+
+/// This is the GRF loader from before rows were parsed in parallel, without
+/// the resampling onto target timestamps (which didn't change). It returns one
+/// ForcePlate per plate, with every row of the file. The column naming rules
+/// are the old ones, condensed into loops that apply them in the same order.
+std::vector<ForcePlate> legacyLoadGRFRows(
+    const std::string& content, const std::vector<std::string>& colNames)
+{
+  // Work out which plate, and which axis of its COP or wrench, each column is
+  std::vector<int> colToPlate;
+  std::vector<int> colToCOP;
+  std::vector<int> colToWrench;
+  std::map<std::string, int> prefixSuffixNumbers;
+  for (const std::string& token : colNames)
+  {
+    int plate = -1;
+    int cop = -1;
+    int wrench = -1;
+    std::string prefixSuffix = token;
+    const std::vector<std::pair<std::string, int>> copAxes
+        = {{"px", 0}, {"py", 1}, {"pz", 2}};
+    for (auto& axis : copAxes)
+    {
+      if (token.find(axis.first) != std::string::npos)
+      {
+        prefixSuffix.replace(token.find(axis.first), axis.first.size(), "");
+        cop = axis.second;
+      }
+    }
+    const std::vector<std::pair<std::string, int>> wrenchAxes
+        = {{"mx", 0},
+           {"my", 1},
+           {"mz", 2},
+           {"torque_x", 0},
+           {"torque_y", 1},
+           {"torque_z", 2}};
+    for (auto& axis : wrenchAxes)
+    {
+      if (token.find(axis.first) != std::string::npos)
+      {
+        prefixSuffix.replace(token.find(axis.first), axis.first.size(), "");
+        wrench = axis.second;
+      }
+    }
+    const std::vector<std::pair<std::string, int>> sidedTorqueAxes
+        = {{"_x", 0}, {"_y", 1}, {"_z", 2}};
+    for (auto& axis : sidedTorqueAxes)
+    {
+      std::string right = "torque_r" + axis.first;
+      std::string left = "torque_l" + axis.first;
+      if (token.find(right) != std::string::npos
+          || token.find(left) != std::string::npos)
+      {
+        prefixSuffix.replace(token.find(axis.first), axis.first.size(), "_");
+        wrench = axis.second;
+      }
+    }
+    const std::vector<std::pair<std::string, int>> forceAxes
+        = {{"vx", 3}, {"vy", 4}, {"vz", 5}};
+    for (auto& axis : forceAxes)
+    {
+      if (token.find(axis.first) != std::string::npos)
+      {
+        prefixSuffix.replace(token.find(axis.first), axis.first.size(), "");
+        wrench = axis.second;
+      }
+    }
+    for (std::string word : {"force", "moment", "torque"})
+    {
+      if (prefixSuffix.find(word) != std::string::npos)
+      {
+        prefixSuffix.replace(prefixSuffix.find(word), word.size(), "");
+      }
+    }
+    while (prefixSuffix.find("__") != std::string::npos)
+    {
+      prefixSuffix.replace(prefixSuffix.find("__"), 2, "_");
+    }
+
+    if (token == "time")
+    {
+      plate = 0;
+    }
+    else if (prefixSuffixNumbers.count(prefixSuffix) > 0)
+    {
+      plate = prefixSuffixNumbers.at(prefixSuffix);
+    }
+    else
+    {
+      plate = prefixSuffixNumbers.size();
+      prefixSuffixNumbers[prefixSuffix] = plate;
+    }
+    colToPlate.push_back(plate);
+    colToCOP.push_back(cop);
+    colToWrench.push_back(wrench);
+  }
+  int numPlates = prefixSuffixNumbers.size();
+
+  std::vector<ForcePlate> forcePlates(numPlates);
+  bool inHeader = true;
+  bool sawColumnNames = false;
+  auto start = 0U;
+  auto end = content.find("\n");
+  while (true)
+  {
+    std::string line = content.substr(start, end - start);
+
+    // Trim '\r', in case this file was saved on a Windows machine
+    if (line.size() > 0 && line[line.size() - 1] == '\r')
+    {
+      line = line.substr(0, line.size() - 1);
+    }
+
+    if (inHeader)
+    {
+      std::string ENDHEADER = "endheader";
+      if (line.size() >= ENDHEADER.size()
+          && line.substr(0, ENDHEADER.size()) == ENDHEADER)
+      {
+        inHeader = false;
+      }
+    }
+    else if (!line.empty())
+    {
+      std::string whitespace = " \t";
+      int tokenNumber = 0;
+      auto tokenStart = line.find_first_not_of(whitespace);
+      double timestamp = 0.0;
+      std::vector<Eigen::Vector3s> cops(numPlates, Eigen::Vector3s::Zero());
+      std::vector<Eigen::Vector6s> wrenches(
+          numPlates, Eigen::Vector6s::Zero());
+      while (tokenStart != std::string::npos)
+      {
+        auto tokenEnd = line.find_first_of(whitespace, tokenStart + 1);
+        std::string token = line.substr(tokenStart, tokenEnd - tokenStart);
+        if (sawColumnNames)
+        {
+          double value = atof(token.c_str());
+          if (tokenNumber == 0)
+          {
+            timestamp = value;
+          }
+          else
+          {
+            int plateIndex = colToPlate[tokenNumber];
+            if (plateIndex != -1)
+            {
+              if (colToWrench[tokenNumber] != -1)
+              {
+                wrenches[plateIndex](colToWrench[tokenNumber]) = value;
+              }
+              if (colToCOP[tokenNumber] != -1)
+              {
+                cops[plateIndex](colToCOP[tokenNumber]) = value;
+              }
+            }
+          }
+        }
+        tokenNumber++;
+        if (tokenEnd == std::string::npos)
+        {
+          break;
+        }
+        tokenStart = line.find_first_not_of(whitespace, tokenEnd + 1);
+      }
+
+      if (sawColumnNames)
+      {
+        for (int i = 0; i < numPlates; i++)
+        {
+          forcePlates[i].timestamps.push_back(timestamp);
+          forcePlates[i].centersOfPressure.push_back(cops[i]);
+          forcePlates[i].moments.push_back(wrenches[i].segment<3>(0));
+          forcePlates[i].forces.push_back(wrenches[i].segment<3>(3));
+        }
+      }
+      // Ignore whitespace in a .MOT file between "endheader" and the names of
+      // the columns
+      else if (tokenNumber > 0)
+      {
+        sawColumnNames = true;
+      }
+    }
+
+    if (end == std::string::npos)
+    {
+      break;
+    }
+    start = end + 1; // "\n".length()
+    end = content.find("\n", start);
+  }
+  return forcePlates;
+}
+
+/// This reads the column names of a GRF .mot file, from the first non-blank
+/// line after "endheader"
+std::vector<std::string> readGRFColumnNames(const std::string& content)
+{
+  std::vector<std::string> colNames;
+  std::size_t start = content.find("endheader");
+  start = content.find("\n", start) + 1;
+  while (colNames.empty() && start < content.size())
+  {
+    std::size_t end = content.find("\n", start);
+    std::string line = content.substr(start, end - start);
+    std::string whitespace = " \t\r";
+    auto tokenStart = line.find_first_not_of(whitespace);
+    while (tokenStart != std::string::npos)
+    {
+      auto tokenEnd = line.find_first_of(whitespace, tokenStart + 1);
+      colNames.push_back(line.substr(tokenStart, tokenEnd - tokenStart));
+      if (tokenEnd == std::string::npos)
+        break;
+      tokenStart = line.find_first_not_of(whitespace, tokenEnd + 1);
+    }
+    if (end == std::string::npos)
+      break;
+    start = end + 1;
+  }
+  return colNames;
+}
+
+} // namespace
+
+TEST(OpenSimParserLoaders, PARSE_DECIMAL_MATCHES_STRTOD)
+{
+  // Plain decimals, leading zeros and signs
+  for (const std::string& token :
+       {"0",
+        "1",
+        "-1",
+        "+1",
+        "-0",
+        "+0",
+        "0.0",
+        "-0.0",
+        "123.456",
+        "-123.456",
+        "+123.456",
+        "0001234.5000",
+        "-0000.000123",
+        "000",
+        ".5",
+        "-.5",
+        "5.",
+        "0.1",
+        "0.3",
+        "2.2250738585072014",
+        "1002.085083007813",
+        "-995.9971923828124",
+        "9007199254740992",
+        "9007199254740993",
+        "18446744073709551615"})
+  {
+    expectParseDecimalMatchesStrtod(token);
+  }
+
+  // Exponents, inside and outside the range that takes the exact fast path
+  for (const std::string& token :
+       {"1e0",
+        "1e5",
+        "1E5",
+        "1e+5",
+        "1e-5",
+        "-2.5e-3",
+        "+2.5E+3",
+        "1.5e22",
+        "1.5e23",
+        "1.5e-22",
+        "1.5e-23",
+        "1e308",
+        "1e309",
+        "1e-320",
+        "4.9e-324",
+        "1e-400",
+        "123456789e-30",
+        "0.000000000000000000000000001",
+        "1e",
+        "1e+",
+        "1e-"})
+  {
+    expectParseDecimalMatchesStrtod(token);
+  }
+
+  // More than 19 significant digits, so the mantissa doesn't fit in 64 bits
+  for (const std::string& token :
+       {"12345678901234567890",
+        "1.2345678901234567890123",
+        "-0.00012345678901234567890123",
+        "00000000000000000000000000001.5",
+        "1.0000000000000000000001",
+        "99999999999999999999999999e-10",
+        "3.14159265358979323846264338327950288"})
+  {
+    expectParseDecimalMatchesStrtod(token);
+  }
+
+  // NaN, infinity, and things that aren't numbers at all
+  for (const std::string& token :
+       {"nan",
+        "NaN",
+        "-nan",
+        "inf",
+        "-inf",
+        "+inf",
+        "Infinity",
+        "-INF",
+        "",
+        "-",
+        "+",
+        ".",
+        "abc",
+        "1.2.3",
+        "--1",
+        "0x1A"})
+  {
+    expectParseDecimalMatchesStrtod(token);
+  }
+
+  // A trailing '\r' left in the token, as on a Windows line ending that
+  // wasn't trimmed
+  for (const std::string& token : {"1.5\r", "-2e3\r", "nan\r", "7\r"})
+  {
+    expectParseDecimalMatchesStrtod(token);
+  }
+
+  // Random values, printed the ways mocap exporters tend to print them
+  srand(42);
+  char buffer[64];
+  for (int i = 0; i < 10000; i++)
+  {
+    double value = ((double)rand() / RAND_MAX - 0.5)
+                   * std::pow(10.0, (rand() % 16) - 8);
+    for (const char* format : {"%.17g", "%.6f", "%.12f", "%e", "%.3e", "%g"})
+    {
+      snprintf(buffer, sizeof(buffer), format, value);
+      expectParseDecimalMatchesStrtod(buffer);
+    }
+  }
+}
+
+TEST(OpenSimParserLoaders, TRC_MATCHES_LEGACY_LOADER)
+{
+  for (const std::string& uri :
+       {"dart://sample/osim/AlanBug2/step_width.trc",
+        "dart://sample/grf/subject18_synthetic/trials/walk2/markers.trc"})
+  {
+    OpenSimTRC loaded = OpenSimParser::loadTRC(uri);
+    OpenSimTRC legacy = legacyLoadTRC(readFixture(uri));
+
+    ASSERT_EQ(loaded.timestamps.size(), legacy.timestamps.size()) << uri;
+    ASSERT_GT(loaded.timestamps.size(), 0) << uri;
+    for (int t = 0; t < loaded.timestamps.size(); t++)
+    {
+      EXPECT_TRUE(sameBits(loaded.timestamps[t], legacy.timestamps[t]));
+
+      // The old loader left the '\r' of a Windows line ending on the last
+      // marker name. That was a bug, so we strip it before comparing.
+      std::map<std::string, Eigen::Vector3s> legacyMarkers;
+      for (auto& pair : legacy.markerTimesteps[t])
+      {
+        std::string name = pair.first;
+        if (!name.empty() && name.back() == '\r')
+          name.pop_back();
+        legacyMarkers[name] = pair.second;
+      }
+      ASSERT_EQ(loaded.markerTimesteps[t].size(), legacyMarkers.size())
+          << uri << " row " << t;
+      for (auto& pair : legacyMarkers)
+      {
+        ASSERT_EQ(loaded.markerTimesteps[t].count(pair.first), 1)
+            << uri << " row " << t << " marker " << pair.first;
+        EXPECT_TRUE(
+            sameBits(loaded.markerTimesteps[t].at(pair.first), pair.second))
+            << uri << " row " << t << " marker " << pair.first;
+      }
+    }
+  }
+}
+
+TEST(OpenSimParserLoaders, MOT_MATCHES_LEGACY_LOADER)
+{
+  std::shared_ptr<dynamics::Skeleton> skel
+      = OpenSimParser::parseOsim(
+            "dart://sample/osim/Rajagopal2015_v3_scaled/Rajagopal_scaled.osim")
+            .skeleton;
+  const std::string uri
+      = "dart://sample/osim/Rajagopal2015_v3_scaled/S01DN603_ik.mot";
+  const std::string content = readFixture(uri);
+  for (int downsampleByFactor : {1, 3})
+  {
+    OpenSimMot loaded = OpenSimParser::loadMot(
+        skel, uri, Eigen::Matrix3s::Identity(), downsampleByFactor);
+    OpenSimMot legacy = legacyLoadMot(
+        skel, content, Eigen::Matrix3s::Identity(), downsampleByFactor);
+
+    ASSERT_EQ(loaded.timestamps.size(), legacy.timestamps.size());
+    ASSERT_GT(loaded.timestamps.size(), 0);
+    for (int t = 0; t < loaded.timestamps.size(); t++)
+    {
+      EXPECT_TRUE(sameBits(loaded.timestamps[t], legacy.timestamps[t]));
+    }
+    EXPECT_TRUE(sameBits(loaded.poses, legacy.poses));
+  }
+}
+
+TEST(OpenSimParserLoaders, GRF_MATCHES_LEGACY_LOADER)
+{
+  for (const std::string& uri :
+       {"dart://sample/grf/subject18_synthetic/trials/walk2/grf.mot",
+        "dart://sample/grf/Subject4/ID/walking2_grf.mot",
+        "dart://sample/osim/WeirdGRF/weird.mot"})
+  {
+    const std::string content = readFixture(uri);
+    std::vector<ForcePlate> loaded = OpenSimParser::loadGRF(uri);
+    std::vector<ForcePlate> legacy
+        = legacyLoadGRFRows(content, readGRFColumnNames(content));
+
+    ASSERT_EQ(loaded.size(), legacy.size()) << uri;
+    ASSERT_GT(loaded.size(), 0) << uri;
+    for (int i = 0; i < loaded.size(); i++)
+    {
+      ASSERT_EQ(loaded[i].timestamps.size(), legacy[i].timestamps.size())
+          << uri << " plate " << i;
+      ASSERT_GT(loaded[i].timestamps.size(), 0) << uri << " plate " << i;
+      for (int t = 0; t < loaded[i].timestamps.size(); t++)
+      {
+        EXPECT_TRUE(
+            sameBits(loaded[i].timestamps[t], legacy[i].timestamps[t]));
+        EXPECT_TRUE(sameBits(
+            loaded[i].centersOfPressure[t], legacy[i].centersOfPressure[t]))
+            << uri << " plate " << i << " row " << t;
+        EXPECT_TRUE(sameBits(loaded[i].moments[t], legacy[i].moments[t]))
+            << uri << " plate " << i << " row " << t;
+        EXPECT_TRUE(sameBits(loaded[i].forces[t], legacy[i].forces[t]))
+            << uri << " plate " << i << " row " << t;
+      }
+    }
+  }
+}
@@ -30,6 +30,7 @@
  *   POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <atomic>
 #include <chrono>
 #include <iostream>
 #include <memory>
@@ -124,6 +125,188 @@ TEST(REALTIME, VECTOR_LOG_AFTER)
 }
 #endif
 
+#ifdef ALL_TESTS
+TEST(REALTIME, VECTOR_LOG_WRAP_AROUND)
+{
+  int dim = 2;
+  VectorLog log = VectorLog(dim, 4);
+
+  for (int i = 0; i < 10; i++)
+  {
+    log.record(i * 10L, Eigen::VectorXs::Ones(dim) * i);
+  }
+  // Recording backwards in time is dropped
+  log.record(5L, Eigen::VectorXs::Ones(dim) * -1);
+
+  // Only the newest (capacity - 1) records are kept, which is 70, 80 and 90
+  EXPECT_EQ(3, log.availableStepsBefore(1000L));
+  EXPECT_EQ(2, log.availableStepsBefore(90L));
+  EXPECT_EQ(-1, log.availableStepsBefore(60L));
+  EXPECT_EQ(30L, log.availableHistoryBefore(100L));
+
+  Eigen::MatrixXs expected = Eigen::MatrixXs::Zero(dim, 4);
+  expected.col(2) = Eigen::VectorXs::Ones(dim) * 7;
+  expected.col(3) = Eigen::VectorXs::Ones(dim) * 8;
+  EXPECT_TRUE(equals(expected, log.getRecentValuesBefore(90L, 4)));
+
+  long time;
+  Eigen::VectorXs value = Eigen::VectorXs::Zero(dim);
+  EXPECT_TRUE(log.getLastValueAtOrBefore(85L, time, value));
+  EXPECT_EQ(80L, time);
+  EXPECT_TRUE(equals(Eigen::VectorXs(Eigen::VectorXs::Ones(dim) * 8), value));
+  EXPECT_FALSE(log.getLastValueAtOrBefore(65L, time, value));
+
+  EXPECT_TRUE(log.getFirstValue(time, value));
+  EXPECT_EQ(70L, time);
+  EXPECT_TRUE(equals(Eigen::VectorXs(Eigen::VectorXs::Ones(dim) * 7), value));
+
+  log.discardBefore(85L);
+  EXPECT_EQ(1, log.availableStepsBefore(1000L));
+  EXPECT_TRUE(log.getFirstValue(time, value));
+  EXPECT_EQ(90L, time);
+
+  log.discardBefore(1000L);
+  EXPECT_FALSE(log.getFirstValue(time, value));
+}
+#endif
+
+#ifdef ALL_TESTS
+TEST(REALTIME, VECTOR_LOG_CONCURRENT_READER)
+{
+  // One thread records into a tiny ring, so it wraps constantly, while this
+  // thread reads. Every entry of value i is i, and it's recorded at time i,
+  // so a torn read shows up as a value that doesn't match itself or its
+  // timestamp.
+  int dim = 16;
+  int capacity = 4;
+  long numRecords = 2000000;
+  VectorLog log = VectorLog(dim, capacity);
+  std::atomic<long> lastRecorded(-1);
+
+  std::thread writer([&]() {
+    Eigen::VectorXs value = Eigen::VectorXs::Zero(dim);
+    for (long i = 0; i < numRecords; i++)
+    {
+      value.setConstant(i);
+      log.record(i, value);
+      lastRecorded.store(i, std::memory_order_release);
+    }
+  });
+
+  long time;
+  long lastSeen = -1;
+  int numTorn = 0;
+  int numOutOfRange = 0;
+  Eigen::VectorXs value = Eigen::VectorXs::Zero(dim);
+  while (lastRecorded.load(std::memory_order_acquire) < numRecords - 1)
+  {
+    long upperBound = lastRecorded.load(std::memory_order_acquire);
+    // Ask for slightly old times too, which read the slots the writer is
+    // about to overwrite
+    for (long lag = 0; lag < capacity + 2; lag++)
+    {
+      if (!log.getLastValueAtOrBefore(upperBound - lag, time, value))
+        continue;
+      if (time > upperBound - lag || time < 0)
+        numOutOfRange++;
+      if ((value.array() != static_cast<s_t>(time)).any())
+        numTorn++;
+      if (lag == 0)
+      {
+        // The newest value we can see never goes backwards
+        if (time < lastSeen)
+          numOutOfRange++;
+        lastSeen = time;
+      }
+    }
+    if (log.getFirstValue(time, value))
+    {
+      if (time < 0 || time > lastRecorded.load(std::memory_order_acquire))
+        numOutOfRange++;
+      if ((value.array() != static_cast<s_t>(time)).any())
+        numTorn++;
+    }
+  }
+  writer.join();
+
+  EXPECT_EQ(0, numTorn);
+  EXPECT_EQ(0, numOutOfRange);
+  EXPECT_TRUE(log.getLastValueAtOrBefore(numRecords, time, value));
+  EXPECT_EQ(numRecords - 1, time);
+}
+#endif
+
+#ifdef ALL_TESTS
+TEST(REALTIME, OBSERVATION_LOG)
+{
+  ObservationLog log = ObservationLog(
+      5L,
+      Eigen::VectorXs::Zero(1),
+      Eigen::VectorXs::Zero(1),
+      Eigen::VectorXs::Ones(1),
+      8);
+
+  for (int i = 1; i <= 20; i++)
+  {
+    log.observe(
+        i * 10L,
+        Eigen::VectorXs::Ones(1) * i,
+        Eigen::VectorXs::Ones(1) * -i,
+        Eigen::VectorXs::Ones(1));
+  }
+
+  Observation obs = log.getClosestObservationBefore(155L);
+  EXPECT_EQ(150L, obs.time);
+  EXPECT_EQ(15.0, static_cast<double>(obs.pos(0)));
+  EXPECT_EQ(-15.0, static_cast<double>(obs.vel(0)));
+
+  obs = log.getClosestObservationBefore(1000L);
+  EXPECT_EQ(200L, obs.time);
+
+  // Asking for a time older than anything still in the ring falls back to
+  // the oldest observation we still have. The ring holds (capacity - 1)
+  // readable entries, so that's 140.
+  obs = log.getClosestObservationBefore(20L);
+  EXPECT_EQ(140L, obs.time);
+  EXPECT_EQ(14.0, static_cast<double>(obs.pos(0)));
+
+  // Once everything is discarded, we fall back to the initial observation
+  log.discardBefore(1000L);
+  obs = log.getClosestObservationBefore(20L);
+  EXPECT_EQ(5L, obs.time);
+}
+#endif
+
+#ifdef ALL_TESTS
+TEST(REALTIME, OBSERVATION_LOG_BEFORE_EVICTION)
+{
+  ObservationLog log = ObservationLog(
+      5L,
+      Eigen::VectorXs::Ones(1) * 3,
+      Eigen::VectorXs::Ones(1) * -3,
+      Eigen::VectorXs::Ones(1),
+      8);
+  log.observe(
+      10L,
+      Eigen::VectorXs::Ones(1),
+      Eigen::VectorXs::Ones(1),
+      Eigen::VectorXs::Ones(1));
+
+  // The initial observation is the oldest one until it's evicted
+  Observation obs = log.getClosestObservationBefore(7L);
+  EXPECT_EQ(5L, obs.time);
+  EXPECT_EQ(3.0, static_cast<double>(obs.pos(0)));
+  EXPECT_EQ(-3.0, static_cast<double>(obs.vel(0)));
+  obs = log.getClosestObservationBefore(0L);
+  EXPECT_EQ(5L, obs.time);
+
+  // Discarding drops the initial observation like any other
+  log.discardBefore(10L);
+  obs = log.getClosestObservationBefore(0L);
+  EXPECT_EQ(10L, obs.time);
+}
+#endif
+
 #ifdef ALL_TESTS
 TEST(REALTIME, CONTROL_LOG)
 {
@@ -0,0 +1,25 @@
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "dart/common/Sha256.hpp"
+
+using namespace dart;
+
+TEST(Sha256, MATCHES_FIPS_180_TEST_VECTORS)
+{
+  EXPECT_EQ(
+      common::computeSha256(""),
+      "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+  EXPECT_EQ(
+      common::computeSha256("abc"),
+      "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+  // 56 bytes, so the length spills the padding into a second block
+  EXPECT_EQ(
+      common::computeSha256(
+          "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+      "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+  EXPECT_EQ(
+      common::computeSha256(std::string(1000000, 'a')),
+      "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
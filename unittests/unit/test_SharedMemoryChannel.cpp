@@ -0,0 +1,105 @@
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "dart/realtime/SharedMemoryChannel.hpp"
+
+using namespace dart;
+
+TEST(SharedMemoryChannel, MESSAGES_WRAP_AROUND_THE_RING)
+{
+  // The ring is small enough that the messages wrap around it many times, and
+  // the sender regularly has to wait for the receiver to make room
+  realtime::SharedMemoryChannel channel(256, 256);
+  int numMessages = 10000;
+
+  std::thread sender([&]() {
+    for (int i = 0; i < numMessages; i++)
+    {
+      std::vector<int> payload(i % 13, i);
+      EXPECT_TRUE(channel.sendToPlanner(
+          i % 5, payload.data(), payload.size() * sizeof(int)));
+    }
+  });
+
+  int type;
+  std::vector<char> data;
+  for (int i = 0; i < numMessages; i++)
+  {
+    while (!channel.receiveOnPlanner(type, data))
+    {
+      std::this_thread::yield();
+    }
+    EXPECT_EQ(type, i % 5);
+    ASSERT_EQ(data.size(), (i % 13) * sizeof(int));
+    const int* values = reinterpret_cast<const int*>(data.data());
+    for (int j = 0; j < i % 13; j++)
+    {
+      EXPECT_EQ(values[j], i);
+    }
+  }
+  sender.join();
+
+  // The planner isn't caught up until it comes back after the last message
+  EXPECT_FALSE(channel.isPlannerCaughtUp());
+  EXPECT_FALSE(channel.receiveOnPlanner(type, data));
+  EXPECT_TRUE(channel.isPlannerCaughtUp());
+
+  // A message that can never fit is rejected, rather than blocking forever
+  std::vector<char> tooBig(1024);
+  EXPECT_FALSE(channel.sendToClient(0, tooBig.data(), tooBig.size()));
+
+  // Closing wakes up a sender that's waiting for room
+  std::vector<char> big(200);
+  EXPECT_TRUE(channel.sendToClient(0, big.data(), big.size()));
+  std::thread blocked([&]() {
+    EXPECT_FALSE(channel.sendToClient(0, big.data(), big.size()));
+  });
+  channel.close();
+  blocked.join();
+  EXPECT_TRUE(channel.isClosed());
+}
+
+TEST(SharedMemoryChannel, WORKS_ACROSS_FORK)
+{
+  realtime::SharedMemoryChannel channel;
+
+  int childId = fork();
+  if (childId == 0)
+  {
+    // Echo every message back to the parent, with its type incremented
+    int type;
+    std::vector<char> data;
+    while (!channel.isClosed())
+    {
+      if (channel.receiveOnPlanner(type, data))
+      {
+        channel.sendToClient(type + 1, data.data(), data.size());
+      }
+    }
+    _exit(0);
+  }
+
+  int type;
+  std::vector<char> data;
+  for (int i = 0; i < 100; i++)
+  {
+    double value = i * 0.5;
+    ASSERT_TRUE(channel.sendToPlanner(i, &value, sizeof(value)));
+    while (!channel.receiveOnClient(type, data))
+    {
+      std::this_thread::yield();
+    }
+    EXPECT_EQ(type, i + 1);
+    ASSERT_EQ(data.size(), sizeof(double));
+    EXPECT_EQ(*reinterpret_cast<const double*>(data.data()), value);
+  }
+  channel.close();
+
+  int status;
+  waitpid(childId, &status, 0);
+  EXPECT_TRUE(WIFEXITED(status));
+}
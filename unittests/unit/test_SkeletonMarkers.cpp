@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <gtest/gtest.h>
 
 #include "dart/biomechanics/OpenSimParser.hpp"
@@ -5,6 +7,7 @@
 #include "dart/dynamics/BallJoint.hpp"
 #include "dart/dynamics/FreeJoint.hpp"
 #include "dart/dynamics/Joint.hpp"
+#include "dart/dynamics/KinematicsPlan.hpp"
 #include "dart/dynamics/Skeleton.hpp"
 #include "dart/math/Geometry.hpp"
 #include "dart/realtime/Ticker.hpp"
@@ -206,4 +209,139 @@ TEST(SkeletonConverter, MARKER_DISTANCE)
     EXPECT_TRUE(equals(axisGroupGrad, axisGroupGrad_fd, 1e-10));
   }
 }
+#endif
+
+#ifdef ALL_TESTS
+TEST(KinematicsPlan, MATCHES_SKELETON)
+{
+  std::shared_ptr<dynamics::Skeleton> osim
+      = OpenSimParser::parseOsim(
+            "dart://sample/osim/Rajagopal2015/Rajagopal2015.osim")
+            .skeleton;
+  osim->getBodyNode("tibia_l")->setScale(Eigen::Vector3s(1.1, 1.2, 1.3));
+
+  std::vector<std::pair<dynamics::BodyNode*, Eigen::Vector3s>> markers;
+  for (std::string name : {"pelvis", "radius_l", "tibia_l", "calcn_r"})
+  {
+    markers.push_back(
+        std::make_pair(osim->getBodyNode(name), Eigen::Vector3s::Random()));
+  }
+  std::vector<dynamics::Joint*> joints;
+  for (std::string name : {"hip_r", "walker_knee_l", "elbow_r"})
+  {
+    joints.push_back(osim->getJoint(name));
+  }
+
+  dynamics::KinematicsPlan plan(osim, markers, joints);
+  EXPECT_EQ(plan.getNumPoints(), (int)(markers.size() + joints.size()));
+
+  Eigen::MatrixXs poses = Eigen::MatrixXs::Zero(osim->getNumDofs(), 5);
+  for (int t = 0; t < poses.cols(); t++)
+  {
+    poses.col(t) = osim->getRandomPose();
+  }
+  Eigen::VectorXs originalPose = osim->getPositions();
+  Eigen::MatrixXs positions = plan.getWorldPositionsForPoses(poses);
+  std::vector<Eigen::SparseMatrix<s_t, Eigen::RowMajor>> jacs
+      = plan.getWorldPositionsJacobiansWrtJointPositionsForPoses(poses);
+  EXPECT_TRUE(equals(osim->getPositions(), originalPose, 0));
+
+  for (int t = 0; t < poses.cols(); t++)
+  {
+    osim->setPositions(poses.col(t));
+    Eigen::VectorXs expectedPositions
+        = Eigen::VectorXs::Zero(plan.getNumPoints() * 3);
+    expectedPositions.head(markers.size() * 3)
+        = osim->getMarkerWorldPositions(markers);
+    expectedPositions.tail(joints.size() * 3)
+        = osim->getJointWorldPositions(joints);
+    Eigen::MatrixXs expectedJac
+        = Eigen::MatrixXs::Zero(plan.getNumPoints() * 3, osim->getNumDofs());
+    expectedJac.topRows(markers.size() * 3)
+        = osim->getMarkerWorldPositionsJacobianWrtJointPositions(markers);
+    expectedJac.bottomRows(joints.size() * 3)
+        = osim->getJointWorldPositionsJacobianWrtJointPositions(joints);
+
+    EXPECT_TRUE(equals(
+        Eigen::VectorXs(positions.col(t)), expectedPositions, 1e-12));
+    EXPECT_TRUE(equals(Eigen::MatrixXs(jacs[t]), expectedJac, 1e-12));
+    EXPECT_TRUE(equals(plan.getWorldPositions(), expectedPositions, 1e-12));
+    EXPECT_TRUE(equals(
+        Eigen::MatrixXs(plan.getWorldPositionsJacobianWrtJointPositions()),
+        expectedJac,
+        1e-12));
+  }
+}
+#endif
+
+#ifdef ALL_TESTS
+TEST(SkeletonConverter, SPARSE_MARKER_JACOBIANS)
+{
+  std::shared_ptr<dynamics::Skeleton> osim
+      = OpenSimParser::parseOsim(
+            "dart://sample/osim/Rajagopal2015/Rajagopal2015.osim")
+            .skeleton;
+  osim->setPositions(osim->getRandomPose());
+  osim->getBodyNode("tibia_l")->setScale(Eigen::Vector3s(1.1, 1.2, 1.3));
+  osim->mergeScaleGroups(
+      osim->getBodyNode("radius_l"), osim->getBodyNode("radius_r"));
+  osim->setScaleGroupUniformScaling(osim->getBodyNode("tibia_r"));
+
+  std::vector<std::pair<dynamics::BodyNode*, Eigen::Vector3s>> markers;
+  for (int i = 0; i < osim->getNumBodyNodes(); i++)
+  {
+    markers.push_back(
+        std::make_pair(osim->getBodyNode(i), Eigen::Vector3s::Random()));
+  }
+  std::vector<dynamics::Joint*> joints = osim->getJoints();
+
+  auto expectSparseMatchesDense = [&]() {
+    EXPECT_TRUE(equals(
+        Eigen::MatrixXs(
+            osim->getMarkerWorldPositionsSparseJacobianWrtJointPositions(
+                markers)),
+        osim->getMarkerWorldPositionsJacobianWrtJointPositions(markers),
+        1e-12));
+    EXPECT_TRUE(equals(
+        Eigen::MatrixXs(
+            osim->getJointWorldPositionsSparseJacobianWrtJointPositions(
+                joints)),
+        osim->getJointWorldPositionsJacobianWrtJointPositions(joints),
+        1e-12));
+    EXPECT_TRUE(equals(
+        Eigen::MatrixXs(
+            osim->getMarkerWorldPositionsSparseJacobianWrtBodyScales(markers)),
+        osim->getMarkerWorldPositionsJacobianWrtBodyScales(markers),
+        1e-12));
+    EXPECT_TRUE(equals(
+        Eigen::MatrixXs(
+            osim->getMarkerWorldPositionsSparseJacobianWrtGroupScales(
+                markers)),
+        osim->getMarkerWorldPositionsJacobianWrtGroupScales(markers),
+        1e-12));
+    EXPECT_TRUE(equals(
+        Eigen::MatrixXs(
+            osim->getMarkerWorldPositionsSparseJacobianWrtMarkerOffsets(
+                markers)),
+        osim->getMarkerWorldPositionsJacobianWrtMarkerOffsets(markers),
+        1e-12));
+  };
+  expectSparseMatchesDense();
+
+  // The skeleton keeps the sparsity patterns between calls, so check they're
+  // refilled after the pose, scales and marker offsets change
+  osim->setPositions(osim->getRandomPose());
+  osim->getBodyNode("femur_r")->setScale(Eigen::Vector3s(0.9, 1.1, 1.05));
+  for (auto& marker : markers)
+  {
+    marker.second = Eigen::Vector3s::Random();
+  }
+  expectSparseMatchesDense();
+
+  // And that they're rebuilt for a different set of markers and joints
+  markers.erase(markers.begin() + 1, markers.begin() + 4);
+  std::reverse(markers.begin(), markers.end());
+  joints.resize(joints.size() / 2);
+  expectSparseMatchesDense();
+}
 #endif
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "dart/common/WorkerPool.hpp"
+
+using namespace dart;
+
+TEST(WorkerPool, EACH_WORKER_RUNS_ITS_OWN_INDEX)
+{
+  common::WorkerPool pool(8);
+  EXPECT_EQ(pool.getNumWorkers(), 8);
+
+  // Every call with fewer tasks than workers should leave the extra workers
+  // idle, and each task index should always land on the same thread
+  std::vector<int> counts(8, 0);
+  std::vector<std::thread::id> threads(8);
+  for (int call = 0; call < 1000; call++)
+  {
+    int numTasks = 1 + (call % 8);
+    pool.run(numTasks, [&](int i) {
+      if (counts[i] == 0)
+        threads[i] = std::this_thread::get_id();
+      EXPECT_EQ(threads[i], std::this_thread::get_id());
+      counts[i]++;
+    });
+  }
+  for (int i = 0; i < 8; i++)
+  {
+    EXPECT_EQ(counts[i], 125 * (8 - i));
+    EXPECT_NE(threads[i], std::this_thread::get_id());
+  }
+}
+
+TEST(WorkerPool, RETHROWS_TASK_EXCEPTIONS)
+{
+  common::WorkerPool pool(4);
+  std::vector<int> ran(4, 0);
+  EXPECT_THROW(
+      pool.run(
+          4,
+          [&](int i) {
+            ran[i] = 1;
+            if (i == 2)
+              throw std::runtime_error("task failed");
+          }),
+      std::runtime_error);
+  // The other tasks still run to completion, and the pool is still usable
+  EXPECT_EQ(ran, std::vector<int>(4, 1));
+  pool.run(4, [&](int i) { ran[i] = 2; });
+  EXPECT_EQ(ran, std::vector<int>(4, 2));
+}